@@ -33,18 +33,42 @@
 
 #include "structure/hardware.hpp"
 
-//! \brief	HDD computation model.
+#include "util/unitarytest.hpp"
+
+//! \brief	HDD computation model. The seek curve coefficients of each
+//!			device are computed once, and the batches are computed in two
+//!			passes: the seek distances, which depend on the previous request
+//!			of the device, then the service times on flat arrays.
+//!
+//!			With the rotational model, the platter angle is tracked against
+//!			the device clock: a request starts at its arrival date or when
+//!			the device is done with the previous one, and waits for its first
+//!			sector to pass under the head after the seek.
+//!
+//!			This start date is an approximation. The execution does not know
+//!			the bus transfer times and the queueing of the synchronization,
+//!			so the request actually reaches the device later than its arrival
+//!			date, and its delay is taken at a different angle. The model
+//!			gives the distribution of the rotational delays, not the exact
+//!			delay of each request.
 class CompHDD: public ComputationModel {
 public:
+	friend class UT_CompHDD;
 
 /*----------------------------------------------------------------------------*/
 /* PUBLIC FUNCTIONS ----------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
 //! \brief	Constructor.
-//! \param	devs				Devices using the computation model.
+//! \param	devs				Devices of the simulation.
+//! \param	first				First device computed by the model.
+//! \param	last				Device after the last one computed by the model.
+//! \param	rotational			TRUE if the rotational position is tracked.
 	CompHDD (
-		std::vector <Device>	& devs);
+		std::vector <Device>	& devs,
+		const OGSS_Ulong		first,
+		const OGSS_Ulong		last,
+		const OGSS_Bool			rotational = false);
 
 //! \brief	Destructor.
 	~CompHDD ();
@@ -54,20 +78,66 @@ public:
 	void compute (
 		Request					& req);
 
+//! \brief	Computation function for a batch of requests.
+//! \param	reqs				Requests, in their reception order.
+	void computeBatch (
+		std::vector <Request *>	& reqs);
+
+//! \brief	Computation of the seek curve coefficients of a device, the seek
+//!			time of a distance d being a * sqrt (d) + b * (d - 1) + min.
+//! \param	h					HDD parameters.
+//! \param	write				TRUE for the write seek curve.
+//! \param	a					Coefficient a.
+//! \param	b					Coefficient b.
+//! \param	minSeek				Minimum seek time.
+	static void seekCurve (
+		const HDDParameters		& h,
+		const OGSS_Bool			write,
+		OGSS_Real				& a,
+		OGSS_Real				& b,
+		OGSS_Real				& minSeek);
+
 protected:
 
 /*----------------------------------------------------------------------------*/
 /* PRIVATE FUNCTIONS ---------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
-//! \brief	Computation of the seek time.
+//! \brief	Computation of the seek distance, and update of the track
+//!			position of the device.
 //! \param	req					Request.
 //! \param	dev					Targeted device.
-//! \return						Computed time.
-	OGSS_Real seekTime (
+//! \return						Seek distance (in tracks).
+	OGSS_Real seekDistance (
 		Request					& req,
 		Device					& dev);
 
+//! \brief	Index of the seek curve coefficients of a request.
+//! \param	req					Request.
+//! \return						Coefficient index.
+	inline OGSS_Ulong coefIndex (
+		const Request			& req) const
+		{ return 2 * req._idxDevice + ( (req._type & RQT_WRITE) ? 1 : 0); }
+
+//! \brief	Computation of the service times of a batch, on flat arrays.
+//! \param	num					Number of requests.
+//! \param	dist				Seek distances.
+//! \param	a					Seek curve coefficients a.
+//! \param	b					Seek curve coefficients b.
+//! \param	minSeek				Minimum seek times.
+//! \param	rot					Rotation times.
+//! \param	tsf					Transfer times.
+//! \param	serv				Computed service times.
+	static void serviceTimeKernel (
+		const OGSS_Ulong		num,
+		const OGSS_Real			* __restrict dist,
+		const OGSS_Real			* __restrict a,
+		const OGSS_Real			* __restrict b,
+		const OGSS_Real			* __restrict minSeek,
+		const OGSS_Real			* __restrict rot,
+		const OGSS_Real			* __restrict tsf,
+		OGSS_Real				* __restrict serv);
+
 //! \brief	Computation of the rotation time.
 //! \param	req					Request.
 //! \param	dev					Targeted device.
@@ -76,6 +146,29 @@ protected:
 		Request					& req,
 		Device					& dev);
 
+//! \brief	Angle of the first sector of a request, in rotations.
+//! \param	req					Request.
+//! \param	dev					Targeted device.
+//! \return						Sector angle, in [0, 1).
+	inline OGSS_Real sectorAngle (
+		const Request			& req,
+		const Device			& dev) const;
+
+//! \brief	Computation of the rotational delay from the platter angle, and
+//!			update of the device clock.
+//! \param	req					Request.
+//! \param	dev					Targeted device.
+//! \param	seek				Seek time.
+//! \param	angle				Angle of the first sector.
+//! \param	tsf					Transfer time.
+//! \return						Rotational delay.
+	OGSS_Real rotDelay (
+		const Request			& req,
+		Device					& dev,
+		const OGSS_Real			seek,
+		const OGSS_Real			angle,
+		const OGSS_Real			tsf);
+
 //! \brief	Computation of the transfer time.
 //! \param	req					Request.
 //! \param	dev					Targeted device.
@@ -89,6 +182,55 @@ protected:
 /*----------------------------------------------------------------------------*/
 
 	std::vector <Device>		& _devices;			//!< Device parameters.
+
+	std::vector <OGSS_Real>		_seekA;				//!< Seek curve coefficient a, by device
+													//!< and request type.
+	std::vector <OGSS_Real>		_seekB;				//!< Seek curve coefficient b.
+	std::vector <OGSS_Real>		_seekMin;			//!< Minimum seek time.
+
+	OGSS_Bool					_rotational;		//!< TRUE if the rotational position is tracked.
+	std::vector <OGSS_Real>		_invRotation;		//!< Rotations by time unit, by device.
+	std::vector <OGSS_Real>		_angleStep;			//!< Angle between two sectors, by device.
+
+	std::vector <OGSS_Real>		_batchDist;			//!< Seek distances of the batch.
+	std::vector <OGSS_Real>		_batchA;			//!< Coefficients a of the batch.
+	std::vector <OGSS_Real>		_batchB;			//!< Coefficients b of the batch.
+	std::vector <OGSS_Real>		_batchMin;			//!< Minimum seek times of the batch.
+	std::vector <OGSS_Real>		_batchRot;			//!< Rotation times of the batch.
+	std::vector <OGSS_Real>		_batchTsf;			//!< Transfer times of the batch.
+	std::vector <OGSS_Real>		_batchServ;			//!< Service times of the batch.
+	std::vector <OGSS_Real>		_batchAngle;		//!< First sector angles of the batch.
+};
+
+/*----------------------------------------------------------------------------*/
+/* INLINE FUNCTIONS ----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+OGSS_Real
+CompHDD::sectorAngle (
+	const Request				& req,
+	const Device				& dev) const {
+	OGSS_Ulong					sector = req._deviceAddress / dev._param.h._sectorSize;
+
+	return (sector % dev._param.h._sectorsPerTrack) * _angleStep [req._idxDevice];
+}
+
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+class UT_CompHDD:
+public UnitaryTest <UT_CompHDD> {
+public:
+	UT_CompHDD (
+		const OGSS_String		& configurationFile);
+	~UT_CompHDD ();
+
+protected:
+	OGSS_Bool sectorPosition ();
+	OGSS_Bool rotationalDelay ();
+	OGSS_Bool delayWrapAround ();
+	OGSS_Bool serviceTime ();
 };
 
 #endif
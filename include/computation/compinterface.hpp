@@ -36,7 +36,7 @@
 #include "structure/hardware.hpp"
 
 //! \brief	Interface computation model.
-class CompInterface: public ComputationModel {
+class CompInterface: public BatchedModel <CompInterface> {
 public:
 
 /*----------------------------------------------------------------------------*/
@@ -59,7 +59,8 @@ public:
 //! \brief	Destructor.
 	~CompInterface ();
 
-//! \brief	Computation function for the request transfer time.
+//! \brief	Computation function for the request transfer time. The
+//!			interfaces of the request come from the path of its device.
 //! \param	req					Request.
 	void compute (
 		Request					& req);
@@ -76,6 +77,8 @@ protected:
 	std::vector <Device>		& _devices;			//!< Devices.
 	std::vector <Interface>		& _interfaces;		//!< Interfaces.
 
+	std::vector <OGSS_DevicePath>	_paths;			//!< I/O path of each device.
+
 	OGSS_Ulong					_codSize;			//!< Size of the request code.
 	OGSS_Ulong					_ackSize;			//!< Size of the request acknowledgment.
 };
@@ -33,18 +33,35 @@
 
 #include "structure/hardware.hpp"
 
-//! \brief	NVRAM computation model.
-class CompNVRAM : public ComputationModel {
+#include "util/unitarytest.hpp"
+
+//! \brief	NVRAM computation model. By default, the cycles of a request,
+//!			each one reading or writing a column in every chip, are done one
+//!			after the other.
+//!
+//!			With the banked model, the rows of a chip are split in banks and
+//!			the consecutive rows of the address space are interleaved on them.
+//!			The cycles on different banks overlap, and each bank keeps its
+//!			last row open: a cycle in the open row does not pay the row
+//!			activation time.
+class CompNVRAM : public BatchedModel <CompNVRAM> {
 public:
+	friend class UT_CompNVRAM;
 
 /*----------------------------------------------------------------------------*/
 /* PUBLIC FUNCTIONS ----------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
 //! \brief	Constructor.
-//! \param	devs				Devices using the computation model.
+//! \param	devs				Devices of the simulation.
+//! \param	first				First device computed by the model.
+//! \param	last				Device after the last one computed by the model.
+//! \param	banked				TRUE if the banks are modeled.
 	CompNVRAM (
-		std::vector<Device>		& devs);
+		std::vector <Device>	& devs,
+		const OGSS_Ulong		first,
+		const OGSS_Ulong		last,
+		const OGSS_Bool			banked = false);
 
 //! \brief	Destructor.
 	~CompNVRAM ();
@@ -56,11 +73,64 @@ public:
 
 protected:
 
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Computation of the service time with the banked model, and
+//!			update of the open rows.
+//! \param	req					Request.
+//! \param	dev					Targeted device.
+//! \return						Service time.
+	OGSS_Real bankedServTime (
+		const Request			& req,
+		const Device			& dev);
+
+//! \brief	Computation of the busy time of each bank used by a request, on
+//!			flat arrays.
+//! \param	num					Number of banks.
+//! \param	cycles				Number of cycles by bank.
+//! \param	misses				Number of row activations by bank.
+//! \param	cycleTime			Time of a cycle in an open row.
+//! \param	activation			Row activation time.
+//! \return						Longest busy time.
+	static OGSS_Real bankTimeKernel (
+		const OGSS_Ulong		num,
+		const OGSS_Real			* __restrict cycles,
+		const OGSS_Real			* __restrict misses,
+		const OGSS_Real			cycleTime,
+		const OGSS_Real			activation);
+
 /*----------------------------------------------------------------------------*/
 /* ATTRIBUTES ----------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+	static constexpr OGSS_Ulong	_kNoRow = OGSS_ULONG_MAX;	//!< No open row.
+
 	std::vector<Device>			& _devices;			//!< Device parameters.
+
+	OGSS_Bool					_banked;			//!< TRUE if the banks are modeled.
+	std::vector <OGSS_Ulong>	_firstBank;			//!< First bank of each device.
+	std::vector <OGSS_Ulong>	_openRow;			//!< Open row of each bank.
+	std::vector <OGSS_Real>		_bankCycles;		//!< Cycles of the request, by bank.
+	std::vector <OGSS_Real>		_bankMisses;		//!< Activations of the request, by bank.
+};
+
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+class UT_CompNVRAM:
+public UnitaryTest <UT_CompNVRAM> {
+public:
+	UT_CompNVRAM (
+		const OGSS_String		& configurationFile);
+	~UT_CompNVRAM ();
+
+protected:
+	OGSS_Bool bankConflict ();
+	OGSS_Bool parallelBanks ();
+	OGSS_Bool singleBank ();
 };
 
 #endif
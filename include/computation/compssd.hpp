@@ -33,8 +33,10 @@
 
 #include "structure/hardware.hpp"
 
-//! \brief	SSD computation model.
-class CompSSD: public ComputationModel {
+//! \brief	SSD computation model. The geometry of each device is computed
+//!			once, with shifts and masks when all its sizes are powers of two,
+//!			and the last page seen on each die is stored in a flat array.
+class CompSSD: public BatchedModel <CompSSD> {
 public:
 
 /*----------------------------------------------------------------------------*/
@@ -42,9 +44,13 @@ public:
 /*----------------------------------------------------------------------------*/
 
 //! \brief	Constructor.
-//! \param	devs				Devices using the computation model.
+//! \param	devs				Devices of the simulation.
+//! \param	first				First device computed by the model.
+//! \param	last				Device after the last one computed by the model.
 	CompSSD (
-		std::vector <Device>	& devs);
+		std::vector <Device>	& devs,
+		const OGSS_Ulong		first,
+		const OGSS_Ulong		last);
 
 //! \brief	Destructor.
 	~CompSSD ();
@@ -56,25 +62,50 @@ public:
 
 protected:
 
+//! \brief	Geometry of a device, in memory units.
+	struct SSDGeometry {
+		OGSS_Ulong				_pageSize;			//!< Page size.
+		OGSS_Ulong				_blockSize;			//!< Block size.
+		OGSS_Ulong				_dieSize;			//!< Die size.
+		OGSS_Ushort				_pageShift;			//!< Shift for the page size.
+		OGSS_Ushort				_blockShift;		//!< Shift for the block size.
+		OGSS_Ushort				_dieShift;			//!< Shift for the die size.
+		OGSS_Bool				_pow2;				//!< TRUE if the sizes are powers of two.
+		OGSS_Ulong				_firstDie;			//!< Position of the first die in
+													//!< the last page array.
+	};
+
 /*----------------------------------------------------------------------------*/
 /* PRIVATE FUNCTIONS ---------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
-//! \brief	Computation of the read service time.
+//! \brief	Computation of the read or write service time.
+//! \param	Pow2				TRUE if the geometry sizes are powers of two.
 //! \param	req					Request.
-//! \param	dev					Targeted device.
+//! \param	geo					Geometry of the targeted device.
+//! \param	randTime			Random access time for a page.
+//! \param	seqTime				Sequential access time for a page.
 //! \return						Computed time.
-	OGSS_Real readServTime (
+	template <OGSS_Bool Pow2>
+	OGSS_Real accessServTime (
 		Request					& req,
-		Device					& dev);
-
-//! \brief	Computation of the write service time.
-//! \param	req					Request.
-//! \param	dev					Targeted device.
-//! \return						Computed time.
-	OGSS_Real writeServTime (
-		Request					& req,
-		Device					& dev);
+		const SSDGeometry		& geo,
+		const OGSS_Real			randTime,
+		const OGSS_Real			seqTime);
+
+//! \brief	Check if a size is a power of two.
+//! \param	value				Size.
+//! \return						TRUE if power of two.
+	static inline OGSS_Bool isPow2 (
+		const OGSS_Ulong		value)
+		{ return value && ! (value & (value - 1) ); }
+
+//! \brief	Compute the base-2 logarithm of a size, rounded down.
+//! \param	value				Size.
+//! \return						Logarithm.
+	static inline OGSS_Ushort floorLog2 (
+		OGSS_Ulong				value)
+		{ OGSS_Ushort res {0}; while (value >>= 1) ++res; return res; }
 
 //! \brief	Computation of the erase service time.
 //! \param	req					Request.
@@ -89,8 +120,9 @@ protected:
 /*----------------------------------------------------------------------------*/
 
 	std::vector <Device>		& _devices;			//!< Device parameters.
-	std::map <OGSS_Ulong, std::vector <OGSS_Ulong>>
-								_lastPageSeen;		//!< Last page seen on each device.
+	std::vector <SSDGeometry>	_geometry;			//!< Geometry of each device.
+	std::vector <OGSS_Ulong>	_lastPageSeen;		//!< Last page seen on each die of
+													//!< each device.
 };
 
 #endif
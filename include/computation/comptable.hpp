@@ -0,0 +1,261 @@
+/*
+ * Copyright UVSQ - CEA/DAM/DIF (2017-2018)
+ * Contributors:  Sebastien GOUGEAUD  -- sebastien.gougeaud@uvsq.fr
+ *                Soraya ZERTAL       --      soraya.zertal@uvsq.fr
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+//! \file	comptable.hpp
+//! \brief	Definition of the table-driven surrogate computation models.
+
+#ifndef _OGSS_COMPTABLE_HPP_
+#define _OGSS_COMPTABLE_HPP_
+
+/*----------------------------------------------------------------------------*/
+/* HEADERS -------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <vector>
+
+#include "computation/comphdd.hpp"
+#include "computation/compssd.hpp"
+
+#include "structure/hardware.hpp"
+
+//! \brief	Error of a service time table, measured against the exact model.
+struct OGSS_TableError {
+	OGSS_Real					_maxAbs {.0};		//!< Maximum absolute error.
+	OGSS_Real					_maxRel {.0};		//!< Maximum relative error.
+	OGSS_Real					_meanRel {.0};		//!< Mean relative error.
+};
+
+//! \brief	Service time table over a position key (seek distance,
+//!			sequential access) and the request size. Both axes are bucketed
+//!			on a log-linear grid, exact up to 2 * _kSub, then with _kSub
+//!			buckets by power of two, and the times are bilinearly
+//!			interpolated between the grid points.
+class ServiceTable {
+public:
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTIONS ----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Constructor.
+//! \param	maxKey				Largest key of the grid.
+//! \param	maxSize				Largest size of the grid, larger sizes are
+//!								extrapolated.
+	ServiceTable (
+		const OGSS_Ulong		maxKey = 0,
+		const OGSS_Ulong		maxSize = 0);
+
+//! \brief	Fill the table with the exact model.
+//! \param	exact				Exact service time of a key and a size.
+	template <class F>
+	void fill (
+		F						exact);
+
+//! \brief	Measure the error of the table against the exact model, on
+//!			random keys and sizes.
+//! \param	exact				Exact service time of a key and a size.
+//! \param	numSamples			Number of samples.
+//! \return						Measured error.
+	template <class F>
+	OGSS_TableError measure (
+		F						exact,
+		const OGSS_Ulong		numSamples);
+
+//! \brief	Interpolated service time.
+//! \param	key					Position key.
+//! \param	size				Request size.
+//! \return						Service time.
+	inline OGSS_Real lookup (
+		const OGSS_Ulong		key,
+		const OGSS_Ulong		size) const;
+
+protected:
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Grid index of a value, rounded down.
+//! \param	value				Value.
+//! \return						Grid index.
+	static inline OGSS_Ulong _index (
+		const OGSS_Ulong		value);
+
+//! \brief	Value of a grid point.
+//! \param	idx					Grid index.
+//! \return						Value.
+	static inline OGSS_Ulong _value (
+		const OGSS_Ulong		idx);
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE ATTRIBUTES --------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+	static constexpr OGSS_Ushort	_kSubShift = 3;	//!< Log of the buckets by power of two.
+	static constexpr OGSS_Ulong	_kSub = 1UL << _kSubShift;	//!< Buckets by power of two.
+
+	OGSS_Ulong					_maxKey;			//!< Largest key of the grid.
+	OGSS_Ulong					_maxSize;			//!< Largest size of the grid.
+	OGSS_Ulong					_numKeys;			//!< Number of key grid points.
+	OGSS_Ulong					_numSizes;			//!< Number of size grid points.
+	std::vector <OGSS_Real>		_keys;				//!< Key grid points, the last one
+													//!< being the largest key.
+	std::vector <OGSS_Real>		_keySteps;			//!< Inverse width of the key buckets.
+	std::vector <OGSS_Real>		_sizes;				//!< Size grid points.
+	std::vector <OGSS_Real>		_sizeSteps;			//!< Inverse width of the size buckets.
+	std::vector <OGSS_Real>		_values;			//!< Service times, by key then size.
+};
+
+//! \brief	Surrogate HDD computation model. The seek distance is tracked
+//!			as in the exact model, and the service time is interpolated in
+//!			a table by device parameters and request type, filled once with
+//!			the exact model.
+class CompHDDTable: public CompHDD {
+public:
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTIONS ----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Constructor. Builds the tables and reports their error.
+//! \param	devs				Devices of the simulation.
+//! \param	first				First device computed by the model.
+//! \param	last				Device after the last one computed by the model.
+	CompHDDTable (
+		std::vector <Device>	& devs,
+		const OGSS_Ulong		first,
+		const OGSS_Ulong		last);
+
+//! \brief	Destructor.
+	~CompHDDTable ();
+
+//! \brief	Computation function for the request service time.
+//! \param	req					Request.
+	void compute (
+		Request					& req);
+
+//! \brief	Computation function for a batch of requests.
+//! \param	reqs				Requests, in their reception order.
+	void computeBatch (
+		std::vector <Request *>	& reqs);
+
+protected:
+
+/*----------------------------------------------------------------------------*/
+/* ATTRIBUTES ----------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+	std::vector <ServiceTable>	_tables;			//!< Tables, by parameters and type.
+	std::vector <OGSS_Ulong>	_tableOf;			//!< First table of each device.
+};
+
+//! \brief	Surrogate SSD computation model. The service time of a request
+//!			in a block is interpolated in a table by device parameters and
+//!			request type, over the continuation of the previous request of
+//!			the die and the number of pages, filled once with the exact
+//!			model. The requests which cross a block boundary use the exact
+//!			model, and both models track the last page seen on each die.
+class CompSSDTable: public CompSSD {
+public:
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTIONS ----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Constructor. Builds the tables and reports their error.
+//! \param	devs				Devices of the simulation.
+//! \param	first				First device computed by the model.
+//! \param	last				Device after the last one computed by the model.
+	CompSSDTable (
+		std::vector <Device>	& devs,
+		const OGSS_Ulong		first,
+		const OGSS_Ulong		last);
+
+//! \brief	Destructor.
+	~CompSSDTable ();
+
+//! \brief	Computation function for the request service time.
+//! \param	req					Request.
+	void compute (
+		Request					& req);
+
+//! \brief	Computation function for a batch of requests.
+//! \param	reqs				Requests, in their reception order.
+	void computeBatch (
+		std::vector <Request *>	& reqs)
+		{ for (auto req: reqs) CompSSDTable::compute (* req); }
+
+protected:
+
+/*----------------------------------------------------------------------------*/
+/* ATTRIBUTES ----------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+	std::vector <ServiceTable>	_tables;			//!< Tables, by parameters and type.
+	std::vector <OGSS_Ulong>	_tableOf;			//!< First table of each device.
+};
+
+/*----------------------------------------------------------------------------*/
+/* INLINE FUNCTIONS ----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+OGSS_Ulong
+ServiceTable::_index (
+	const OGSS_Ulong			value) {
+	OGSS_Ushort					shift;
+
+	if (value < 2 * _kSub) return value;
+
+	shift = 63 - __builtin_clzl (value) - _kSubShift;
+	return (shift + 1) * _kSub + (value >> shift) - _kSub;
+}
+
+OGSS_Ulong
+ServiceTable::_value (
+	const OGSS_Ulong			idx) {
+	OGSS_Ulong					shift;
+
+	if (idx < 2 * _kSub) return idx;
+
+	shift = (idx >> _kSubShift) - 1;
+	return (idx - shift * _kSub) << shift;
+}
+
+OGSS_Real
+ServiceTable::lookup (
+	const OGSS_Ulong			key,
+	const OGSS_Ulong			size) const {
+	OGSS_Ulong					i {std::min (_index (key), _numKeys - 2)};
+	OGSS_Ulong					j {std::min (_index (size), _numSizes - 2)};
+	OGSS_Real					fk {(key - _keys [i]) * _keySteps [i]};
+	OGSS_Real					fs {(size - _sizes [j]) * _sizeSteps [j]};
+	const OGSS_Real				* v = _values.data () + i * _numSizes + j;
+	OGSS_Real					r0, r1;
+
+	// The sizes above the grid are extrapolated from the last bucket
+	r0 = v [0] + fs * (v [1] - v [0]);
+	r1 = v [_numSizes] + fs * (v [_numSizes + 1] - v [_numSizes]);
+
+	return r0 + fk * (r1 - r0);
+}
+
+#endif
@@ -29,6 +29,10 @@
 /* HEADERS -------------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+#include <memory>
+#include <vector>
+
+#include "structure/hardware.hpp"
 #include "structure/request.hpp"
 #include "structure/types.hpp"
 
@@ -48,6 +52,13 @@ public:
 	virtual void compute (
 		Request					& req) = 0;
 
+//! \brief	Computation function for a batch of requests, given in their
+//!			reception order. By default, they are computed one by one.
+//! \param	reqs				Requests.
+	virtual void computeBatch (
+		std::vector <Request *>	& reqs)
+		{ for (auto req: reqs) compute (* req); }
+
 protected:
 
 /*----------------------------------------------------------------------------*/
@@ -58,4 +69,35 @@ protected:
 	ComputationModel () {  }
 };
 
+//! \brief	Computation model whose batches are computed one request after
+//!			the other, with a direct call to the compute function of the
+//!			model, which can be inlined.
+//! \param	M					Computation model.
+template <class M>
+class BatchedModel: public ComputationModel {
+public:
+
+//! \brief	Computation function for a batch of requests.
+//! \param	reqs				Requests, in their reception order.
+	void computeBatch (
+		std::vector <Request *>	& reqs)
+		{ for (auto req: reqs) static_cast <M *> (this) ->M::compute (* req); }
+};
+
+//! \brief	Create a device computation model from its name, following the
+//!			registry of the available models.
+//! \param	type				Device type.
+//! \param	name				Model name.
+//! \param	devs				Devices of the simulation.
+//! \param	first				First device computed by the model.
+//! \param	last				Device after the last one computed by the model.
+//! \return						Computation model, nullptr if the name does not
+//!								match a model of the device type.
+std::unique_ptr <ComputationModel> createComputationModel (
+	const OGSS_DeviceType		type,
+	const OGSS_String			& name,
+	std::vector <Device>		& devs,
+	const OGSS_Ulong			first,
+	const OGSS_Ulong			last);
+
 #endif
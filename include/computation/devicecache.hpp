@@ -0,0 +1,195 @@
+/*
+ * Copyright UVSQ - CEA/DAM/DIF (2018)
+ * Contributors:  Sebastien GOUGEAUD  -- sebastien.gougeaud@uvsq.fr
+ *                Soraya ZERTAL       --      soraya.zertal@uvsq.fr
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published per the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+//! \file	devicecache.hpp
+//! \brief	Definition of the device buffer, which models the DRAM cache of
+//!			the HDD and SSD controllers in the execution module.
+
+#ifndef _OGSS_DEVICECACHE_HPP_
+#define _OGSS_DEVICECACHE_HPP_
+
+/*----------------------------------------------------------------------------*/
+/* HEADERS -------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#include <vector>
+
+#include "structure/hardware.hpp"
+#include "structure/request.hpp"
+
+#include "util/unitarytest.hpp"
+
+//! \brief	Device buffer split in segments, with read-ahead and an optional
+//!			write-back. The segments of all the devices are kept in one
+//!			flat table, each device owning a contiguous range of it. A read
+//!			which is fully contained in a segment is served by the buffer, a
+//!			read miss fills a segment with the end of the request and the
+//!			data following it, and pays the media time of this read-ahead.
+//!			With the write-back policy, a write is
+//!			acknowledged by the buffer and its media time is charged to the
+//!			next request of the device which goes to the media, or to the
+//!			write which does not fit in the buffer anymore.
+class DeviceCache {
+public:
+	friend class UT_DeviceCache;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTIONS ----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Constructor, without any buffer.
+	DeviceCache ():
+		_firstDevice {0} {  }
+
+//! \brief	Constructor.
+//! \param	devices				Devices.
+//! \param	first				First device using the buffers.
+//! \param	last				Device after the last one using the buffers.
+	DeviceCache (
+		const std::vector <Device>	& devices,
+		const OGSS_Ulong		first,
+		const OGSS_Ulong		last);
+
+//! \brief	Destructor.
+	~DeviceCache ();
+
+//! \brief	Check if the buffer of at least one device is used.
+//! \return						TRUE if the cache has segments.
+	inline OGSS_Bool isEnabled () const
+		{ return ! _segments.empty (); }
+
+//! \brief	Go through the device buffers with a batch of requests, in their
+//!			reception order. The requests served by the buffers get a null
+//!			service time and are removed from the batch.
+//! \param	reqs				Requests of the batch.
+	void filter (
+		std::vector <Request *>	& reqs);
+
+//! \brief	Charge the media time of the acknowledged writes of a filtered
+//!			batch, once its service times are computed, and give back their
+//!			size to the read misses.
+//! \param	reqs				Requests of the batch.
+	void settle (
+		const std::vector <Request *>	& reqs);
+
+protected:
+
+//! \brief	Buffer segment, holding a contiguous device range.
+	struct Segment {
+		OGSS_Ulong				_start {0};			//!< First address.
+		OGSS_Ulong				_end {0};			//!< Address after the last one.
+		OGSS_Ulong				_lastUse {0};		//!< Date of the last use.
+	};
+
+//! \brief	Buffer of a device.
+	struct Buffer {
+		OGSS_Ulong				_first {0};			//!< First segment.
+		OGSS_Ulong				_num {0};			//!< Number of segments.
+		OGSS_Ulong				_segmentSize {0};	//!< Segment size.
+		OGSS_Ulong				_capacity {0};		//!< Device capacity.
+		OGSS_Bool				_writeBack {false};	//!< TRUE if the writes are
+													//!< acknowledged by the buffer.
+		OGSS_Ulong				_size {0};			//!< Buffer size.
+		OGSS_Ulong				_dirty {0};			//!< Size of the acknowledged writes
+													//!< not charged yet.
+		OGSS_Real				_pending {.0};		//!< Media time of the acknowledged
+													//!< writes not charged yet.
+	};
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Read a range through a buffer.
+//! \param	buf					Device buffer.
+//! \param	start				First address.
+//! \param	end					Address after the last one.
+//! \param	ahead				Size read after the range by a miss.
+//! \return						TRUE if the range is in the buffer.
+	OGSS_Bool _read (
+		Buffer					& buf,
+		const OGSS_Ulong		start,
+		const OGSS_Ulong		end,
+		OGSS_Ulong				& ahead);
+
+//! \brief	Write a range through a buffer.
+//! \param	buf					Device buffer.
+//! \param	start				First address.
+//! \param	end					Address after the last one.
+//! \return						TRUE if the write is acknowledged by the buffer,
+//!								which needs the write-back policy and a write
+//!								not larger than a segment.
+	OGSS_Bool _write (
+		Buffer					& buf,
+		const OGSS_Ulong		start,
+		const OGSS_Ulong		end);
+
+//! \brief	Drop the segments overlapping a range.
+//! \param	buf					Device buffer.
+//! \param	start				First address.
+//! \param	end					Address after the last one.
+	void _invalidate (
+		Buffer					& buf,
+		const OGSS_Ulong		start,
+		const OGSS_Ulong		end);
+
+//! \brief	Get the segment to fill, the one holding the start address if
+//!			any, the least recently used one otherwise.
+//! \param	buf					Device buffer.
+//! \param	start				First address.
+//! \return						Segment position.
+	OGSS_Ulong _victim (
+		const Buffer			& buf,
+		const OGSS_Ulong		start) const;
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE ATTRIBUTES --------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+	std::vector <Segment>		_segments;			//!< Segments of all the buffers.
+	std::vector <Buffer>		_buffers;			//!< Buffer of each device.
+	std::vector <OGSS_Bool>		_deferred;			//!< TRUE for the acknowledged writes
+													//!< of the filtered batch.
+	std::vector <OGSS_Ulong>	_readAhead;			//!< Read-ahead size of the read
+													//!< misses of the filtered batch.
+	OGSS_Ulong					_firstDevice;		//!< First device.
+	OGSS_Ulong					_date {0};			//!< Date of the last segment use.
+};
+
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+class UT_DeviceCache:
+public UnitaryTest <UT_DeviceCache> {
+public:
+	UT_DeviceCache (
+		const OGSS_String		& configurationFile);
+	~UT_DeviceCache ();
+
+protected:
+	OGSS_Bool readHitMiss ();
+	OGSS_Bool writeBack ();
+	OGSS_Bool writeThrough ();
+	OGSS_Bool eviction ();
+};
+
+#endif
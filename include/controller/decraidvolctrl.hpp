@@ -157,6 +157,9 @@ private:
 
 	std::map <OGSS_Ulong, OGSS_Real>	_failures;	//!< Failures.
 	std::map <OGSS_Ulong, OGSS_Real>	_renewals;	//!< Replacements/renewals.
+
+	Request						_block;				//!< Block located at each
+													//!< decomposition, reused.
 };
 
 /*----------------------------------------------------------------------------*/
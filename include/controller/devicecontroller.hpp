@@ -29,6 +29,8 @@
 /* PUBLIC FUNCTIONS ----------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+#include <vector>
+
 #include "structure/request.hpp"
 
 //! \brief	Interface for a device controller. Each controller needs to implement
@@ -45,10 +47,14 @@ public:
 //! \brief	Destructor.
 	virtual ~DeviceController () = default;
 
-//! \brief	Translate an intermediate request into a physical one.
+//! \brief	Translate an intermediate request into a physical one. The
+//!			controller can generate internal requests (maintenance, fragments),
+//!			which are executed on the device before the request.
 //! \param	request				Request to translate.
+//! \param	internals			Internal requests.
 	virtual void translate (
-		Request					& request) = 0;
+		Request					& request,
+		std::vector <Request>	& internals) = 0;
 
 protected:
 
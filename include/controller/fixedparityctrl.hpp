@@ -0,0 +1,173 @@
+/*
+ * Copyright UVSQ - CEA/DAM/DIF (2017-2018)
+ * Contributors:  Sebastien GOUGEAUD  -- sebastien.gougeaud@uvsq.fr
+ *                Soraya ZERTAL       --      soraya.zertal@uvsq.fr
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+//! \file	fixedparityctrl.hpp
+//! \brief	Definition of the parity controller specialized for a given
+//!			geometry. The number of data and parity devices are known at
+//!			compile time and the stripe unit size is a power of two, so the
+//!			decomposition does not need any runtime division.
+
+#ifndef _OGSS_FIXEDPARITYCTRL_HPP_
+#define _OGSS_FIXEDPARITYCTRL_HPP_
+
+/*----------------------------------------------------------------------------*/
+/* HEADERS -------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#include <memory>
+#include <vector>
+
+#include "controller/perfparityctrl.hpp"
+
+#include "structure/hardware.hpp"
+
+#include "util/unitarytest.hpp"
+
+//! \brief	Parity controller with a compile-time geometry. It produces the
+//!			same decomposition as the generic parity controller.
+//! \param	D					Number of data devices (power of two).
+//! \param	P					Number of parity devices.
+template <OGSS_Ulong D, OGSS_Ulong P>
+class FixedParityCtrl:
+public PerfectParityCtrl {
+public:
+	friend class UT_FixedParityCtrl;
+
+	static_assert (D && ! (D & (D - 1) ), "Number of data devices must be a power of two");
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTIONS ----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Constructor.
+//! \param	vol					Volume.
+//! \param	dev					Device contained in the volume.
+	FixedParityCtrl (
+		const Volume					& vol,
+		const Device					& dev);
+
+//! \brief	Destructor.
+	~FixedParityCtrl ();
+
+//! \brief	Request decomposition.
+//! \param	request				Request to decompose.
+//! \param	subrequests			New requests.
+	void decompose (
+		Request					& request,
+		std::vector <Request>	& subrequests);
+
+protected:
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Get the preread stripe for a given request.
+//! \param	parent						Parent request.
+//! \param	children					New requests.
+//! \param	idx							Stripe index.
+//! \param	start						Start address on the stripe.
+//! \param	end							End address on the stripe.
+	void _getFixedPrereadStripe (
+		Request							& parent,
+		std::vector <Request>			& children,
+		OGSS_Ulong						idx,
+		OGSS_Ulong						start,
+		OGSS_Ulong						end);
+
+//! \brief	Get the data stripe for a given request.
+//! \param	parent						Parent request.
+//! \param	children					New requests.
+//! \param	idx							Stripe index.
+//! \param	start						Start address on the stripe.
+//! \param	end							End address on the stripe.
+	void _getFixedDataStripe (
+		Request							& parent,
+		std::vector <Request>			& children,
+		OGSS_Ulong						idx,
+		OGSS_Ulong						start,
+		OGSS_Ulong						end);
+
+//! \brief	Update the request address to the physical one.
+//! \param	requests					Requests to process.
+	void _fixedRealloc (
+		std::vector <Request>			& requests);
+
+//! \brief	Compute the base-2 logarithm of a power of two.
+//! \param	value						Power of two.
+//! \return								Logarithm.
+	static constexpr OGSS_Ushort _log2 (
+		OGSS_Ulong						value)
+		{ return value > 1 ? 1 + _log2 (value >> 1) : 0; }
+
+/*----------------------------------------------------------------------------*/
+/* ATTRIBUTES ----------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+	static constexpr OGSS_Ulong			_kNumData = D;			//!< Number of data devices.
+	static constexpr OGSS_Ulong			_kNumParity = P;		//!< Number of parity devices.
+	static constexpr OGSS_Ulong			_kNumDevices = D + P;	//!< Number of devices.
+	static constexpr OGSS_Ushort		_kDataShift = _log2 (D);//!< Shift for the data devices.
+
+	OGSS_Ushort							_suShift;		//!< Shift for the stripe unit size.
+	OGSS_Ushort							_stripeShift;	//!< Shift for the stripe size.
+	OGSS_Ulong							_stripeMask;	//!< Mask for an address in a stripe.
+};
+
+//! \brief	Create the parity controller of a volume. A specialized
+//!			controller is chosen when the volume geometry is one of the
+//!			deployed ones (4+1, 8+1, 8+2, 16+2) with a power of two stripe
+//!			unit size, the generic one otherwise.
+//! \param	vol					Volume.
+//! \param	dev					Device contained in the volume.
+//! \return						Parity controller.
+std::unique_ptr <VolumeController> createParityCtrl (
+	const Volume						& vol,
+	const Device						& dev);
+
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+class UT_FixedParityCtrl:
+public UnitaryTest <UT_FixedParityCtrl> {
+public:
+	UT_FixedParityCtrl (
+		const OGSS_String		& configurationFile);
+	~UT_FixedParityCtrl ();
+
+protected:
+	template <OGSS_Ulong D, OGSS_Ulong P, class C = FixedParityCtrl <D, P>>
+	OGSS_Bool compareLayout (
+		const OGSS_DeclusteringType	parity,
+		const OGSS_Bool			ranges = false);
+
+	OGSS_Bool layout4p1 ();
+	OGSS_Bool layout8p1 ();
+	OGSS_Bool layout8p2 ();
+	OGSS_Bool layout16p2 ();
+	OGSS_Bool layout8p2Declustered ();
+	OGSS_Bool rangeDecomposition ();
+};
+
+#include "controller/fixedparityctrl.tpp"
+
+#endif
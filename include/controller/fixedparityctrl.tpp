@@ -0,0 +1,199 @@
+/*
+ * Copyright UVSQ - CEA/DAM/DIF (2017-2018)
+ * Contributors:  Sebastien GOUGEAUD  -- sebastien.gougeaud@uvsq.fr
+ *                Soraya ZERTAL       --      soraya.zertal@uvsq.fr
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+//! \file	fixedparityctrl.tpp
+//! \brief	Definition of the parity controller specialized for a given
+//!			geometry. Divisions by the stripe unit and stripe sizes become
+//!			shifts and masks, the modulos by the number of devices are done
+//!			by a constant and are reduced by the compiler.
+
+/*----------------------------------------------------------------------------*/
+/* HEADERS -------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+
+/*----------------------------------------------------------------------------*/
+/* MEMBER FUNCTIONS ----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+template <OGSS_Ulong D, OGSS_Ulong P>
+FixedParityCtrl <D, P>::FixedParityCtrl (
+	const Volume						& vol,
+	const Device						& dev):
+	PerfectParityCtrl (vol, dev) {
+	_suShift							= _log2 (_numMUBySU);
+	_stripeShift						= _suShift + _kDataShift;
+	_stripeMask							= (1UL << _stripeShift) - 1;
+}
+
+template <OGSS_Ulong D, OGSS_Ulong P>
+FixedParityCtrl <D, P>::~FixedParityCtrl () {  }
+
+template <OGSS_Ulong D, OGSS_Ulong P>
+void
+FixedParityCtrl <D, P>::decompose (
+	Request								& request,
+	std::vector <Request>				& subrequests) {
+	OGSS_Ulong							addr {request._volumeAddress};
+	OGSS_Ulong							remainingSize {request._size};
+	OGSS_Ulong							first {(addr + _stripeMask) >> _stripeShift};
+	OGSS_Ulong							last {(addr + remainingSize) >> _stripeShift};
+	OGSS_Bool							ranges {_useRanges (request, first, last)};
+
+	while (remainingSize) {
+		auto							sIdx {addr >> _stripeShift};
+		auto							sStart {addr & _stripeMask};
+		auto							sEnd {std::min (sStart + remainingSize, _stripeMask + 1)};
+
+		if (ranges && sIdx == first) {				// Full stripes are done by range
+			addr += (last - first) << _stripeShift;
+			remainingSize -= (last - first) << _stripeShift;
+			continue;
+		}
+
+		if (request._type == RQT_WRITE)
+			_getFixedPrereadStripe (request, subrequests, sIdx, sStart, sEnd);
+		_getFixedDataStripe (request, subrequests, sIdx, sStart, sEnd);
+
+		addr += (sEnd - sStart);
+		remainingSize -= (sEnd - sStart);
+	}
+
+	_fixedRealloc (subrequests);
+	if (ranges) _getDeviceRanges (request, subrequests, first, last);
+	_removeAndMerge (request, subrequests);
+}
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+template <OGSS_Ulong D, OGSS_Ulong P>
+void
+FixedParityCtrl <D, P>::_getFixedPrereadStripe (
+	Request								& parent,
+	std::vector <Request>				& children,
+	OGSS_Ulong							idx,
+	OGSS_Ulong							start,
+	OGSS_Ulong							end) {
+	OGSS_Ulong							firstDevice = start >> _suShift;
+	OGSS_Ulong							lastDevice = ( (end - 1) & _stripeMask) >> _suShift;
+
+	if (end - start == _stripeMask + 1) return;		// If whole stripe, do not need a preread
+
+	Request								child {parent};
+
+	child._deviceAddress = idx << _suShift;
+	child._size = _numMUBySU;
+	child._numPrioChild = 1;
+	child._prio = true;
+	child._numLink = idx;
+
+	child._type = RQT_READ;
+
+	if (end - start + (_kNumParity << _suShift) > (_kNumDevices << _suShift) / 2) {
+		for (OGSS_Ulong i {0}; i < firstDevice; ++i) {	// If large stripe, do on not written data
+			child._idxDevice = i;
+			children.push_back (child);
+		}
+
+		for (OGSS_Ulong i {lastDevice + 1}; i < _kNumData; ++i) {
+			child._idxDevice = i;
+			children.push_back (child);
+		}
+
+		parent._numChild += _kNumData - 1 - lastDevice + firstDevice;
+		parent._numPrioChild += _kNumData - 1 - lastDevice + firstDevice;
+	} else {
+		for (OGSS_Ulong i {firstDevice}; i <= lastDevice; ++i) {	// If small stripe, do on written data
+			child._idxDevice = i;
+			children.push_back (child);
+		}
+
+		for (OGSS_Ulong i {_kNumData}; i < _kNumDevices; ++i) {	// And parity
+			child._idxDevice = i;
+			children.push_back (child);
+		}
+
+		parent._numChild += lastDevice - firstDevice + 1 + _kNumParity;
+		parent._numPrioChild += lastDevice - firstDevice + 1 + _kNumParity;
+	}
+}
+
+template <OGSS_Ulong D, OGSS_Ulong P>
+void
+FixedParityCtrl <D, P>::_getFixedDataStripe (
+	Request								& parent,
+	std::vector <Request>				& children,
+	OGSS_Ulong							idx,
+	OGSS_Ulong							start,
+	OGSS_Ulong							end) {
+	Request								child {parent};
+
+	child._deviceAddress = idx << _suShift;
+	child._size = _numMUBySU;
+	child._numPrioChild = 0;
+	child._prio = false;
+	child._numLink = idx;
+
+	for (; start != end; start += _numMUBySU) {		// Operation on data
+		child._idxDevice = (start & _stripeMask) >> _suShift;
+
+		++ parent._numChild;
+		children.push_back (child);
+	}
+
+	if (parent._type == RQT_WRITE) {				// Write on parity if needed
+		for (OGSS_Ulong i {_kNumData}; i < _kNumDevices; ++i) {
+			child._idxDevice = i;
+
+			++ parent._numChild;
+			children.push_back (child);
+		}
+	}
+}
+
+template <OGSS_Ulong D, OGSS_Ulong P>
+void
+FixedParityCtrl <D, P>::_fixedRealloc (
+	std::vector <Request>				& requests) {
+	OGSS_Ulong							stripe;
+
+	if (_parity == DCL_OFF) return;
+
+	if (_parity == DCL_PARITY) {
+		for (auto & elt: requests) {
+			stripe = (elt._deviceAddress >> _suShift) % _kNumDevices;
+			if (elt._idxDevice >= _kNumData)
+				elt._idxDevice = (_kNumDevices + elt._idxDevice - stripe) % _kNumDevices;
+			else if ( (_kNumDevices + _kNumData - stripe) % _kNumDevices <= elt._idxDevice ||
+				(_kNumDevices - stripe - 1) % _kNumDevices <= elt._idxDevice)
+				elt._idxDevice += std::min (P,
+					1 + ( (_kNumDevices - stripe - 1) % _kNumDevices) );
+		}
+	} else { // DCL_DATA
+		for (auto & elt: requests) {
+			stripe = (elt._deviceAddress >> _suShift) % _kNumDevices;
+			elt._idxDevice = (_kNumDevices + elt._idxDevice - stripe) % _kNumDevices;
+		}
+	}
+}
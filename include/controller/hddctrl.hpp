@@ -48,8 +48,10 @@ public:
 
 //! \brief	Translate an intermediate request into a physical one.
 //! \param	request				Request to translate.
+//! \param	internals			Internal requests.
 	void translate (
-		Request					& request);
+		Request					& request,
+		std::vector <Request>	& internals);
 };
 
 #endif
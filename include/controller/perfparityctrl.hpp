@@ -164,6 +164,34 @@ protected:
 		OGSS_Ulong						start,
 		OGSS_Ulong						end);
 
+//! \brief	Get one child per device covering the given full stripes. The
+//!			stripe units of these stripes are contiguous on each device, so
+//!			each device gets a single range instead of one child per stripe.
+//!			Children are given with their physical device index.
+//! \param	parent						Parent request.
+//! \param	children					New requests.
+//! \param	first						First full stripe index.
+//! \param	last						Index after the last full stripe.
+	void _getDeviceRanges (
+		Request							& parent,
+		std::vector <Request>			& children,
+		OGSS_Ulong						first,
+		OGSS_Ulong						last);
+
+//! \brief	Check if the full stripes of a request can be decomposed by
+//!			device range. A read on a declustered volume does not target the
+//!			same devices from one stripe to another, so it stays by stripe.
+//! \param	request						Request to decompose.
+//! \param	first						First full stripe index.
+//! \param	last						Index after the last full stripe.
+//! \return								TRUE if ranges are used, FALSE else.
+	inline OGSS_Bool _useRanges (
+		const Request					& request,
+		OGSS_Ulong						first,
+		OGSS_Ulong						last)
+		{ return _rangeDecomposition && last > first
+			&& (request._type == RQT_WRITE || _parity == DCL_OFF); }
+
 //! \brief	Update the request address to the physical one.
 //! \param	requests					Requests to process.
 	void _realloc (
@@ -179,6 +207,7 @@ protected:
 	OGSS_Ulong							_numParity;		//!< Number of parity devices.
 	OGSS_Ulong							_numData;		//!< Number of data devices.
 	OGSS_DeclusteringType				_parity;		//!< Parity strategy.
+	OGSS_Bool							_rangeDecomposition;	//!< Use device ranges.
 };
 
 #endif
@@ -129,9 +129,7 @@ protected:
 	OGSS_Ulong					_numBytesBySU;		//!< Number of bytes by stripe unit.
 	OGSS_Ushort					_numDevices;		//!< Number of devices.
 	OGSS_Bool					_mirrorChosen;		//!< TRUE if the mirror was chosen last.
-	std::set <OGSS_Ushort>		_failedDevices;		//!< Failed devices.
-	std::map <OGSS_Ushort, OGSS_Real>
-								_failureDates;		//!< Failure dates.
+	OGSS_FailureTimeline		_failures;			//!< Device failures.
 };
 
 /*----------------------------------------------------------------------------*/
@@ -153,6 +151,7 @@ protected:
 	OGSS_Bool moreStripeRequest ();
 	OGSS_Bool readRequests ();
 	OGSS_Bool writeRequest ();
+	OGSS_Bool steadyBuffer ();
 };
 
 #endif
@@ -128,9 +128,7 @@ protected:
 	OGSS_Ulong					_numBytesByDev;		//!< Number of bytes by device.
 	OGSS_Ushort					_numDevices;		//!< Number of devices.
 	OGSS_Bool					_mirrorChosen;		//!< TRUE if the mirror was chosen last.
-	std::set <OGSS_Ushort>		_failedDevices;		//!< Failed devices.
-	std::map <OGSS_Ushort, OGSS_Real>
-								_failureDates;		//!< Failure dates.
+	OGSS_FailureTimeline		_failures;			//!< Device failures.
 };
 
 /*----------------------------------------------------------------------------*/
@@ -152,6 +150,7 @@ protected:
 	OGSS_Bool moreDeviceRequest ();
 	OGSS_Bool readRequests ();
 	OGSS_Bool writeRequest ();
+	OGSS_Bool failedReadRequest ();
 };
 
 #endif
@@ -154,9 +154,9 @@ protected:
 	OGSS_Ulong					_numBytesBySU;		//!< Number of bytes by stripe unit.
 	OGSS_Ulong					_numDevices;		//!< Number of devices.
 	OGSS_Ulong					_numParity;			//!< Number of parity devices.
-	std::set <OGSS_Ushort>		_failedDevices;		//!< Failed devices.
-	std::map <OGSS_Ushort, OGSS_Real>
-								_failureDates;		//!< Failure dates.
+	OGSS_FailureTimeline		_failures;			//!< Device failures.
+	std::vector <Request>		_failureBuffer;		//!< Buffer reused to rebuild the
+													//!< decomposition on failure.
 };
 
 /*----------------------------------------------------------------------------*/
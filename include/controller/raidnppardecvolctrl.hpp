@@ -154,9 +154,9 @@ protected:
 	OGSS_Ulong					_numBytesBySU;		//!< Number of bytes by stripe unit.
 	OGSS_Ulong					_numDevices;		//!< Number of devices.
 	OGSS_Ulong					_numParity;			//!< Number of parity devices.
-	std::set <OGSS_Ushort>		_failedDevices;		//!< Failed devices.
-	std::map <OGSS_Ushort, OGSS_Real>
-								_failureDates;		//!< Failure dates.
+	OGSS_FailureTimeline		_failures;			//!< Device failures.
+	std::vector <Request>		_failureBuffer;		//!< Buffer reused to rebuild the
+													//!< decomposition on failure.
 };
 
 /*----------------------------------------------------------------------------*/
@@ -201,6 +201,7 @@ protected:
 	OGSS_Bool fullStripeW2PRequest ();
 	OGSS_Bool twoStripeW2PRequest ();
 	OGSS_Bool moreStripeW2PRequest ();
+	OGSS_Bool steadyBuffer ();
 };
 
 #endif
@@ -20,7 +20,11 @@
  */
 
 //! \file	ssdctrl.hpp
-//! \brief	Definition of the SSD controller.
+//! \brief	Definition of the SSD controller. With the page-mapped translation,
+//!			the controller runs a flash translation layer (FTL): the logical
+//!			pages are written out of place, the garbage collection reclaims
+//!			the blocks with invalid pages and the wear levelling moves cold
+//!			data out of the least erased blocks.
 
 #ifndef _OGSS_SSDCTRL_HPP_
 #define _OGSS_SSDCTRL_HPP_
@@ -29,27 +33,340 @@
 /* HEADERS -------------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
 #include "controller/devicecontroller.hpp"
 
+#include "structure/hardware.hpp"
+
+#include "util/unitarytest.hpp"
+
+/*----------------------------------------------------------------------------*/
+/* STRUCTURES ----------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Flat table of page indexes, allocated by chunks on the first write
+//!			so the memory follows the written footprint of the device.
+struct OGSS_PageTable {
+	static constexpr OGSS_Ushort		_kChunkShift = 16;			//!< Entries by chunk (log2).
+	static constexpr uint32_t			_kNil = UINT32_MAX;			//!< Unmapped entry.
+
+	std::vector <std::unique_ptr <uint32_t []>>
+										_chunks;					//!< Chunks of entries.
+
+//! \brief	Resize the table.
+//! \param	size						Number of entries.
+	inline void resize (
+		const OGSS_Ulong				size);
+
+//! \brief	Get an entry.
+//! \param	idx							Entry index.
+//! \return								Entry value, nil if not set.
+	inline uint32_t get (
+		const OGSS_Ulong				idx) const;
+
+//! \brief	Set an entry.
+//! \param	idx							Entry index.
+//! \param	value						Entry value.
+	inline void set (
+		const OGSS_Ulong				idx,
+		const uint32_t					value);
+};
+
+//! \brief	Flash translation layer state of a device. Every array is indexed
+//!			by page or by block, so the state does not depend on the number
+//!			of requests. The closed blocks are also sorted by number of valid
+//!			pages and by erase count, so the garbage collection and the wear
+//!			levelling do not go through all the blocks.
+struct OGSS_FTL {
+	OGSS_Ulong							_unit;			//!< Page size (memory unit).
+	OGSS_Ulong							_pagesPerBlock;	//!< Number of pages per block.
+	OGSS_Ulong							_numBlocks;		//!< Number of blocks.
+	OGSS_Ulong							_numPages;		//!< Number of pages.
+	OGSS_Ulong							_numLogical;	//!< Number of exported pages.
+
+	OGSS_PageTable						_l2p;			//!< Logical to physical page.
+	OGSS_PageTable						_p2l;			//!< Physical to logical page.
+
+	std::vector <uint32_t>				_valid;			//!< Valid pages of each block.
+	std::vector <uint32_t>				_erase;			//!< Erase count of each block.
+	std::vector <OGSS_Real>				_lastWrite;		//!< Last write date of each block.
+	std::vector <OGSS_Bool>				_closed;		//!< TRUE if the block is fully written.
+
+	std::vector <std::set <std::pair <OGSS_Real, uint32_t>>>
+										_buckets;		//!< Closed blocks by number of valid
+														//!< pages, from the oldest write.
+	std::set <std::pair <uint32_t, uint32_t>>
+										_cold;			//!< Closed blocks by erase count.
+	std::vector <OGSS_Ulong>			_eraseHist;		//!< Number of blocks by erase count.
+
+	std::vector <uint32_t>				_free;			//!< Free block queue.
+	OGSS_Ulong							_freeHead {0};	//!< Head of the free block queue.
+	OGSS_Ulong							_numFree {0};	//!< Number of free blocks.
+
+	uint32_t							_active {OGSS_PageTable::_kNil};	//!< Block being written.
+	OGSS_Ulong							_activePage {0};	//!< Next page of the active block.
+	OGSS_Ulong							_minErase {0};	//!< Lowest erase count.
+
+	OGSS_Ulong							_hostWrites {0};	//!< Pages written by the host.
+	OGSS_Ulong							_flashWrites {0};	//!< Pages written on the flash.
+	OGSS_Ulong							_numErase {0};	//!< Number of erased blocks.
+	OGSS_Bool							_wornOut {false};	//!< TRUE if a block passed its endurance.
+};
+
 //! \brief	Controller for a SSD Device.
 class SSDCtrl:
 public DeviceController {
 public:
+	friend class UT_SSDCtrl;
 
 /*----------------------------------------------------------------------------*/
 /* PUBLIC FUNCTIONS ----------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
 //! \brief	Constructor.
-	SSDCtrl ();
+//! \param	device				Device parameters.
+	SSDCtrl (
+		const Device			& device);
 
 //! \brief	Destructor.
 	~SSDCtrl ();
 
-//! \brief	Translate an intermediate request into a physical one.
+//! \brief	Translate an intermediate request into a physical one. The
+//!			logical pages are mapped to physical ones; the fragments of the
+//!			request which are not contiguous on the flash, the copies and
+//!			the erases of the garbage collection are added to the internal
+//!			requests, before the request itself.
 //! \param	request				Request to translate.
+//! \param	internals			Internal requests.
 	void translate (
-		Request					& request);
+		Request					& request,
+		std::vector <Request>	& internals);
+
+protected:
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Get the FTL state of a device, initialized on the first request.
+//!			The spare blocks (over-provisioning) are not exported, so the
+//!			garbage collection always finds a block to reclaim.
+//! \param	idxDevice			Device index.
+//! \return						FTL state.
+	OGSS_FTL & getFTL (
+		const OGSS_Ulong		idxDevice);
+
+//! \brief	Translate a read request, page after page.
+//! \param	ftl					FTL state.
+//! \param	request				Request to translate.
+//! \param	internals			Internal requests.
+	void translateRead (
+		OGSS_FTL				& ftl,
+		Request					& request,
+		std::vector <Request>	& internals);
+
+//! \brief	Translate a write request, page after page.
+//! \param	ftl					FTL state.
+//! \param	request				Request to translate.
+//! \param	internals			Internal requests.
+	void translateWrite (
+		OGSS_FTL				& ftl,
+		Request					& request,
+		std::vector <Request>	& internals);
+
+//! \brief	Get the next physical page of the active block. A new block is
+//!			taken from the free queue when the active one is full, after a
+//!			garbage collection if there are not enough free blocks.
+//! \param	ftl					FTL state.
+//! \param	base				Request used as a model for internal requests.
+//! \param	internals			Internal requests.
+//! \param	collect				TRUE if the garbage collection can be run.
+//! \return						Physical page.
+	OGSS_Ulong allocatePage (
+		OGSS_FTL				& ftl,
+		const Request			& base,
+		std::vector <Request>	& internals,
+		const OGSS_Bool			collect);
+
+//! \brief	Close the active block, which is sorted with the other closed
+//!			blocks.
+//! \param	ftl					FTL state.
+	inline void closeBlock (
+		OGSS_FTL				& ftl);
+
+//! \brief	Invalidate a physical page, its block is moved to the bucket of
+//!			its new number of valid pages if it is closed.
+//! \param	ftl					FTL state.
+//! \param	page				Physical page.
+	inline void invalidatePage (
+		OGSS_FTL				& ftl,
+		const OGSS_Ulong		page);
+
+//! \brief	Select the victim block of the garbage collection. Only the
+//!			oldest block of each valid page bucket can be selected, as it is
+//!			the best one of its bucket for both policies.
+//! \param	ftl					FTL state.
+//! \param	date				Current date.
+//! \return						Victim block, nil if there is none.
+	uint32_t selectVictim (
+		const OGSS_FTL			& ftl,
+		const OGSS_Real			date) const;
+
+//! \brief	Copy the valid pages of a block, then erase it and put it back
+//!			in the free queue.
+//! \param	ftl					FTL state.
+//! \param	block				Block to reclaim.
+//! \param	base				Request used as a model for internal requests.
+//! \param	internals			Internal requests.
+	void reclaim (
+		OGSS_FTL				& ftl,
+		const uint32_t			block,
+		const Request			& base,
+		std::vector <Request>	& internals);
+
+//! \brief	Static wear levelling: when an erased block is too worn compared
+//!			to the least erased one, the data of the least erased closed
+//!			block is moved so that this block gets the next writes.
+//! \param	ftl					FTL state.
+//! \param	block				Erased block.
+//! \param	base				Request used as a model for internal requests.
+//! \param	internals			Internal requests.
+	void levelWear (
+		OGSS_FTL				& ftl,
+		const uint32_t			block,
+		const Request			& base,
+		std::vector <Request>	& internals);
+
+//! \brief	Add an internal request.
+//! \param	base				Request used as a model.
+//! \param	type				Request type.
+//! \param	address				Physical address.
+//! \param	size				Request size.
+//! \param	internals			Internal requests.
+	inline void addInternal (
+		const Request			& base,
+		const OGSS_RequestType	type,
+		const OGSS_Ulong		address,
+		const OGSS_Ulong		size,
+		std::vector <Request>	& internals);
+
+/*----------------------------------------------------------------------------*/
+/* ATTRIBUTES ----------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+	SSDParameters				_param;				//!< SSD parameters.
+	std::map <OGSS_Ulong, OGSS_FTL>
+								_ftl;				//!< FTL state of each device.
+
+	OGSS_Ulong					_gcThreshold {2};	//!< Free blocks under which the
+													//!< garbage collection is run.
+	OGSS_Ulong					_wlThreshold {64};	//!< Erase count difference which
+													//!< triggers the wear levelling.
+};
+
+/*----------------------------------------------------------------------------*/
+/* INLINE FUNCTIONS ----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+void
+OGSS_PageTable::resize (
+	const OGSS_Ulong			size) {
+	_chunks.resize ( (size >> _kChunkShift) + 1);
+}
+
+uint32_t
+OGSS_PageTable::get (
+	const OGSS_Ulong			idx) const {
+	const auto					& chunk = _chunks [idx >> _kChunkShift];
+
+	return chunk ? chunk [idx & ( (1UL << _kChunkShift) - 1)] : _kNil;
+}
+
+void
+OGSS_PageTable::set (
+	const OGSS_Ulong			idx,
+	const uint32_t				value) {
+	auto						& chunk = _chunks [idx >> _kChunkShift];
+
+	if (! chunk) {
+		chunk.reset (new uint32_t [1UL << _kChunkShift]);
+		std::fill (chunk.get (), chunk.get () + (1UL << _kChunkShift), _kNil);
+	}
+
+	chunk [idx & ( (1UL << _kChunkShift) - 1)] = value;
+}
+
+void
+SSDCtrl::closeBlock (
+	OGSS_FTL					& ftl) {
+	uint32_t					b {ftl._active};
+
+	ftl._closed [b] = true;
+	ftl._buckets [ftl._valid [b] ] .emplace (ftl._lastWrite [b], b);
+	ftl._cold.emplace (ftl._erase [b], b);
+	ftl._active = OGSS_PageTable::_kNil;
+}
+
+void
+SSDCtrl::invalidatePage (
+	OGSS_FTL					& ftl,
+	const OGSS_Ulong			page) {
+	uint32_t					b {static_cast <uint32_t> (page / ftl._pagesPerBlock)};
+
+	if (ftl._closed [b]) {
+		ftl._buckets [ftl._valid [b] ] .erase (std::make_pair (ftl._lastWrite [b], b) );
+		ftl._buckets [ftl._valid [b] - 1] .emplace (ftl._lastWrite [b], b);
+	}
+
+	-- ftl._valid [b];
+}
+
+void
+SSDCtrl::addInternal (
+	const Request				& base,
+	const OGSS_RequestType		type,
+	const OGSS_Ulong			address,
+	const OGSS_Ulong			size,
+	std::vector <Request>		& internals) {
+	internals.push_back (base);
+	internals.back () ._type = type;
+	internals.back () ._deviceAddress = address;
+	internals.back () ._size = size;
+	internals.back () ._internal = true;
+}
+
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+class UT_SSDCtrl:
+public UnitaryTest <UT_SSDCtrl> {
+public:
+	UT_SSDCtrl (
+		const OGSS_String		& configurationFile);
+	~UT_SSDCtrl ();
+
+protected:
+	OGSS_Bool checkMapping (
+		const OGSS_FTL			& ftl);
+
+	OGSS_Bool runWorkload (
+		const OGSS_GarbageCollectionType	gc,
+		const OGSS_WearLevellingType		wl,
+		const OGSS_Ulong		hotPages,
+		OGSS_FTL				& res);
+
+	OGSS_Bool mapping ();
+	OGSS_Bool fullCapacity ();
+	OGSS_Bool greedyCollection ();
+	OGSS_Bool costBenefitCollection ();
+	OGSS_Bool wearLevelling ();
 };
 
 #endif
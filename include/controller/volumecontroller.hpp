@@ -114,6 +114,34 @@ protected:
 //! \brief	Constructor.
 	VolumeController () {  }
 
+//! \brief	Append a child of the given request at the end of the child
+//!			buffer. The child is a full copy of its parent, built in place;
+//!			the request is trivially copyable so it is a plain copy, and, as
+//!			the buffer is owned and reused by the volume driver, no
+//!			allocation occurs once its capacity is reached.
+//! \param	parent				Parent request.
+//! \param	children			Child buffer.
+//! \return						New child, valid until the next append.
+	inline Request & appendChild (
+		const Request			& parent,
+		std::vector <Request>	& children)
+		{ children.emplace_back (parent); return children.back (); }
+
+//! \brief	Remove the duplicated child requests and merge the contiguous
+//!			ones. The children are sorted in place, so no ordered container
+//!			is built. The children are ordered by type, device and device
+//!			address, then by creation order, which is stored in their minor
+//!			index before sorting; among duplicates, the first created one is
+//!			kept.
+//! \param	request				Parent request.
+//! \param	subrequests			Child requests.
+//! \param	renumber			TRUE to renumber the children and update the
+//!								child counters of the parent.
+	static void _removeAndMerge (
+		Request					& request,
+		std::vector <Request>	& subrequests,
+		const OGSS_Bool			renumber = true);
+
 	Request						_lastEventBlock;	//!< Last event block processed.
 	std::map <OGSS_Ulong, OGSS_DeviceState>
 								_deviceState;		//!< Devices state.
@@ -0,0 +1,213 @@
+/*
+ * Copyright UVSQ - CEA/DAM/DIF (2018)
+ * Contributors:  Sebastien GOUGEAUD  -- sebastien.gougeaud@uvsq.fr
+ *                Soraya ZERTAL       --      soraya.zertal@uvsq.fr
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published per the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+//! \file	commandqueue.hpp
+//! \brief	Definition of the device command queue, used by the device driver
+//!			to reorder the requests sent to a device.
+
+#ifndef _OGSS_COMMANDQUEUE_HPP_
+#define _OGSS_COMMANDQUEUE_HPP_
+
+/*----------------------------------------------------------------------------*/
+/* HEADERS -------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#include <vector>
+
+#include "structure/hardware.hpp"
+#include "structure/request.hpp"
+#include "structure/types.hpp"
+
+#include "util/unitarytest.hpp"
+
+//! \brief	Command queue of a device. Up to the queue depth requests are
+//!			held, sorted by target track then by arrival. The device takes
+//!			the next request when it goes idle, at a date estimated from the
+//!			positioning and transfer times of the previous ones, among the
+//!			requests which arrived by then. The request is chosen by the
+//!			scheduling discipline from the head position: FIFO (arrival
+//!			order), SSTF (nearest track), SCAN (elevator, in the LOOK
+//!			variant) or SPTF (lowest seek time plus rotational delay, from
+//!			the seek curve of the HDD model). A request which was passed over
+//!			too many times is served first, so none starves. Only the HDDs
+//!			have a positioning cost, the other devices stay in the arrival
+//!			order. The requests are numbered in the dispatch order, so the
+//!			synchronization serves them in this order on the device (see
+//!			OGSS_DispatchOrder).
+class CommandQueue {
+public:
+	friend class UT_CommandQueue;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTIONS ----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Constructor.
+//! \param	device				Device parameters.
+	CommandQueue (
+		const Device			& device);
+
+//! \brief	Destructor.
+	~CommandQueue ();
+
+//! \brief	Check if the requests are reordered.
+//! \return						TRUE if the queue is used.
+	inline OGSS_Bool isEnabled () const
+		{ return _depth > 1 && _scheduling != SCH_FIFO; }
+
+//! \brief	Check if the queue is empty.
+//! \return						TRUE if no request is held.
+	inline OGSS_Bool isEmpty () const
+		{ return _entries.empty (); }
+
+//! \brief	Check if the queue is full.
+//! \return						TRUE if the queue depth is reached.
+	inline OGSS_Bool isFull () const
+		{ return _entries.size () >= _depth; }
+
+//! \brief	Check if the device takes a queued request before a date, ie.
+//!			it goes idle before the date with a request to serve.
+//! \param	date				Date.
+//! \return						TRUE if a request is served before the date.
+	OGSS_Bool isReady (
+		const OGSS_Real			date) const;
+
+//! \brief	Insert a request in the queue.
+//! \param	req					Request.
+	void push (
+		const Request			& req);
+
+//! \brief	Remove the next request to serve when the device goes idle, and
+//!			move the head to its end. The request gets its rank in the
+//!			dispatch order, which the synchronization follows.
+//! \param	req					Next request.
+	void pop (
+		Request					& req);
+
+protected:
+
+//! \brief	Queued request, with its position on the device.
+	struct Entry {
+		OGSS_Ulong				_track;				//!< Target track.
+		OGSS_Ulong				_seq;				//!< Arrival number.
+		OGSS_Real				_angle;				//!< First sector angle, in rotations.
+		Request					_req;				//!< Request.
+	};
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Date at which the device takes the next request.
+//! \return						Date.
+	OGSS_Real _nextDate () const;
+
+//! \brief	Select the nearest track from the head.
+//! \param	date				Date of the choice.
+//! \return						Entry position.
+	OGSS_Ulong _selectSSTF (
+		const OGSS_Real			date) const;
+
+//! \brief	Select the next track in the sweep direction, and reverse the
+//!			direction at the last one.
+//! \param	date				Date of the choice.
+//! \return						Entry position.
+	OGSS_Ulong _selectSCAN (
+		const OGSS_Real			date);
+
+//! \brief	Select the lowest positioning time.
+//! \param	date				Date of the choice.
+//! \return						Entry position.
+	OGSS_Ulong _selectSPTF (
+		const OGSS_Real			date) const;
+
+//! \brief	Find the first entry of a track, or of the next track.
+//! \param	track				Track.
+//! \return						Entry position.
+	OGSS_Ulong _lowerBound (
+		const OGSS_Ulong		track) const;
+
+//! \brief	Estimate the positioning time of an entry.
+//! \param	elt					Entry.
+//! \param	date				Date at which the seek starts.
+//! \return						Seek time plus rotational delay.
+	OGSS_Real _positioningTime (
+		const Entry				& elt,
+		const OGSS_Real			date) const;
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE ATTRIBUTES --------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+	static constexpr OGSS_Ulong	_kAging = 4;		//!< Number of queue depths after
+													//!< which a request is served first.
+	static constexpr OGSS_Ulong	_kNone = OGSS_ULONG_MAX;	//!< No entry.
+
+	std::vector <Entry>			_entries;			//!< Requests, by track and arrival.
+	OGSS_Ulong					_depth;				//!< Queue depth.
+	OGSS_SchedulingType			_scheduling;		//!< Scheduling discipline.
+	OGSS_Bool					_hdd;				//!< TRUE if the positions are tracked.
+	HDDParameters				_geometry;			//!< HDD parameters.
+	OGSS_Real					_seekA [2];			//!< Seek curve coefficient a, by type.
+	OGSS_Real					_seekB [2];			//!< Seek curve coefficient b.
+	OGSS_Real					_seekMin [2];		//!< Minimum seek time.
+
+	OGSS_Ulong					_headTrack {0};		//!< Track under the head.
+	OGSS_Real					_idleDate {.0};		//!< Estimated date at which the device
+													//!< is done with the served requests.
+	OGSS_Bool					_up {true};			//!< Sweep direction.
+	OGSS_Ulong					_numPushed {0};		//!< Number of queued requests.
+	OGSS_Ulong					_numPopped {0};		//!< Number of dispatched requests.
+};
+
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+class UT_CommandQueue:
+public UnitaryTest <UT_CommandQueue> {
+public:
+	UT_CommandQueue (
+		const OGSS_String		& configurationFile);
+	~UT_CommandQueue ();
+
+protected:
+	Device createDevice (
+		const OGSS_SchedulingType	scheduling,
+		const OGSS_Ulong		depth);
+
+	void pushTrack (
+		CommandQueue			& queue,
+		const OGSS_Ulong		track,
+		const OGSS_Ulong		sector,
+		const OGSS_Real			date);
+
+	std::vector <OGSS_Ulong> popTracks (
+		CommandQueue			& queue);
+
+	OGSS_Bool shortestSeek ();
+	OGSS_Bool elevator ();
+	OGSS_Bool shortestPositioning ();
+	OGSS_Bool aging ();
+	OGSS_Bool dateAdmission ();
+};
+
+#endif
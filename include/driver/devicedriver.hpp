@@ -29,11 +29,13 @@
 /* HEADERS -------------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+#include <map>
 #include <memory>
 
 #include "communication/communicationinterface.hpp"
 
 #include "controller/devicecontroller.hpp"
+#include "driver/commandqueue.hpp"
 #include "module/module.hpp"
 
 #include "structure/devicestate.hpp"
@@ -44,7 +46,10 @@
 //! 		controller. The driver is the submodule which handles communication
 //! 		with other modules (volume & execution), receiving requests
 //! 		to process. When a request is received, it will asks the controller
-//! 		to decompose it before sending it to the execution module.
+//! 		to decompose it before sending it to the execution module. The
+//! 		requests of a device can wait in its command queue, which sends
+//! 		them to the execution module in the order of its scheduling, each
+//! 		one when the device goes idle after its arrival.
 class DeviceDriver: public Module {
 public:
 
@@ -82,12 +87,24 @@ private:
 //! \brief	Data reception (device parameters).
 	inline void receiveData ();
 
+//! \brief	Send a request to the execution module, after the internal
+//!			requests of the controller.
+//! \param	req					Request.
+	void dispatch (
+		Request					& req);
+
+//! \brief	Send all the requests held by the command queues.
+	void flushQueues ();
+
 /*----------------------------------------------------------------------------*/
 /* ATTRIBUTES ----------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
 	std::unique_ptr <DeviceController>
 								_ctrl;				//!< Device controller.
+	std::vector <Request>		_internals;			//!< Internal requests of the controller.
+	std::map <OGSS_Long, CommandQueue>
+								_queues;			//!< Command queues, by device.
 	Device						_device;			//!< Device parameters.
 	std::map <OGSS_Long, OGSS_DeviceState>
 								_deviceState;		//!< Devices state.
@@ -0,0 +1,147 @@
+/*
+ * Copyright UVSQ - CEA/DAM/DIF (2018)
+ * Contributors:  Sebastien GOUGEAUD  -- sebastien.gougeaud@uvsq.fr
+ *                Soraya ZERTAL       --      soraya.zertal@uvsq.fr
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published per the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+//! \file	volumecache.hpp
+//! \brief	Definition of the volume cache, used by the volume driver to
+//!			model the controller cache of a volume.
+
+#ifndef _OGSS_VOLUMECACHE_HPP_
+#define _OGSS_VOLUMECACHE_HPP_
+
+/*----------------------------------------------------------------------------*/
+/* HEADERS -------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#include <vector>
+
+#include "structure/types.hpp"
+
+//! \brief	Volume cache with a LRU replacement. The cache lines are allocated
+//!			once, then they are linked in an open hash table and in the LRU
+//!			list by index, so a lookup, an insertion and an eviction are done
+//!			in constant time without any allocation.
+class VolumeCache {
+public:
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTIONS ----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Constructor.
+//! \param	size				Cache size.
+//! \param	lineSize			Cache line size.
+	VolumeCache (
+		const OGSS_Ulong		size = 0,
+		const OGSS_Ulong		lineSize = 1);
+
+//! \brief	Destructor.
+	~VolumeCache ();
+
+//! \brief	Check if the cache is used.
+//! \return						TRUE if the cache has lines.
+	inline OGSS_Bool isEnabled () const
+		{ return ! _lines.empty (); }
+
+//! \brief	Get the cache line size.
+//! \return						Cache line size.
+	inline OGSS_Ulong getLineSize () const
+		{ return _lineSize; }
+
+//! \brief	Look up the lines of a volume range. If they are all present,
+//!			they become the most recently used ones.
+//! \param	address				Volume address.
+//! \param	size				Range size.
+//! \return						TRUE if the whole range is in the cache.
+	OGSS_Bool lookup (
+		const OGSS_Ulong		address,
+		const OGSS_Ulong		size);
+
+//! \brief	Insert the lines of a volume range, as the most recently used
+//!			ones. The least recently used lines are evicted if needed.
+//! \param	address				Volume address.
+//! \param	size				Range size.
+//! \param	dirty				TRUE if the lines are not on the devices yet.
+//! \param	evicted				Evicted dirty lines, which need a destage.
+	void insert (
+		const OGSS_Ulong		address,
+		const OGSS_Ulong		size,
+		const OGSS_Bool			dirty,
+		std::vector <OGSS_Ulong>	& evicted);
+
+protected:
+
+//! \brief	Cache line, linked in a hash chain and in the LRU list.
+	struct Line {
+		OGSS_Ulong				_tag;				//!< Line index in the volume.
+		OGSS_Ulong				_prev;				//!< More recently used line.
+		OGSS_Ulong				_next;				//!< Less recently used line.
+		OGSS_Ulong				_chain;				//!< Next line of the bucket.
+		OGSS_Bool				_dirty;				//!< TRUE if not destaged.
+	};
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Find a line.
+//! \param	tag					Line index in the volume.
+//! \return						Line position, _kNil if absent.
+	OGSS_Ulong _find (
+		const OGSS_Ulong		tag) const;
+
+//! \brief	Remove a line from the LRU list.
+//! \param	pos					Line position.
+	void _unlink (
+		const OGSS_Ulong		pos);
+
+//! \brief	Put a line at the head of the LRU list.
+//! \param	pos					Line position.
+	void _pushFront (
+		const OGSS_Ulong		pos);
+
+//! \brief	Remove a line from its hash chain.
+//! \param	pos					Line position.
+	void _unchain (
+		const OGSS_Ulong		pos);
+
+//! \brief	Hash a line index (multiplicative hashing).
+//! \param	tag					Line index in the volume.
+//! \return						Bucket.
+	inline OGSS_Ulong _bucket (
+		const OGSS_Ulong		tag) const
+		{ return (tag * 0x9E3779B97F4A7C15UL) >> _hashShift; }
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE ATTRIBUTES --------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+	static constexpr OGSS_Ulong	_kNil = OGSS_ULONG_MAX;	//!< Null position.
+
+	std::vector <Line>			_lines;				//!< Cache lines.
+	std::vector <OGSS_Ulong>	_buckets;			//!< First line of each bucket.
+	OGSS_Ulong					_lineSize;			//!< Cache line size.
+	OGSS_Ushort					_hashShift;			//!< Shift of the hash.
+	OGSS_Ulong					_numUsed {0};		//!< Number of used lines.
+	OGSS_Ulong					_head {_kNil};		//!< Most recently used line.
+	OGSS_Ulong					_tail {_kNil};		//!< Least recently used line.
+};
+
+#endif
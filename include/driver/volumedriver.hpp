@@ -34,10 +34,21 @@
 #include "communication/communicationinterface.hpp"
 
 #include "controller/volumecontroller.hpp"
+#include "driver/volumecache.hpp"
 #include "module/module.hpp"
 #include "structure/hardware.hpp"
 #include "structure/types.hpp"
 
+#include "util/unitarytest.hpp"
+
+//! \brief	Writes of a stripe held in the coalescing window.
+struct OGSS_CoalescedStripe {
+	OGSS_Real							_date;		//!< Arrival date of the first write.
+	std::vector <std::pair <OGSS_Ulong, OGSS_Ulong>>
+										_ranges;	//!< Written ranges of the stripe.
+	std::vector <Request>				_writes;	//!< Held writes.
+};
+
 //! \brief	Volume module is composed of two submodules: the driver and the
 //! 		controller. The driver is the submodule which handles communication
 //! 		with other modules (preprocessing & device), receiving requests
@@ -45,6 +56,7 @@
 //! 		to decompose it before sending it to the device module.
 class VolumeDriver: public Module {
 public:
+	friend class UT_VolumeDriver;
 
 /*----------------------------------------------------------------------------*/
 /* PUBLIC FUNCTIONS ----------------------------------------------------------*/
@@ -85,6 +97,69 @@ protected:
 		OGSS_Ulong						numBlocks,
 		std::vector <Request>			& subrequests);
 
+//! \brief	Generation of the requests of the pending events dated before a
+//!			given date, when there is no on-the-fly reconstruction. The blocks
+//!			of an event are dated one rebuild period apart, so the rebuild is
+//!			spread over time and merged into the stream by date: the blocks
+//!			dated before the next user request are sent before it, by chunks,
+//!			and the number of generated requests in memory does not depend on
+//!			the device size.
+//! \param	date				Date of the next request of the stream.
+	void generatePendingRequests (
+		const OGSS_Real			date);
+
+//! \brief	Go through the volume cache with a decomposed request. The
+//!			children of a read hit or of a write-back write are marked as
+//!			served by the cache. The dirty lines evicted by the request are
+//!			decomposed as writes and added to its children, so the destage
+//!			is charged to the request which needs the space. The destage
+//!			children are not prioritary, so they do not delay the children
+//!			of the request.
+//! \param	request				Decomposed request.
+	void processCache (
+		Request							& request);
+
+//! \brief	Send a decomposed request to the synchronization and its
+//!			children to the devices.
+//! \param	request				Decomposed request.
+	void sendDecomposition (
+		Request							& request);
+
+//! \brief	Check if a write can wait in the coalescing window, ie. it is a
+//!			partial write of a single stripe of a parity volume.
+//! \param	request				Request to check.
+//! \return						TRUE if the write can be held.
+	OGSS_Bool isCoalescable (
+		const Request					& request) const;
+
+//! \brief	Hold a write in the coalescing window of its stripe. When the
+//!			held writes cover the whole stripe, they are written without
+//!			any pre-read.
+//! \param	request				Write to hold.
+	void coalesceWrite (
+		const Request					& request);
+
+//! \brief	Write a complete stripe from the held writes. Each write only
+//!			keeps its data children, the parity is written with the last one.
+//!			The held writes are dated with the last one, as they wait in the
+//!			window until the stripe is complete.
+//! \param	stripe				Stripe index.
+//! \param	writes				Held writes.
+	void writeFullStripe (
+		const OGSS_Ulong				stripe,
+		std::vector <Request>			& writes);
+
+//! \brief	Decompose the held writes of the stripes whose window ends
+//!			before a given date, with read-modify-writes. The writes are
+//!			dated with the end of their window, or with the given date if
+//!			it is before, and the stripes are flushed by date, so the
+//!			requests of the volume are sent in the date order.
+//! \param	date				Current date.
+//! \param	all					TRUE to flush all the stripes.
+	void flushCoalescedStripes (
+		const OGSS_Real					date,
+		const OGSS_Bool					all = false);
+
 //! \brief	Data reception during the initialization process.
 	virtual void receiveData ();
 
@@ -118,6 +193,51 @@ protected:
 
 	OGSS_Real					_fillingRate = .2;	//!< Device filling rate ie. how many
 													//!< blocks need to be reconstructed.
+
+	std::vector <Request>		_subrequests;		//!< Child buffer, reused by the
+													//!< controller for each decomposition.
+	std::vector <Request>		_pendingEvents;		//!< Events which still have requests
+													//!< to generate, with the next block
+													//!< and its date.
+	OGSS_Ulong					_eventChunkSize {64};	//!< Number of blocks generated at
+													//!< once for a pending event.
+	OGSS_Real					_rebuildPeriod {1.};	//!< Time between two rebuilt blocks
+													//!< of an event (rebuild rate).
+
+	VolumeCache					_cache;				//!< Volume cache.
+	OGSS_Ulong					_defaultLineSize {64};	//!< Cache line size when there
+													//!< is no stripe unit.
+	std::vector <OGSS_Ulong>	_evictedLines;		//!< Dirty lines evicted by the last request.
+	std::vector <Request>		_destages;			//!< Destage buffer, reused for each eviction.
+
+	std::map <OGSS_Ulong, OGSS_CoalescedStripe>
+								_coalescedStripes;	//!< Stripes in the coalescing window.
+	std::vector <Request>		_stripeChildren;	//!< Children of a full stripe write.
+};
+
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+class UT_VolumeDriver:
+public UnitaryTest <UT_VolumeDriver> {
+public:
+	UT_VolumeDriver (
+		const OGSS_String		& configurationFile);
+	~UT_VolumeDriver ();
+
+protected:
+	OGSS_Bool checkOrder (
+		VolumeDriver			& driver);
+
+	OGSS_Bool cacheHitMiss ();
+	OGSS_Bool cacheEviction ();
+	OGSS_Bool cacheDestage ();
+	OGSS_Bool fullStripe ();
+	OGSS_Bool partialFlush ();
+	OGSS_Bool timeoutFlush ();
+
+	OGSS_String					_cfg;
 };
 
 #endif
@@ -29,12 +29,31 @@
 /* HEADERS -------------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "communication/communicationinterface.hpp"
 #include "computation/computationmodel.hpp"
+#include "computation/devicecache.hpp"
 #include "module/module.hpp"
 #include "structure/hardware.hpp"
 #include "structure/types.hpp"
 
+//! \brief	Execution shard, which owns a contiguous range of devices and the
+//!			computation models of these devices. Shards do not share any
+//!			device state, so they compute their requests in parallel. The
+//!			models of a shard only hold the state of its devices.
+struct OGSS_ExecutionShard {
+	OGSS_Ulong					_firstDevice;		//!< First device of the shard.
+	OGSS_Ulong					_lastDevice;		//!< Device after the last one of the shard.
+
+	std::unique_ptr <ComputationModel>	_models [DTP_TOTAL];	//!< Computation model of each
+															//!< device type.
+	std::vector <Request *>		_batches [DTP_TOTAL];	//!< Requests of the batch, by model.
+	DeviceCache					_cache;				//!< Buffers of the devices.
+};
+
 //! \brief	The execution module computes for each request received from the
 //!			the device drivers, their service and transfer times according to
 //!			the hardware components used. Then, the requests are sent to the
@@ -73,10 +92,41 @@ private:
 //! \brief	Data reception during the initialization step, for the hardware parameters.
 	inline void receiveData ();
 
-//! \brief	Request processing.
-//!	\param	req					Request to process.
-	void treatRequest (
-		Request					& req);
+//! \brief	Check if the service and transfer times of a request have to be
+//!			computed, ie. it is not an event nor a step of the reconstruction.
+//! \param	req					Request.
+//! \return						TRUE if the request has to be computed.
+	inline OGSS_Bool isComputed (
+		const Request			& req) const;
+
+//! \brief	Processing of the received requests. The requests are routed to
+//!			the shard owning their device, and to the model of their device,
+//!			which was chosen once. The requests of each computation model
+//!			are given at once to the model of the shard. The shards are
+//!			computed in parallel by the worker pool, then the transfer times
+//!			are computed by batch and the requests are sent in their
+//!			reception order.
+	void treatBatch ();
+
+//! \brief	Worker of the pool, which computes a shard for each batch until
+//!			the pool is stopped.
+//! \param	idx					Shard index.
+	void runWorker (
+		const OGSS_Ulong		idx);
+
+//! \brief	Compute the service times of the requests routed to a shard.
+//!			The requests go through the device buffers first, only the
+//!			ones which need the media are given to the models.
+//! \param	shard				Execution shard.
+	static void computeShard (
+		OGSS_ExecutionShard		& shard);
+
+//! \brief	Split the devices in contiguous ranges, one for each shard, and
+//!			start the worker pool: the first shard is computed by the module
+//!			thread and each other shard by its own worker.
+//! \param	numShards			Requested number of shards.
+	void initShards (
+		OGSS_Ulong				numShards);
 
 //! \brief	Initialization of the computation models, following the information
 //!			given in OGSSim configuration file.
@@ -97,10 +147,27 @@ private:
 
 	OGSS_Ushort					_numRealVolumes;	//!< Number of real volumes.
 
-	std::unique_ptr <ComputationModel>	_hdd;		//!< HDD computation model.
-	std::unique_ptr <ComputationModel>	_ssd;		//!< SSD computation model.
-	std::unique_ptr <ComputationModel>	_nvram;		//!< NVRAM computation model.
+	std::vector <OGSS_ExecutionShard>	_shards;	//!< Execution shards.
+	std::vector <std::thread>	_workers;			//!< Worker pool, one for each shard
+													//!< but the first one.
+	std::mutex					_poolMutex;			//!< Mutex of the worker pool.
+	std::condition_variable		_poolStart;			//!< Signaled when a batch is given
+													//!< to the workers.
+	std::condition_variable		_poolDone;			//!< Signaled when the workers are done.
+	OGSS_Ulong					_poolRound {0};		//!< Index of the current batch.
+	OGSS_Ulong					_poolPending {0};	//!< Workers not done with the batch.
+	OGSS_Bool					_poolStop {false};	//!< TRUE when the pool is stopped.
+	std::vector <OGSS_Ushort>	_shardOf;			//!< Shard of each device.
+	std::vector <OGSS_Ushort>	_modelOf;			//!< Computation model of each device.
 	std::unique_ptr <ComputationModel>	_interface;	//!< Interface computation model.
+	std::vector <Request *>		_transferBatch;		//!< Requests of the batch for the
+													//!< interface model.
+
+	std::vector <Request>		_batch;				//!< Received requests not computed yet.
+	std::vector <OGSS_Real>		_internalTime;		//!< Service time of the internal requests
+													//!< not charged yet, for each device.
+	OGSS_Ulong					_batchSize {4096};	//!< Maximum number of requests in a batch.
+	OGSS_Real					_batchWindow {.0};	//!< Maximum date range of a batch (0 if none).
 
 	OGSS_Bool					_syncOTF;			//!< TRUE if there is an on-the-fly synchronization step.
 	OGSS_Bool					_syncProc {false};	//!< Indicate if the synchronization was processed.
@@ -110,6 +177,13 @@ private:
 /* INLINE FUNCTIONS ----------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+OGSS_Bool
+Execution::isComputed (
+	const Request				& req) const {
+	return req._type != RQT_EVEND && req._type != RQT_EVSTP
+		&& req._type != RQT_EVFLT && req._type != RQT_EVRPL;
+}
+
 void
 Execution::receiveData () {
 	void						* arg;
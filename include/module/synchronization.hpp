@@ -90,6 +90,9 @@ private:
 
 	OGSS_DataUnit				_globalDU;			//!< Global data unit.
 
+	OGSS_Bool					_online;			//!< TRUE if the synchronization
+													//!< is done during the decomposition.
+
 	HardwareParameters			_hardParam;			//!< Hardware parameters.
 
 	std::vector <Tier>			_tiers;				//!< Tiers.
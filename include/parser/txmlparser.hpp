@@ -96,6 +96,48 @@ namespace XMLParser {
 		const OGSS_String		& configurationFile,
 		const OGSS_ParamType	& paramType);
 
+//! \brief	Get the number of execution shards by searching through the
+//! configuration file.
+//! \param	configurationFile	Configuration file.
+//! \return						Number of shards, 0 if not given.
+	OGSS_Ulong getNumExecutionShards (
+		const OGSS_String		& configurationFile);
+
+//! \brief	Get the maximum number of requests of an execution batch by
+//! searching through the configuration file.
+//! \param	configurationFile	Configuration file.
+//! \return						Number of requests, 0 if not given.
+	OGSS_Ulong getExecutionBatchSize (
+		const OGSS_String		& configurationFile);
+
+//! \brief	Get the maximum date range of an execution batch by searching
+//! through the configuration file.
+//! \param	configurationFile	Configuration file.
+//! \return						Date range, 0 if not given.
+	OGSS_Real getExecutionBatchWindow (
+		const OGSS_String		& configurationFile);
+
+//! \brief	Get the number of synchronization shards by searching through the
+//! configuration file.
+//! \param	configurationFile	Configuration file.
+//! \return						Number of shards, 0 if not given.
+	OGSS_Ulong getNumSynchronizationShards (
+		const OGSS_String		& configurationFile);
+
+//! \brief	Check if the synchronization is done online, during the
+//! decomposition, by searching through the configuration file.
+//! \param	configurationFile	Configuration file.
+//! \return						TRUE if the online synchronization is on.
+	OGSS_Bool getOnlineSynchronization (
+		const OGSS_String		& configurationFile);
+
+//! \brief	Check if the requests are retired once their logical request is
+//! done, by searching through the configuration file.
+//! \param	configurationFile	Configuration file.
+//! \return						TRUE if the request retirement is on.
+	OGSS_Bool getRequestRetirement (
+		const OGSS_String		& configurationFile);
+
 //! \brief	Get the value of the port used for the communication by searching
 //! through the configuration file.
 //! \param	configurationFile	Configuration file.
@@ -30,6 +30,8 @@
 /* HEADERS -------------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+#include <vector>
+
 #include "scheme/decraidscheme.hpp"
 
 #include "structure/devicestate.hpp"
@@ -125,6 +127,61 @@ private:
 	OGSS_Ushort computeMatrixRank (
 		const OGSS_Ulong		lambda);
 
+//! \brief	Precompute the layout tables of the chosen offset: the logical
+//!			devices hosted by each physical device and the use counters of
+//!			the spare areas.
+	void buildLayoutTables ();
+
+//! \brief	Set an entry of a redirection vector and keep the use counters of
+//!			the spare areas up to date.
+//! \param	device				Device owning the redirection vector.
+//! \param	row					Row of the entry.
+//! \param	target				New target of the entry.
+	void setRedirection (
+		const OGSS_Ushort		device,
+		const OGSS_Ulong		row,
+		const OGSS_Ushort		target);
+
+//! \brief	Search for the first device whose redirection vector points on a
+//!			given spare area.
+//! \param	row					Row of the spare area.
+//! \param	target				Device of the spare area.
+//! \return						Device index, the number of devices if none.
+	OGSS_Ushort findRedirectedDevice (
+		const OGSS_Ulong		row,
+		const OGSS_Ushort		target);
+
+//! \brief	Compute the logical device stored on a physical device for a
+//!			given row.
+//! \param	row					Row.
+//! \param	device				Physical device.
+//! \return						Logical device, spare area if greater or equal
+//!								to the number of data devices.
+	inline OGSS_Ushort logicalDevice (
+		const OGSS_Ulong		row,
+		const OGSS_Ulong		device)
+		{ return (_numDevices * row + device - row * _lambda) % _numDevices; }
+
+//! \brief	Check if a device is failed at a given date.
+//! \param	device				Device index, can be an unset redirection.
+//! \param	clock				Checking date.
+//! \return						TRUE if the device is failed.
+	inline OGSS_Bool isFailed (
+		const OGSS_Ushort		device,
+		const OGSS_Real			clock)
+		{ return device < _numDevices && _deviceState [device] .isFailed (clock); }
+
+//! \brief	Check if a device is faulty and not renewed at a given date,
+//!			according to the events received by the scheme.
+//! \param	device				Device index.
+//! \param	clock				Checking date.
+//! \return						TRUE if the device is faulty.
+	inline OGSS_Bool isFaulty (
+		const OGSS_Ushort		device,
+		const OGSS_Real			clock)
+		{ return _eventDevices.test (device) && _eventTimes [device] .first <= clock
+			&& _eventTimes [device] .second > clock; }
+
 /*----------------------------------------------------------------------------*/
 /* PRIVATE ATTRIBUTES --------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
@@ -138,11 +195,16 @@ private:
 	OGSS_Ulong					_numBytesBySU;		//!< Number of bytes by stripe unit.
 	OGSS_Ulong					_numBytesByDev;		//!< Number of bytes by device.
 
-	std::map <OGSS_Ushort, std::vector <OGSS_Ushort>>
-								_redirection;		//!< Redirection vector.
-	std::map <OGSS_Ushort, std::pair <OGSS_Real, OGSS_Real>>
+	std::vector <std::vector <OGSS_Ushort>>
+								_redirection;		//!< Redirection vectors, empty if none.
+	std::vector <OGSS_Ushort>	_redirectedDevices;	//!< Sorted devices which own a redirection vector.
+	std::vector <OGSS_DeviceMask>
+								_hosted;			//!< Logical devices hosted by each device.
+	std::vector <OGSS_Ushort>	_spareUse;			//!< Number of redirections on each spare area.
+	OGSS_DeviceMask				_eventDevices;		//!< Devices which received an event.
+	std::vector <std::pair <OGSS_Real, OGSS_Real>>
 								_eventTimes;		//!< Event arrival dates.
-	std::map <OGSS_Ulong, OGSS_DeviceState>
+	std::vector <OGSS_DeviceState>
 								_deviceState;		//!< Devices state.
 };
 
@@ -30,8 +30,24 @@
 /* HEADERS -------------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+#include <algorithm>
+#include <bitset>
+#include <map>
+#include <vector>
+
 #include "structure/types.hpp"
 
+/*----------------------------------------------------------------------------*/
+/* CONSTANT VALUES -----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+const OGSS_Ushort						OGSS_MAXVOLUMEDEVICES = 256;
+	//!< Maximum number of devices in a volume.
+
+//! \brief	Bitmask of the devices of a volume, one bit by local device index.
+typedef std::bitset <OGSS_MAXVOLUMEDEVICES>
+										OGSS_DeviceMask;
+
 /*----------------------------------------------------------------------------*/
 /* STRUCTURE -----------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
@@ -64,6 +80,115 @@ struct OGSS_DeviceState {
 	OGSS_Real							_renewalDate {OGSS_REAL_MAX};	//!< Device renewal date (max if no renewal.
 };
 
+//! \brief	Failure state of the devices of a volume, used by the volume
+//!			controllers during the decomposition. The failures are stored in
+//!			a timeline sorted by increasing date, and the ones which happened
+//!			before the date of the current request are set in a bitmask. The
+//!			bitmask follows the request date in both directions, so a request
+//!			dated before an earlier one (e.g. a held write) sees the devices
+//!			as they were at its own date.
+struct OGSS_FailureTimeline {
+
+//! \brief	Add a failure to the timeline. A device only keeps its earliest
+//!			failure, as it is failed from this date on.
+//! \param	device						Local device index.
+//! \param	date						Failure date.
+	inline void schedule (OGSS_Ushort device, OGSS_Real date);
+
+//! \brief	Update the bitmask to the failures which happened before a given
+//!			date. The dates usually increase, so it is amortized constant.
+//! \param	clock						Request date.
+	inline void update (OGSS_Real clock);
+
+//! \brief	Check if a device is failed at the date of the last update.
+//! \param	device						Local device index.
+//! \return								TRUE if the device is failed.
+	inline OGSS_Bool isFailed (OGSS_Ulong device) const
+		{ return _failed [device]; }
+
+//! \brief	Getter of the number of failed devices.
+//! \return								Number of failed devices.
+	inline OGSS_Ulong numFailed () const
+		{ return _failed.count (); }
+
+	OGSS_DeviceMask						_failed;		//!< Failed devices.
+	std::vector <std::pair <OGSS_Real, OGSS_Ushort>>
+										_timeline;		//!< All failures.
+	OGSS_Ulong							_numPassed {0};	//!< Number of failures
+														//!< in the bitmask.
+};
+
+//! \brief	Dispatch order of the requests taken from the command queues of
+//!			the devices (see CommandQueue), used during the synchronization
+//!			step. A device serves its queued requests in this order: a request
+//!			which reaches the device while one dispatched before it is not
+//!			received yet, or is still awaited, is parked until its service.
+//!			The requests which wait for the prior requests of their parent
+//!			are not awaited, as these can be parked behind them; the requests
+//!			which did not go through a queue are served at once.
+struct OGSS_DispatchOrder {
+
+//! \brief	Set the number of devices.
+//! \param	numDevices					Number of devices.
+	inline void resize (OGSS_Ulong numDevices);
+
+//! \brief	Add a queued request once its row is known.
+//! \param	device						Device index.
+//! \param	rank						Rank in the dispatch order (max if not queued).
+//! \param	row							Row of the request.
+//! \param	awaited						TRUE if the request does not wait for
+//!										other ones to reach the device.
+	inline void add (OGSS_Ulong device, OGSS_Ulong rank, OGSS_Ulong row,
+		OGSS_Bool awaited);
+
+//! \brief	Check if a request which reaches its device can be served, ie. the
+//!			requests dispatched before it are all served or not awaited.
+//! \param	device						Device index.
+//! \param	rank						Rank in the dispatch order.
+//! \return								TRUE if the request is served.
+	inline OGSS_Bool isNext (OGSS_Ulong device, OGSS_Ulong rank) const;
+
+//! \brief	Park a request until the ones dispatched before it are served.
+//! \param	device						Device index.
+//! \param	rank						Rank in the dispatch order.
+	inline void park (OGSS_Ulong device, OGSS_Ulong rank);
+
+//! \brief	Mark a request as served, and release the next parked one if its
+//!			turn has come.
+//! \param	device						Device index.
+//! \param	rank						Rank in the dispatch order.
+//! \return								Row of the released request (max if none).
+	inline OGSS_Ulong serve (OGSS_Ulong device, OGSS_Ulong rank);
+
+//! \brief	Release the next parked request of a device if its turn has come.
+//!			The caller serves it, then marks it as served.
+//! \param	device						Device index.
+//! \return								Row of the released request (max if none).
+	inline OGSS_Ulong release (OGSS_Ulong device);
+
+//! \brief	Shift the rows after the first ones are removed. The removed
+//!			rows are all served.
+//! \param	num							Number of removed rows.
+	inline void shift (OGSS_Ulong num);
+
+//! \brief	Queued request, kept until the ones dispatched before it are
+//!			served.
+	struct Entry {
+		OGSS_Ulong						_row;			//!< Row of the request.
+		OGSS_Bool						_awaited;		//!< TRUE if it is awaited.
+		OGSS_Bool						_parked;		//!< TRUE if it is parked.
+		OGSS_Bool						_served;		//!< TRUE if it is served.
+	};
+
+	std::vector <std::map <OGSS_Ulong, Entry>>
+										_queued;		//!< Queued requests,
+														//!< by device and rank.
+	std::vector <OGSS_Ulong>			_numServed;		//!< Number of first ranks
+														//!< served, by device.
+	std::vector <OGSS_Ulong>			_numParked;		//!< Number of parked
+														//!< requests, by device.
+};
+
 /*----------------------------------------------------------------------------*/
 /* INLINE FUNCTIONS ----------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
@@ -92,4 +217,136 @@ OGSS_DeviceState::isRenewed (
 	OGSS_Real							clock)
 	{ return _renewalDate <= clock; }
 
+void
+OGSS_FailureTimeline::schedule (
+	OGSS_Ushort							device,
+	OGSS_Real							date) {
+	auto								elt {std::make_pair (date, device)};
+	auto								prev {std::find_if (_timeline.begin (),
+		_timeline.end (), [device] (const std::pair <OGSS_Real, OGSS_Ushort> & f)
+		{ return f.second == device; })};
+
+	if (prev != _timeline.end () ) {
+		if (prev->first <= date) return;
+		if (OGSS_Ulong (prev - _timeline.begin () ) < _numPassed) {
+			-- _numPassed;
+			_failed.reset (device);
+		}
+		_timeline.erase (prev);
+	}
+
+	auto								pos {std::upper_bound (_timeline.begin (),
+		_timeline.end (), elt)};
+
+	if (OGSS_Ulong (pos - _timeline.begin () ) < _numPassed) {
+		++ _numPassed;
+		_failed.set (device);
+	}
+	_timeline.insert (pos, elt);
+}
+
+void
+OGSS_FailureTimeline::update (
+	OGSS_Real							clock) {
+	while (_numPassed < _timeline.size ()
+		&& _timeline [_numPassed] .first <= clock)
+		_failed.set (_timeline [_numPassed ++] .second);
+
+	while (_numPassed && _timeline [_numPassed - 1] .first > clock)
+		_failed.reset (_timeline [-- _numPassed] .second);
+}
+
+void
+OGSS_DispatchOrder::resize (
+	OGSS_Ulong							numDevices) {
+	_queued.resize (numDevices);
+	_numServed.resize (numDevices, 0);
+	_numParked.resize (numDevices, 0);
+}
+
+void
+OGSS_DispatchOrder::add (
+	OGSS_Ulong							device,
+	OGSS_Ulong							rank,
+	OGSS_Ulong							row,
+	OGSS_Bool							awaited) {
+	if (rank != OGSS_ULONG_MAX)
+		_queued [device] [rank] = {row, awaited, false, false};
+}
+
+OGSS_Bool
+OGSS_DispatchOrder::isNext (
+	OGSS_Ulong							device,
+	OGSS_Ulong							rank) const {
+	OGSS_Ulong							expected {_numServed [device]};
+
+	if (rank == OGSS_ULONG_MAX) return true;
+
+	// A missing rank is a request which is not received yet
+	for (auto & elt: _queued [device]) {
+		if (elt.first != expected ++) return false;
+		if (elt.first == rank) return true;
+		if (! elt.second._served && (elt.second._awaited || elt.second._parked) )
+			return false;
+	}
+
+	return false;
+}
+
+void
+OGSS_DispatchOrder::park (
+	OGSS_Ulong							device,
+	OGSS_Ulong							rank) {
+	_queued [device] [rank] ._parked = true;
+	++ _numParked [device];
+}
+
+OGSS_Ulong
+OGSS_DispatchOrder::serve (
+	OGSS_Ulong							device,
+	OGSS_Ulong							rank) {
+	auto								& queue = _queued [device];
+
+	if (rank == OGSS_ULONG_MAX) return OGSS_ULONG_MAX;
+
+	queue [rank] ._served = true;
+
+	while (! queue.empty () && queue.begin () ->first == _numServed [device]
+		&& queue.begin () ->second._served) {
+		queue.erase (queue.begin () );
+		++ _numServed [device];
+	}
+
+	return release (device);
+}
+
+OGSS_Ulong
+OGSS_DispatchOrder::release (
+	OGSS_Ulong							device) {
+	OGSS_Ulong							expected {_numServed [device]};
+
+	if (! _numParked [device]) return OGSS_ULONG_MAX;
+
+	for (auto & elt: _queued [device]) {
+		if (elt.first != expected ++) break;
+		if (elt.second._served) continue;
+		if (elt.second._parked) {
+			elt.second._parked = false;
+			-- _numParked [device];
+			return elt.second._row;
+		}
+		if (elt.second._awaited) break;
+	}
+
+	return OGSS_ULONG_MAX;
+}
+
+void
+OGSS_DispatchOrder::shift (
+	OGSS_Ulong							num) {
+	for (auto & queue: _queued)
+		for (auto & elt: queue)
+			if (! elt.second._served) elt.second._row -= num;
+}
+
 #endif
@@ -80,12 +80,15 @@ struct Volume {
 	OGSS_Ushort					_parent;			//!< Parent tier index.
 	OGSS_VolumeType				_type;				//!< Layout type.
 	OGSS_Ulong					_interface;			//!< Interface between the volume and the devices.
-	OGSS_Ulong					_bufferSize;		//!< Buffer size.
+	OGSS_Ulong					_bufferSize;		//!< Buffer size (volume cache).
+	OGSS_CachePolicy			_cachePolicy;		//!< Volume cache write policy.
+	OGSS_Real					_coalescingWindow;	//!< Write coalescing window (0 if off).
 	OGSS_Ulong					_suSize;			//!< Stripe unit size.
 	OGSS_Ushort					_numDevices;		//!< Number of devices.
 	OGSS_Ushort					_numRedundancyDevices;	//!< Number of devices used for redundancy.
 	OGSS_Ushort					_numSubVolumes;		//!< Number of subdevices (for Declustered RAID).
 	OGSS_DeclusteringType		_declustering;		//!< Declustering (off, parity, data)
+	OGSS_Bool					_rangeDecomposition;	//!< TRUE to decompose the full stripes by device range.
 	OGSS_DRDType				_decraidScheme;		//!< Declustered RAID scheme.
 	OGSS_Bool					_isSubVolume;		//!< TRUE if a subvolume of a declustered RAID.
 
@@ -144,11 +147,22 @@ struct SSDParameters {
 	OGSS_TranslationType		_algTrns;			//!< Translation algorithm.
 	OGSS_WearLevellingType		_algWL;				//!< Wear leveling algorithm.
 	OGSS_GarbageCollectionType	_algGC;				//!< Garbage collection algorithm.
+	OGSS_Real					_overProvisioning;	//!< Share of the blocks kept as spare
+													//!< by the page-mapped translation.
+
+	static constexpr OGSS_Ulong	_kMinSpareBlocks = 3;	//!< Lowest number of spare blocks,
+													//!< one more than the reserve of the
+													//!< garbage collection.
 
 //! \brief	Apply a data unit (time/memory) to the structure.
 //! \param	du					Data unit to apply.
 	void applyDataUnit (
 		const OGSS_DataUnit		du);
+
+//! \brief	Get the number of spare blocks of the page-mapped translation,
+//!			which are not exported by the device.
+//! \return						Number of spare blocks.
+	OGSS_Ulong numSpareBlocks () const;
 };
 
 //! \brief	Contains NVRAM-device parameters.
@@ -157,8 +171,11 @@ struct NVRAMParameters{
 	OGSS_Real					_bytesPerCol;		//!< Bytes per column.
 	OGSS_Ulong					_rows;				//!< Number of rows.
 	OGSS_Ulong					_cols;				//!< Number of columns.
+	OGSS_Ulong					_nbBanks;			//!< Number of banks by chip.
 	OGSS_Real					_read;				//!< Read access time.
 	OGSS_Real					_write;				//!< Write access time.
+	OGSS_Real					_activation;		//!< Row activation time, included
+													//!< in the access times.
 
 //! \brief	Apply a data unit (time/memory) to the structure.
 //! \param	du					Data unit to apply.
@@ -182,6 +199,11 @@ struct Device {
 	OGSS_Real					_busyTime;			//!< Device busy time.
 	OGSS_Ulong					_physicalCapacity;	//!< Device capacity.
 	OGSS_Ulong					_bufferSize;		//!< Buffer size.
+	OGSS_Ulong					_queueDepth {1};	//!< Command queue depth.
+	OGSS_SchedulingType			_scheduling {SCH_FIFO};	//!< Command queue scheduling.
+	OGSS_Ulong					_numSegments {0};	//!< Number of buffer segments (0 if
+													//!< the buffer is not used).
+	OGSS_CachePolicy			_writeCache {CCP_WRITETHROUGH};	//!< Buffer write policy.
 
 //! \brief	Apply a data unit (time/memory) to the structure.
 //! \param	du					Data unit to apply.
@@ -200,4 +222,44 @@ struct Interface {
 		const OGSS_DataUnit		du);
 };
 
+//! \brief	I/O path of a device, from the host to the device. It holds the
+//!			reciprocal bandwidths of the interfaces used by its requests,
+//!			the interfaces and the parents of the device, in a compact
+//!			record (40 bytes).
+struct OGSS_DevicePath {
+	OGSS_Real					_hostCost;			//!< Reciprocal bandwidth of the
+													//!< host interface.
+	OGSS_Real					_tierCost;			//!< Reciprocal bandwidth of the
+													//!< tier interface.
+	OGSS_Real					_volumeCost;		//!< Reciprocal bandwidth of the
+													//!< volume interface.
+	OGSS_Ushort					_hostInterface;		//!< Interface between the host
+													//!< and the tiers.
+	OGSS_Ushort					_tierInterface;		//!< Interface between the tier
+													//!< and the volumes.
+	OGSS_Ushort					_volumeInterface;	//!< Interface between the volume
+													//!< and the devices.
+	OGSS_Ushort					_tier;				//!< Tier of the device.
+	OGSS_Ushort					_volume;			//!< Volume of the device.
+};
+
+/*----------------------------------------------------------------------------*/
+/* FUNCTIONS -----------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Resolve once the I/O path of each device.
+//! \param	params				Hardware parameters.
+//! \param	tiers				Tiers.
+//! \param	vols				Volumes.
+//! \param	devs				Devices.
+//! \param	intfs				Interfaces, the costs of the unknown ones are
+//!								null.
+//! \return						Path of each device.
+std::vector <OGSS_DevicePath> createDevicePaths (
+	const HardwareParameters	& params,
+	const std::vector <Tier>	& tiers,
+	const std::vector <Volume>	& vols,
+	const std::vector <Device>	& devs,
+	const std::vector <Interface>	& intfs);
+
 #endif
@@ -148,6 +148,14 @@ struct Request {
 	OGSS_RequestOperation		_operation;			//!< Requested operation
 													//!< following an event.
 	OGSS_Bool					_prio {false};		//!< TRUE if happened before others.
+	OGSS_Bool					_cached {false};	//!< TRUE if served by the volume cache.
+	OGSS_Bool					_internal {false};	//!< TRUE if generated by the device
+													//!< controller, not synchronized.
+	OGSS_Bool					_split {false};		//!< TRUE if the device controller split
+													//!< the request into internal ones.
+	OGSS_Ulong					_dispatchIdx {OGSS_ULONG_MAX};	//!< Rank in the dispatch
+													//!< order of the device command
+													//!< queue (max if not queued).
 };
 
 //! \brief	Structure for an on-the-fly request, used during the reconstruction.
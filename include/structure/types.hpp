@@ -56,11 +56,15 @@ typedef	std::string				OGSS_String;		//!< String.
 
 //! \brief	Module type.
 enum OGSS_ModuleType {
+	MTP_COMMANDQUEUE,
 	MTP_COMMUNICATION,
 	MTP_COMMUNICATIONZMQ,
+	MTP_COMPHDD,
+	MTP_COMPNVRAM,
 	MTP_COMPUTATIONBUSADV,
 	MTP_DECRAIDCTRL,
 	MTP_DEVICE,
+	MTP_DEVICECACHE,
 	MTP_EVALUATION,
 	MTP_EVENT,
 	MTP_EXECUTION,
@@ -72,11 +76,13 @@ enum OGSS_ModuleType {
 	MTP_PREPROCESSING,
 	MTP_RAWPARSER,
 	MTP_SSDALLOCDEFAULT,
+	MTP_SSDCTRL,
 	MTP_SYNCDEFV2,
 	MTP_SYNCDEFV3,
 	MTP_SYNCHRONIZATION,
 	MTP_SYNCPAR,
 	MTP_SYNCQUEUE,
+	MTP_VOLFIXEDPARITY,
 	MTP_VOLJBOD,
 	MTP_VOLRAID01,
 	MTP_VOLRAID1,
@@ -114,9 +120,9 @@ enum OGSS_CommType {
 
 //! \brief	Parameter type, used for XML file parsing.
 enum OGSS_ParamType {
-	PTP_ADDRESS, PTP_AGRSK, PTP_AGWSK, PTP_ARG1, PTP_ARG2, PTP_ARG3,
-	PTP_BANDWIDTH, PTP_BLKDIE, PTP_BUFSIZE, PTP_BUS, PTP_BUSES, PTP_BYTESPERCOL,
-	PTP_COLS, PTP_COMM, PTP_COMPUTATION, PTP_CONFIG, PTP_CONTROLLER,
+	PTP_ACTIVATION, PTP_ADDRESS, PTP_AGRSK, PTP_AGWSK, PTP_ARG1, PTP_ARG2, PTP_ARG3,
+	PTP_BANDWIDTH, PTP_BATCHSIZE, PTP_BATCHWINDOW, PTP_BLKDIE, PTP_BUFSIZE, PTP_BUS, PTP_BUSES, PTP_BYTESPERCOL,
+	PTP_CACHE, PTP_COALESCING, PTP_COLS, PTP_COMM, PTP_COMPUTATION, PTP_CONFIG, PTP_CONTROLLER,
 	PTP_DATAUNIT, PTP_DATAUNITS, PTP_DATE, PTP_DECL, PTP_DEFRAGMENTATION,
 	PTP_DEVICE, PTP_DUNAME,
 	PTP_ENTRY, PTP_ERASE, PTP_EVENT,
@@ -125,19 +131,23 @@ enum OGSS_ParamType {
 	PTP_HDD,
 	PTP_INPUT, PTP_INTERFACE, PTP_IOPS,
 	PTP_MEMORY, PTP_MNRSK, PTP_MNWSK, PTP_MTTF, PTP_MXRSK, PTP_MXWSK,
-	PTP_NAME, PTP_NBCHIPS, PTP_NBDEV, PTP_NBDIE, PTP_NBERASE, PTP_NBPAR,
+	PTP_NAME, PTP_NBBANKS, PTP_NBCHIPS, PTP_NBDEV, PTP_NBDIE, PTP_NBERASE, PTP_NBPAR,
 	PTP_NBPLT, PTP_NBSPARE, PTP_NBSUBVOL, PTP_NVRAM,
-	PTP_OGMD, PTP_ON, PTP_OUTPUT,
+	PTP_OGMD, PTP_ON, PTP_ONLINE, PTP_OUTPUT, PTP_OVERPROV,
 	PTP_PAGBLK, PTP_PAGESIZE, PTP_PATH, PTP_PERF, PTP_PORT, PTP_PROTOCOL,
-	PTP_READ, PTP_RELIABILITY, PTP_RNDR, PTP_RNDW, PTP_ROTSPD, PTP_ROWS,
+	PTP_QUEUEDEPTH,
+	PTP_RANGES, PTP_READ, PTP_RELIABILITY, PTP_RETIRE, PTP_RNDR, PTP_RNDW, PTP_ROTSPD, PTP_ROWS,
 	PTP_RULES,
-	PTP_SCHEME, PTP_SECSIZE, PTP_SECTRK, PTP_SEQR, PTP_SEQW, PTP_SIZE, PTP_SSD,
-	PTP_SUBVOL, PTP_SUSIZE, PTP_SYSTEM, PTP_SYNC,
+	PTP_SCHEDULING,
+	PTP_SCHEME, PTP_SECSIZE, PTP_SECTRK, PTP_SEGMENTS, PTP_SEQR, PTP_SEQW,
+	PTP_SHARDS, PTP_SIZE,
+	PTP_SSD,
+	PTP_SUBVOL, PTP_SUSIZE, PTP_SYSTEM, PTP_SYNC, PTP_SYNCSHARDS,
 	PTP_TARGET, PTP_TIER, PTP_TIME, PTP_TRANSLATION,
 	PTP_TRKPLT, PTP_TSFRATE, PTP_TYPE,
 	PTP_UNIT, PTP_UTEST,
 	PTP_VOLUME,
-	PTP_WAIT, PTP_WEARLEVELLING, PTP_WORKLOAD, PTP_WRITE,
+	PTP_WAIT, PTP_WEARLEVELLING, PTP_WORKLOAD, PTP_WRITE, PTP_WRITECACHE,
 	PTP_TOTAL,
 };
 
@@ -161,6 +171,16 @@ enum OGSS_DeclusteringType {
 	DCL_TOTAL
 };
 
+//! \brief	Write policy of the volume cache:
+//!			- Write-back - a write is acknowledged by the cache, the dirty
+//!			  data are written on the devices when evicted
+//!			- Write-through - a write is also sent to the devices
+enum OGSS_CachePolicy {
+	CCP_WRITEBACK,
+	CCP_WRITETHROUGH,
+	CCP_TOTAL
+};
+
 //! \brief	Device types which are handled per OGSSim.
 enum OGSS_DeviceType {
 	DTP_HDD,
@@ -194,6 +214,7 @@ enum OGSS_MaintenanceOutcode {
 enum OGSS_TranslationType {
 	TRS_DEFAULT,
 	TRS_SSDNAIVE,
+	TRS_SSDPAGEMAP,
 	TRS_TOTAL
 };
 
@@ -206,30 +227,46 @@ enum OGSS_DefragmentationType {
 //! \brief	Wear levelling algorithm type.
 enum OGSS_WearLevellingType {
 	WRL_DEFAULT,
+	WRL_STATIC,
 	WRL_TOTAL
 };
 
 //! \brief	Garbage collection algorithm type.
 enum OGSS_GarbageCollectionType {
 	GCL_DEFAULT,
+	GCL_GREEDY,
+	GCL_COSTBENEFIT,
 	GCL_TOTAL
 };
 
+//! \brief	Device command queue scheduling type.
+enum OGSS_SchedulingType {
+	SCH_FIFO,
+	SCH_SSTF,
+	SCH_SCAN,
+	SCH_SPTF,
+	SCH_TOTAL
+};
+
 //! \brief	HDD computation model type.
 enum OGSS_HDDComputationType {
 	HCP_DEFAULT,
+	HCP_ROTATIONAL,
+	HCP_TABLE,
 	HCP_TOTAL
 };
 
 //! \brief	SSD computation model type.
 enum OGSS_SSDComputationType {
 	SCP_DEFAULT,
+	SCP_TABLE,
 	SCP_TOTAL
 };
 
 //! \brief	NVRAM computation model type.
 enum OGSS_NVRAMComputationType {
 	NCP_DEFAULT,
+	NCP_BANKED,
 	NCP_TOTAL
 };
 
@@ -243,6 +280,7 @@ enum OGSS_InterfaceComputationType {
 enum OGSS_SynchronizationType {
 	SNC_DEFAULT,
 	SNC_DEFV2,
+	SNC_DEFV2HEAP,
 	SNC_DEFV3,
 	SNC_DEFV3OTF,
 	SNC_DEFV4OTF,
@@ -457,11 +495,15 @@ const std::vector <OGSS_SynchronizationType>
 //! \brief	Map between a module type and its name.
 const std::map <OGSS_ModuleType, OGSS_String>
 								ModuleNameMap = {
+	{MTP_COMMANDQUEUE,			"CommandQueue"},
 	{MTP_COMMUNICATION,			"CommunicationManager"},
 	{MTP_COMMUNICATIONZMQ,		"CommunicationManagerZMQ"},
+	{MTP_COMPHDD,				"HDDComputation"},
+	{MTP_COMPNVRAM,				"NVRAMComputation"},
 	{MTP_COMPUTATIONBUSADV,		"ComputationModelBusAdvanced"},
 	{MTP_DECRAIDCTRL,			"DecRAIDVolCtrl"},
 	{MTP_DEVICE,				"Device"},
+	{MTP_DEVICECACHE,			"DeviceCache"},
 	{MTP_EVALUATION,			"Evaluation"},
 	{MTP_EVENT,					"Event"},
 	{MTP_EXECUTION,				"Execution"},
@@ -473,11 +515,13 @@ const std::map <OGSS_ModuleType, OGSS_String>
 	{MTP_PREPROCESSING,			"Preprocessing"},
 	{MTP_RAWPARSER,				"RawParser"},
 	{MTP_SSDALLOCDEFAULT,		"SSDAllocDefault"},
+	{MTP_SSDCTRL,				"SSDController"},
 	{MTP_SYNCDEFV2,				"SyncDefV2"},
 	{MTP_SYNCDEFV3,				"SyncDefV3"},
 	{MTP_SYNCHRONIZATION,		"Synchronization"},
 	{MTP_SYNCPAR,				"SyncParallel"},
 	{MTP_SYNCQUEUE,				"SyncQueue"},
+	{MTP_VOLFIXEDPARITY,		"FixedParityController"},
 	{MTP_VOLJBOD,				"JBODController"},
 	{MTP_VOLRAID01,				"RAID01Controller"},
 	{MTP_VOLRAID1,				"RAID1Controller"},
@@ -515,6 +559,7 @@ const std::map <OGSS_CommType, OGSS_String>
 //! \brief	Map between a parameter type and its name.
 const std::map <OGSS_ParamType, OGSS_String>
 								ParamNameMap = {
+	{PTP_ACTIVATION,			"activation"},
 	{PTP_ADDRESS,				"address"},
 	{PTP_AGRSK,					"avgrseek"},
 	{PTP_AGWSK,					"avgwseek"},
@@ -522,12 +567,17 @@ const std::map <OGSS_ParamType, OGSS_String>
 	{PTP_ARG2,					"arg2"},
 	{PTP_ARG3,					"arg3"},
 	{PTP_BANDWIDTH,				"bandwidth"},
+	{PTP_BATCHSIZE,				"batchsize"},
+	{PTP_BATCHWINDOW,			"batchwindow"},
 	{PTP_BLKDIE,				"blocksperdie"},
 	{PTP_BUFSIZE,				"buffersize"},
 	{PTP_BUS,					"bus"},
 	{PTP_BUSES,					"buses"},
 	{PTP_BYTESPERCOL,			"bytespercol"},
+	{PTP_CACHE,					"cache"},
+	{PTP_NBBANKS,				"nbbanks"},
 	{PTP_NBCHIPS,				"nbchips"},
+	{PTP_COALESCING,			"coalescing"},
 	{PTP_COLS,					"columns"},
 	{PTP_COMM,					"communication"},
 	{PTP_COMPUTATION,			"computation"},
@@ -569,31 +619,40 @@ const std::map <OGSS_ParamType, OGSS_String>
 	{PTP_NVRAM,					"nvram"},
 	{PTP_OGMD,					"ogmdsim"},
 	{PTP_ON,					"on"},
+	{PTP_ONLINE,				"online"},
 	{PTP_OUTPUT,				"output"},
+	{PTP_OVERPROV,				"overprovisioning"},
 	{PTP_PAGBLK,				"pagesperblock"},
 	{PTP_PAGESIZE,				"pagesize"},
 	{PTP_PATH,					"path"},
 	{PTP_PERF,					"performance"},
 	{PTP_PORT,					"port"},
 	{PTP_PROTOCOL,				"protocol"},
+	{PTP_QUEUEDEPTH,			"queuedepth"},
+	{PTP_RANGES,				"ranges"},
 	{PTP_READ,					"read"},
 	{PTP_RELIABILITY,			"reliability"},
+	{PTP_RETIRE,				"retire"},
 	{PTP_RNDR,					"randread"},
 	{PTP_RNDW,					"randwrite"},
 	{PTP_ROWS,					"rows"},
 	{PTP_ROTSPD,				"rotspeed"},
 	{PTP_RULES,					"rules"},
+	{PTP_SCHEDULING,			"scheduling"},
 	{PTP_SCHEME,				"scheme"},
 	{PTP_SECSIZE,				"sectorsize"},
 	{PTP_SECTRK,				"sectorspertrack"},
+	{PTP_SEGMENTS,				"segments"},
 	{PTP_SEQR,					"seqread"},
 	{PTP_SEQW,					"seqwrite"},
+	{PTP_SHARDS,				"shards"},
 	{PTP_SIZE,					"size"},
 	{PTP_SSD,					"ssd"},
 	{PTP_SUBVOL,				"subvol"},
 	{PTP_SUSIZE,				"susize"},
 	{PTP_SYSTEM,				"system"},
 	{PTP_SYNC,					"synchronization"},
+	{PTP_SYNCSHARDS,			"syncshards"},
 	{PTP_TARGET,				"target"},
 	{PTP_TIER,					"tier"},
 	{PTP_TIME,					"time"},
@@ -608,6 +667,7 @@ const std::map <OGSS_ParamType, OGSS_String>
 	{PTP_WEARLEVELLING,			"wearlevelling"},
 	{PTP_WORKLOAD,				"workload"},
 	{PTP_WRITE,					"write"},
+	{PTP_WRITECACHE,			"writecache"},
 	{PTP_TOTAL,					"und."}
 };
 
@@ -631,6 +691,14 @@ const std::map <OGSS_DeclusteringType, OGSS_String>
 	{DCL_TOTAL,					"und."}
 };
 
+//! \brief	Map between a cache policy and its name.
+const std::map <OGSS_CachePolicy, OGSS_String>
+								CachePolicyNameMap = {
+	{CCP_WRITEBACK,				"writeback"},
+	{CCP_WRITETHROUGH,			"writethrough"},
+	{CCP_TOTAL,					"und."}
+};
+
 
 //! \brief	Map between a device type and its name.
 const std::map <OGSS_DeviceType, OGSS_String>
@@ -655,6 +723,7 @@ const std::map <OGSS_TranslationType, OGSS_String>
 								TranslationNameMap = {
 	{TRS_DEFAULT,				"default"},
 	{TRS_SSDNAIVE,				"ssdnaive"},
+	{TRS_SSDPAGEMAP,			"pagemap"},
 	{TRS_TOTAL,					"und."}
 };
 
@@ -669,6 +738,7 @@ const std::map <OGSS_DefragmentationType, OGSS_String>
 const std::map <OGSS_WearLevellingType, OGSS_String>
 								WearLevellingNameMap = {
 	{WRL_DEFAULT,				"default"},
+	{WRL_STATIC,				"static"},
 	{WRL_TOTAL,					"und."}
 };
 
@@ -676,13 +746,27 @@ const std::map <OGSS_WearLevellingType, OGSS_String>
 const std::map <OGSS_GarbageCollectionType, OGSS_String>
 								GarbageCollectionNameMap = {
 	{GCL_DEFAULT,				"default"},
+	{GCL_GREEDY,				"greedy"},
+	{GCL_COSTBENEFIT,			"costbenefit"},
 	{GCL_TOTAL,					"und."}
 };
 
+//! \brief	Map between a command queue scheduling and its name.
+const std::map <OGSS_SchedulingType, OGSS_String>
+								SchedulingNameMap = {
+	{SCH_FIFO,					"fifo"},
+	{SCH_SSTF,					"sstf"},
+	{SCH_SCAN,					"scan"},
+	{SCH_SPTF,					"sptf"},
+	{SCH_TOTAL,					"und."}
+};
+
 //! \brief	Map between an HDD computation model and its name.
 const std::map <OGSS_HDDComputationType, OGSS_String>
 								HDDComputationNameMap = {
 	{HCP_DEFAULT,				"default"},
+	{HCP_ROTATIONAL,			"rotational"},
+	{HCP_TABLE,					"table"},
 	{HCP_TOTAL,					"und."}
 };
 
@@ -690,6 +774,7 @@ const std::map <OGSS_HDDComputationType, OGSS_String>
 const std::map <OGSS_SSDComputationType, OGSS_String>
 								SSDComputationNameMap = {
 	{SCP_DEFAULT,				"default"},
+	{SCP_TABLE,					"table"},
 	{SCP_TOTAL,					"und."}
 };
 
@@ -697,6 +782,7 @@ const std::map <OGSS_SSDComputationType, OGSS_String>
 const std::map <OGSS_NVRAMComputationType, OGSS_String>
 								NVRAMComputationNameMap = {
 	{NCP_DEFAULT,				"default"},
+	{NCP_BANKED,				"banked"},
 	{NCP_TOTAL,					"und."}
 };
 
@@ -712,6 +798,7 @@ const std::map <OGSS_SynchronizationType, OGSS_String>
 								SynchronizationNameMap = {
 	{SNC_DEFAULT,				"default"},
 	{SNC_DEFV2,					"defv2"},
+	{SNC_DEFV2HEAP,				"defv2heap"},
 	{SNC_DEFV3,					"defv3"},
 	{SNC_DEFV3OTF,				"defv3otf"},
 	{SNC_DEFV4OTF,				"defv4otf"},
@@ -30,13 +30,18 @@
 /*----------------------------------------------------------------------------*/
 
 #include <array>
+#include <deque>
+#include <fstream>
 #include <tuple>
+#include <vector>
 
+#include "structure/devicestate.hpp"
 #include "structure/hardware.hpp"
 #include "structure/requeststat.hpp"
 
 #include "synchronization/synchronizationmodel.hpp"
 #include "serializer/resume.hpp"
+#include "util/unitarytest.hpp"
 
 //! \brief	The version 2 of the default model was the mainly used
 //!			synchronization model. It consists in extracting the useful request
@@ -46,11 +51,38 @@
 //!			array, containing the waiting times ; (3) a counter array to get which
 //!			device/interface the request targets, and other stuff ; (4) and
 //!			finally a shortcut pair, to determine faster the request scheduling.
+//!			The next step is found by scanning the requests in index order from
+//!			the first one which is not done, or from the last step done when it
+//!			left a shortcut to the earlier ones.
+//!			In the heap order, the active requests are kept in a heap by the
+//!			date of their next step instead, and the earliest one is done
+//!			first, the lowest row first. It is not the scan order: when two
+//!			requests share a clock, the results may differ from the ones of
+//!			the scan.
+//!			The arrays are dense tables with one column per field. Each request
+//!			gets a row on its arrival; before the synchronization, the rows are
+//!			sorted so that the children of a request directly follow it.
+//!			In the online mode, the rows of the logical requests are sorted
+//!			as soon as all their children arrived, and the steps are processed
+//!			up to the date of the last laid out logical request: they are laid
+//!			out in index order, which is their date order, so the next ones
+//!			can not come before. A late logical request is kept with a warning
+//!			and waits as the other ones, a child of a laid out one is fatal.
+//!			When the retirement is on, the rows of the first logical requests
+//!			are written to the output file as soon as they are done, and
+//!			removed from the arrays: only the requests in flight are kept.
+//!			It needs the online mode, the batch mode receives all the requests
+//!			before the first step.
+//!			A device serves the requests of its command queue in their
+//!			dispatch order: a request which reaches it before an awaited
+//!			one dispatched earlier is parked until its service.
 //!			The version 4 was made because implementing the on-the-fly
 //!			reconstruction request generation in version 2 would be too
 //!			complicated and time consuming.
 class SyncDefV2: public SynchronizationModel {
-private:
+protected:
+	friend class UT_SyncDefV2;
+
 	enum tabid_t {UND = -1, ARRIVL, TO_TIR, TO_VOL, TO_DEV, SERVCE, FM_DEV,
 		FM_VOL, FM_TIR, TABTOT};
 	enum clkid_t {BUS_HT, BUS_TV, BUS_VD, CLKTOT};
@@ -59,12 +91,22 @@ private:
 	enum pntid_t {IDNEXT, IDPREV, PNTTOT};
 
 	typedef std::tuple <OGSS_Ulong, OGSS_Ulong, OGSS_Ulong>	index_t;
-	typedef std::array <double, TABTOT>						value_t;
-	typedef std::array <int, CNTTOT>						valct_t;
-	typedef std::array <index_t, PNTTOT>					point_t;
-	typedef std::map <index_t, value_t>						table_t;
-	typedef std::map <index_t, valct_t>						tabct_t;
-	typedef	std::map <index_t, point_t>						tabpt_t;
+	typedef std::array <std::vector <double>, TABTOT>		table_t;
+	typedef std::array <std::vector <int>, CNTTOT>			tabct_t;
+	typedef std::array <std::vector <OGSS_Ulong>, PNTTOT>	tabpt_t;
+
+//! \brief	Reception state of a logical request which is not laid out.
+	struct pending_t {
+		double					_date;				//!< Date, once received.
+		OGSS_Long				_majrs;				//!< Number of missing intermediate requests.
+		OGSS_Long				_minrs;				//!< Number of missing physical requests.
+	};
+
+//! \brief	Next step of an active request, ordered by date then by row.
+	struct step_t {
+		double					_date;				//!< Date of the last done step.
+		OGSS_Ulong				_row;				//!< Request row.
+	};
 
 public:
 
@@ -80,6 +122,7 @@ public:
 //! \param	devs				Devices.
 //! \param	intfs				Interfaces.
 //! \param	globalDU			Global data unit.
+//! \param	heapOrder			TRUE to process the steps in the heap order.
 	SyncDefV2 (
 		std::shared_ptr <CommunicationInterface>	ci,
 		HardwareParameters		& params,
@@ -87,7 +130,8 @@ public:
 		std::vector <Volume>	& vols,
 		std::vector <Device>	& devs,
 		std::vector <Interface>	& intfs,
-		OGSS_DataUnit			globalDU);
+		OGSS_DataUnit			globalDU,
+		const OGSS_Bool			heapOrder = false);
 
 //! \brief	Destructor.
 	~SyncDefV2 ();
@@ -98,16 +142,26 @@ public:
 		Request	    			&req);
 
 //! \brief	Construct a request stat structure.
-//! \param	idx					Request index.
+//! \param	row					Request row.
 //! \return						Request stat.
 	RequestStat prepareStat (
-		const index_t			idx);
+		const OGSS_Ulong		row);
 
 //! \brief	Once all the requests are received, start processing the
 //!			synchronization which computes request waiting times by determining
 //!			the correct request scheduling.
 	void process ();
 
+//! \brief	Lay out the logical requests which are complete, and process the
+//!			steps which can not be delayed anymore by the requests to come.
+	void advance ();
+
+//! \brief	Retire the logical requests once done, and stream their rows to
+//!			the detailed output file.
+//! \param	outputFile			Path to the detailed output file.
+	void enableRetirement (
+		const OGSS_String		outputFile);
+
 //! \brief	Generation of the detailed output file.
 //! \param	outputFile			Path to the detailed output file.
 	void createOutputFile (
@@ -118,100 +172,256 @@ public:
 	void createResumeFile (
 		const OGSS_String		resumeFile);
 
-private:
+protected:
 
 /*----------------------------------------------------------------------------*/
 /* PRIVATE FUNCTIONS ---------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+//! \brief	Sort the rows which are not laid out yet by request index, so
+//!			that the children of a request follow it, and link each row to
+//!			its parent. The I/O path of the physical requests is then copied
+//!			to their parents, in the order they arrived, and the rows are
+//!			scheduled. Only the rows of the given logical requests are laid
+//!			out, the other ones wait for the next call.
+//! \param	lastMainIdx			Index of the last logical request to lay out.
+	void _layout (
+		const OGSS_Ulong		lastMainIdx);
+
+//! \brief	Process the next steps, in the scheduling order, up to a given
+//!			date.
+//! \param	horizon				Date of the last step to process.
+	void _run (
+		const double			horizon);
+
+//! \brief	Find the request of the next step: the requests are compared in
+//!			index order, from the restart point or the starter, following the
+//!			shortcuts, until one arrives after the earliest step found. The
+//!			shortcuts found on the way are only kept if the step is processed.
+//!			In the heap order, the request at the top of the heap is taken.
+//! \param	horizon				Date of the last step to process.
+//! \return						Request row, undefined if the next step is
+//!								after the horizon.
+	OGSS_Ulong _findNext (
+		const double			horizon);
+
+//! \brief	Update the restart point once the step of a request is done,
+//!			following the shortcut to the request compared before it.
+//! \param	row					Request row.
+	void _updateShortcuts (
+		const OGSS_Ulong		row);
+
+//! \brief	Process the next step of a request: its result is computed from
+//!			the clock of the interface it uses, then its parent or children
+//!			are updated.
+//! \param	row					Request row.
+//! \param	nbComputations		Remaining number of computations.
+	void _step (
+		const OGSS_Ulong		row,
+		OGSS_Ulong				& nbComputations);
+
+//! \brief	Write the rows of the first logical requests which are done,
+//!			in row order, and remove them from the arrays once they are
+//!			the larger part of them. The shortcuts to the removed rows keep
+//!			the date of their step, which is done.
+	void _retireRows ();
+
+//! \brief	Write the header of an output file section.
+//! \param	output				Output stream.
+	void _printHeader (
+		std::ostream			& output);
+
+//! \brief	Write the results of a row in the output file.
+//! \param	output				Output stream.
+//! \param	row					Request row.
+	void _printResults (
+		std::ostream			& output,
+		const OGSS_Ulong		row);
+
+//! \brief	Write the data of a row in the output file.
+//! \param	output				Output stream.
+//! \param	row					Request row.
+	void _printData (
+		std::ostream			& output,
+		const OGSS_Ulong		row);
+
 //! \brief	Compute the waiting time from the host to the tier.
-//! \param	minCursor			Current index.
-//! \param	tmp					Result value of the current index.
-//! \param	idx					Counter value of the current index.
+//! \param	row					Current row.
 //! \param	nbComputations		Remaining number of computations.
 	void _processToTier (
-		index_t					& minCursor,
-		value_t					& tmp,
-		valct_t					& idx,
+		const OGSS_Ulong		row,
 		OGSS_Ulong				& nbComputations);
 
 //! \brief	Compute the waiting time from the tier to the volume.
-//! \param	minCursor			Current index.
-//! \param	tmp					Result value of the current index.
-//! \param	idx					Counter value of the current index.
+//! \param	row					Current row.
 //! \param	nbComputations		Remaining number of computations.
 	void _processToVolume (
-		index_t					& minCursor,
-		value_t					& tmp,
-		valct_t					& idx,
+		const OGSS_Ulong		row,
 		OGSS_Ulong				& nbComputations);
 
-//! \brief	Compute the waiting time from the volume to the device.
-//! \param	minCursor			Current index.
-//! \param	tmp					Result value of the current index.
-//! \param	idx					Counter value of the current index.
+//! \brief	Compute the waiting time from the volume to the device. A
+//!			request which is not next in the dispatch order is parked, and
+//!			the service of a request releases the parked ones whose turn
+//!			has come.
+//! \param	row					Current row.
 //! \param	nbComputations		Remaining number of computations.
 //! \param	devClocks			Device clocks.
 	void _processToDevice (
-		index_t					& minCursor,
-		value_t					& tmp,
-		valct_t					& idx,
+		const OGSS_Ulong		row,
+		OGSS_Ulong				& nbComputations,
+		std::vector <double>	& devClocks);
+
+//! \brief	Compute the service of a request on its device.
+//! \param	row					Current row.
+//! \param	devClocks			Device clocks.
+	void _serve (
+		const OGSS_Ulong		row,
+		std::vector <double>	& devClocks);
+
+//! \brief	Serve the released requests of a device, each one releasing the
+//!			next parked one in the dispatch order.
+//! \param	row					First released row (max if none).
+//! \param	nbComputations		Remaining number of computations.
+//! \param	devClocks			Device clocks.
+	void _release (
+		OGSS_Ulong				row,
 		OGSS_Ulong				& nbComputations,
 		std::vector <double>	& devClocks);
 
 //! \brief	Compute the waiting time from the device to the volume.
-//! \param	minCursor			Current index.
-//! \param	tmp					Result value of the current index.
-//! \param	idx					Counter value of the current index.
+//! \param	row					Current row.
 //! \param	nbComputations		Remaining number of computations.
 	void _processFromDevice (
-		index_t					& minCursor,
-		value_t					& tmp,
-		valct_t					& idx,
+		const OGSS_Ulong		row,
 		OGSS_Ulong				& nbComputations);
 
 //! \brief	Compute the waiting time from the volume to the tier.
-//! \param	minCursor			Current index.
-//! \param	tmp					Result value of the current index.
-//! \param	idx					Counter value of the current index.
+//! \param	row					Current row.
 //! \param	nbComputations		Remaining number of computations.
 	void _processFromVolume (
-		index_t					& minCursor,
-		value_t					& tmp,
-		valct_t					& idx,
+		const OGSS_Ulong		row,
 		OGSS_Ulong				& nbComputations);
 
 //! \brief	Compute the waiting time from the tier to the host.
-//! \param	minCursor			Current index.
-//! \param	tmp					Result value of the current index.
-//! \param	idx					Counter value of the current index.
-//! \param	nbComputations		Remaining number of computations.
-//! \param	starter				First index to compare.
-//! \param	lastMainIdx			Last main index done.
+//! \param	row					Current row.
 	void _processFromTier (
-		index_t					& minCursor,
-		value_t					& tmp,
-		valct_t					& idx,
-		OGSS_Ulong				& nbComputations,
-		index_t					& starter,
-		OGSS_Ulong				& lastMainIdx);
+		const OGSS_Ulong		row);
+
+//! \brief	Send the stat of a done request, and add it to the resume.
+//! \param	row					Request row.
+	virtual void _emitStat (
+		const OGSS_Ulong		row);
+
+//! \brief	Notify that the step of a request changed. In the scan order,
+//!			the next step is found by a scan, so nothing is done here.
+//! \param	row					Request row.
+	virtual void _schedule (
+		const OGSS_Ulong		row)
+		{ if (_heapOrder) _schedule (_steps, row); }
+
+//! \brief	Update the position of a request in a step heap: the active
+//!			requests are ordered by the date of their last done step, the
+//!			others are removed.
+//! \param	steps				Step heap.
+//! \param	row					Request row.
+	void _schedule (
+		std::vector <step_t>	& steps,
+		const OGSS_Ulong		row);
+
+//! \brief	Remove a request from a step heap, if it is in.
+//! \param	steps				Step heap.
+//! \param	row					Request row.
+	void _unschedule (
+		std::vector <step_t>	& steps,
+		const OGSS_Ulong		row);
+
+//! \brief	Move a step of a heap to its position.
+//! \param	steps				Step heap.
+//! \param	pos					Current position of the step.
+	void _sift (
+		std::vector <step_t>	& steps,
+		OGSS_Ulong				pos);
+
+//! \brief	Put a step at a given position of a heap.
+//! \param	steps				Step heap.
+//! \param	pos					Position.
+//! \param	step				Step.
+	inline void _place (
+		std::vector <step_t>	& steps,
+		const OGSS_Ulong		pos,
+		const step_t			& step)
+		{ steps [pos] = step; _heapPos [step._row] = pos; }
+
+//! \brief	Compare two steps of the heap.
+//! \param	a					First step.
+//! \param	b					Second step.
+//! \return						TRUE if the first step is done before.
+	inline static OGSS_Bool _before (
+		const step_t			& a,
+		const step_t			& b)
+		{ return a._date < b._date || (a._date == b._date && a._row < b._row); }
 
 /*----------------------------------------------------------------------------*/
 /* ATTRIBUTES ----------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+	static constexpr OGSS_Ulong	_kUnd = OGSS_ULONG_MAX;	//!< Undefined row.
+	static constexpr OGSS_Ulong	_kGone = OGSS_ULONG_MAX - 1;	//!< Removed row.
+	static constexpr OGSS_Ulong	_kDrop = 1024;		//!< Minimum number of written rows
+													//!< to remove.
+
 	HardwareParameters			& _hardParam;		//!< Hardware parameters.
 	std::vector <Tier>			& _tiers;			//!< Tiers.
 	std::vector <Volume>		& _volumes;			//!< Volumes.
 	std::vector <Device>		& _devices;			//!< Devices.
 	std::vector <Interface>		& _interfaces;		//!< Interfaces.
+	std::vector <OGSS_DevicePath>	_paths;			//!< I/O path of each device.
 
+	std::vector <index_t>		_index;				//!< Request index of each row.
+	std::vector <OGSS_Ulong>	_parent;			//!< Row of the parent request.
+	std::vector <OGSS_Ulong>	_end;				//!< Row following the last child.
+	std::vector <OGSS_Ulong>	_leaves;			//!< Rows of the physical requests, in arrival order.
 	table_t						_data;				//!< Data used during the synchronization.
 	table_t						_rslt;				//!< Results computed during the synchronization.
 	tabct_t						_cntr;				//!< Counters used during the synchronization.
 	tabpt_t						_idpt;				//!< Shortcuts used during comparison.
-	std::map <index_t, OGSS_Bool>
-								_failedReqs;		//!< Failed requests.
+	std::vector <double>		_prevDate;			//!< Step date of the removed request
+													//!< before the shortcut.
+	std::vector <std::pair <OGSS_Ulong, OGSS_Ulong>>
+								_links;				//!< Shortcuts found by the last scan.
+	OGSS_Ulong					_starter {0};		//!< First row to compare.
+	OGSS_Ulong					_restart {_kUnd};	//!< Row from which the scan restarts.
+	OGSS_Ulong					_checkpoint {_kUnd};//!< Earliest row found before the
+													//!< restart point.
+	double						_checkpointDate;	//!< Step date of the checkpoint, once
+													//!< removed.
+	OGSS_Bool					_heapOrder;			//!< TRUE if the steps are done in
+													//!< the heap order.
+	std::vector <step_t>		_steps;				//!< Heap of the next steps.
+	std::vector <OGSS_Long>		_heapPos;			//!< Heap position of each request,
+													//!< -1 if not in a heap.
+	std::vector <OGSS_Bool>		_failedReqs;		//!< Failed requests.
+	std::vector <OGSS_Bool>		_cachedReqs;		//!< Requests served by the volume cache.
+	std::vector <OGSS_Ulong>	_dispatchIdx;		//!< Rank in the dispatch order of the
+													//!< device (max if not queued).
+	OGSS_DispatchOrder			_dispatch;			//!< Dispatch order of the devices.
+	OGSS_Ulong					_laid {0};			//!< Number of rows laid out.
+	OGSS_Ulong					_nbComputations {0};//!< Remaining number of computations.
+	std::vector <double>		_busClocks;			//!< Interface clocks.
+	std::vector <double>		_devClocks;			//!< Device clocks.
+
+	std::deque <pending_t>		_pending;			//!< Logical requests which are not laid out.
+	OGSS_Ulong					_nextMain {0};		//!< Index of the first logical request
+													//!< which is not laid out.
+	double						_laidDate;			//!< Date of the last laid out logical request.
+	double						_horizon;			//!< Date up to which the steps are processed.
+
+	OGSS_Bool					_retire {false};	//!< TRUE if the done requests are retired.
+	OGSS_Ulong					_retired {0};		//!< Number of first rows which are written.
+	OGSS_Ulong					_numRetired {0};	//!< Number of rows removed from the arrays.
+	std::ofstream				_output;			//!< Detailed output file, for the results.
+	std::ofstream				_outputData;		//!< Temporary file, for the data.
+	OGSS_String					_outputDataFile;	//!< Path to the temporary file.
 
 	Resume 						_resume;			//!< Resume file generator.
 	OGSS_Ulong					_mainRequestsDone;	//!< Number of done user requests.
@@ -219,4 +429,47 @@ private:
 	OGSS_DataUnit				_globalDU;			//!< Global data unit.
 };
 
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+class UT_SyncDefV2:
+public UnitaryTest <UT_SyncDefV2> {
+public:
+	UT_SyncDefV2 (
+		const OGSS_String		& configurationFile);
+	~UT_SyncDefV2 ();
+
+protected:
+	OGSS_Ulong findRow (
+		SyncDefV2				& sync,
+		const OGSS_Ulong		mainIdx,
+		const OGSS_Ulong		majrIdx,
+		const OGSS_Ulong		minrIdx);
+	Request createRequest (
+		const OGSS_Real			date,
+		const OGSS_Ulong		mainIdx,
+		const OGSS_Ulong		majrIdx,
+		const OGSS_Ulong		minrIdx,
+		const OGSS_Ulong		numChild,
+		const OGSS_Ulong		device);
+	OGSS_Bool compareOnline (
+		const std::vector <Request>	& requests,
+		const OGSS_Bool			retire,
+		const OGSS_Bool			heapOrder);
+
+	OGSS_Bool oneRequest ();
+	OGSS_Bool twoRequests ();
+	OGSS_Bool twoRequests_smallLambda ();
+	OGSS_Bool twoRequests_hugeLambda ();
+	OGSS_Bool twoRequests_twoVolumes ();
+	OGSS_Bool threeRequests_RAIDNP ();
+	OGSS_Bool scanOrder ();
+	OGSS_Bool heapOrder ();
+	OGSS_Bool dispatchOrder ();
+	OGSS_Bool onlineVolumes ();
+	OGSS_Bool onlineCoalescing ();
+	OGSS_Bool onlineRetirement ();
+};
+
 #endif
@@ -32,6 +32,7 @@
 #include <array>
 #include <tuple>
 #include <set>
+#include <vector>
 
 #include "serializer/resume.hpp"
 
@@ -55,6 +56,14 @@ typedef std::set <std::pair <Request, OGSS_Bool>, OGSS_Bool (*) (std::pair <Requ
 //!			between host and tier or physical request between volume and
 //!			device). Also, it takes reconstruction requests on-the-fly to
 //!			reduce the memory used and process this step faster.
+//!			The user requests are stored in dense tables with one column per
+//!			field. Each request gets a row on its arrival; before the
+//!			synchronization, the rows are sorted so that the children of a
+//!			request directly follow it.
+//!			When the retirement is on, the rows of the first logical requests
+//!			are removed from the tables as soon as they are done. It does not
+//!			need the online mode: all the requests are received before the
+//!			first step, but the tables shrink during the synchronization.
 class SyncDefV4OTF: public SynchronizationModel {
 private:
 
@@ -65,19 +74,14 @@ private:
 	struct OrderedWaitQueue;
 
 	static OGSS_Bool __stampCompare (
-		std::pair <OGSS_RequestIdx, OGSS_Real>				lhs,
-		std::pair <OGSS_RequestIdx, OGSS_Real>				rhs);
+		std::pair <OGSS_Ulong, OGSS_Real>					lhs,
+		std::pair <OGSS_Ulong, OGSS_Real>					rhs);
 
 	enum tabid_t {UND = -1, ARRIVL, IN, OUT, TABTOT};
 	enum count_t {IDSTEP, IDBUS, START, SYSTEM, REMOVE, CNTTOT};
-	enum pntid_t {IDNEXT, IDPREV, PNTTOT};
 
-	typedef std::array <OGSS_Real, TABTOT>					value_t;
-	typedef std::array <int, CNTTOT>						valct_t;
-	typedef std::array <OGSS_RequestIdx, PNTTOT>			point_t;
-	typedef std::map <OGSS_RequestIdx, value_t>				table_t;
-	typedef std::map <OGSS_RequestIdx, valct_t>				tabct_t;
-	typedef std::map <OGSS_RequestIdx, point_t>				tabpt_t;
+	typedef std::array <std::vector <OGSS_Real>, TABTOT>	table_t;
+	typedef std::array <std::vector <int>, CNTTOT>			tabct_t;
 
 public:
 
@@ -108,16 +112,23 @@ public:
 		Request	    			& req);
 
 //! \brief	Construct a request stat structure.
-//! \param	idx					Request index.
+//! \param	row					Request row.
 //! \return						Request stat.
 	RequestStat prepareStat (
-		const OGSS_RequestIdx	idx);
+		const OGSS_Ulong		row);
 
 //! \brief	Once all the requests are received, start processing the
 //!			synchronization which computes request waiting times by determining
 //!			the correct request scheduling.
 	void process ();
 
+//! \brief	Retire the logical requests once done. This model does not
+//!			generate the detailed output file, so only the tables are
+//!			released.
+//! \param	outputFile			Path to the detailed output file.
+	void enableRetirement (
+		const OGSS_String		outputFile);
+
 //! \brief	Generation of the detailed output file.
 //! \param	outputFile			Path to the detailed output file.
 	void createOutputFile (
@@ -134,36 +145,54 @@ private:
 /* PRIVATE FUNCTIONS ---------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+//! \brief	Sort the rows by request index, so that the children of a
+//!			request follow it, and link each row to its parent. The physical
+//!			request data are then copied to their parents, in the order they
+//!			arrived, and the logical requests are queued.
+	void _layout ();
+
+//! \brief	Skip the first logical requests which are done, and remove them
+//!			from the tables once they are the larger part of them.
+	void _retireRows ();
+
 //! \brief	Determine the next request to process.
-//! \return						Next request index to process.
-	OGSS_RequestIdx _getNextRequest ();
+//! \return						Next request row to process.
+	OGSS_Ulong _getNextRequest ();
 
 //! \brief	Update the clock of each request issued from the same logical parent request.
-//! \param	mainIdx				Logical parent request index.
+//! \param	main				Logical parent request row.
 //! \param	clock				New clock.
 	void _updateRequestClock (
-		const OGSS_Ulong		mainIdx,
+		const OGSS_Ulong		main,
 		const OGSS_Real			clock);
 
 //! \brief	Compute the waiting time from the host to the tier.
-//! \param	idx					Request index.
+//! \param	row					Request row.
 	void _processToTier (
-		const OGSS_RequestIdx	idx);
+		const OGSS_Ulong		row);
 
 //! \brief	Compute the waiting time from the tier to the volume.
-//! \param	idx					Request index.
+//! \param	row					Request row.
 	void _processToVolume (
-		const OGSS_RequestIdx	idx);
+		const OGSS_Ulong		row);
 
 //! \brief	Compute the waiting time from the volume to the device (user request).
-//! \param	idx					Request index.
+//!			A request which is not next in the dispatch order of its device
+//!			is parked until the service of the ones dispatched before it.
+//! \param	row					Request row.
 	void _processUserToDevice (
-		const OGSS_RequestIdx	idx);
+		const OGSS_Ulong		row);
+
+//! \brief	Compute the service of a user request on its device, once it is
+//!			transferred to it.
+//! \param	row					Request row.
+	void _serveUserRequest (
+		const OGSS_Ulong		row);
 
 //! \brief	Compute the waiting time from the device to the volume (user request).
-//! \param	idx					Request index.
+//! \param	row					Request row.
 	void _processUserFromDevice (
-		const OGSS_RequestIdx	idx);
+		const OGSS_Ulong		row);
 
 //! \brief	Compute the waiting time of a system request.-
 //! \param	idx					Request index.
@@ -173,14 +202,14 @@ private:
 		OGSS_Bool						direction);
 
 //! \brief	Compute the waiting time from the volume to the tier.
-//! \param	idx					Request index.
+//! \param	row					Request row.
 	void _processFromVolume (
-		const OGSS_RequestIdx	idx);
+		const OGSS_Ulong		row);
 
 //! \brief	Compute the waiting time from the tier to the host.
-//! \param	idx					Request index.
+//! \param	row					Request row.
 	void _processFromTier (
-		const OGSS_RequestIdx	idx);
+		const OGSS_Ulong		row);
 
 //! \brief	Seek the next system requests to process. If none are found, request
 //!			new ones to the volume drivers.
@@ -211,10 +240,10 @@ private:
 
 //! \brief	Select the user request operation depending on the current state of
 //!			the targeted device.
-//! \param	idx					Request index.
+//! \param	row					Request row.
 //! \param	clock				Current clock.
 	void _selectUserRequestOperation (
-		const OGSS_RequestIdx	idx,
+		const OGSS_Ulong		row,
 		const OGSS_Real			clock);
 
 //! \brief	Update the rebuilt and spared blocks data structures depending on
@@ -237,17 +266,17 @@ private:
 	std::vector <Volume>		& _volumes;			//!< Volumes.
 	std::vector <Device>		& _devices;			//!< Devices.
 
+	std::vector <Request>		_requests;			//!< User requests.
+	std::vector <OGSS_Ulong>	_parent;			//!< Row of the parent request.
+	std::vector <OGSS_Ulong>	_end;				//!< Row following the last child.
+	std::vector <OGSS_Ulong>	_leaves;			//!< Rows of the physical requests, in arrival order.
+	std::vector <OGSS_Ulong>	_mains;				//!< Rows of the logical requests, in arrival order.
+
 	table_t						_data;				//!< Data array.
 	tabct_t						_cntr;				//!< Counter array.
 
 	table_t						_userRslt;			//!< Result array for user requests.
 
-	std::map <OGSS_RequestIdx, OGSS_Bool>
-								_failedReqs;		//!< Failed requests.
-
-	std::map <OGSS_RequestIdx, Request>
-								_userRequests;		//!< User requests.
-
 	std::map <OGSS_Ushort, std::vector <OGSS_RequestIdx>>
 								_evByVolIdx;		//!< Events sorted by their targeted volume index.
 	std::map <OGSS_RequestIdx, Request>
@@ -272,19 +301,13 @@ private:
 	OGSS_Ulong					_nbSystemRequestsGenerated {10000};	//!< Number of requests generated on the fly.
 	OGSS_Ulong					_minOTFRequestSize {1048576}; //!< Size of the generated request.
 
-	OGSS_Ulong					_starter {0};		//!< Starter used during synchronization to know
-													//!< from where we need to start seeking the next
-													//!< request to process
-
-	std::map <OGSS_Ulong, std::pair <OGSS_Real, OGSS_Real>>
-								_requestClock;		//!< Logical request clocks.
+	std::vector <OGSS_Real>		_requestClock;		//!< Logical request clocks.
 
 	OGSS_DataUnit				_globalDU;			//!< Global data unit.
 
-	std::map <OGSS_Ulong, OGSS_Real>
-								_devClocks;			//!< Device clocks.
-	std::map <OGSS_Ulong, OGSS_Real>
-								_busClocks;			//!< Interface clocks.
+	std::vector <OGSS_Real>		_devClocks;			//!< Device clocks.
+	OGSS_DispatchOrder			_dispatch;			//!< Dispatch order of the devices.
+	std::vector <OGSS_Real>		_busClocks;			//!< Interface clocks.
 
 	std::map <OGSS_Ulong, std::vector <OGSS_Bool>>
 								_sparedBlocks;		//!< List of spared blocks.
@@ -302,6 +325,8 @@ private:
 
 	std::vector <OrderedWaitQueue>
 								_busWaitQueue;		//!< Bus waiting queues.
+	OGSS_Bool					_retire {false};	//!< TRUE if the done requests are retired.
+	OGSS_Ulong					_retired {0};		//!< Number of first rows which are done.
 	OGSS_Real					_firstEventDate {OGSS_REAL_MAX};
 													//!< First event date.
 
@@ -57,6 +57,21 @@ public:
 //!			the correct request scheduling.
 	virtual void process () = 0;
 
+//! \brief	Process the requests which can not be delayed anymore by the
+//!			requests to come. It is called after each reception when the
+//!			online synchronization is on; it is rejected at the
+//!			initialization for the models which do not support it.
+	virtual void advance () {  }
+
+//! \brief	Retire the requests as soon as their logical request is done:
+//!			their stats are sent, their output rows are written and their
+//!			entries are released. It is rejected at the initialization
+//!			without the online synchronization, except for the models which
+//!			release their entries during the batch synchronization.
+//! \param	outputFile			Path to the detailed output file.
+	virtual void enableRetirement (
+		const OGSS_String		outputFile) {  }
+
 //! \brief	Send the request stats to the evaluation module.
 //! \param	stat				Request stats.
 	virtual void sendStat (
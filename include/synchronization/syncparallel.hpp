@@ -0,0 +1,261 @@
+/*
+ * Copyright UVSQ - CEA/DAM/DIF (2017-2018)
+ * Contributors:  Sebastien GOUGEAUD  -- sebastien.gougeaud@uvsq.fr
+ *                Soraya ZERTAL       --      soraya.zertal@uvsq.fr
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+//! \file	syncparallel.hpp
+//! \brief	Definition of the parallel model.
+
+#ifndef _OGSS_SYNCPARALLEL_HPP_
+#define _OGSS_SYNCPARALLEL_HPP_
+
+/*----------------------------------------------------------------------------*/
+/* HEADERS -------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "synchronization/syncdefv2.hpp"
+
+//! \brief	Parallel version of the default model (version 2). The devices
+//!			are split in groups which do not share any volume interface, nor
+//!			any intermediate request, and each group is given to a shard. The
+//!			shards process the steps on the devices and on the volume
+//!			interfaces of their group, each on its own thread, while the
+//!			first shard processes the steps on the host and tier interfaces,
+//!			and the devices which share them.
+//!			The shards are synchronized in rounds: the requests which go to
+//!			another shard are exchanged between two rounds, and during a round
+//!			each shard processes its steps up to the earliest date the other
+//!			shards can send a request to it, computed from their next steps
+//!			and their minimum transfer times. The earliest step of all shards
+//!			is always processed, so that a round is never empty.
+//!			The steps of a shard are done earliest first, the lowest row first,
+//!			which is not the scan order of the version 2: when two requests
+//!			share a clock, the results may differ from the ones of the
+//!			version 2. It is the order of the defv2heap model, whatever the
+//!			number of shards.
+//!			The steps on the host and tier interfaces are all done by the
+//!			first shard, one after the other, which bounds the speedup: with
+//!			a fifth of the steps on them, the rounds show a parallelism of
+//!			about 2 with 8 shards. The shard threads sleep between two rounds,
+//!			so each round costs a thread wake up: with short transfer times,
+//!			the rounds are short and the wake ups take the larger part.
+class SyncParallel: public SyncDefV2 {
+protected:
+
+//! \brief	Latest step done before a request, in the step order. A request
+//!			received from another shard comes after the step which sent it.
+	struct stamp_t {
+		step_t					_step;				//!< Latest step done.
+		OGSS_Ulong				_hops;				//!< Number of shards the request
+													//!< went through since.
+	};
+
+//! \brief	Request sent to another shard.
+	struct message_t {
+		OGSS_Ulong				_row;				//!< Request row.
+		OGSS_Ulong				_shard;				//!< Target shard.
+		stamp_t					_stamp;				//!< Latest step done before the
+													//!< request was sent.
+	};
+
+//! \brief	Stat of a done request, waiting for the stats of the previous
+//!			steps of the other shards.
+	struct stat_t {
+		stamp_t					_stamp;				//!< Latest step done before the
+													//!< request was done.
+		RequestStat				_stat;				//!< Request stat.
+	};
+
+//! \brief	Synchronization shard, which owns the clocks of a group of
+//!			devices and of their volume interfaces.
+	struct shard_t {
+		std::vector <step_t>	_steps;				//!< Heap of the next steps.
+		std::vector <message_t>	_inbox;				//!< Requests received from the other shards.
+		std::vector <message_t>	_outbox;			//!< Requests sent to the other shards.
+		std::deque <stat_t>		_stats;				//!< Stats which are not sent yet.
+		std::vector <OGSS_Ulong>	_visit;			//!< Heap positions left to explore.
+		stamp_t					_stamp;				//!< Latest step done.
+		OGSS_Ulong				_nbComputations {0};//!< Remaining number of computations,
+													//!< from the whole number when the
+													//!< rounds start.
+		double					_horizon;			//!< Date up to which the steps are
+													//!< processed during the round.
+		double					_output;			//!< Earliest date of a request sent
+													//!< to another shard.
+		double					_next;				//!< Date of the next step.
+		OGSS_Bool				_forced {false};	//!< TRUE if the next step is
+													//!< processed whatever its date.
+	};
+
+public:
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTIONS ----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Constructor.
+//! \param	ci					Communication interface.
+//! \param	params				Hardware parameters.
+//! \param	tiers				Tiers.
+//! \param	vols				Volumes.
+//! \param	devs				Devices.
+//! \param	intfs				Interfaces.
+//! \param	globalDU			Global data unit.
+//! \param	numShards			Requested number of shards.
+	SyncParallel (
+		std::shared_ptr <CommunicationInterface>	ci,
+		HardwareParameters		& params,
+		std::vector <Tier>		& tiers,
+		std::vector <Volume>	& vols,
+		std::vector <Device>	& devs,
+		std::vector <Interface>	& intfs,
+		OGSS_DataUnit			globalDU,
+		OGSS_Ulong				numShards);
+
+//! \brief	Destructor.
+	~SyncParallel ();
+
+//! \brief	Once all the requests are received, split the devices between
+//!			the shards and process the synchronization in parallel. If only
+//!			one shard is available, its steps are processed on this thread.
+	void process ();
+
+//! \brief	The steps are only processed once all the requests are received.
+	void advance ();
+
+//! \brief	The requests are not retired, all the rows are written once the
+//!			synchronization is done.
+//! \param	outputFile			Path to the detailed output file.
+	void enableRetirement (
+		const OGSS_String		outputFile);
+
+protected:
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Split the devices in groups, so that the devices sharing a
+//!			volume interface or an intermediate request are in the same group,
+//!			then give the groups to the shards, the largest first. The groups
+//!			of the devices behind a host or tier interface go to the first
+//!			shard.
+//! \return						TRUE if at least two shards are used.
+	OGSS_Bool _partition ();
+
+//! \brief	Process the synchronization with one thread per shard.
+	void _runShards ();
+
+//! \brief	Thread of a shard, which processes a round each time the first
+//!			shard starts it.
+//! \param	idx					Shard index.
+	void _work (
+		const OGSS_Ulong		idx);
+
+//! \brief	Process a round of a shard: the received requests are scheduled,
+//!			then the steps are processed up to the shard horizon.
+//! \param	shard				Shard.
+	void _runRound (
+		shard_t					& shard);
+
+//! \brief	Exchange the requests between the shards, compute the horizon of
+//!			each shard for the next round and send the stats which can not
+//!			be preceded anymore.
+//! \return						FALSE if no step is left.
+	OGSS_Bool _exchange ();
+
+//! \brief	Send the stats of the shards, in the order of the version 2, up
+//!			to a given step.
+//! \param	limit				First step whose stats are kept.
+	void _flushStats (
+		const stamp_t			& limit);
+
+//! \brief	Compute the earliest date a shard can send a request to another
+//!			shard, from its next steps and its parked requests. The heap is
+//!			only explored while its dates are early enough.
+//! \param	shard				Shard.
+//! \return						Earliest date.
+	double _earliestOutput (
+		shard_t					& shard);
+
+//! \brief	Compute the earliest date a request can be sent to another shard,
+//!			from its current step. The first shard sends the requests down
+//!			to the devices, the other ones send them up to the tiers.
+//! \param	row					Request row.
+//! \param	down				TRUE for the first shard.
+//! \return						Earliest date.
+	double _outputDate (
+		const OGSS_Ulong		row,
+		const OGSS_Bool			down);
+
+//! \brief	Update the position of a request in the step heap of the shard
+//!			running on this thread, or send it to the shard owning its next
+//!			step.
+//! \param	row					Request row.
+	void _schedule (
+		const OGSS_Ulong		row);
+
+	using SyncDefV2::_schedule;
+
+//! \brief	Keep the stat of a done request until it can be sent in order.
+//! \param	row					Request row.
+	void _emitStat (
+		const OGSS_Ulong		row);
+
+//! \brief	Compare two stamps.
+//! \param	a					First stamp.
+//! \param	b					Second stamp.
+//! \return						TRUE if the first stamp comes before the second one.
+	inline static OGSS_Bool _precedes (
+		const stamp_t			& a,
+		const stamp_t			& b)
+		{ return _before (a._step, b._step)
+			|| (! _before (b._step, a._step) && a._hops < b._hops); }
+
+/*----------------------------------------------------------------------------*/
+/* ATTRIBUTES ----------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+	OGSS_Ulong					_numShards;			//!< Requested number of shards.
+	std::vector <shard_t>		_shards;			//!< Synchronization shards.
+	std::vector <OGSS_Ulong>	_shardOf;			//!< Shard of each device.
+	std::vector <stamp_t>		_stamps;			//!< Latest step done before each
+													//!< request was received.
+	double						_lookDown;			//!< Minimum transfer time from the
+													//!< tiers to the volumes.
+	double						_lookUp;			//!< Minimum transfer time from the
+													//!< devices to the volumes.
+
+	std::mutex					_roundLock;			//!< Lock of the round state.
+	std::condition_variable		_roundStart;		//!< Signaled when a round starts.
+	std::condition_variable		_roundEnd;			//!< Signaled when the shard threads
+													//!< end their round.
+	OGSS_Ulong					_round {0};			//!< Number of started rounds.
+	OGSS_Ulong					_running {0};		//!< Number of shard threads in a round.
+	OGSS_Bool					_done {false};		//!< TRUE once all the steps are done.
+
+	static thread_local shard_t	* _shard;			//!< Shard running on the thread.
+};
+
+#endif
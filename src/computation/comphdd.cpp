@@ -26,10 +26,14 @@
 /* HEADERS -------------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+#include <algorithm>
 #include <cmath>
+#include <set>
 
 #include "computation/comphdd.hpp"
 
+#include "parser/xmlparser.hpp"
+
 #if USE_STATIC_GLOG
 #include "glog/logging.h"
 #else
@@ -43,41 +47,132 @@ using namespace std;
 /*----------------------------------------------------------------------------*/
 
 CompHDD::CompHDD (
-	vector <Device>			& devs):
-	_devices (devs) {  }
+	vector <Device>			& devs,
+	const OGSS_Ulong		first,
+	const OGSS_Ulong		last,
+	const OGSS_Bool			rotational):
+	_devices (devs), _rotational (rotational) {
+	_seekA.assign (2 * _devices.size (), .0);
+	_seekB.assign (2 * _devices.size (), .0);
+	_seekMin.assign (2 * _devices.size (), .0);
+	_invRotation.assign (_devices.size (), .0);
+	_angleStep.assign (_devices.size (), .0);
+
+	for (OGSS_Ulong i = first; i < last; ++i) {
+		HDDParameters		& h = _devices [i] ._param.h;
+
+		if (_devices [i] ._type != DTP_HDD) continue;
+
+		for (OGSS_Ulong w = 0; w < 2; ++w)
+			seekCurve (h, w, _seekA [2 * i + w], _seekB [2 * i + w],
+				_seekMin [2 * i + w]);
+
+		// Sector to angle mapping, the platters start at angle 0
+		_invRotation [i] = 1 / h._rotationSpeed;
+		_angleStep [i] = 1. / h._sectorsPerTrack;
+		if (_rotational) _devices [i] ._clock = .0;
+	}
+}
+
 CompHDD::~CompHDD () {  }
 
 void
 CompHDD::compute (
 	Request					& req) {
+	Device					& dev = _devices [req._idxDevice];
+	OGSS_Ulong				c {coefIndex (req)};
+	OGSS_Real				st, rt, tt, dist;
 
-	OGSS_Real				st, rt, tt;
-
-	st = seekTime (req, _devices [req._idxDevice]);
-	rt = rotTime (req, _devices [req._idxDevice]);
-	tt = tsfTime (req, _devices [req._idxDevice]);
+	dist = seekDistance (req, dev);
+	st = (dist == 0) ? .0
+		: _seekA [c] * sqrt (dist) + _seekB [c] * (dist - 1) + _seekMin [c];
+	tt = tsfTime (req, dev);
+	rt = _rotational ? rotDelay (req, dev, st, sectorAngle (req, dev), tt)
+		: rotTime (req, dev);
 
 	req._serviceTime = st + rt + tt;
 }
 
+void
+CompHDD::computeBatch (
+	vector <Request *>		& reqs) {
+	OGSS_Ulong				num {reqs.size ()};
+
+	_batchDist.resize (num);	_batchA.resize (num);	_batchB.resize (num);
+	_batchMin.resize (num);		_batchRot.resize (num);	_batchTsf.resize (num);
+	_batchServ.resize (num);	_batchAngle.resize (num);
+
+	// The seek distance depends on the previous request of the device, so
+	// this pass is done in the reception order
+	for (OGSS_Ulong i = 0; i < num; ++i) {
+		Request				& req = * reqs [i];
+		Device				& dev = _devices [req._idxDevice];
+		OGSS_Ulong			c {coefIndex (req)};
+
+		_batchDist [i] = seekDistance (req, dev);
+		_batchA [i] = _seekA [c];
+		_batchB [i] = _seekB [c];
+		_batchMin [i] = _seekMin [c];
+
+		if (_rotational) {
+			// Only the seek time is computed by the kernel
+			_batchRot [i] = _batchTsf [i] = .0;
+			_batchAngle [i] = sectorAngle (req, dev);
+		} else {
+			_batchRot [i] = rotTime (req, dev);
+			_batchTsf [i] = tsfTime (req, dev);
+		}
+	}
+
+	serviceTimeKernel (num, _batchDist.data (), _batchA.data (), _batchB.data (),
+		_batchMin.data (), _batchRot.data (), _batchTsf.data (), _batchServ.data () );
+
+	// The rotational delay depends on the device clock, so this pass is
+	// done in the reception order too
+	if (_rotational) {
+		for (OGSS_Ulong i = 0; i < num; ++i) {
+			Request			& req = * reqs [i];
+			Device			& dev = _devices [req._idxDevice];
+			OGSS_Real		tt {tsfTime (req, dev)};
+			OGSS_Real		rt {rotDelay (req, dev, _batchServ [i], _batchAngle [i], tt)};
+
+			_batchServ [i] = _batchServ [i] + rt + tt;
+		}
+	}
+
+	for (OGSS_Ulong i = 0; i < num; ++i)
+		reqs [i] ->_serviceTime = _batchServ [i];
+}
+
+void
+CompHDD::seekCurve (
+	const HDDParameters		& h,
+	const OGSS_Bool			write,
+	OGSS_Real				& a,
+	OGSS_Real				& b,
+	OGSS_Real				& minSeek) {
+	OGSS_Real				avgSeek, maxSeek;
+
+	minSeek = write ? h._minWriteSeek : h._minReadSeek;
+	avgSeek = write ? h._avgWriteSeek : h._avgReadSeek;
+	maxSeek = write ? h._maxWriteSeek : h._maxReadSeek;
+
+	a = (-10 * minSeek + 15 * avgSeek - 5 * maxSeek)
+		/ (3 * sqrt (h._tracksPerPlatter) );
+	b = (7 * minSeek - 15 * avgSeek + 8 * maxSeek)
+		/ (3 * h._tracksPerPlatter);
+}
+
 /*----------------------------------------------------------------------------*/
 /* PRIVATE FUNCTIONS ---------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
 OGSS_Real
-CompHDD::seekTime (
+CompHDD::seekDistance (
 	Request					& req,
 	Device					& dev) {
-	OGSS_Real				a, b, dist;
-	OGSS_Real				seekTime, minSeek, avgSeek, maxSeek;
 	OGSS_Ulong				previous, next, start;
-
-	minSeek = (req._type & RQT_WRITE) ? dev._param.h._minWriteSeek
-									  : dev._param.h._minReadSeek;
-	avgSeek = (req._type & RQT_WRITE) ? dev._param.h._avgWriteSeek
-									  : dev._param.h._avgReadSeek;
-	maxSeek = (req._type & RQT_WRITE) ? dev._param.h._maxWriteSeek
-									  : dev._param.h._maxReadSeek;
+	OGSS_Real				dist;
 
 	previous = dev._param.h._lastTrack;
 	start = req._deviceAddress / dev._param.h._sectorSize;
@@ -94,17 +189,28 @@ CompHDD::seekTime (
 	previous = previous % dev._param.h._tracksPerPlatter;
 	dev._param.h._lastTrack = previous;
 
-	// Seek time computation
-	if (dist == 0) seekTime = 0;
-	else {
-		a = (-10 * minSeek + 15 * avgSeek - 5 * maxSeek)
-			/ (3 * sqrt (dev._param.h._tracksPerPlatter) );
-		b = (7 * minSeek - 15 * avgSeek + 8 * maxSeek)
-			/ (3 * dev._param.h._tracksPerPlatter);
-		seekTime = a * sqrt (dist) + b * (dist - 1) + minSeek;
-	}
+	return dist;
+}
+
+void
+CompHDD::serviceTimeKernel (
+	const OGSS_Ulong		num,
+	const OGSS_Real			* __restrict dist,
+	const OGSS_Real			* __restrict a,
+	const OGSS_Real			* __restrict b,
+	const OGSS_Real			* __restrict minSeek,
+	const OGSS_Real			* __restrict rot,
+	const OGSS_Real			* __restrict tsf,
+	OGSS_Real				* __restrict serv) {
+	// Without call, each service time only depends on the flat arrays; the
+	// square root is only vectorized without math errno and FP traps, so
+	// this file is built with -fno-math-errno -fno-trapping-math
+	for (OGSS_Ulong i = 0; i < num; ++i) {
+		OGSS_Real			d {dist [i]}, ai {a [i]}, bi {b [i]}, mi {minSeek [i]};
 
-	return seekTime;
+		serv [i] = ( (d != 0) ? ai * sqrt (d) + bi * (d - 1) + mi : .0)
+			+ rot [i] + tsf [i];
+	}
 }
 
 OGSS_Real
@@ -116,6 +222,31 @@ CompHDD::rotTime (
 
 }
 
+OGSS_Real
+CompHDD::rotDelay (
+	const Request			& req,
+	Device					& dev,
+	const OGSS_Real			seek,
+	const OGSS_Real			angle,
+	const OGSS_Real			tsf) {
+	// The bus transfers and the synchronization queues are not known yet,
+	// so the start date is approximated (see the model description)
+	OGSS_Real				start {max (req._date, dev._clock)};
+	OGSS_Real				head, delay;
+
+	// Angle under the head at the end of the seek, in rotations
+	head = (start + seek) * _invRotation [req._idxDevice];
+	head -= floor (head);
+
+	delay = angle - head;
+	if (delay < 0) delay += 1;
+	delay *= dev._param.h._rotationSpeed;
+
+	dev._clock = start + seek + delay + tsf;
+
+	return delay;
+}
+
 OGSS_Real
 CompHDD::tsfTime (
 	Request					& req,
@@ -123,3 +254,47 @@ CompHDD::tsfTime (
 
 	return req._size * (dev._param.h._transferRate);
 }
+
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+UT_CompHDD::UT_CompHDD (
+	const OGSS_String		& configurationFile):
+	UnitaryTest <UT_CompHDD> (MTP_COMPHDD) {
+	set <OGSS_String>		testNames;
+
+	XMLParser::getListOfRequestedUnitaryTests (
+		configurationFile, _module, testNames);
+
+	for (auto & elt: testNames) {
+		if (! elt.compare ("all") ) {
+			_tests.push_back (make_pair ("Sector position",
+				&UT_CompHDD::sectorPosition) );
+			_tests.push_back (make_pair ("Rotational delay",
+				&UT_CompHDD::rotationalDelay) );
+			_tests.push_back (make_pair ("Delay wrap-around",
+				&UT_CompHDD::delayWrapAround) );
+			_tests.push_back (make_pair ("Rotational service time",
+				&UT_CompHDD::serviceTime) );
+		} else if (! elt.compare ("sectorPosition") )
+			_tests.push_back (make_pair ("Sector position",
+				&UT_CompHDD::sectorPosition) );
+		else if (! elt.compare ("rotationalDelay") )
+			_tests.push_back (make_pair ("Rotational delay",
+				&UT_CompHDD::rotationalDelay) );
+		else if (! elt.compare ("delayWrapAround") )
+			_tests.push_back (make_pair ("Delay wrap-around",
+				&UT_CompHDD::delayWrapAround) );
+		else if (! elt.compare ("serviceTime") )
+			_tests.push_back (make_pair ("Rotational service time",
+				&UT_CompHDD::serviceTime) );
+		else
+			LOG (WARNING) << ModuleNameMap.at (_module) << " unitary test "
+				<< "named '" << elt << "' does not match!";
+	}
+}
+
+UT_CompHDD::~UT_CompHDD () {  }
+
+#include "utest/utcomphdd.cpp"
@@ -42,6 +42,8 @@ CompInterface::CompInterface (
 	vector <Interface>		& intfs):
 	_hardParam (params), _tiers (tiers), _volumes (vols),
 	_devices (devs), _interfaces (intfs) {
+	_paths = createDevicePaths (_hardParam, _tiers, _volumes, _devices, _interfaces);
+
 	_codSize = 128;
 	_ackSize = 128;
 }
@@ -50,41 +52,20 @@ CompInterface::~CompInterface () {  }
 void
 CompInterface::compute (
 	Request					& req) {
+	const OGSS_DevicePath	& path = _paths [req._idxDevice];
+	OGSS_Ulong				size {req._size};
 
-	OGSS_Ushort				idv;
-	OGSS_Ulong				size;
-	OGSS_Ushort				i1, i2, i3;
-	OGSS_Real				date;
-
-	idv = req._idxDevice;
-	size = req._size;
-	date = req._date;
-
-	i1 = _hardParam._hostInterface;
-	i2 = _tiers [_volumes [_devices [idv] ._parent] ._parent] ._interface;
-	i3 = _volumes [_devices [idv] ._parent] ._interface;
+	req._transferTimeA1 = ((double) _codSize + req._transferTimeA1) * path._hostCost;
+	req._transferTimeA2 = ((double) _codSize + req._transferTimeA2) * path._tierCost;
 
-	req._transferTimeA1 = ((double) _codSize + req._transferTimeA1)
-		/ (_interfaces [i1] ._bandwidth);
-	req._transferTimeA2 = ((double) _codSize + req._transferTimeA2)
-		/ (_interfaces [i2] ._bandwidth);
-
-	req._transferTimeB2 = ((double) _ackSize + req._transferTimeB2)
-		/ (_interfaces [i2] ._bandwidth);
-	req._transferTimeB1 = ((double) _ackSize + req._transferTimeB1)
-		/ (_interfaces [i1] ._bandwidth);
+	req._transferTimeB2 = ((double) _ackSize + req._transferTimeB2) * path._tierCost;
+	req._transferTimeB1 = ((double) _ackSize + req._transferTimeB1) * path._hostCost;
 
 	if (req._type & RQT_WRITE) {
-		req._transferTimeA3 = ((double) _codSize + size)
-			/ (_interfaces [i3] ._bandwidth);
-
-		req._transferTimeB3 = ((double) _ackSize)
-			/ (_interfaces [i3] ._bandwidth);
+		req._transferTimeA3 = ((double) _codSize + size) * path._volumeCost;
+		req._transferTimeB3 = ((double) _ackSize) * path._volumeCost;
 	} else {
-		req._transferTimeA3 = ((double) _codSize)
-			/ (_interfaces [i3] ._bandwidth);
-
-		req._transferTimeB3 = ((double) _ackSize + size)
-			/ (_interfaces [i3] ._bandwidth);
+		req._transferTimeA3 = ((double) _codSize) * path._volumeCost;
+		req._transferTimeB3 = ((double) _ackSize + size) * path._volumeCost;
 	}
 }
@@ -26,10 +26,14 @@
 /* HEADERS -------------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+#include <algorithm>
 #include <cmath>
+#include <set>
 
 #include "computation/compnvram.hpp"
 
+#include "parser/xmlparser.hpp"
+
 #if USE_STATIC_GLOG
 #include "glog/logging.h"
 #else
@@ -38,16 +42,48 @@
 
 using namespace std;
 
+constexpr OGSS_Ulong CompNVRAM::_kNoRow;
+
 /*----------------------------------------------------------------------------*/
 /* PUBLIC FUNCTIONS ----------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
-CompNVRAM::CompNVRAM(
-	vector<Device> &devs) : _devices(devs) {}
+CompNVRAM::CompNVRAM (
+	vector <Device>			& devs,
+	const OGSS_Ulong		first,
+	const OGSS_Ulong		last,
+	const OGSS_Bool			banked):
+	_devices (devs), _banked (banked) {
+	OGSS_Ulong				numBanks {0}, maxBanks {1};
+
+	_firstBank.assign (_devices.size (), 0);
+
+	// Only the banks of the devices of the model are allocated
+	for (OGSS_Ulong i = first; i < last; ++i) {
+		if (_devices [i] ._type != DTP_NVRAM) continue;
+
+		_firstBank [i] = numBanks;
+		numBanks += max <OGSS_Ulong> (_devices [i] ._param.n._nbBanks, 1);
+		maxBanks = max <OGSS_Ulong> (_devices [i] ._param.n._nbBanks, maxBanks);
+	}
+
+	if (! _banked) return;
+
+	// All the banks are precharged at the beginning
+	_openRow.assign (numBanks, _kNoRow);
+	_bankCycles.assign (maxBanks, .0);
+	_bankMisses.assign (maxBanks, .0);
+}
+
 CompNVRAM::~CompNVRAM() {}
 
 void CompNVRAM::compute(Request &req)
 {
+	if (_banked) {
+		req._serviceTime = bankedServTime (req, _devices [req._idxDevice]);
+		return;
+	}
+
 	OGSS_Real servTime;
 	OGSS_Long nb_sub_requests;
 	OGSS_Short bytes_max_in_one_cycle;
@@ -68,3 +104,108 @@ void CompNVRAM::compute(Request &req)
 	//Compute the total time needed to handle the full request	
 	req._serviceTime = servTime * nb_sub_requests;
 }
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+OGSS_Real
+CompNVRAM::bankedServTime (
+	const Request			& req,
+	const Device			& dev) {
+	const NVRAMParameters	& n = dev._param.n;
+	OGSS_Real				unit {n._bytesPerCol * n._nbChips};
+	OGSS_Ulong				cols {max <OGSS_Ulong> (n._cols, 1)};
+	OGSS_Ulong				banks {max <OGSS_Ulong> (n._nbBanks, 1)};
+	OGSS_Ulong				rowsByBank {max <OGSS_Ulong> (n._rows / banks, 1)};
+	OGSS_Ulong				* open = _openRow.data () + _firstBank [req._idxDevice];
+	OGSS_Real				access, activation;
+	OGSS_Ulong				first, last, firstRow, numRows, used;
+
+	access = (req._type == RQT_READ) ? n._read : n._write;
+	activation = min (n._activation, access);
+
+	// Cycles of the request, and rows of the address space they belong to
+	first = req._deviceAddress / unit;
+	last = (req._deviceAddress + max <OGSS_Ulong> (req._size, 1) - 1) / unit;
+	firstRow = first / cols;
+	numRows = last / cols - firstRow + 1;
+	used = min (numRows, banks);
+
+	// The consecutive rows are on consecutive banks, so the j-th bank used
+	// gets the rows j, j + banks, etc. of the request
+	for (OGSS_Ulong j = 0; j < used; ++j) {
+		OGSS_Ulong			bank {(firstRow + j) % banks};
+		OGSS_Ulong			rows {(numRows - j + banks - 1) / banks};
+		OGSS_Ulong			cycles {rows * cols};
+
+		if (j == 0) cycles -= first % cols;
+		if (j == (numRows - 1) % banks) cycles -= cols - 1 - last % cols;
+
+		_bankCycles [j] = cycles;
+		_bankMisses [j] = rows
+			- ( (open [bank] == ( (firstRow + j) / banks) % rowsByBank) ? 1 : 0);
+		open [bank] = ( (firstRow + j + (rows - 1) * banks) / banks) % rowsByBank;
+	}
+
+	return bankTimeKernel (used, _bankCycles.data (), _bankMisses.data (),
+		access - activation, activation);
+}
+
+OGSS_Real
+CompNVRAM::bankTimeKernel (
+	const OGSS_Ulong		num,
+	const OGSS_Real			* __restrict cycles,
+	const OGSS_Real			* __restrict misses,
+	const OGSS_Real			cycleTime,
+	const OGSS_Real			activation) {
+	OGSS_Real				longest {.0};
+
+	// Without call, the longest bank time of the flat arrays
+	for (OGSS_Ulong i = 0; i < num; ++i) {
+		OGSS_Real			t {cycles [i] * cycleTime + misses [i] * activation};
+
+		longest = (t > longest) ? t : longest;
+	}
+
+	return longest;
+}
+
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+UT_CompNVRAM::UT_CompNVRAM (
+	const OGSS_String		& configurationFile):
+	UnitaryTest <UT_CompNVRAM> (MTP_COMPNVRAM) {
+	set <OGSS_String>		testNames;
+
+	XMLParser::getListOfRequestedUnitaryTests (
+		configurationFile, _module, testNames);
+
+	for (auto & elt: testNames) {
+		if (! elt.compare ("all") ) {
+			_tests.push_back (make_pair ("Bank conflict",
+				&UT_CompNVRAM::bankConflict) );
+			_tests.push_back (make_pair ("Parallel banks",
+				&UT_CompNVRAM::parallelBanks) );
+			_tests.push_back (make_pair ("Single bank",
+				&UT_CompNVRAM::singleBank) );
+		} else if (! elt.compare ("bankConflict") )
+			_tests.push_back (make_pair ("Bank conflict",
+				&UT_CompNVRAM::bankConflict) );
+		else if (! elt.compare ("parallelBanks") )
+			_tests.push_back (make_pair ("Parallel banks",
+				&UT_CompNVRAM::parallelBanks) );
+		else if (! elt.compare ("singleBank") )
+			_tests.push_back (make_pair ("Single bank",
+				&UT_CompNVRAM::singleBank) );
+		else
+			LOG (WARNING) << ModuleNameMap.at (_module) << " unitary test "
+				<< "named '" << elt << "' does not match!";
+	}
+}
+
+UT_CompNVRAM::~UT_CompNVRAM () {  }
+
+#include "utest/utcompnvram.cpp"
@@ -26,6 +26,8 @@
 /* HEADERS -------------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+#include <algorithm>
+
 #include "computation/compssd.hpp"
 
 #if USE_STATIC_GLOG
@@ -41,123 +43,106 @@ using namespace std;
 /*----------------------------------------------------------------------------*/
 
 CompSSD::CompSSD (
-	vector <Device>			& devs):
+	vector <Device>			& devs,
+	const OGSS_Ulong		first,
+	const OGSS_Ulong		last):
 	_devices (devs) {
-	for (auto i = 0; i < _devices.size (); ++i) {
-		if (_devices [i] ._type == DTP_SSD)
-			// number of elements = number of dies
-			_lastPageSeen [i] = vector <OGSS_Ulong> (_devices [i] ._param.s._numDies);
+	OGSS_Ulong				numDies {0};
+
+	_geometry.resize (_devices.size () );
+
+	// Only the dies of the devices of the model are allocated
+	for (OGSS_Ulong i = first; i < last; ++i) {
+		SSDParameters		& s = _devices [i] ._param.s;
+		SSDGeometry			& g = _geometry [i];
+
+		if (_devices [i] ._type != DTP_SSD) continue;
+
+		g._pageSize = s._pageSize;
+		g._blockSize = s._pagesPerBlock * g._pageSize;
+		g._dieSize = s._blocksPerDie * g._blockSize;
+
+		g._pow2 = isPow2 (g._pageSize) && isPow2 (s._pagesPerBlock)
+			&& isPow2 (s._blocksPerDie);
+		g._pageShift = floorLog2 (g._pageSize);
+		g._blockShift = floorLog2 (g._blockSize);
+		g._dieShift = floorLog2 (g._dieSize);
+
+		// number of elements = number of dies
+		g._firstDie = numDies;
+		numDies += s._numDies;
 	}
+
+	_lastPageSeen.assign (numDies, 0);
 }
+
 CompSSD::~CompSSD () {  }
 
 void
 CompSSD::compute (
 	Request					& req) {
-	OGSS_Real				servTime;
+	Device					& dev = _devices [req._idxDevice];
+	const SSDGeometry		& geo = _geometry [req._idxDevice];
+	OGSS_Real				rt, st;
 
-	if (req._type == RQT_ERASE)
-		servTime = eraseServTime (req, _devices [req._idxDevice] );
-	else if (req._type & RQT_WRITE)
-		servTime = writeServTime (req, _devices [req._idxDevice] );
+	if (req._type == RQT_ERASE) {
+		req._serviceTime = eraseServTime (req, dev);
+		return;
+	}
+
+	if (req._type & RQT_WRITE)
+		{ rt = dev._param.s._randWrite; st = dev._param.s._seqWrite; }
 	else
-		servTime = readServTime (req, _devices [req._idxDevice] );
+		{ rt = dev._param.s._randRead; st = dev._param.s._seqRead; }
 
-	req._serviceTime = servTime;
+	req._serviceTime = geo._pow2 ? accessServTime <true> (req, geo, rt, st)
+		: accessServTime <false> (req, geo, rt, st);
 }
 
 /*----------------------------------------------------------------------------*/
 /* PRIVATE FUNCTIONS ---------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+template <OGSS_Bool Pow2>
 OGSS_Real
-CompSSD::readServTime (
+CompSSD::accessServTime (
 	Request					& req,
-	Device					& dev) {
-	OGSS_Ulong	a = req._deviceAddress;
-	OGSS_Ulong	b = req._size;
-
-	OGSS_Ulong	pb = dev._param.s._pagesPerBlock;
-	OGSS_Ulong	bd = dev._param.s._blocksPerDie;
-	OGSS_Ulong	ps = dev._param.s._pageSize;
-
-	std::vector <OGSS_Ulong> & t =
-		_lastPageSeen [req._idxDevice];
-
-	OGSS_Real	rt;
-	OGSS_Real	st;
-
-	OGSS_Real	r = .0;
-
-	OGSS_Ulong   c, d, e, f;
-
-	rt = dev._param.s._randRead;
-	st = dev._param.s._seqRead;
+	const SSDGeometry		& geo,
+	const OGSS_Real			randTime,
+	const OGSS_Real			seqTime) {
+	OGSS_Ulong				a = req._deviceAddress;
+	OGSS_Ulong				b = req._size;
+	OGSS_Ulong				* t = _lastPageSeen.data () + geo._firstDie;
+	OGSS_Real				r = .0;
+	OGSS_Ulong				c, d, e, f;
+
+	// Divisions and modulos by the geometry sizes, which are shifts and
+	// masks for a power of two geometry
+	auto					div = [] (OGSS_Ulong x, OGSS_Ulong size, OGSS_Ushort shift)
+		{ return Pow2 ? x >> shift : x / size; };
+	auto					mod = [] (OGSS_Ulong x, OGSS_Ulong size)
+		{ return Pow2 ? x & (size - 1) : x % size; };
 
 	// Loop on dies
-	for (OGSS_Ulong i = a / (pb * bd * ps); i <= (a + b - 1) / (pb * bd * ps); ++i)
-	{
-		c = std::max (i * pb * bd * ps, a);
-		d = std::min ( (i + 1) * pb * bd * ps - 1, a + b - 1);
+	for (OGSS_Ulong i = div (a, geo._dieSize, geo._dieShift);
+		i <= div (a + b - 1, geo._dieSize, geo._dieShift); ++i) {
+		c = std::max (i * geo._dieSize, a);
+		d = std::min ( (i + 1) * geo._dieSize - 1, a + b - 1);
 		// e <- number of rand access
-		e = 1 + (d / (pb * ps) ) - (c / (pb * ps) );
+		e = 1 + div (d, geo._blockSize, geo._blockShift)
+			- div (c, geo._blockSize, geo._blockShift);
 
-		if (t [i] == c % (pb * bd * ps) && (c - 1) / (pb * ps) == c / (pb * ps) )
+		if (t [i] == mod (c, geo._dieSize)
+			&& div (c - 1, geo._blockSize, geo._blockShift)
+				== div (c, geo._blockSize, geo._blockShift) )
 			e--;
-		
-		f = (1 + d - c - e) / ps;
-
-		r += rt * e;
-		r += st * ( (f < 1) ? 1 : f);
 
-		t [i] = (d + 1) % (pb * bd * ps);
-	}
-
-	return r;
-}
-
-OGSS_Real
-CompSSD::writeServTime (
-	Request					& req,
-	Device					& dev) {
-	OGSS_Ulong   a = req._deviceAddress;
-	OGSS_Ulong   b = req._size;
-
-	OGSS_Ulong   pb = dev._param.s._pagesPerBlock;
-	OGSS_Ulong   bd = dev._param.s._blocksPerDie;
-	OGSS_Ulong   ps = dev._param.s._pageSize;
-
-	std::vector <OGSS_Ulong> & t =
-		_lastPageSeen [req._idxDevice];
-
-	OGSS_Real rt;
-	OGSS_Real st;
-
-	OGSS_Real r = .0;
-
-	OGSS_Ulong   c, d, e, f;
-
-	rt = dev._param.s._randWrite;
-	st = dev._param.s._seqWrite;
-
-	// Loop on dies
-	for (OGSS_Ulong i = a / (pb * bd * ps); i <= (a + b - 1) / (pb * bd * ps); ++i)
-	{
-		c = std::max (i * pb * bd * ps, a);
-		d = std::min ( (i + 1) * pb * bd * ps - 1, a + b - 1);
-		// e <- number of rand access
-		e = 1 + (d / (pb * ps) ) - (c / (pb * ps) );
-
-		if (t [i] == c % (pb * bd * ps) && (c - 1) / (pb * ps)
-			== c / (pb * ps) )
-			e--;
-		
-		f = (1 + d - c - e) / ps;
+		f = div (1 + d - c - e, geo._pageSize, geo._pageShift);
 
-		r += rt * e;
-		r += st * ( (f < 1) ? 1 : f);
+		r += randTime * e;
+		r += seqTime * ( (f < 1) ? 1 : f);
 
-		t [i] = (d + 1) % (pb * bd * ps);
+		t [i] = mod (d + 1, geo._dieSize);
 	}
 
 	return r;
@@ -0,0 +1,334 @@
+/*
+ * Copyright UVSQ - CEA/DAM/DIF (2017-2018)
+ * Contributors:  Sebastien GOUGEAUD  -- sebastien.gougeaud@uvsq.fr
+ *                Soraya ZERTAL       --      soraya.zertal@uvsq.fr
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+//! \file	comptable.cpp
+//! \brief	Definition of the table-driven surrogate computation models.
+
+/*----------------------------------------------------------------------------*/
+/* HEADERS -------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#include <cmath>
+#include <random>
+
+#include "computation/comptable.hpp"
+
+#if USE_STATIC_GLOG
+#include "glog/logging.h"
+#else
+#include <glog/logging.h>
+#endif
+
+using namespace std;
+
+constexpr OGSS_Ushort ServiceTable::_kSubShift;
+constexpr OGSS_Ulong ServiceTable::_kSub;
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+namespace {
+//! \brief	Number of samples used to measure the error of a table.
+const OGSS_Ulong				NumErrorSamples = 10000;
+
+//! \brief	Log the error of the tables of a device.
+//! \param	model				Model name.
+//! \param	idx					Device index.
+//! \param	read				Error of the read table.
+//! \param	write				Error of the write table.
+void
+logError (
+	const OGSS_String			model,
+	const OGSS_Ulong			idx,
+	const OGSS_TableError		& read,
+	const OGSS_TableError		& write) {
+	LOG (INFO) << "[" << model << "] Table of device #" << idx << ": "
+		<< "read max error " << read._maxAbs << " (" << 100 * read._maxRel
+		<< "%, mean " << 100 * read._meanRel << "%), write max error "
+		<< write._maxAbs << " (" << 100 * write._maxRel << "%, mean "
+		<< 100 * write._meanRel << "%)";
+}
+}
+
+/*----------------------------------------------------------------------------*/
+/* SERVICE TABLE -------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+ServiceTable::ServiceTable (
+	const OGSS_Ulong		maxKey,
+	const OGSS_Ulong		maxSize):
+	_maxKey (maxKey), _maxSize (maxSize) {
+	// The last interval of each axis contains the largest value, and the
+	// keys above the largest one are not valid positions
+	_numKeys = _index (maxKey) + 2;
+	_numSizes = _index (maxSize) + 2;
+
+	_keys.resize (_numKeys);
+	_sizes.resize (_numSizes);
+	_keySteps.assign (_numKeys, .0);
+	_sizeSteps.assign (_numSizes, .0);
+
+	for (OGSS_Ulong i = 0; i < _numKeys; ++i)
+		_keys [i] = min (_value (i), _maxKey);
+	for (OGSS_Ulong j = 0; j < _numSizes; ++j)
+		_sizes [j] = _value (j);
+
+	for (OGSS_Ulong i = 0; i + 1 < _numKeys; ++i)
+		if (_keys [i + 1] > _keys [i]) _keySteps [i] = 1 / (_keys [i + 1] - _keys [i]);
+	for (OGSS_Ulong j = 0; j + 1 < _numSizes; ++j)
+		_sizeSteps [j] = 1 / (_sizes [j + 1] - _sizes [j]);
+}
+
+template <class F>
+void
+ServiceTable::fill (
+	F						exact) {
+	_values.resize (_numKeys * _numSizes);
+
+	for (OGSS_Ulong i = 0; i < _numKeys; ++i)
+		for (OGSS_Ulong j = 0; j < _numSizes; ++j)
+			_values [i * _numSizes + j] = exact (_keys [i], _sizes [j]);
+}
+
+template <class F>
+OGSS_TableError
+ServiceTable::measure (
+	F						exact,
+	const OGSS_Ulong		numSamples) {
+	OGSS_TableError			err;
+	mt19937_64				gen (0);
+	uniform_real_distribution <OGSS_Real>	logSize (0, log2 (_maxSize + 1.) );
+
+	// Uniform keys, log-uniform sizes
+	for (OGSS_Ulong n = 0; n < numSamples; ++n) {
+		OGSS_Ulong			key {gen () % (_maxKey + 1)};
+		OGSS_Ulong			size {static_cast <OGSS_Ulong> (exp2 (logSize (gen) ) ) };
+		OGSS_Real			ref {exact (key, size)};
+		OGSS_Real			diff {fabs (lookup (key, size) - ref)};
+		OGSS_Real			rel {ref > 0 ? diff / ref : .0};
+
+		err._maxAbs = max (err._maxAbs, diff);
+		err._maxRel = max (err._maxRel, rel);
+		err._meanRel += rel / numSamples;
+	}
+
+	return err;
+}
+
+/*----------------------------------------------------------------------------*/
+/* HDD SURROGATE MODEL -------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+CompHDDTable::CompHDDTable (
+	vector <Device>			& devs,
+	const OGSS_Ulong		first,
+	const OGSS_Ulong		last):
+	CompHDD (devs, first, last) {
+	vector <OGSS_Ulong>		owners;
+
+	_tableOf.assign (_devices.size (), 0);
+
+	for (OGSS_Ulong i = first; i < last; ++i) {
+		Device				& dev = _devices [i];
+		const HDDParameters	& h = dev._param.h;
+		OGSS_Ulong			lastTrack {h._lastTrack};
+		OGSS_TableError		err [2];
+
+		if (dev._type != DTP_HDD) continue;
+
+		// The devices with the same parameters share their tables
+		auto				same = find_if (owners.begin (), owners.end (),
+			[&] (const OGSS_Ulong j) {
+				const HDDParameters	& o = _devices [j] ._param.h;
+				return o._sectorSize == h._sectorSize
+					&& o._sectorsPerTrack == h._sectorsPerTrack
+					&& o._tracksPerPlatter == h._tracksPerPlatter
+					&& o._minReadSeek == h._minReadSeek && o._avgReadSeek == h._avgReadSeek
+					&& o._maxReadSeek == h._maxReadSeek && o._minWriteSeek == h._minWriteSeek
+					&& o._avgWriteSeek == h._avgWriteSeek && o._maxWriteSeek == h._maxWriteSeek
+					&& o._rotationSpeed == h._rotationSpeed
+					&& o._transferRate == h._transferRate
+					&& _devices [j] ._physicalCapacity == dev._physicalCapacity; } );
+		if (same != owners.end () ) { _tableOf [i] = _tableOf [* same]; continue; }
+
+		owners.push_back (i);
+		_tableOf [i] = _tables.size ();
+
+		for (OGSS_Ulong w = 0; w < 2; ++w) {
+			// Exact model, from the first track to the track at the distance
+			auto			exact = [&] (OGSS_Ulong dist, OGSS_Ulong size) {
+				Request		req;
+
+				req._idxDevice = i;
+				req._type = w ? RQT_WRITE : RQT_READ;
+				req._size = size;
+				req._deviceAddress = dist * h._sectorsPerTrack * h._sectorSize;
+				dev._param.h._lastTrack = 0;
+				CompHDD::compute (req);
+
+				return req._serviceTime;
+			};
+
+			_tables.emplace_back (h._tracksPerPlatter - 1, dev._physicalCapacity);
+			_tables.back () .fill (exact);
+			err [w] = _tables.back () .measure (exact, NumErrorSamples);
+		}
+
+		dev._param.h._lastTrack = lastTrack;
+		logError ("HDD", i, err [0], err [1]);
+	}
+}
+
+CompHDDTable::~CompHDDTable () {  }
+
+void
+CompHDDTable::compute (
+	Request					& req) {
+	Device					& dev = _devices [req._idxDevice];
+	OGSS_Ulong				dist = seekDistance (req, dev);
+
+	req._serviceTime = _tables [_tableOf [req._idxDevice]
+		+ ( (req._type & RQT_WRITE) ? 1 : 0)] .lookup (dist, req._size);
+}
+
+void
+CompHDDTable::computeBatch (
+	vector <Request *>		& reqs) {
+	for (auto req: reqs) CompHDDTable::compute (* req);
+}
+
+/*----------------------------------------------------------------------------*/
+/* SSD SURROGATE MODEL -------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+CompSSDTable::CompSSDTable (
+	vector <Device>			& devs,
+	const OGSS_Ulong		first,
+	const OGSS_Ulong		last):
+	CompSSD (devs, first, last) {
+	vector <OGSS_Ulong>		owners;
+
+	_tableOf.assign (_devices.size (), 0);
+
+	for (OGSS_Ulong i = first; i < last; ++i) {
+		Device				& dev = _devices [i];
+		const SSDParameters	& s = dev._param.s;
+		const SSDGeometry	& geo = _geometry [i];
+		OGSS_TableError		err [2];
+
+		if (dev._type != DTP_SSD) continue;
+
+		auto				same = find_if (owners.begin (), owners.end (),
+			[&] (const OGSS_Ulong j) {
+				const SSDParameters	& o = _devices [j] ._param.s;
+				return o._pageSize == s._pageSize
+					&& o._pagesPerBlock == s._pagesPerBlock
+					&& o._blocksPerDie == s._blocksPerDie && o._numDies == s._numDies
+					&& o._randRead == s._randRead && o._randWrite == s._randWrite
+					&& o._seqRead == s._seqRead && o._seqWrite == s._seqWrite; } );
+		if (same != owners.end () ) { _tableOf [i] = _tableOf [* same]; continue; }
+
+		owners.push_back (i);
+		_tableOf [i] = _tables.size ();
+
+		for (OGSS_Ulong w = 0; w < 2; ++w) {
+			// Exact model in the first block. The service time of a request
+			// in a block only depends on whether it continues the previous
+			// request of the die, and on its number of pages once its random
+			// access is paid: the sequential requests start at the second
+			// byte of the block
+			auto			inBlock = [&] (OGSS_Ulong seq, OGSS_Ulong pages) {
+				Request		req;
+
+				req._idxDevice = i;
+				req._type = w ? RQT_WRITE : RQT_READ;
+				req._deviceAddress = seq;
+				req._size = max <OGSS_Ulong> (pages * geo._pageSize + 1 - seq, 1);
+				_lastPageSeen [geo._firstDie] = seq ? seq : OGSS_ULONG_MAX;
+				CompSSD::compute (req);
+
+				return req._serviceTime;
+			};
+			// The grid point above the last page of the block is extended
+			// with the time of this last page
+			auto			exact = [&] (OGSS_Ulong seq, OGSS_Ulong pages) {
+				OGSS_Ulong	last {min <OGSS_Ulong> (pages, s._pagesPerBlock - 1)};
+				OGSS_Real	time {inBlock (seq, last)};
+
+				if (pages > last && last)
+					time += (pages - last) * (time - inBlock (seq, last - 1) );
+				return time;
+			};
+
+			_tables.emplace_back (1, s._pagesPerBlock - 1);
+			_tables.back () .fill (exact);
+			err [w] = _tables.back () .measure (exact, NumErrorSamples);
+		}
+
+		fill (_lastPageSeen.begin () + geo._firstDie,
+			_lastPageSeen.begin () + geo._firstDie + s._numDies, 0);
+		logError ("SSD", i, err [0], err [1]);
+	}
+}
+
+CompSSDTable::~CompSSDTable () {  }
+
+void
+CompSSDTable::compute (
+	Request					& req) {
+	Device					& dev = _devices [req._idxDevice];
+	const SSDGeometry		& geo = _geometry [req._idxDevice];
+	OGSS_Ulong				* t = _lastPageSeen.data () + geo._firstDie;
+	OGSS_Ulong				die, inDie, inBlock, seq;
+
+	if (req._type == RQT_ERASE) {
+		req._serviceTime = eraseServTime (req, dev);
+		return;
+	}
+
+	if (geo._pow2) {
+		die = req._deviceAddress >> geo._dieShift;
+		inDie = req._deviceAddress & (geo._dieSize - 1);
+		inBlock = req._deviceAddress & (geo._blockSize - 1);
+	} else {
+		die = req._deviceAddress / geo._dieSize;
+		inDie = req._deviceAddress % geo._dieSize;
+		inBlock = req._deviceAddress % geo._blockSize;
+	}
+
+	// A request which crosses a block boundary pays a random access by
+	// block, which depends on its offset, so it uses the exact model
+	if (inBlock + req._size > geo._blockSize) {
+		CompSSD::compute (req);
+		return;
+	}
+
+	// A request which continues the previous one of its die in the same
+	// block does not pay its random access
+	seq = (inBlock && t [die] == inDie) ? 1 : 0;
+	req._serviceTime = _tables [_tableOf [req._idxDevice]
+		+ ( (req._type & RQT_WRITE) ? 1 : 0)] .lookup (seq, (geo._pow2
+			? (max <OGSS_Ulong> (req._size, 1) + seq - 1) >> geo._pageShift
+			: (max <OGSS_Ulong> (req._size, 1) + seq - 1) / geo._pageSize) );
+
+	t [die] = (inDie + req._size == geo._dieSize) ? 0 : inDie + req._size;
+}
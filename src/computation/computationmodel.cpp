@@ -0,0 +1,99 @@
+/*
+ * Copyright UVSQ - CEA/DAM/DIF (2017-2018)
+ * Contributors:  Sebastien GOUGEAUD  -- sebastien.gougeaud@uvsq.fr
+ *                Soraya ZERTAL       --      soraya.zertal@uvsq.fr
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+//! \file	computationmodel.cpp
+//! \brief	Registry of the device computation models.
+
+/*----------------------------------------------------------------------------*/
+/* HEADERS -------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#include "computation/comphdd.hpp"
+#include "computation/compnvram.hpp"
+#include "computation/compssd.hpp"
+#include "computation/comptable.hpp"
+
+using namespace std;
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+namespace {
+//! \brief	Registered computation model.
+struct OGSS_ModelEntry {
+	OGSS_DeviceType				_type;				//!< Device type.
+	OGSS_String					_name;				//!< Model name.
+	unique_ptr <ComputationModel>	(* _create) (vector <Device> &,
+		OGSS_Ulong, OGSS_Ulong);						//!< Factory, for a device range.
+};
+
+//! \brief	Registry of the computation models, a new model only needs an
+//!			entry here and a name in the type maps.
+const OGSS_ModelEntry			ModelRegistry [] = {
+	{DTP_HDD, HDDComputationNameMap.at (HCP_DEFAULT),
+		[] (vector <Device> & devs, OGSS_Ulong first, OGSS_Ulong last)
+		-> unique_ptr <ComputationModel>
+		{ return make_unique <CompHDD> (devs, first, last); } },
+	{DTP_HDD, HDDComputationNameMap.at (HCP_ROTATIONAL),
+		[] (vector <Device> & devs, OGSS_Ulong first, OGSS_Ulong last)
+		-> unique_ptr <ComputationModel>
+		{ return make_unique <CompHDD> (devs, first, last, true); } },
+	{DTP_HDD, HDDComputationNameMap.at (HCP_TABLE),
+		[] (vector <Device> & devs, OGSS_Ulong first, OGSS_Ulong last)
+		-> unique_ptr <ComputationModel>
+		{ return make_unique <CompHDDTable> (devs, first, last); } },
+	{DTP_SSD, SSDComputationNameMap.at (SCP_DEFAULT),
+		[] (vector <Device> & devs, OGSS_Ulong first, OGSS_Ulong last)
+		-> unique_ptr <ComputationModel>
+		{ return make_unique <CompSSD> (devs, first, last); } },
+	{DTP_SSD, SSDComputationNameMap.at (SCP_TABLE),
+		[] (vector <Device> & devs, OGSS_Ulong first, OGSS_Ulong last)
+		-> unique_ptr <ComputationModel>
+		{ return make_unique <CompSSDTable> (devs, first, last); } },
+	{DTP_NVRAM, NVRAMComputationNameMap.at (NCP_DEFAULT),
+		[] (vector <Device> & devs, OGSS_Ulong first, OGSS_Ulong last)
+		-> unique_ptr <ComputationModel>
+		{ return make_unique <CompNVRAM> (devs, first, last); } },
+	{DTP_NVRAM, NVRAMComputationNameMap.at (NCP_BANKED),
+		[] (vector <Device> & devs, OGSS_Ulong first, OGSS_Ulong last)
+		-> unique_ptr <ComputationModel>
+		{ return make_unique <CompNVRAM> (devs, first, last, true); } }
+};
+}
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTIONS ----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+unique_ptr <ComputationModel>
+createComputationModel (
+	const OGSS_DeviceType		type,
+	const OGSS_String			& name,
+	vector <Device>				& devs,
+	const OGSS_Ulong			first,
+	const OGSS_Ulong			last) {
+	for (auto & elt: ModelRegistry)
+		if (elt._type == type && ! elt._name.compare (name) )
+			return elt._create (devs, first, last);
+
+	return nullptr;
+}
@@ -0,0 +1,256 @@
+/*
+ * Copyright UVSQ - CEA/DAM/DIF (2018)
+ * Contributors:  Sebastien GOUGEAUD  -- sebastien.gougeaud@uvsq.fr
+ *                Soraya ZERTAL       --      soraya.zertal@uvsq.fr
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published per the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+//! \file	devicecache.cpp
+//! \brief	Definition of the device buffer.
+
+/*----------------------------------------------------------------------------*/
+/* HEADERS -------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <set>
+
+#include "computation/devicecache.hpp"
+
+#include "parser/xmlparser.hpp"
+
+#if USE_STATIC_GLOG
+#include "glog/logging.h"
+#else
+#include <glog/logging.h>
+#endif
+
+using namespace std;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC MEMBER FUNCTIONS ---------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+DeviceCache::DeviceCache (
+	const vector <Device>	& devices,
+	const OGSS_Ulong		first,
+	const OGSS_Ulong		last) {
+	_firstDevice = first;
+	_buffers.resize (last - first);
+
+	for (auto i = first; i < last; ++i) {
+		const Device		& dev = devices [i];
+		Buffer				& buf = _buffers [i - first];
+
+		if (dev._type == DTP_NVRAM || ! dev._bufferSize || ! dev._numSegments)
+			continue;
+
+		buf._num = min (dev._numSegments, dev._bufferSize);
+		buf._first = _segments.size ();
+		buf._segmentSize = dev._bufferSize / buf._num;
+		buf._size = dev._bufferSize;
+		buf._capacity = dev._physicalCapacity;
+		buf._writeBack = (dev._writeCache == CCP_WRITEBACK);
+
+		_segments.resize (_segments.size () + buf._num);
+	}
+}
+
+DeviceCache::~DeviceCache () {  }
+
+void
+DeviceCache::filter (
+	vector <Request *>		& reqs) {
+	OGSS_Ulong				num {0};
+
+	_deferred.clear ();
+	_readAhead.clear ();
+
+	for (auto req: reqs) {
+		Buffer				& buf = _buffers [req->_idxDevice - _firstDevice];
+		OGSS_Ulong			start {req->_deviceAddress};
+		OGSS_Ulong			end {start + max <OGSS_Ulong> (req->_size, 1)};
+		OGSS_Bool			deferred {false};
+		OGSS_Ulong			ahead {0};
+
+		// The internal requests of the controller do not use the buffer
+		if (buf._num && ! req->_internal) {
+			if (req->_type == RQT_READ) {
+				if (_read (buf, start, end, ahead) )
+					{ req->_serviceTime = .0; continue; }
+				// The miss reads its segment from the media, its size is
+				// given back once its service time is computed
+				req->_size += ahead;
+			} else if (req->_type == RQT_WRITE)
+				deferred = _write (buf, start, end);
+			else
+				_invalidate (buf, start, end);
+		}
+
+		reqs [num ++] = req;
+		_deferred.push_back (deferred);
+		_readAhead.push_back (ahead);
+	}
+
+	reqs.resize (num);
+}
+
+void
+DeviceCache::settle (
+	const vector <Request *>	& reqs) {
+	for (OGSS_Ulong i = 0; i < reqs.size (); ++i) {
+		Buffer				& buf = _buffers [reqs [i] ->_idxDevice - _firstDevice];
+
+		reqs [i] ->_size -= _readAhead [i];
+
+		if (! buf._num || reqs [i] ->_internal) continue;
+
+		// The acknowledged writes are destaged by the next request which
+		// goes to the media, or by the write which does not fit in the
+		// buffer anymore
+		if (_deferred [i] && buf._dirty + reqs [i] ->_size <= buf._size) {
+			buf._pending += reqs [i] ->_serviceTime;
+			buf._dirty += reqs [i] ->_size;
+			reqs [i] ->_serviceTime = .0;
+		} else {
+			reqs [i] ->_serviceTime += buf._pending;
+			buf._pending = .0;
+			buf._dirty = 0;
+		}
+	}
+}
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+OGSS_Bool
+DeviceCache::_read (
+	Buffer					& buf,
+	const OGSS_Ulong		start,
+	const OGSS_Ulong		end,
+	OGSS_Ulong				& ahead) {
+	OGSS_Ulong				kept;
+
+	for (auto pos = buf._first; pos < buf._first + buf._num; ++pos) {
+		if (_segments [pos] ._start <= start && end <= _segments [pos] ._end) {
+			_segments [pos] ._lastUse = ++ _date;
+			return true;
+		}
+	}
+
+	// The segment keeps the end of the request, at most half of it, and is
+	// filled with the following data
+	kept = min (end - start, max <OGSS_Ulong> (buf._segmentSize / 2, 1) );
+
+	Segment					& seg = _segments [_victim (buf, start)];
+
+	seg._start = end - kept;
+	seg._end = max (end, min (seg._start + buf._segmentSize, buf._capacity) );
+	seg._lastUse = ++ _date;
+	ahead = seg._end - end;
+
+	return false;
+}
+
+OGSS_Bool
+DeviceCache::_write (
+	Buffer					& buf,
+	const OGSS_Ulong		start,
+	const OGSS_Ulong		end) {
+	_invalidate (buf, start, end);
+
+	if (! buf._writeBack || end - start > buf._segmentSize) return false;
+
+	Segment					& seg = _segments [_victim (buf, start)];
+
+	seg._start = start;
+	seg._end = end;
+	seg._lastUse = ++ _date;
+
+	return true;
+}
+
+void
+DeviceCache::_invalidate (
+	Buffer					& buf,
+	const OGSS_Ulong		start,
+	const OGSS_Ulong		end) {
+	for (auto pos = buf._first; pos < buf._first + buf._num; ++pos)
+		if (_segments [pos] ._start < end && start < _segments [pos] ._end)
+			_segments [pos] = Segment ();
+}
+
+OGSS_Ulong
+DeviceCache::_victim (
+	const Buffer			& buf,
+	const OGSS_Ulong		start) const {
+	OGSS_Ulong				victim {buf._first};
+
+	for (auto pos = buf._first; pos < buf._first + buf._num; ++pos) {
+		if (_segments [pos] ._start <= start && start < _segments [pos] ._end)
+			return pos;
+		if (_segments [pos] ._lastUse < _segments [victim] ._lastUse)
+			victim = pos;
+	}
+
+	return victim;
+}
+
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+UT_DeviceCache::UT_DeviceCache (
+	const OGSS_String		& configurationFile):
+	UnitaryTest <UT_DeviceCache> (MTP_DEVICECACHE) {
+	set <OGSS_String>		testNames;
+
+	XMLParser::getListOfRequestedUnitaryTests (
+		configurationFile, _module, testNames);
+
+	for (auto & elt: testNames) {
+		if (! elt.compare ("all") ) {
+			_tests.push_back (make_pair ("Read hit and miss",
+				&UT_DeviceCache::readHitMiss) );
+			_tests.push_back (make_pair ("Write-back",
+				&UT_DeviceCache::writeBack) );
+			_tests.push_back (make_pair ("Write-through",
+				&UT_DeviceCache::writeThrough) );
+			_tests.push_back (make_pair ("Eviction",
+				&UT_DeviceCache::eviction) );
+		} else if (! elt.compare ("readHitMiss") )
+			_tests.push_back (make_pair ("Read hit and miss",
+				&UT_DeviceCache::readHitMiss) );
+		else if (! elt.compare ("writeBack") )
+			_tests.push_back (make_pair ("Write-back",
+				&UT_DeviceCache::writeBack) );
+		else if (! elt.compare ("writeThrough") )
+			_tests.push_back (make_pair ("Write-through",
+				&UT_DeviceCache::writeThrough) );
+		else if (! elt.compare ("eviction") )
+			_tests.push_back (make_pair ("Eviction",
+				&UT_DeviceCache::eviction) );
+		else
+			LOG (WARNING) << ModuleNameMap.at (_module) << " unitary test "
+				<< "named '" << elt << "' does not match!";
+	}
+}
+
+UT_DeviceCache::~UT_DeviceCache () {  }
+
+#include "utest/utdevicecache.cpp"
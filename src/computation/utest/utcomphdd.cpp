@@ -0,0 +1,159 @@
+OGSS_Bool
+UT_CompHDD::sectorPosition () {
+	vector <Device>				devs (1);
+		devs [0] ._type = DTP_HDD; devs [0] ._clock = .0;
+		devs [0] ._physicalCapacity = 800;
+	HDDParameters				& h = devs [0] ._param.h;
+		h._sectorSize = 1; h._sectorsPerTrack = 8;
+		h._tracksPerPlatter = 100; h._numPlatters = 1;
+		h._minReadSeek = h._minWriteSeek = 1;
+		h._avgReadSeek = h._avgWriteSeek = 2;
+		h._maxReadSeek = h._maxWriteSeek = 4;
+		h._rotationSpeed = 8; h._transferRate = .5;
+		h._lastTrack = 0; h._lastSector = 0;
+	Request						req;
+
+	// 8 sectors by track and one rotation every 8 time units, so a sector
+	// passes under the head every time unit
+	CompHDD						model (devs, 0, 1, true);
+
+	req._idxDevice = 0;
+
+	if (model._angleStep [0] != .125 || model._invRotation [0] != .125)
+		return false;
+
+	// First sector of the track, then on the next tracks
+	req._deviceAddress = 0;
+	if (model.sectorAngle (req, devs [0]) != 0) return false;
+	req._deviceAddress = 3;
+	if (model.sectorAngle (req, devs [0]) != .375) return false;
+	req._deviceAddress = 8 + 5;
+	if (model.sectorAngle (req, devs [0]) != .625) return false;
+	req._deviceAddress = 16 * 8 + 7;
+
+	return model.sectorAngle (req, devs [0]) == .875;
+}
+
+OGSS_Bool
+UT_CompHDD::rotationalDelay () {
+	vector <Device>				devs (1);
+		devs [0] ._type = DTP_HDD; devs [0] ._clock = .0;
+		devs [0] ._physicalCapacity = 800;
+	HDDParameters				& h = devs [0] ._param.h;
+		h._sectorSize = 1; h._sectorsPerTrack = 8;
+		h._tracksPerPlatter = 100; h._numPlatters = 1;
+		h._minReadSeek = h._minWriteSeek = 1;
+		h._avgReadSeek = h._avgWriteSeek = 2;
+		h._maxReadSeek = h._maxWriteSeek = 4;
+		h._rotationSpeed = 8; h._transferRate = .5;
+		h._lastTrack = 0; h._lastSector = 0;
+	Request						req;
+
+	CompHDD						model (devs, 0, 1, true);
+
+	req._idxDevice = 0;
+	req._date = 0;
+
+	// The head is on sector 0, sector 3 is 3 time units away
+	if (model.rotDelay (req, devs [0], 0, .375, 1) != 3 || devs [0] ._clock != 4)
+		return false;
+
+	// The device is idle, the request starts at its arrival date and the
+	// head is on sector 1 (17 mod 8)
+	req._date = 17;
+	if (model.rotDelay (req, devs [0], 0, .125, 0) != 0 || devs [0] ._clock != 17)
+		return false;
+
+	// The head is on sector 4 after the seek (17 + 3), so sector 6 is
+	// 2 time units away
+	return model.rotDelay (req, devs [0], 3, .75, 0) == 2
+		&& devs [0] ._clock == 22;
+}
+
+OGSS_Bool
+UT_CompHDD::delayWrapAround () {
+	vector <Device>				devs (1);
+		devs [0] ._type = DTP_HDD; devs [0] ._clock = .0;
+		devs [0] ._physicalCapacity = 800;
+	HDDParameters				& h = devs [0] ._param.h;
+		h._sectorSize = 1; h._sectorsPerTrack = 8;
+		h._tracksPerPlatter = 100; h._numPlatters = 1;
+		h._minReadSeek = h._minWriteSeek = 1;
+		h._avgReadSeek = h._avgWriteSeek = 2;
+		h._maxReadSeek = h._maxWriteSeek = 4;
+		h._rotationSpeed = 8; h._transferRate = .5;
+		h._lastTrack = 0; h._lastSector = 0;
+	Request						req;
+
+	CompHDD						model (devs, 0, 1, true);
+
+	req._idxDevice = 0;
+	req._date = 0;
+
+	// The device is busy until 5, the head is on sector 5: sector 2 is
+	// reached after the end of the track, 5 time units later
+	devs [0] ._clock = 5;
+	if (model.rotDelay (req, devs [0], 0, .25, 0) != 5 || devs [0] ._clock != 10)
+		return false;
+
+	// The head is on sector 3 (10 + 1 mod 8) after the seek, sector 2 was
+	// just missed and needs almost a full rotation
+	if (model.rotDelay (req, devs [0], 1, .25, 0) != 7 || devs [0] ._clock != 18)
+		return false;
+
+	// The head is right on the sector, no delay
+	return model.rotDelay (req, devs [0], 0, .25, 0) == 0
+		&& devs [0] ._clock == 18;
+}
+
+OGSS_Bool
+UT_CompHDD::serviceTime () {
+	vector <Device>				devs (1);
+		devs [0] ._type = DTP_HDD; devs [0] ._clock = .0;
+		devs [0] ._physicalCapacity = 800;
+	HDDParameters				& h = devs [0] ._param.h;
+		h._sectorSize = 1; h._sectorsPerTrack = 8;
+		h._tracksPerPlatter = 100; h._numPlatters = 1;
+		h._minReadSeek = h._minWriteSeek = 1;
+		h._avgReadSeek = h._avgWriteSeek = 2;
+		h._maxReadSeek = h._maxWriteSeek = 4;
+		h._rotationSpeed = 8; h._transferRate = .5;
+		h._lastTrack = 0; h._lastSector = 0;
+	vector <Device>				batchDevs {devs};
+	vector <Request>			reqs (3);
+	vector <Request *>			batch;
+
+	CompHDD						model (devs, 0, 1, true);
+	CompHDD						batchModel (batchDevs, 0, 1, true);
+
+	for (auto & elt: reqs) {
+		elt._idxDevice = 0;
+		elt._type = RQT_READ;
+		elt._date = 0;
+		elt._size = 2;
+	}
+
+	// Same track: no seek, a delay to sector 4, then to sector 6 from the
+	// end of the previous request, then a wrap-around to sector 1
+	reqs [0] ._deviceAddress = 4;
+	reqs [1] ._deviceAddress = 6;
+	reqs [2] ._deviceAddress = 1;
+
+	for (auto & elt: reqs) {
+		Request					copy {elt};
+
+		model.compute (copy);
+		batch.push_back (&elt);
+		elt._serviceTime = copy._serviceTime;
+	}
+
+	if (reqs [0] ._serviceTime != 5 || reqs [1] ._serviceTime != 2
+		|| reqs [2] ._serviceTime != 3 || devs [0] ._clock != 10) return false;
+
+	// The batches give the same service times
+	for (auto & elt: reqs) elt._serviceTime = -1;
+	batchModel.computeBatch (batch);
+
+	return reqs [0] ._serviceTime == 5 && reqs [1] ._serviceTime == 2
+		&& reqs [2] ._serviceTime == 3 && batchDevs [0] ._clock == 10;
+}
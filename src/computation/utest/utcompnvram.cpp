@@ -0,0 +1,99 @@
+OGSS_Bool
+UT_CompNVRAM::bankConflict () {
+	vector <Device>				devs (1);
+		devs [0] ._type = DTP_NVRAM;
+	NVRAMParameters				& n = devs [0] ._param.n;
+		n._nbChips = 1; n._bytesPerCol = 1; n._cols = 4;
+		n._rows = 32; n._nbBanks = 2;
+		n._read = n._write = 10; n._activation = 4;
+	Request						req (0, 4, 0, RQT_READ);
+		req._idxDevice = 0;
+
+	// A cycle reads one byte, a row is 4 cycles and a bank holds 16 rows
+	CompNVRAM					model (devs, 0, 1, true);
+
+	// Rows 0 and 2 are on bank 0: a cycle costs 6, plus 4 to open a row
+	req._deviceAddress = 0;		model.compute (req);
+	if (req._serviceTime != 28) return false;
+	req._deviceAddress = 8;		model.compute (req);
+	if (req._serviceTime != 28) return false;
+
+	// Row 2 is still open, then row 0 has to be opened again
+	req._deviceAddress = 8;		model.compute (req);
+	if (req._serviceTime != 24) return false;
+	req._deviceAddress = 0;		model.compute (req);
+	if (req._serviceTime != 28) return false;
+
+	// Rows 0 and 2 in one request are served one after the other
+	n._rows = 16; n._nbBanks = 1;
+
+	CompNVRAM					single (devs, 0, 1, true);
+
+	req._size = 8;				single.compute (req);
+
+	return req._serviceTime == 56;
+}
+
+OGSS_Bool
+UT_CompNVRAM::parallelBanks () {
+	vector <Device>				devs (1);
+		devs [0] ._type = DTP_NVRAM;
+	NVRAMParameters				& n = devs [0] ._param.n;
+		n._nbChips = 1; n._bytesPerCol = 1; n._cols = 4;
+		n._rows = 32; n._nbBanks = 2;
+		n._read = n._write = 10; n._activation = 4;
+	Request						req (0, 8, 0, RQT_READ);
+		req._idxDevice = 0;
+
+	CompNVRAM					model (devs, 0, 1, true);
+
+	// Rows 0 and 1 overlap on banks 0 and 1
+	req._deviceAddress = 0;		model.compute (req);
+	if (req._serviceTime != 28) return false;
+
+	// Both rows stay open
+	req._deviceAddress = 1;		req._size = 6;
+	model.compute (req);
+	if (req._serviceTime != 18) return false;
+
+	// Cycles 2 to 13 on 4 banks: the busiest banks hold a full row
+	n._rows = 64; n._nbBanks = 4;
+
+	CompNVRAM					banked (devs, 0, 1, true);
+	CompNVRAM					serial (devs, 0, 1);
+
+	req._deviceAddress = 2;		req._size = 12;
+	banked.compute (req);
+	if (req._serviceTime != 28) return false;
+	serial.compute (req);
+
+	return req._serviceTime == 120;
+}
+
+OGSS_Bool
+UT_CompNVRAM::singleBank () {
+	vector <Device>				devs (1);
+		devs [0] ._type = DTP_NVRAM;
+	NVRAMParameters				& n = devs [0] ._param.n;
+		n._nbChips = 1; n._bytesPerCol = 1; n._cols = 4;
+		n._rows = 16; n._nbBanks = 1;
+		n._read = n._write = 10; n._activation = 0;
+	Request						req (0, 8, 0, RQT_READ);
+		req._idxDevice = 0;
+
+	CompNVRAM					banked (devs, 0, 1, true);
+	CompNVRAM					serial (devs, 0, 1);
+
+	// Without activation time, the aligned requests take the same time
+	banked.compute (req);
+	if (req._serviceTime != 80) return false;
+	serial.compute (req);
+	if (req._serviceTime != 80) return false;
+
+	req._deviceAddress = 4;		req._size = 4;
+	banked.compute (req);
+	if (req._serviceTime != 40) return false;
+	serial.compute (req);
+
+	return req._serviceTime == 40;
+}
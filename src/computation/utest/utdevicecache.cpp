@@ -0,0 +1,138 @@
+OGSS_Bool
+UT_DeviceCache::readHitMiss () {
+	vector <Device>				devs (1);
+		devs [0] ._type = DTP_HDD; devs [0] ._physicalCapacity = 1024;
+		devs [0] ._bufferSize = 64; devs [0] ._numSegments = 4;
+		devs [0] ._writeCache = CCP_WRITETHROUGH;
+	vector <Request>			reqs {{0, 8, 0}, {0, 8, 8}, {0, 8, 4},
+		{0, 8, 12}, {0, 4, 0}, {0, 8, 20}, {0, 8, 500}, {0, 8, 1016},
+		{0, 8, 20}};
+	vector <Request *>			batch;
+
+	// A buffer of 4 segments of 16 units
+	DeviceCache					cache (devs, 0, 1);
+
+	if (! cache.isEnabled () || DeviceCache () .isEnabled () ) return false;
+
+	for (auto & elt: reqs) {
+		elt._deviceAddress = elt._address;
+		batch.push_back (&elt);
+	}
+	reqs [8] ._internal = true;
+
+	cache.filter (batch);
+
+	// The miss fills a segment with the request and the following data. A
+	// read crossing the end of the segment is a miss, and the segment is
+	// refilled from the end of the request. The internal requests of the
+	// controller do not use the buffer
+	if (batch != vector <Request *> {&reqs [0], &reqs [3], &reqs [4],
+		&reqs [6], &reqs [7], &reqs [8]}) return false;
+
+	// The misses are computed with their read-ahead, up to the end of their
+	// segment or of the device, and get back their size once settled
+	if (reqs [0] ._size != 16 || reqs [3] ._size != 16 || reqs [4] ._size != 16
+		|| reqs [6] ._size != 16 || reqs [7] ._size != 8 || reqs [8] ._size != 8)
+		return false;
+
+	cache.settle (batch);
+
+	return reqs [0] ._size == 8 && reqs [3] ._size == 8 && reqs [4] ._size == 4
+		&& reqs [6] ._size == 8 && reqs [7] ._size == 8 && reqs [8] ._size == 8;
+}
+
+OGSS_Bool
+UT_DeviceCache::writeBack () {
+	vector <Device>				devs (1);
+		devs [0] ._type = DTP_HDD; devs [0] ._physicalCapacity = 1024;
+		devs [0] ._bufferSize = 64; devs [0] ._numSegments = 4;
+		devs [0] ._writeCache = CCP_WRITEBACK;
+	vector <Request>			reqs {{0, 8, 100, RQT_WRITE}, {0, 8, 100},
+		{0, 8, 200}, {0, 16, 300, RQT_WRITE}, {0, 16, 400, RQT_WRITE},
+		{0, 16, 500, RQT_WRITE}, {0, 16, 600, RQT_WRITE},
+		{0, 16, 700, RQT_WRITE}, {0, 8, 0, RQT_WRITE}, {0, 32, 0, RQT_WRITE}};
+	vector <OGSS_Real>			media {5, 0, 3, 1, 1, 1, 1, 1, 2, 4};
+	vector <Request *>			batch;
+
+	DeviceCache					cache (devs, 0, 1);
+
+	// The media times are the ones of the computation model
+	for (OGSS_Ulong i = 0; i < reqs.size (); ++i) {
+		reqs [i] ._deviceAddress = reqs [i] ._address;
+		reqs [i] ._serviceTime = media [i];
+		batch.push_back (&reqs [i]);
+	}
+
+	cache.filter (batch);
+
+	// The write is acknowledged by the buffer and can be read back
+	if (batch.size () != reqs.size () - 1 || reqs [1] ._serviceTime != 0)
+		return false;
+
+	cache.settle (batch);
+
+	// The next request going to the media pays the write. The buffer holds
+	// 64 units of writes, the next one destages them. A write larger than a
+	// segment goes to the media
+	return reqs [0] ._serviceTime == 0 && reqs [2] ._serviceTime == 8
+		&& reqs [3] ._serviceTime == 0 && reqs [4] ._serviceTime == 0
+		&& reqs [5] ._serviceTime == 0 && reqs [6] ._serviceTime == 0
+		&& reqs [7] ._serviceTime == 5 && reqs [8] ._serviceTime == 0
+		&& reqs [9] ._serviceTime == 6;
+}
+
+OGSS_Bool
+UT_DeviceCache::writeThrough () {
+	vector <Device>				devs (1);
+		devs [0] ._type = DTP_HDD; devs [0] ._physicalCapacity = 1024;
+		devs [0] ._bufferSize = 64; devs [0] ._numSegments = 4;
+		devs [0] ._writeCache = CCP_WRITETHROUGH;
+	vector <Request>			reqs {{0, 8, 100, RQT_WRITE}, {0, 8, 100},
+		{0, 8, 200}, {0, 8, 208}, {0, 2, 204, RQT_WRITE}, {0, 8, 208}};
+	vector <Request *>			batch;
+
+	DeviceCache					cache (devs, 0, 1);
+
+	for (auto & elt: reqs) {
+		elt._deviceAddress = elt._address;
+		elt._serviceTime = 1;
+		batch.push_back (&elt);
+	}
+
+	cache.filter (batch);
+
+	// The write goes to the media and is not kept. A write drops the
+	// segment it overlaps
+	if (batch != vector <Request *> {&reqs [0], &reqs [1], &reqs [2],
+		&reqs [4], &reqs [5]}) return false;
+
+	cache.settle (batch);
+
+	return reqs [0] ._serviceTime == 1 && reqs [4] ._serviceTime == 1;
+}
+
+OGSS_Bool
+UT_DeviceCache::eviction () {
+	vector <Device>				devs (1);
+		devs [0] ._type = DTP_HDD; devs [0] ._physicalCapacity = 1024;
+		devs [0] ._bufferSize = 64; devs [0] ._numSegments = 4;
+		devs [0] ._writeCache = CCP_WRITETHROUGH;
+	vector <Request>			reqs;
+	vector <Request *>			batch;
+
+	DeviceCache					cache (devs, 0, 1);
+
+	for (OGSS_Ulong addr: {0, 100, 200, 300, 0, 400, 0, 200, 300, 400, 100})
+		reqs.push_back (Request (0, 8, addr) );
+
+	for (auto & elt: reqs) {
+		elt._deviceAddress = elt._address;
+		batch.push_back (&elt);
+	}
+
+	cache.filter (batch);
+
+	// Segment 0 is used again, the least recently used one is segment 100
+	return batch == vector <Request *> {&reqs [0], &reqs [1], &reqs [2],
+		&reqs [3], &reqs [5], &reqs [10]};
+}
@@ -35,7 +35,7 @@
 #include "controller/raidnpnodecvolctrl.hpp"
 #include "controller/raidnppardecvolctrl.hpp"
 
-#include "controller/perfparityctrl.hpp"
+#include "controller/fixedparityctrl.hpp"
 
 #include "scheme/sd2sscheme.hpp"
 
@@ -72,18 +72,18 @@ DecRAIDVolCtrl::decompose (
 	OGSS_Ushort previousIdx = 0;
 	OGSS_Ulong previousOff = 0;
 
-	for (auto elt: _redirectionTable) {
+	for (auto & elt: _redirectionTable) {
 		if (request._volumeAddress < elt.second) {
-			Request			block {request};
+			_block = request;
 
-			block._volumeAddress -= previousOff;
+			_block._volumeAddress -= previousOff;
 			request._volumeAddress -= previousOff;
 
-			_volCtrls [elt.first] ->getBlockLocation (block);
+			_volCtrls [elt.first] ->getBlockLocation (_block);
 
-			block._volumeAddress += previousOff;
-			block._idxDevice += previousIdx;
-			_scheme->realloc (block);
+			_block._volumeAddress += previousOff;
+			_block._idxDevice += previousIdx;
+			_scheme->realloc (_block);
 
 			_volCtrls [elt.first] ->decompose (request, subrequests);
 
@@ -93,7 +93,7 @@ DecRAIDVolCtrl::decompose (
 				_scheme->realloc (flt);
 			}
 
-			request._idxDevice = block._idxDevice;
+			request._idxDevice = _block._idxDevice;
 
 			break;
 		}
@@ -292,7 +292,7 @@ DecRAIDVolCtrl::updateMapping (
 				break;
 			default: break;
 			}
-*/			_volCtrls [devCnt] = make_unique <PerfectParityCtrl> (elt, dev);
+*/			_volCtrls [devCnt] = createParityCtrl (elt, dev);
 			break;
 		default: break;
 		}
@@ -0,0 +1,127 @@
+/*
+ * Copyright UVSQ - CEA/DAM/DIF (2017-2018)
+ * Contributors:  Sebastien GOUGEAUD  -- sebastien.gougeaud@uvsq.fr
+ *                Soraya ZERTAL       --      soraya.zertal@uvsq.fr
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+//! \file	fixedparityctrl.cpp
+//! \brief	Selection of the parity controller, specialized or generic,
+//!			according to the volume geometry.
+
+/*----------------------------------------------------------------------------*/
+/* HEADERS -------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#include <random>
+
+#include "controller/fixedparityctrl.hpp"
+
+#include "parser/xmlparser.hpp"
+
+#include "util/chrono.hpp"
+
+#if USE_STATIC_GLOG
+#include "glog/logging.h"
+#else
+#include <glog/logging.h>
+#endif
+
+using namespace std;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTIONS ----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+unique_ptr <VolumeController>
+createParityCtrl (
+	const Volume						& vol,
+	const Device						& dev) {
+	OGSS_Ulong							numData {static_cast <OGSS_Ulong> (
+		vol._numDevices - vol._numRedundancyDevices) };
+
+	if (vol._suSize && ! (vol._suSize & (vol._suSize - 1) ) ) {
+		if (numData == 4 && vol._numRedundancyDevices == 1)
+			return make_unique <FixedParityCtrl <4, 1>> (vol, dev);
+		if (numData == 8 && vol._numRedundancyDevices == 1)
+			return make_unique <FixedParityCtrl <8, 1>> (vol, dev);
+		if (numData == 8 && vol._numRedundancyDevices == 2)
+			return make_unique <FixedParityCtrl <8, 2>> (vol, dev);
+		if (numData == 16 && vol._numRedundancyDevices == 2)
+			return make_unique <FixedParityCtrl <16, 2>> (vol, dev);
+	}
+
+	DLOG(INFO) << "No specialized parity controller for " << numData << "+"
+		<< vol._numRedundancyDevices << " (SU " << vol._suSize << "), the "
+		<< "generic one is selected";
+
+	return make_unique <PerfectParityCtrl> (vol, dev);
+}
+
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+UT_FixedParityCtrl::UT_FixedParityCtrl (
+	const OGSS_String		& configurationFile):
+	UnitaryTest <UT_FixedParityCtrl> (MTP_VOLFIXEDPARITY) {
+	set <OGSS_String>		testNames;
+
+	XMLParser::getListOfRequestedUnitaryTests (
+		configurationFile, _module, testNames);
+
+	for (auto & elt: testNames) {
+		if (! elt.compare ("all") ) {
+			_tests.push_back (make_pair ("Layout 4+1",
+				&UT_FixedParityCtrl::layout4p1) );
+			_tests.push_back (make_pair ("Layout 8+1",
+				&UT_FixedParityCtrl::layout8p1) );
+			_tests.push_back (make_pair ("Layout 8+2",
+				&UT_FixedParityCtrl::layout8p2) );
+			_tests.push_back (make_pair ("Layout 16+2",
+				&UT_FixedParityCtrl::layout16p2) );
+			_tests.push_back (make_pair ("Layout 8+2 declustered",
+				&UT_FixedParityCtrl::layout8p2Declustered) );
+			_tests.push_back (make_pair ("Range decomposition",
+				&UT_FixedParityCtrl::rangeDecomposition) );
+		} else if (! elt.compare ("4p1") )
+			_tests.push_back (make_pair ("Layout 4+1",
+				&UT_FixedParityCtrl::layout4p1) );
+		else if (! elt.compare ("8p1") )
+			_tests.push_back (make_pair ("Layout 8+1",
+				&UT_FixedParityCtrl::layout8p1) );
+		else if (! elt.compare ("8p2") )
+			_tests.push_back (make_pair ("Layout 8+2",
+				&UT_FixedParityCtrl::layout8p2) );
+		else if (! elt.compare ("16p2") )
+			_tests.push_back (make_pair ("Layout 16+2",
+				&UT_FixedParityCtrl::layout16p2) );
+		else if (! elt.compare ("8p2dec") )
+			_tests.push_back (make_pair ("Layout 8+2 declustered",
+				&UT_FixedParityCtrl::layout8p2Declustered) );
+		else if (! elt.compare ("ranges") )
+			_tests.push_back (make_pair ("Range decomposition",
+				&UT_FixedParityCtrl::rangeDecomposition) );
+		else
+			LOG (WARNING) << ModuleNameMap.at (_module) << " unitary test "
+				<< "named '" << elt << "' does not match!";
+	}
+}
+
+UT_FixedParityCtrl::~UT_FixedParityCtrl () {  }
+
+#include "utest/utfixedparity.cpp"
@@ -43,6 +43,7 @@ HDDCtrl::~HDDCtrl () {  }
 
 void
 HDDCtrl::translate (
-	Request					& request) {
-	DLOG(INFO) << "Need to translate for HDD";
+	Request					& request,
+	std::vector <Request>	& internals) {
+	// No translation, the device addresses are the physical ones
 }
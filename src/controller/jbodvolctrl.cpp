@@ -65,7 +65,7 @@ JBODVolCtrl::decompose (
 	remainingSize = request._size;
 
 	while (remainingSize > 0) {
-		Request				sr {request};
+		Request				& sr = appendChild (request, subrequests);
 
 		sr._size = min (_numBytesByDev - addr % _numBytesByDev, remainingSize);
 		sr._deviceAddress = addr % _numBytesByDev;
@@ -82,8 +82,6 @@ JBODVolCtrl::decompose (
 
 		++ request._numChild;
 
-		subrequests.push_back (sr);
-
 		addr += sr._size;
 		remainingSize -= sr._size;
 	}
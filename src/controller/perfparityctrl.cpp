@@ -31,77 +31,12 @@
 
 #include "controller/perfparityctrl.hpp"
 
-#include <set>
+#include <algorithm>
 
 #include <glog/logging.h>
 
 using namespace std;
 
-typedef set <Request, OGSS_Bool (*) (Request, Request)>
-										__RequestSet;
-
-/*----------------------------------------------------------------------------*/
-/* STATIC FUNCTIONS ----------------------------------------------------------*/
-/*----------------------------------------------------------------------------*/
-
-static OGSS_Bool
-__requestCompare (
-	Request								lhs,
-	Request								rhs) {
-	return (lhs._type == RQT_READ && rhs._type == RQT_WRITE)
-		|| (lhs._type == rhs._type && lhs._idxDevice < rhs._idxDevice)
-		|| (lhs._type == rhs._type && lhs._idxDevice == rhs._idxDevice && lhs._deviceAddress < rhs._deviceAddress);
-}
-
-static void
-__removeAndMerge (
-	Request								& request,
-	vector <Request>					& subrequests) {
-	__RequestSet						tmp (__requestCompare);
-
-	for (auto elt: subrequests)			tmp.insert (elt);
-	subrequests.clear ();
-
-	auto 								c = tmp.begin ();
-	auto								p = c;
-	OGSS_Bool							building {false};
-	Request								flt;
-	auto								idx {1};
-
-	request._numChild = request._numPrioChild = 0;
-
-	for (++c; c != tmp.end (); ++c, ++p) {
-		if (! building) {
-			flt = *p;
-			building = true;
-		}
-
-		if (flt._type != c->_type
-		 || flt._idxDevice != c->_idxDevice
-		 || flt._deviceAddress + flt._size != c->_deviceAddress) {
-		 	flt._minrIdx = idx ++;
-			subrequests.push_back (flt);
-			++ request._numChild;
-			if (flt._prio) ++ request._numPrioChild;
-			building = false;
-			continue;
-		}
-
-		flt._size += c->_size;
-	}
-
-	++ request._numChild;
-	if (building) {
-		flt._minrIdx = idx;
-		subrequests.push_back (flt);
-		if (flt._prio) ++ request._numPrioChild;
-	} else {
-		subrequests.push_back (*tmp.rbegin () );
-		subrequests.back () ._minrIdx = idx;
-		if (tmp.rbegin () ->_prio) ++ request._numPrioChild;
-	}
-}
-
 /*----------------------------------------------------------------------------*/
 /* MEMBER FUNCTIONS ----------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
@@ -115,6 +50,7 @@ PerfectParityCtrl::PerfectParityCtrl (
 	_numParity							= vol._numRedundancyDevices;
 	_numData							= _numDevices - _numParity;
 	_parity								= vol._declustering;
+	_rangeDecomposition					= vol._rangeDecomposition;
 }
 
 PerfectParityCtrl::~PerfectParityCtrl () {  }
@@ -125,11 +61,21 @@ PerfectParityCtrl::decompose (
 	vector <Request>					& subrequests) {
 	OGSS_Ulong							addr {request._volumeAddress};
 	OGSS_Ulong							remainingSize {request._size};
+	OGSS_Ulong							stripeSize {_numData * _numMUBySU};
+	OGSS_Ulong							first {(addr + stripeSize - 1) / stripeSize};
+	OGSS_Ulong							last {(addr + remainingSize) / stripeSize};
+	OGSS_Bool							ranges {_useRanges (request, first, last)};
 
 	while (remainingSize) {
-		auto							sIdx {addr / (_numData * _numMUBySU)};
-		auto							sStart {addr % (_numData * _numMUBySU)};
-		auto							sEnd {min (sStart + remainingSize, _numData * _numMUBySU)};
+		auto							sIdx {addr / stripeSize};
+		auto							sStart {addr % stripeSize};
+		auto							sEnd {min (sStart + remainingSize, stripeSize)};
+
+		if (ranges && sIdx == first) {				// Full stripes are done by range
+			addr += (last - first) * stripeSize;
+			remainingSize -= (last - first) * stripeSize;
+			continue;
+		}
 
 		if (request._type == RQT_WRITE)
 			_getPrereadStripe (request, subrequests, sIdx, sStart, sEnd);
@@ -141,7 +87,8 @@ PerfectParityCtrl::decompose (
 	}
 
 	_realloc (subrequests);
-	__removeAndMerge (request, subrequests);
+	if (ranges) _getDeviceRanges (request, subrequests, first, last);
+	_removeAndMerge (request, subrequests);
 }
 
 void
@@ -404,6 +351,29 @@ PerfectParityCtrl::_getDataStripe (
 	}
 }
 
+void
+PerfectParityCtrl::_getDeviceRanges (
+	Request						& parent,
+	vector <Request>			& children,
+	OGSS_Ulong					first,
+	OGSS_Ulong					last) {
+	Request						child {parent};
+	OGSS_Ulong					numTargets {parent._type == RQT_WRITE ? _numDevices : _numData};
+
+	child._deviceAddress = first * _numMUBySU;
+	child._size = (last - first) * _numMUBySU;
+	child._numPrioChild = 0;
+	child._prio = false;
+	child._numLink = first;
+
+	for (OGSS_Ulong i {0}; i < numTargets; ++i) {	// Same rows on each device
+		child._idxDevice = i;
+
+		++ parent._numChild;
+		children.push_back (child);
+	}
+}
+
 void
 PerfectParityCtrl::_realloc (
 	vector <Request>					& requests) {
@@ -40,68 +40,6 @@
 
 using namespace std;
 
-typedef set <Request, OGSS_Bool (*) (Request, Request)>
-										__RequestSet;
-
-static OGSS_Bool
-__requestCompare (
-	Request								lhs,
-	Request								rhs) {
-	return (lhs._type == RQT_READ && rhs._type == RQT_WRITE)
-		|| (lhs._type == rhs._type && lhs._idxDevice < rhs._idxDevice)
-		|| (lhs._type == rhs._type && lhs._idxDevice == rhs._idxDevice && lhs._deviceAddress < rhs._deviceAddress);
-}
-
-static void
-__removeAndMerge (
-	Request								& request,
-	vector <Request>					& subrequests) {
-	__RequestSet						tmp (__requestCompare);
-
-	for (auto elt: subrequests)			tmp.insert (elt);
-	subrequests.clear ();
-
-	auto 								c = tmp.begin ();
-	auto								p = c;
-	OGSS_Bool							building {false};
-	Request								flt;
-	auto								idx {1};
-
-	request._numChild = request._numPrioChild = 0;
-
-	for (++c; c != tmp.end (); ++c, ++p) {
-		if (! building) {
-			flt = *p;
-			building = true;
-		}
-
-		if (flt._type != c->_type
-		 || flt._idxDevice != c->_idxDevice
-		 || flt._deviceAddress + flt._size != c->_deviceAddress) {
-		 	flt._minrIdx = idx ++;
-			subrequests.push_back (flt);
-			++ request._numChild;
-			if (flt._prio) ++ request._numPrioChild;
-			building = false;
-			continue;
-		}
-
-		flt._size += c->_size;
-	}
-
-	++ request._numChild;
-	if (building) {
-		flt._minrIdx = idx;
-		subrequests.push_back (flt);
-		if (flt._prio) ++ request._numPrioChild;
-	} else {
-		subrequests.push_back (*tmp.rbegin () );
-		subrequests.back () ._minrIdx = idx;
-		if (tmp.rbegin () ->_prio) ++ request._numPrioChild;
-	}
-}
-
-
 /*----------------------------------------------------------------------------*/
 /* PUBLIC FUNCTIONS ----------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
@@ -113,8 +51,9 @@ RAID01VolCtrl::RAID01VolCtrl (
 	_numBytesBySU			= vol._suSize;
 	_numDevices				= vol._numDevices;
 	_mirrorChosen			= true;
-	_failedDevices			= set <OGSS_Ushort> ();
-	_failureDates			= map <OGSS_Ushort, OGSS_Real> ();
+
+	LOG_IF (FATAL, _numDevices > OGSS_MAXVOLUMEDEVICES) << "A volume can not have more than "
+		<< OGSS_MAXVOLUMEDEVICES << " devices";
 }
 RAID01VolCtrl::~RAID01VolCtrl () {  }
 
@@ -129,8 +68,10 @@ RAID01VolCtrl::decompose (
 	addr = request._volumeAddress;
 	remainingSize = request._size;
 
+	_failures.update (request._date);
+
 	while (remainingSize > 0) {
-		Request				sr {request}, srm {request};
+		Request				& sr = appendChild (request, subrequests);
 
 		sr._size = min (_numBytesBySU - addr % _numBytesBySU, remainingSize);
 		sr._deviceAddress = (addr / (_numBytesBySU * (_numDevices / 2) )
@@ -141,7 +82,9 @@ RAID01VolCtrl::decompose (
 		sr._majrIdx = request._majrIdx;
 		sr._minrIdx = ++cnt;
 		sr._type = request._type;
-		sr._prio = false; srm._prio = false;
+		sr._prio = false;
+
+		const OGSS_Ulong	size {sr._size};
 
 		++ request._numChild;
 
@@ -149,43 +92,48 @@ RAID01VolCtrl::decompose (
 			sr._idxDevice = _mirrorChosen ? sr._idxDevice
 				: sr._idxDevice + _numDevices / 2;
 
-			if (_failedDevices.find (sr._idxDevice) != _failedDevices.end ()
-				&& _failureDates.at (sr._idxDevice) <= sr._date)
+			if (_failures.isFailed (sr._idxDevice) )
 				sr._idxDevice = (!_mirrorChosen) ? sr._idxDevice
 					: sr._idxDevice + _numDevices / 2;
 
 			request._idxDevice = sr._idxDevice;
 			request._deviceAddress = sr._deviceAddress;
-
-			subrequests.push_back (sr);
 		} else {
-			srm = sr;
-
-			srm._idxDevice = sr._idxDevice + _numDevices / 2;
-			srm._minrIdx = ++cnt;
+			const OGSS_Ulong	mirror {sr._idxDevice + _numDevices / 2};
 
+			++ cnt;
 			++ request._numChild;
 
-			if (_failedDevices.find (sr._idxDevice) == _failedDevices.end ()
-				|| _failureDates.at (sr._idxDevice) > sr._date) {
-				subrequests.push_back (sr);
-			} else -- request._numChild;
-			if (_failedDevices.find (srm._idxDevice) == _failedDevices.end ()
-				|| _failureDates.at (srm._idxDevice) > srm._date) {
-				subrequests.push_back (srm);
-			} else -- request._numChild;
-
 			request._idxDevice = sr._idxDevice;
 			request._deviceAddress = sr._deviceAddress;
+
+			// The mirror child is built from the primary one, which is reused
+			// for it when the primary device is failed
+			if (_failures.isFailed (sr._idxDevice) ) {
+				-- request._numChild;
+
+				if (! _failures.isFailed (mirror) ) {
+					sr._idxDevice = mirror;
+					sr._minrIdx = cnt;
+				} else {
+					-- request._numChild;
+					subrequests.pop_back ();
+				}
+			} else if (! _failures.isFailed (mirror) ) {
+				Request		& srm = appendChild (sr, subrequests);
+
+				srm._idxDevice = mirror;
+				srm._minrIdx = cnt;
+			} else -- request._numChild;
 		}
 
-		addr += sr._size;
-		remainingSize -= sr._size;
+		addr += size;
+		remainingSize -= size;
 	}
 
 	if (request._type == RQT_READ) _mirrorChosen = ! _mirrorChosen;
 
-	__removeAndMerge (request, subrequests);
+	_removeAndMerge (request, subrequests);
 }
 
 void
@@ -196,8 +144,7 @@ RAID01VolCtrl::updateScheme (
 	LOG(INFO) << "RAID1 receives an event on local disk #" << event._idxDevice;
 
 	if (event._type == RQT_EVFLT) {
-		_failedDevices.insert (event._idxDevice);
-		_failureDates [event._idxDevice] = event._date;
+		_failures.schedule (event._idxDevice, event._date);
 	}
 }
 
@@ -349,6 +296,8 @@ UT_RAID01VolCtrl::UT_RAID01VolCtrl (
 				&UT_RAID01VolCtrl::readRequests) );
 			_tests.push_back (make_pair ("Write request",
 				&UT_RAID01VolCtrl::writeRequest) );
+			_tests.push_back (make_pair ("Steady child buffer",
+				&UT_RAID01VolCtrl::steadyBuffer) );
 		} else if (! elt.compare ("smallStripe") )
 			_tests.push_back (make_pair ("Small stripe request",
 				&UT_RAID01VolCtrl::smallStripeRequest) );
@@ -370,6 +319,9 @@ UT_RAID01VolCtrl::UT_RAID01VolCtrl (
 		else if (! elt.compare ("writeRequest") )
 			_tests.push_back (make_pair ("Write request",
 				&UT_RAID01VolCtrl::writeRequest) );
+		else if (! elt.compare ("steadyBuffer") )
+			_tests.push_back (make_pair ("Steady child buffer",
+				&UT_RAID01VolCtrl::steadyBuffer) );
 		else
 			LOG (WARNING) << ModuleNameMap.at (_module) << " unitary test "
 				<< "named '" << elt << "' does not match!";
@@ -573,3 +525,39 @@ UT_RAID01VolCtrl::writeRequest () {
 
 	return true;
 }
+
+OGSS_Bool
+UT_RAID01VolCtrl::steadyBuffer () {
+	RAID01VolCtrl			module ( (Volume () ), (Device () ) );
+	Request					req;
+	vector <Request>		sr;
+	const Request			* data;
+
+	module._numBytesByDev = 16;
+	module._numBytesBySU = 4;
+	module._numDevices = 4;
+	module._mirrorChosen = true;
+
+	// The largest request sets the capacity of the buffer
+	req._size = 32;
+	req._volumeAddress = 0;
+	req._type = RQT_WRITE;
+
+	module.decompose (req, sr);
+	data = sr.data ();
+
+	// Once the capacity is reached, the buffer is never reallocated
+	for (OGSS_Ulong i = 0; i < 1000; ++i) {
+		req._size = 1 + i % 32;
+		req._volumeAddress = (7 * i) % (32 - req._size + 1);
+		req._type = i % 3 ? RQT_READ : RQT_WRITE;
+		req._numChild = req._numPrioChild = 0;
+
+		sr.clear ();
+		module.decompose (req, sr);
+
+		if (sr.data () != data || sr.empty () ) return false;
+	}
+
+	return true;
+}
@@ -50,8 +50,9 @@ RAID1VolCtrl::RAID1VolCtrl (
 	_numBytesByDev			= dev._physicalCapacity;
 	_numDevices				= vol._numDevices;
 	_mirrorChosen			= true;
-	_failedDevices			= set <OGSS_Ushort> ();
-	_failureDates			= map <OGSS_Ushort, OGSS_Real> ();
+
+	LOG_IF (FATAL, _numDevices > OGSS_MAXVOLUMEDEVICES) << "A volume can not have more than "
+		<< OGSS_MAXVOLUMEDEVICES << " devices";
 }
 
 RAID1VolCtrl::~RAID1VolCtrl () {  }
@@ -64,11 +65,13 @@ RAID1VolCtrl::decompose (
 	OGSS_Ulong				remainingSize;
 	OGSS_Ulong				cnt = 0;
 
+	_failures.update (request._date);
+
 	addr = request._volumeAddress;
 	remainingSize = request._size;
 
 	while (remainingSize > 0) {
-		Request				sr {request}, srm {request};
+		Request				& sr = appendChild (request, subrequests);
 
 		sr._size = min (_numBytesByDev - addr % _numBytesByDev, remainingSize);
 		sr._deviceAddress = addr % _numBytesByDev;
@@ -77,7 +80,9 @@ RAID1VolCtrl::decompose (
 		sr._mainIdx = request._mainIdx;
 		sr._majrIdx = request._majrIdx;
 		sr._minrIdx = ++cnt;
-		sr._prio = srm._prio = false;
+		sr._prio = false;
+
+		const OGSS_Ulong	size {sr._size};
 
 		++ request._numChild;
 
@@ -85,30 +90,27 @@ RAID1VolCtrl::decompose (
 			sr._idxDevice = _mirrorChosen ? sr._idxDevice
 				: sr._idxDevice + _numDevices / 2;
 
-			if (_failedDevices.find (sr._idxDevice) != _failedDevices.end ()
-				&& _failureDates.at (sr._idxDevice) <= sr._date)
+			if (_failures.isFailed (sr._idxDevice) )
 				sr._idxDevice = (!_mirrorChosen) ? sr._idxDevice
 					: sr._idxDevice + _numDevices / 2;
-
-			subrequests.push_back (sr);
 		} else {
-			srm = sr;
-
-			srm._idxDevice = sr._idxDevice + _numDevices / 2;
-			srm._minrIdx = ++cnt;
+			const OGSS_Ulong	mirror {sr._idxDevice + _numDevices / 2};
 
+			++ cnt;
 			++ request._numChild;
 
-			if (_failedDevices.find (sr._idxDevice) != _failedDevices.end ()
-				&& _failureDates.at (sr._idxDevice) <= sr._date)
-				subrequests.push_back (sr);
-			else if (_failedDevices.find (srm._idxDevice) != _failedDevices.end ()
-				&& _failureDates.at (srm._idxDevice) <= srm._date)
-				subrequests.push_back (srm);
+			// The child is kept on the primary device, moved to the mirror
+			// one, or dropped
+			if (! _failures.isFailed (sr._idxDevice) ) {
+				if (_failures.isFailed (mirror) ) {
+					sr._idxDevice = mirror;
+					sr._minrIdx = cnt;
+				} else subrequests.pop_back ();
+			}
 		}
 
-		addr += sr._size;
-		remainingSize -= sr._size;
+		addr += size;
+		remainingSize -= size;
 	}
 
 	if (request._type == RQT_READ) _mirrorChosen = ! _mirrorChosen;
@@ -121,8 +123,7 @@ RAID1VolCtrl::updateScheme (
 	LOG(INFO) << "RAID1 receives an event on local disk #" << event._idxDevice;
 
 	if (event._type == RQT_EVFLT) {
-		_failedDevices.insert (event._idxDevice);
-		_failureDates [event._idxDevice] = event._date;
+		_failures.schedule (event._idxDevice, event._date);
 	}
 }
 
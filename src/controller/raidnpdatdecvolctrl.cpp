@@ -51,6 +51,9 @@ RAIDNPDatDecVolCtrl::RAIDNPDatDecVolCtrl (
 	_numBytesBySU			= vol._suSize;
 	_numDevices				= vol._numDevices;
 	_numParity				= vol._numRedundancyDevices;
+
+	LOG_IF (FATAL, _numDevices > OGSS_MAXVOLUMEDEVICES) << "A volume can not have more than "
+		<< OGSS_MAXVOLUMEDEVICES << " devices";
 }
 RAIDNPDatDecVolCtrl::~RAIDNPDatDecVolCtrl () {  }
 
@@ -88,7 +91,7 @@ RAIDNPDatDecVolCtrl::decompose (
 
 			} else if (a < stripeSize / 2 && remainingSize > stripeSize / 2) {
 				for (auto y = 0; y < a;) {
-					Request sr {request};
+					Request & sr = appendChild (request, subrequests);
 					sr._size = min (_numBytesBySU, a - y);
 					sr._deviceAddress = s * _numBytesBySU;
 					sr._idxDevice = y / _numBytesBySU;
@@ -109,11 +112,10 @@ RAIDNPDatDecVolCtrl::decompose (
 					srp._size = max (srp._size, sr._deviceAddress + sr._size);
 					srp._deviceAddress = min (srp._deviceAddress, sr._deviceAddress);
 
-					subrequests.push_back (sr);
 				}
 
 				for (auto y = a + remainingSize; y < stripeSize;) {
-					Request sr {request};
+					Request & sr = appendChild (request, subrequests);
 					sr._size = _numBytesBySU - (y % _numBytesBySU);
 					sr._deviceAddress = y % _numBytesBySU + s * _numBytesBySU;
 					sr._idxDevice = y / _numBytesBySU;
@@ -134,7 +136,6 @@ RAIDNPDatDecVolCtrl::decompose (
 					srp._size = max (srp._size, sr._deviceAddress + sr._size);
 					srp._deviceAddress = min (srp._deviceAddress, sr._deviceAddress);
 
-					subrequests.push_back (sr);
 				}
 
 				addr += min (remainingSize, stripeSize - a);
@@ -160,7 +161,7 @@ RAIDNPDatDecVolCtrl::decompose (
 
 			} else {
 				do {
-					Request	sr {request};
+					Request	& sr = appendChild (request, subrequests);
 					sr._size = min (_numBytesBySU - addr % _numBytesBySU, remainingSize);
 					sr._deviceAddress = (addr / stripeSize) * _numBytesBySU
 						+ addr % _numBytesBySU;
@@ -183,7 +184,6 @@ RAIDNPDatDecVolCtrl::decompose (
 					addr += sr._size;
 					remainingSize -= sr._size;
 
-					subrequests.push_back (sr);
 				} while (remainingSize != 0 && s == addr / stripeSize);
 
 				srp._size = srp._size - srp._deviceAddress;
@@ -216,7 +216,7 @@ RAIDNPDatDecVolCtrl::decompose (
 	srp._deviceAddress = OGSS_ULONG_MAX;
 
 	while (remainingSize > 0) {
-		Request				sr {request};
+		Request				& sr = appendChild (request, subrequests);
 
 		currentStripe = addr / stripeSize;
 
@@ -241,7 +241,6 @@ RAIDNPDatDecVolCtrl::decompose (
 		addr += sr._size;
 		remainingSize -= sr._size;
 
-		subrequests.push_back (sr);
 
 		if (request._type == RQT_WRITE && (remainingSize == 0 || currentStripe
 			!= addr / (_numBytesBySU * (_numDevices - _numParity) ) ) ) {
@@ -276,52 +275,42 @@ void
 RAIDNPDatDecVolCtrl::manageFailure (
 	Request					& request,
 	vector <Request>		& subrequests) {
-	OGSS_Bool				check = true;
-
-	while (check && _failureDates.size () ) {
-		check = false;
-		for (auto elt = _failureDates.begin (); elt != _failureDates.end (); ++elt) {
-			if (elt->second <= request._date) {
-				check = true;
-				_failedDevices.insert (elt->first);
-				_failureDates.erase (elt);
-				break;
-			}
+	_failures.update (request._date);
+
+	if (! _failures.numFailed () || _numParity < _failures.numFailed () ) return;
+
+	_failureBuffer.clear ();
+
+	for (auto & elt: subrequests) {
+		if (! _failures.isFailed (elt._idxDevice) ) {
+			_failureBuffer.push_back (elt);
+			continue;
 		}
-	}
 
-	if (! _failedDevices.size () || _numParity < _failedDevices.size () ) return;
-
-	for (OGSS_Ulong i {0}; i < subrequests.size (); ++i) {
-		Request & elt = subrequests [i];
-		if (_failedDevices.find (elt._idxDevice) != _failedDevices.end ()
-		 && _failureDates [elt._idxDevice] <= request._date) {
-		 	if (elt._type == RQT_READ) {
-		 		for (OGSS_Ushort j = 0; j < _numDevices; ++j) {
-		 			if (_failedDevices.find (j) != _failedDevices.end ()
-		 			 && _failureDates [j] <= request._date) continue;
-
-		 			Request flt {elt};
-		 			flt._idxDevice = j;
-		 			++ request._numChild;
-		 			if (request._numPrioChild)
-		 				++ request._numPrioChild;
-		 			subrequests.insert (subrequests.begin () + i + 1, flt);
-		 		}
-
-		 		-- request._numChild;
-		 		if (request._numPrioChild)
-		 			-- request._numPrioChild;
-		 		subrequests.erase (subrequests.begin () + i);
-		 		--i;
-			} else if (elt._type == RQT_WRITE) {
-				-- request._numChild;
-				subrequests.erase (subrequests.begin () + i);
-				--i;
+		if (elt._type == RQT_READ) {
+			// Recovery requests replace the failed one, in the order they had
+			// when they were inserted one by one right after it
+			for (OGSS_Ushort j = _numDevices; j-- > 0;) {
+				if (_failures.isFailed (j) ) continue;
+
+				_failureBuffer.push_back (elt);
+				_failureBuffer.back () ._idxDevice = j;
+				++ request._numChild;
+				if (request._numPrioChild)
+					++ request._numPrioChild;
 			}
-		}
+
+			-- request._numChild;
+			if (request._numPrioChild)
+				-- request._numPrioChild;
+		} else if (elt._type == RQT_WRITE)
+			-- request._numChild;
+		else
+			_failureBuffer.push_back (elt);
 	}
 
+	subrequests.swap (_failureBuffer);
+
 	removeDuplicates (request, subrequests);
 }
 
@@ -329,21 +318,30 @@ void RAIDNPDatDecVolCtrl::removeDuplicates (
 	Request					& request,
 	vector <Request>		& subrequests) {
 
+	OGSS_Ulong				last = 0;
+
 	for (OGSS_Ulong i = 0; i < subrequests.size (); ++i) {
-		for (OGSS_Ulong j = i + 1; j < subrequests.size (); ++j) {
-			if (subrequests [i] ._idxDevice == subrequests [j] ._idxDevice
+		OGSS_Bool			duplicate = false;
+
+		for (OGSS_Ulong j = 0; j < last && ! duplicate; ++j)
+			duplicate = subrequests [i] ._idxDevice == subrequests [j] ._idxDevice
 			 && subrequests [i] ._deviceAddress == subrequests [j] ._deviceAddress
 			 && subrequests [i] ._size == subrequests [j] ._size
-			 && subrequests [i] ._type == subrequests [j] ._type) {
-				-- request._numChild;
-				if (request._numPrioChild && subrequests [j] ._type == RQT_READ)
-					-- request._numPrioChild;
-				subrequests.erase (subrequests.begin () + j);
-				--j;
-			}
+			 && subrequests [i] ._type == subrequests [j] ._type;
+
+		if (duplicate) {
+			-- request._numChild;
+			if (request._numPrioChild && subrequests [i] ._type == RQT_READ)
+				-- request._numPrioChild;
+			continue;
 		}
+
+		if (last != i) subrequests [last] = subrequests [i];
+		++ last;
 	}
 
+	subrequests.erase (subrequests.begin () + last, subrequests.end () );
+
 	OGSS_Ulong cnt = 1;
 
 	for (auto & elt: subrequests)
@@ -364,7 +362,7 @@ RAIDNPDatDecVolCtrl::updateScheme (
 	LOG(INFO) << "RAIDNP receives an event on local disk #" << event._idxDevice;
 
 	if (event._type == RQT_EVFLT)
-		_failureDates [event._idxDevice] = event._date;
+		_failures.schedule (event._idxDevice, event._date);
 }
 
 void
@@ -51,6 +51,9 @@ RAIDNPNoDecVolCtrl::RAIDNPNoDecVolCtrl (
 	_numBytesBySU			= vol._suSize;
 	_numDevices				= vol._numDevices;
 	_numParity				= vol._numRedundancyDevices;
+
+	LOG_IF (FATAL, _numDevices > OGSS_MAXVOLUMEDEVICES) << "A volume can not have more than "
+		<< OGSS_MAXVOLUMEDEVICES << " devices";
 }
 RAIDNPNoDecVolCtrl::~RAIDNPNoDecVolCtrl () {  }
 
@@ -88,7 +91,7 @@ RAIDNPNoDecVolCtrl::decompose (
 
 			} else if (a < stripeSize / 2 && remainingSize > stripeSize / 2) {
 				for (auto y = 0; y < a;) {
-					Request sr {request};
+					Request & sr = appendChild (request, subrequests);
 					sr._size = min (_numBytesBySU, a - y);
 					sr._deviceAddress = s * _numBytesBySU;
 					sr._idxDevice = y / _numBytesBySU;
@@ -106,12 +109,10 @@ RAIDNPNoDecVolCtrl::decompose (
 
 					srp._size = max (srp._size, sr._deviceAddress + sr._size);
 					srp._deviceAddress = min (srp._deviceAddress, sr._deviceAddress);
-
-					subrequests.push_back (sr);
 				}
 
 				for (auto y = a + remainingSize; y < stripeSize;) {
-					Request sr {request};
+					Request & sr = appendChild (request, subrequests);
 					sr._size = _numBytesBySU - (y % _numBytesBySU);
 					sr._deviceAddress = y % _numBytesBySU + s * _numBytesBySU;
 					sr._idxDevice = y / _numBytesBySU;
@@ -129,8 +130,6 @@ RAIDNPNoDecVolCtrl::decompose (
 
 					srp._size = max (srp._size, sr._deviceAddress + sr._size);
 					srp._deviceAddress = min (srp._deviceAddress, sr._deviceAddress);
-
-					subrequests.push_back (sr);
 				}
 
 				addr += min (remainingSize, stripeSize - a);
@@ -154,7 +153,7 @@ RAIDNPNoDecVolCtrl::decompose (
 
 			} else {
 				do {
-					Request	sr {request};
+					Request	& sr = appendChild (request, subrequests);
 					sr._size = min (_numBytesBySU - addr % _numBytesBySU, remainingSize);
 					sr._deviceAddress = (addr / stripeSize) * _numBytesBySU
 						+ addr % _numBytesBySU;
@@ -174,8 +173,6 @@ RAIDNPNoDecVolCtrl::decompose (
 
 					addr += sr._size;
 					remainingSize -= sr._size;
-
-					subrequests.push_back (sr);
 				} while (remainingSize != 0 && s == addr / stripeSize);
 
 				srp._size = srp._size - srp._deviceAddress;
@@ -206,7 +203,7 @@ RAIDNPNoDecVolCtrl::decompose (
 	srp._deviceAddress = OGSS_ULONG_MAX;
 
 	while (remainingSize > 0) {
-		Request				sr {request};
+		Request				& sr = appendChild (request, subrequests);
 
 		currentStripe = addr / stripeSize;
 
@@ -229,8 +226,6 @@ RAIDNPNoDecVolCtrl::decompose (
 		addr += sr._size;
 		remainingSize -= sr._size;
 
-		subrequests.push_back (sr);
-
 		if (request._type == RQT_WRITE && (remainingSize == 0 || currentStripe
 			!= addr / (_numBytesBySU * (_numDevices - _numParity) ) ) ) {
 			srp._size = srp._size - srp._deviceAddress;
@@ -262,52 +257,42 @@ void
 RAIDNPNoDecVolCtrl::manageFailure (
 	Request					& request,
 	vector <Request>		& subrequests) {
-	OGSS_Bool				check = true;
-
-	while (check && _failureDates.size () ) {
-		check = false;
-		for (auto elt = _failureDates.begin (); elt != _failureDates.end (); ++elt) {
-			if (elt->second <= request._date) {
-				check = true;
-				_failedDevices.insert (elt->first);
-				_failureDates.erase (elt);
-				break;
-			}
+	_failures.update (request._date);
+
+	if (! _failures.numFailed () || _numParity < _failures.numFailed () ) return;
+
+	_failureBuffer.clear ();
+
+	for (auto & elt: subrequests) {
+		if (! _failures.isFailed (elt._idxDevice) ) {
+			_failureBuffer.push_back (elt);
+			continue;
 		}
-	}
 
-	if (! _failedDevices.size () || _numParity < _failedDevices.size () ) return;
-
-	for (OGSS_Ulong i {0}; i < subrequests.size (); ++i) {
-		Request & elt = subrequests [i];
-		if (_failedDevices.find (elt._idxDevice) != _failedDevices.end ()
-		 && _failureDates [elt._idxDevice] <= request._date) {
-		 	if (elt._type == RQT_READ) {
-		 		for (OGSS_Ushort j = 0; j < _numDevices; ++j) {
-		 			if (_failedDevices.find (j) != _failedDevices.end ()
-		 			 && _failureDates [j] <= request._date) continue;
-
-		 			Request flt {elt};
-		 			flt._idxDevice = j;
-		 			++ request._numChild;
-		 			if (request._numPrioChild)
-		 				++ request._numPrioChild;
-		 			subrequests.insert (subrequests.begin () + i + 1, flt);
-		 		}
-
-		 		-- request._numChild;
-		 		if (request._numPrioChild)
-		 			-- request._numPrioChild;
-		 		subrequests.erase (subrequests.begin () + i);
-		 		--i;
-			} else if (elt._type == RQT_WRITE) {
-				-- request._numChild;
-				subrequests.erase (subrequests.begin () + i);
-				--i;
+		if (elt._type == RQT_READ) {
+			// Recovery requests replace the failed one, in the order they had
+			// when they were inserted one by one right after it
+			for (OGSS_Ushort j = _numDevices; j-- > 0;) {
+				if (_failures.isFailed (j) ) continue;
+
+				_failureBuffer.push_back (elt);
+				_failureBuffer.back () ._idxDevice = j;
+				++ request._numChild;
+				if (request._numPrioChild)
+					++ request._numPrioChild;
 			}
-		}
+
+			-- request._numChild;
+			if (request._numPrioChild)
+				-- request._numPrioChild;
+		} else if (elt._type == RQT_WRITE)
+			-- request._numChild;
+		else
+			_failureBuffer.push_back (elt);
 	}
 
+	subrequests.swap (_failureBuffer);
+
 	removeDuplicates (request, subrequests);	
 }
 
@@ -316,21 +301,30 @@ RAIDNPNoDecVolCtrl::removeDuplicates (
 	Request					& request,
 	vector <Request>		& subrequests) {
 
+	OGSS_Ulong				last = 0;
+
 	for (OGSS_Ulong i = 0; i < subrequests.size (); ++i) {
-		for (OGSS_Ulong j = i + 1; j < subrequests.size (); ++j) {
-			if (subrequests [i] ._idxDevice == subrequests [j] ._idxDevice
+		OGSS_Bool			duplicate = false;
+
+		for (OGSS_Ulong j = 0; j < last && ! duplicate; ++j)
+			duplicate = subrequests [i] ._idxDevice == subrequests [j] ._idxDevice
 			 && subrequests [i] ._deviceAddress == subrequests [j] ._deviceAddress
 			 && subrequests [i] ._size == subrequests [j] ._size
-			 && subrequests [i] ._type == subrequests [j] ._type) {
-				--request._numChild;
-				if (request._numPrioChild && subrequests [j] ._type == RQT_READ)
-					--request._numPrioChild;
-				subrequests.erase (subrequests.begin () + j);
-				--j;
-			}
+			 && subrequests [i] ._type == subrequests [j] ._type;
+
+		if (duplicate) {
+			-- request._numChild;
+			if (request._numPrioChild && subrequests [i] ._type == RQT_READ)
+				-- request._numPrioChild;
+			continue;
 		}
+
+		if (last != i) subrequests [last] = subrequests [i];
+		++ last;
 	}
 
+	subrequests.erase (subrequests.begin () + last, subrequests.end () );
+
 	OGSS_Ulong cnt = 1;
 
 	for (auto & elt: subrequests)
@@ -350,7 +344,7 @@ RAIDNPNoDecVolCtrl::updateScheme (
 	LOG(INFO) << "RAIDNP receives an event on local disk #" << event._idxDevice;
 
 	if (event._type == RQT_EVFLT)
-		_failureDates [event._idxDevice] = event._date;
+		_failures.schedule (event._idxDevice, event._date);
 }
 
 void
@@ -556,6 +550,8 @@ UT_RAIDNPNoDecVolCtrl::UT_RAIDNPNoDecVolCtrl (
 				&UT_RAIDNPNoDecVolCtrl::twoStripeW2PRequest) );
 			_tests.push_back (make_pair ("More stripe write 2par request",
 				&UT_RAIDNPNoDecVolCtrl::moreStripeW2PRequest) );
+			_tests.push_back (make_pair ("Failed device read 1par request",
+				&UT_RAIDNPNoDecVolCtrl::failedReadR1PRequest) );
 		} else if (! elt.compare ("smallStripeR0P") )
 			_tests.push_back (make_pair ("Small stripe read 0par request",
 				&UT_RAIDNPNoDecVolCtrl::smallStripeR0PRequest) );
@@ -586,6 +582,9 @@ UT_RAIDNPNoDecVolCtrl::UT_RAIDNPNoDecVolCtrl (
 		else if (! elt.compare ("moreStripeW0P") )
 			_tests.push_back (make_pair ("More stripe write 0par request",
 				&UT_RAIDNPNoDecVolCtrl::moreStripeW0PRequest) );
+		else if (! elt.compare ("failedReadR1P") )
+			_tests.push_back (make_pair ("Failed device read 1par request",
+				&UT_RAIDNPNoDecVolCtrl::failedReadR1PRequest) );
 		else
 			LOG (WARNING) << ModuleNameMap.at (_module) << " unitary test "
 				<< "named '" << elt << "' does not match!";
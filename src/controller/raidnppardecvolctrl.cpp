@@ -41,50 +41,6 @@
 
 using namespace std;
 
-typedef set <Request, OGSS_Bool (*) (Request, Request)>
-										__RequestSet;
-
-OGSS_Bool __requestCompare (Request lhs, Request rhs) {
-	return (lhs._type == RQT_READ && rhs._type == RQT_WRITE)
-		|| (lhs._type == rhs._type && lhs._idxDevice < rhs._idxDevice)
-		|| (lhs._type == rhs._type && lhs._idxDevice == rhs._idxDevice && lhs._deviceAddress < rhs._deviceAddress);
-}
-
-void
-__removeAndMerge (
-	Request								& request,
-	vector <Request>					& subrequests) {
-	__RequestSet						tmp (__requestCompare);
-
-	for (auto elt: subrequests)			tmp.insert (elt);
-	subrequests.clear ();
-
-	auto 								c = tmp.begin ();
-	auto								p = c;
-	OGSS_Bool							building {false};
-	Request								flt;
-
-	for (++c; c != tmp.end (); ++c, ++p) {
-		if (! building) {
-			flt = *p;
-			building = true;
-		}
-
-		if (p->_type != c->_type
-		 || p->_idxDevice != c->_idxDevice
-		 || p->_deviceAddress + p->_size != c->_deviceAddress) {
-			subrequests.push_back (flt);
-			building = false;
-			continue;
-		}
-
-		flt._size += c->_size;
-	}
-
-	if (building)						subrequests.push_back (flt);
-	else								subrequests.push_back (*tmp.rbegin () );
-}
-
 /*----------------------------------------------------------------------------*/
 /* PUBLIC FUNCTIONS ----------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
@@ -96,6 +52,9 @@ RAIDNPParDecVolCtrl::RAIDNPParDecVolCtrl (
 	_numBytesBySU			= vol._suSize;
 	_numDevices				= vol._numDevices;
 	_numParity				= vol._numRedundancyDevices;
+
+	LOG_IF (FATAL, _numDevices > OGSS_MAXVOLUMEDEVICES) << "A volume can not have more than "
+		<< OGSS_MAXVOLUMEDEVICES << " devices";
 }
 RAIDNPParDecVolCtrl::~RAIDNPParDecVolCtrl () {  }
 
@@ -141,7 +100,7 @@ RAIDNPParDecVolCtrl::decompose (
 				kStart = kStop = lStart = lStop = OGSS_ULONG_MAX;
 
 				for (auto y = 0; y < a;) {
-					Request sr {request};
+					Request & sr = appendChild (request, subrequests);
 					sr._size = min (_numBytesBySU, a - y);
 					sr._deviceAddress = s * _numBytesBySU;
 					sr._idxDevice = y / _numBytesBySU;
@@ -169,11 +128,10 @@ RAIDNPParDecVolCtrl::decompose (
 					}
 
 					DLOG(INFO) << "Create{1} " << bitset <5> (sr._type) << " --> " << sr._idxDevice << "/" << sr._deviceAddress;
-					subrequests.push_back (sr);
 				}
 
 				for (auto y = a + remainingSize; y < stripeSize;) {
-					Request sr {request};
+					Request & sr = appendChild (request, subrequests);
 					sr._size = _numBytesBySU - (y % _numBytesBySU);
 					sr._deviceAddress = y % _numBytesBySU + s * _numBytesBySU;
 					sr._idxDevice = y / _numBytesBySU;
@@ -201,7 +159,6 @@ RAIDNPParDecVolCtrl::decompose (
 					}
 
 					DLOG(INFO) << "Create{2} " << bitset <5> (sr._type) << " --> " << sr._idxDevice << "/" << sr._deviceAddress;
-					subrequests.push_back (sr);
 				}
 
 				addr += min (remainingSize, stripeSize - a);
@@ -246,7 +203,7 @@ RAIDNPParDecVolCtrl::decompose (
 				kStart = kStop = lStart = lStop = OGSS_ULONG_MAX;
 
 				do {
-					Request	sr {request};
+					Request	& sr = appendChild (request, subrequests);
 					sr._size = min (_numBytesBySU - addr % _numBytesBySU, remainingSize);
 					sr._deviceAddress = (addr / stripeSize) * _numBytesBySU
 						+ addr % _numBytesBySU;
@@ -276,7 +233,6 @@ RAIDNPParDecVolCtrl::decompose (
 					remainingSize -= sr._size;
 
 					DLOG(INFO) << "Create{5} " << bitset <5> (sr._type) << " --> " << sr._idxDevice << "/" << sr._deviceAddress;
-					subrequests.push_back (sr);
 				} while (remainingSize != 0 && s == addr / stripeSize);
 				
 				for (int i = (2 * _numDevices - _numParity
@@ -325,7 +281,7 @@ RAIDNPParDecVolCtrl::decompose (
 	kStart = kStop = lStart = lStop = OGSS_ULONG_MAX;
 
 	while (remainingSize > 0) {
-		Request				sr {request};
+		Request				& sr = appendChild (request, subrequests);
 
 		currentStripe = addr / stripeSize;
 
@@ -357,7 +313,6 @@ RAIDNPParDecVolCtrl::decompose (
 		remainingSize -= sr._size;
 
 		DLOG(INFO) << "Create{8} " << bitset <5> (sr._type) << " --> " << sr._idxDevice << "/" << sr._deviceAddress;
-		subrequests.push_back (sr);
 		request._idxDevice = sr._idxDevice;
 		request._deviceAddress = sr._deviceAddress;
 
@@ -404,7 +359,7 @@ RAIDNPParDecVolCtrl::decompose (
 	manageFailure (request, subrequests);
 	//removeDuplicates (request, subrequests);
 
-	__removeAndMerge (request, subrequests);
+	_removeAndMerge (request, subrequests, false);
 }
 
 /*----------------------------------------------------------------------------*/
@@ -415,52 +370,42 @@ void
 RAIDNPParDecVolCtrl::manageFailure (
 	Request					& request,
 	vector <Request>		& subrequests) {
-	OGSS_Bool				check = true;
-
-	while (check && _failureDates.size () ) {
-		check = false;
-		for (auto elt = _failureDates.begin (); elt != _failureDates.end (); ++elt) {
-			if (elt->second <= request._date) {
-				check = true;
-				_failedDevices.insert (elt->first);
-				_failureDates.erase (elt);
-				break;
-			}
+	_failures.update (request._date);
+
+	if (! _failures.numFailed () || _numParity < _failures.numFailed () ) return;
+
+	_failureBuffer.clear ();
+
+	for (auto & elt: subrequests) {
+		if (! _failures.isFailed (elt._idxDevice) ) {
+			_failureBuffer.push_back (elt);
+			continue;
 		}
-	}
 
-	if (! _failedDevices.size () || _numParity < _failedDevices.size () ) return;
-
-	for (OGSS_Ulong i {0}; i < subrequests.size (); ++i) {
-		Request & elt = subrequests [i];
-		if (_failedDevices.find (elt._idxDevice) != _failedDevices.end ()
-		 && _failureDates [elt._idxDevice] <= request._date) {
-		 	if (elt._type == RQT_READ) {
-		 		for (OGSS_Ushort j = 0; j < _numDevices; ++j) {
-		 			if (_failedDevices.find (j) != _failedDevices.end ()
-		 			 && _failureDates [j] <= request._date) continue;
-
-		 			Request flt {elt};
-		 			flt._idxDevice = j;
-		 			++ request._numChild;
-		 			if (request._numPrioChild)
-		 				++ request._numPrioChild;
-		 			subrequests.insert (subrequests.begin () + i + 1, flt);
-		 		}
-
-		 		-- request._numChild;
-		 		if (request._numPrioChild)
-		 			-- request._numPrioChild;
-		 		subrequests.erase (subrequests.begin () + i);
-		 		--i;
-			} else if (elt._type == RQT_WRITE) {
-				-- request._numChild;
-				subrequests.erase (subrequests.begin () + i);
-				--i;
+		if (elt._type == RQT_READ) {
+			// Recovery requests replace the failed one, in the order they had
+			// when they were inserted one by one right after it
+			for (OGSS_Ushort j = _numDevices; j-- > 0;) {
+				if (_failures.isFailed (j) ) continue;
+
+				_failureBuffer.push_back (elt);
+				_failureBuffer.back () ._idxDevice = j;
+				++ request._numChild;
+				if (request._numPrioChild)
+					++ request._numPrioChild;
 			}
-		}
+
+			-- request._numChild;
+			if (request._numPrioChild)
+				-- request._numPrioChild;
+		} else if (elt._type == RQT_WRITE)
+			-- request._numChild;
+		else
+			_failureBuffer.push_back (elt);
 	}
 
+	subrequests.swap (_failureBuffer);
+
 	removeDuplicates (request, subrequests);
 }
 
@@ -469,21 +414,30 @@ RAIDNPParDecVolCtrl::removeDuplicates (
 	Request					& request,
 	vector <Request>		& subrequests) {
 
+	OGSS_Ulong				last = 0;
+
 	for (OGSS_Ulong i = 0; i < subrequests.size (); ++i) {
-		for (OGSS_Ulong j = i + 1; j < subrequests.size (); ++j) {
-			if (subrequests [i] ._idxDevice == subrequests [j] ._idxDevice
+		OGSS_Bool			duplicate = false;
+
+		for (OGSS_Ulong j = 0; j < last && ! duplicate; ++j)
+			duplicate = subrequests [i] ._idxDevice == subrequests [j] ._idxDevice
 			 && subrequests [i] ._deviceAddress == subrequests [j] ._deviceAddress
 			 && subrequests [i] ._size == subrequests [j] ._size
-			 && subrequests [i] ._type == subrequests [j] ._type) {
-				--request._numChild;
-				if (request._numPrioChild && subrequests [j] ._type == RQT_READ)
-					--request._numPrioChild;
-				subrequests.erase (subrequests.begin () + j);
-				--j;
-			}
+			 && subrequests [i] ._type == subrequests [j] ._type;
+
+		if (duplicate) {
+			-- request._numChild;
+			if (request._numPrioChild && subrequests [i] ._type == RQT_READ)
+				-- request._numPrioChild;
+			continue;
 		}
+
+		if (last != i) subrequests [last] = subrequests [i];
+		++ last;
 	}
 
+	subrequests.erase (subrequests.begin () + last, subrequests.end () );
+
 	OGSS_Ulong cnt = 1;
 
 	for (auto & elt: subrequests)
@@ -504,7 +458,7 @@ RAIDNPParDecVolCtrl::updateScheme (
 	LOG(INFO) << "RAIDNP receives an event on local disk #" << event._idxDevice << " which will happen at " << event._date;
 
 	if (event._type == RQT_EVFLT)
-		_failureDates [event._idxDevice] = event._date;
+		_failures.schedule (event._idxDevice, event._date);
 }
 
 void
@@ -718,6 +672,9 @@ UT_RAIDNPParDecVolCtrl::UT_RAIDNPParDecVolCtrl (
 				&UT_RAIDNPParDecVolCtrl::twoStripeW2PRequest) );
 			_tests.push_back (make_pair ("More stripe write 2par request",
 				&UT_RAIDNPParDecVolCtrl::moreStripeW2PRequest) );
+
+			_tests.push_back (make_pair ("Steady child buffer",
+				&UT_RAIDNPParDecVolCtrl::steadyBuffer) );
 		} else if (! elt.compare ("smallStripeR0P") )
 			_tests.push_back (make_pair ("Small stripe read 0par request",
 				&UT_RAIDNPParDecVolCtrl::smallStripeR0PRequest) );
@@ -748,6 +705,9 @@ UT_RAIDNPParDecVolCtrl::UT_RAIDNPParDecVolCtrl (
 		else if (! elt.compare ("moreStripeW0P") )
 			_tests.push_back (make_pair ("More stripe write 0par request",
 				&UT_RAIDNPParDecVolCtrl::moreStripeW0PRequest) );
+		else if (! elt.compare ("steadyBuffer") )
+			_tests.push_back (make_pair ("Steady child buffer",
+				&UT_RAIDNPParDecVolCtrl::steadyBuffer) );
 		else
 			LOG (WARNING) << ModuleNameMap.at (_module) << " unitary test "
 				<< "named '" << elt << "' does not match!";
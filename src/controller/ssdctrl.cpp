@@ -26,23 +26,401 @@
 /* HEADERS -------------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+#include <random>
+
 #include "controller/ssdctrl.hpp"
 
+#include "parser/xmlparser.hpp"
+
 #if USE_STATIC_GLOG
 #include "glog/logging.h"
 #else
 #include <glog/logging.h>
 #endif
 
+using namespace std;
+
+constexpr OGSS_Ushort		OGSS_PageTable::_kChunkShift;
+constexpr uint32_t			OGSS_PageTable::_kNil;
+
 /*----------------------------------------------------------------------------*/
 /* PUBLIC FUNCTIONS ----------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
-SSDCtrl::SSDCtrl () {  }
-SSDCtrl::~SSDCtrl () {  }
+SSDCtrl::SSDCtrl (
+	const Device			& device):
+	_param (device._param.s) {  }
+
+SSDCtrl::~SSDCtrl () {
+	for (auto & elt: _ftl)
+		DLOG(INFO) << "[SSD] #" << elt.first << " Write amplification: "
+			<< (elt.second._hostWrites ? static_cast <OGSS_Real>
+				(elt.second._flashWrites) / elt.second._hostWrites : .0)
+			<< " (" << elt.second._numErase << " erased blocks)";
+}
 
 void
 SSDCtrl::translate (
-	Request					& request) {
-	DLOG(INFO) << "Need to translate for SSD";
+	Request					& request,
+	vector <Request>		& internals) {
+	if (_param._algTrns != TRS_SSDPAGEMAP) return;
+	if (request._type != RQT_READ && request._type != RQT_WRITE) return;
+	if (! request._size) return;
+
+	OGSS_FTL				& ftl = getFTL (request._idxDevice);
+
+	LOG_IF (FATAL, (request._deviceAddress + request._size - 1) / ftl._unit
+		>= ftl._numLogical) << "[SSD] #" << request._idxDevice << " Address "
+		<< request._deviceAddress << " is out of the exported capacity";
+
+	if (request._type == RQT_WRITE)
+		translateWrite (ftl, request, internals);
+	else
+		translateRead (ftl, request, internals);
+}
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+OGSS_FTL &
+SSDCtrl::getFTL (
+	const OGSS_Ulong		idxDevice) {
+	auto					it {_ftl.find (idxDevice)};
+
+	if (it != _ftl.end () ) return it->second;
+
+	OGSS_FTL				& ftl = _ftl [idxDevice];
+
+	ftl._unit = max <OGSS_Ulong> (1, static_cast <OGSS_Ulong> (_param._pageSize) );
+	ftl._pagesPerBlock = _param._pagesPerBlock;
+	ftl._numBlocks = _param._blocksPerDie * _param._numDies;
+	ftl._numPages = ftl._pagesPerBlock * ftl._numBlocks;
+
+	// With one spare block more than the reserve of the garbage collection,
+	// the closed blocks always hold an invalid page when it is run
+	LOG_IF (FATAL, ! ftl._pagesPerBlock || _param.numSpareBlocks () <= _gcThreshold
+		|| ftl._numBlocks <= _param.numSpareBlocks () )
+		<< "[SSD] #" << idxDevice << " Not enough blocks for the page-mapped translation";
+	LOG_IF (FATAL, ftl._numPages >= OGSS_PageTable::_kNil)
+		<< "[SSD] #" << idxDevice << " Too many pages for the page-mapped translation";
+
+	ftl._numLogical = ftl._pagesPerBlock * (ftl._numBlocks - _param.numSpareBlocks () );
+
+	ftl._l2p.resize (ftl._numLogical);
+	ftl._p2l.resize (ftl._numPages);
+
+	ftl._valid.assign (ftl._numBlocks, 0);
+	ftl._erase.assign (ftl._numBlocks, 0);
+	ftl._lastWrite.assign (ftl._numBlocks, .0);
+	ftl._closed.assign (ftl._numBlocks, false);
+
+	ftl._buckets.resize (ftl._pagesPerBlock + 1);
+	ftl._eraseHist.assign (1, ftl._numBlocks);
+
+	ftl._free.resize (ftl._numBlocks);
+	for (OGSS_Ulong i = 0; i < ftl._numBlocks; ++i)
+		ftl._free [i] = i;
+	ftl._numFree = ftl._numBlocks;
+
+	return ftl;
+}
+
+void
+SSDCtrl::translateRead (
+	OGSS_FTL				& ftl,
+	Request					& request,
+	vector <Request>		& internals) {
+	OGSS_Ulong				addr {request._deviceAddress};
+	OGSS_Ulong				end {request._deviceAddress + request._size};
+	OGSS_Ulong				runAddr {0}, runSize {0}, prev {0};
+	OGSS_Ulong				numRuns {0};
+
+	for (OGSS_Ulong lp = addr / ftl._unit; lp * ftl._unit < end; ++lp) {
+		OGSS_Ulong			pp {ftl._l2p.get (lp)};
+		OGSS_Ulong			start {max (addr, lp * ftl._unit)};
+		OGSS_Ulong			stop {min (end, (lp + 1) * ftl._unit)};
+
+		// A page never written is read in place
+		if (pp == OGSS_PageTable::_kNil) pp = lp;
+
+		if (runSize && pp == prev + 1)
+			runSize += stop - start;
+		else {
+			if (runSize) addInternal (request, RQT_READ, runAddr, runSize, internals);
+			runAddr = pp * ftl._unit + start - lp * ftl._unit;
+			runSize = stop - start;
+			++ numRuns;
+		}
+
+		prev = pp;
+	}
+
+	if (numRuns == 1)
+		request._deviceAddress = runAddr;
+	else {
+		addInternal (request, RQT_READ, runAddr, runSize, internals);
+		request._deviceAddress = internals [internals.size () - numRuns] ._deviceAddress;
+		request._split = true;
+	}
+}
+
+void
+SSDCtrl::translateWrite (
+	OGSS_FTL				& ftl,
+	Request					& request,
+	vector <Request>		& internals) {
+	OGSS_Ulong				addr {request._deviceAddress};
+	OGSS_Ulong				end {request._deviceAddress + request._size};
+	OGSS_Ulong				runAddr {0}, runSize {0}, prev {0};
+	OGSS_Ulong				firstRun {0};
+	OGSS_Bool				split {false};
+
+	for (OGSS_Ulong lp = addr / ftl._unit; lp * ftl._unit < end; ++lp) {
+		OGSS_Ulong			start {max (addr, lp * ftl._unit)};
+		OGSS_Ulong			stop {min (end, (lp + 1) * ftl._unit)};
+
+		// The run ends with the active block if the next one is not
+		// contiguous or if the garbage collection adds its requests first
+		if (runSize && ftl._activePage == ftl._pagesPerBlock
+			&& (ftl._numFree <= _gcThreshold
+				|| ftl._free [ftl._freeHead] != ftl._active + 1) ) {
+			if (! split) firstRun = internals.size ();
+			addInternal (request, RQT_WRITE, runAddr, runSize, internals);
+			runSize = 0;
+			split = true;
+		}
+
+		OGSS_Ulong			pp {allocatePage (ftl, request, internals, true)};
+		OGSS_Ulong			old {ftl._l2p.get (lp)};
+
+		if (old != OGSS_PageTable::_kNil)
+			invalidatePage (ftl, old);
+
+		ftl._l2p.set (lp, pp);
+		ftl._p2l.set (pp, lp);
+		++ ftl._valid [pp / ftl._pagesPerBlock];
+		ftl._lastWrite [pp / ftl._pagesPerBlock] = request._date;
+		++ ftl._hostWrites;
+		++ ftl._flashWrites;
+
+		if (runSize && pp == prev + 1)
+			runSize += stop - start;
+		else {
+			if (runSize) {
+				if (! split) firstRun = internals.size ();
+				addInternal (request, RQT_WRITE, runAddr, runSize, internals);
+				split = true;
+			}
+			runAddr = pp * ftl._unit + start - lp * ftl._unit;
+			runSize = stop - start;
+		}
+
+		prev = pp;
+	}
+
+	if (! split)
+		request._deviceAddress = runAddr;
+	else {
+		addInternal (request, RQT_WRITE, runAddr, runSize, internals);
+		request._deviceAddress = internals [firstRun] ._deviceAddress;
+		request._split = true;
+	}
+}
+
+OGSS_Ulong
+SSDCtrl::allocatePage (
+	OGSS_FTL				& ftl,
+	const Request			& base,
+	vector <Request>		& internals,
+	const OGSS_Bool			collect) {
+	if (ftl._active != OGSS_PageTable::_kNil
+		&& ftl._activePage == ftl._pagesPerBlock) {
+		closeBlock (ftl);
+
+		// The copies of the garbage collection take the next blocks
+		while (collect && ftl._numFree <= _gcThreshold) {
+			uint32_t		victim {selectVictim (ftl, base._date)};
+
+			if (victim == OGSS_PageTable::_kNil) break;
+			reclaim (ftl, victim, base, internals);
+		}
+	}
+
+	if (ftl._active != OGSS_PageTable::_kNil
+		&& ftl._activePage == ftl._pagesPerBlock)
+		closeBlock (ftl);
+
+	if (ftl._active == OGSS_PageTable::_kNil) {
+		LOG_IF (FATAL, ! ftl._numFree) << "[SSD] #" << base._idxDevice
+			<< " No free block left, the written data exceed the flash capacity";
+
+		ftl._active = ftl._free [ftl._freeHead];
+		ftl._freeHead = (ftl._freeHead + 1) % ftl._numBlocks;
+		-- ftl._numFree;
+		ftl._activePage = 0;
+	}
+
+	return ftl._active * ftl._pagesPerBlock + ftl._activePage ++;
+}
+
+uint32_t
+SSDCtrl::selectVictim (
+	const OGSS_FTL			& ftl,
+	const OGSS_Real			date) const {
+	uint32_t				victim {OGSS_PageTable::_kNil};
+	OGSS_Real				best {-1.};
+
+	// The fully valid blocks can not be reclaimed
+	for (OGSS_Ulong v = 0; v < ftl._pagesPerBlock; ++v) {
+		if (ftl._buckets [v] .empty () ) continue;
+
+		const auto			& oldest = * ftl._buckets [v] .begin ();
+
+		// The greedy policy takes the first block with the fewest valid pages
+		if (! v || _param._algGC != GCL_COSTBENEFIT) return oldest.second;
+
+		// Benefit (free space x age) over the cost (read and write of the
+		// valid pages)
+		OGSS_Real			u {static_cast <OGSS_Real> (v) / ftl._pagesPerBlock};
+
+		if ( (date - oldest.first) * (1 - u) / (2 * u) > best) {
+			best = (date - oldest.first) * (1 - u) / (2 * u);
+			victim = oldest.second;
+		}
+	}
+
+	return victim;
+}
+
+void
+SSDCtrl::reclaim (
+	OGSS_FTL				& ftl,
+	const uint32_t			block,
+	const Request			& base,
+	vector <Request>		& internals) {
+	OGSS_Ulong				rdStart {0}, wrStart {0}, len {0};
+
+	ftl._buckets [ftl._valid [block] ] .erase (make_pair (ftl._lastWrite [block], block) );
+	ftl._cold.erase (make_pair (ftl._erase [block], block) );
+	ftl._closed [block] = false;
+
+	// The valid pages are copied by runs, contiguous on both blocks
+	for (OGSS_Ulong pp = block * ftl._pagesPerBlock;
+		pp < (block + 1) * ftl._pagesPerBlock; ++pp) {
+		OGSS_Ulong			lp {ftl._p2l.get (pp)};
+
+		if (lp == OGSS_PageTable::_kNil || ftl._l2p.get (lp) != pp) continue;
+
+		OGSS_Ulong			npp {allocatePage (ftl, base, internals, false)};
+
+		ftl._l2p.set (lp, npp);
+		ftl._p2l.set (npp, lp);
+		++ ftl._valid [npp / ftl._pagesPerBlock];
+		ftl._lastWrite [npp / ftl._pagesPerBlock] = base._date;
+		++ ftl._flashWrites;
+
+		if (len && pp == rdStart + len && npp == wrStart + len)
+			++ len;
+		else {
+			if (len) {
+				addInternal (base, RQT_READ, rdStart * ftl._unit, len * ftl._unit, internals);
+				addInternal (base, RQT_WRITE, wrStart * ftl._unit, len * ftl._unit, internals);
+			}
+			rdStart = pp;	wrStart = npp;	len = 1;
+		}
+	}
+
+	if (len) {
+		addInternal (base, RQT_READ, rdStart * ftl._unit, len * ftl._unit, internals);
+		addInternal (base, RQT_WRITE, wrStart * ftl._unit, len * ftl._unit, internals);
+	}
+
+	addInternal (base, RQT_ERASE, block * ftl._pagesPerBlock * ftl._unit,
+		ftl._pagesPerBlock * ftl._unit, internals);
+
+	ftl._valid [block] = 0;
+	-- ftl._eraseHist [ftl._erase [block] ];
+	if (++ ftl._erase [block] == ftl._eraseHist.size () )
+		ftl._eraseHist.push_back (0);
+	++ ftl._eraseHist [ftl._erase [block] ];
+	while (! ftl._eraseHist [ftl._minErase]) ++ ftl._minErase;
+	++ ftl._numErase;
+
+	ftl._free [(ftl._freeHead + ftl._numFree) % ftl._numBlocks] = block;
+	++ ftl._numFree;
+
+	if (_param._numErase && ftl._erase [block] >= _param._numErase && ! ftl._wornOut) {
+		LOG (WARNING) << "[SSD] #" << base._idxDevice << " Block " << block
+			<< " reached its endurance (" << _param._numErase << " erasures)";
+		ftl._wornOut = true;
+	}
+
+	if (_param._algWL == WRL_STATIC)
+		levelWear (ftl, block, base, internals);
+}
+
+void
+SSDCtrl::levelWear (
+	OGSS_FTL				& ftl,
+	const uint32_t			block,
+	const Request			& base,
+	vector <Request>		& internals) {
+	// No closed block can be under the threshold
+	if (ftl._erase [block] <= ftl._minErase + _wlThreshold || ftl._cold.empty () ) return;
+
+	uint32_t				cold {ftl._cold.begin () ->second};
+
+	// The cold data is moved, its block will receive the next writes
+	if (ftl._erase [block] > ftl._erase [cold] + _wlThreshold)
+		reclaim (ftl, cold, base, internals);
 }
+
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+UT_SSDCtrl::UT_SSDCtrl (
+	const OGSS_String		& configurationFile):
+	UnitaryTest <UT_SSDCtrl> (MTP_SSDCTRL) {
+	set <OGSS_String>		testNames;
+
+	XMLParser::getListOfRequestedUnitaryTests (
+		configurationFile, _module, testNames);
+
+	for (auto & elt: testNames) {
+		if (! elt.compare ("all") ) {
+			_tests.push_back (make_pair ("Page mapping",
+				&UT_SSDCtrl::mapping) );
+			_tests.push_back (make_pair ("Full capacity",
+				&UT_SSDCtrl::fullCapacity) );
+			_tests.push_back (make_pair ("Greedy garbage collection",
+				&UT_SSDCtrl::greedyCollection) );
+			_tests.push_back (make_pair ("Cost-benefit garbage collection",
+				&UT_SSDCtrl::costBenefitCollection) );
+			_tests.push_back (make_pair ("Wear levelling",
+				&UT_SSDCtrl::wearLevelling) );
+		} else if (! elt.compare ("mapping") )
+			_tests.push_back (make_pair ("Page mapping",
+				&UT_SSDCtrl::mapping) );
+		else if (! elt.compare ("fullcapacity") )
+			_tests.push_back (make_pair ("Full capacity",
+				&UT_SSDCtrl::fullCapacity) );
+		else if (! elt.compare ("greedy") )
+			_tests.push_back (make_pair ("Greedy garbage collection",
+				&UT_SSDCtrl::greedyCollection) );
+		else if (! elt.compare ("costbenefit") )
+			_tests.push_back (make_pair ("Cost-benefit garbage collection",
+				&UT_SSDCtrl::costBenefitCollection) );
+		else if (! elt.compare ("wearlevelling") )
+			_tests.push_back (make_pair ("Wear levelling",
+				&UT_SSDCtrl::wearLevelling) );
+		else
+			LOG (WARNING) << ModuleNameMap.at (_module) << " unitary test "
+				<< "named '" << elt << "' does not match!";
+	}
+}
+
+UT_SSDCtrl::~UT_SSDCtrl () {  }
+
+#include "utest/utssdctrl.cpp"
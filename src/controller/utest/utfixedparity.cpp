@@ -0,0 +1,115 @@
+template <OGSS_Ulong D, OGSS_Ulong P, class C>
+OGSS_Bool
+UT_FixedParityCtrl::compareLayout (
+	const OGSS_DeclusteringType	parity,
+	const OGSS_Bool			ranges) {
+	const OGSS_Ulong		numRequests = 100000;
+	const OGSS_Ulong		maxSize = (ranges ? 64 : 3) * D;
+	Volume					vol;
+	Device					dev;
+	mt19937					gen (0);
+	vector <Request>		parents;
+	vector <Request>		srGeneric, srFixed;
+	OGSS_Ulong				numGeneric {0}, numFixed {0};
+	Chrono					chr;
+
+	vol._numDevices = D + P;
+	vol._numRedundancyDevices = P;
+	vol._suSize = 4096;
+	vol._declustering = parity;
+	vol._rangeDecomposition = false;
+	dev._physicalCapacity = 1UL << 34;
+
+	// The generic controller decomposes stripe by stripe and is the reference
+	PerfectParityCtrl		generic (vol, dev);
+	vol._rangeDecomposition = ranges;
+	C						fixed (vol, dev);
+
+	for (OGSS_Ulong i = 0; i < numRequests; ++i) {
+		Request				req;
+		req._type = gen () % 2 ? RQT_READ : RQT_WRITE;
+		req._size = (1 + gen () % maxSize) * vol._suSize;
+		req._volumeAddress = (gen () % (1UL << 20) ) * vol._suSize;
+		parents.push_back (req);
+	}
+
+	// Check that both controllers give the same decomposition
+	for (auto elt: parents) {
+		Request				rg {elt}, rf {elt};
+
+		srGeneric.clear ();		generic.decompose (rg, srGeneric);
+		srFixed.clear ();		fixed.decompose (rf, srFixed);
+
+		if (rg._numChild != rf._numChild || rg._numPrioChild != rf._numPrioChild
+			|| srGeneric.size () != srFixed.size () ) return false;
+
+		for (OGSS_Ulong i = 0; i < srGeneric.size (); ++i)
+			if (srGeneric [i] ._idxDevice != srFixed [i] ._idxDevice
+				|| srGeneric [i] ._deviceAddress != srFixed [i] ._deviceAddress
+				|| srGeneric [i] ._size != srFixed [i] ._size
+				|| srGeneric [i] ._type != srFixed [i] ._type
+				|| srGeneric [i] ._prio != srFixed [i] ._prio
+				|| srGeneric [i] ._numLink != srFixed [i] ._numLink
+				|| srGeneric [i] ._minrIdx != srFixed [i] ._minrIdx) return false;
+	}
+
+	// Decomposition throughput of each controller
+	chr.tick ();
+	for (auto elt: parents) {
+		srGeneric.clear ();		generic.decompose (elt, srGeneric);
+		numGeneric += srGeneric.size ();
+	}
+	chr.tick ();
+	auto					timeGeneric {max <OGSS_Long> (chr.get (), 1)};
+	chr.restart ();
+
+	chr.tick ();
+	for (auto elt: parents) {
+		srFixed.clear ();		fixed.decompose (elt, srFixed);
+		numFixed += srFixed.size ();
+	}
+	chr.tick ();
+	auto					timeFixed {max <OGSS_Long> (chr.get (), 1)};
+
+	LOG (INFO) << "[" << D << "+" << P << "] Decomposition of " << numRequests
+		<< " requests: generic " << numRequests * 1000000 / timeGeneric
+		<< " req/s, " << (ranges ? "by range " : "specialized ")
+		<< numRequests * 1000000 / timeFixed
+		<< " req/s (" << numGeneric << "/" << numFixed << " subrequests)";
+
+	return numGeneric == numFixed;
+}
+
+OGSS_Bool
+UT_FixedParityCtrl::layout4p1 ()
+	{ return compareLayout <4, 1> (DCL_OFF); }
+
+OGSS_Bool
+UT_FixedParityCtrl::layout8p1 ()
+	{ return compareLayout <8, 1> (DCL_OFF); }
+
+OGSS_Bool
+UT_FixedParityCtrl::layout8p2 ()
+	{ return compareLayout <8, 2> (DCL_OFF); }
+
+OGSS_Bool
+UT_FixedParityCtrl::layout16p2 ()
+	{ return compareLayout <16, 2> (DCL_OFF); }
+
+OGSS_Bool
+UT_FixedParityCtrl::layout8p2Declustered ()
+	{ return compareLayout <8, 2> (DCL_PARITY) && compareLayout <8, 2> (DCL_DATA); }
+
+
+OGSS_Bool
+UT_FixedParityCtrl::rangeDecomposition () {
+	OGSS_Bool				res {true};
+
+	for (auto parity: {DCL_OFF, DCL_PARITY, DCL_DATA}) {
+		res &= compareLayout <8, 1> (parity, true);
+		res &= compareLayout <16, 2> (parity, true);
+		res &= compareLayout <6, 2, PerfectParityCtrl> (parity, true);
+	}
+
+	return res;
+}
@@ -401,4 +401,44 @@ UT_RAIDNPNoDecVolCtrl::moreStripeW1PRequest () {
 			return false;
 
 	return true;
-}
\ No newline at end of file
+}
+
+OGSS_Bool
+UT_RAIDNPNoDecVolCtrl::failedReadR1PRequest () {
+	RAIDNPNoDecVolCtrl		module ( (Volume () ), (Device () ) );
+	Request					req, event;
+	vector <Request>		sr;
+
+	module._numBytesByDev = 16;
+	module._numBytesBySU = 4;
+	module._numDevices = 4;
+	module._numParity = 1;
+
+	event._type = RQT_EVFLT;
+	event._idxDevice = 0;
+	event._date = 5.;
+
+	module.updateScheme (event);
+
+	req._size = 2;
+	req._volumeAddress = 0;
+	req._type = RQT_READ;
+	req._date = 1.;
+
+	module.decompose (req, sr);
+
+	if (sr.size () != 1 || sr.at (0) ._idxDevice != 0) return false;
+
+	sr.clear ();
+	req._numChild = 0;
+	req._date = 10.;
+
+	module.decompose (req, sr);
+
+	if (sr.size () != 3 || req._numChild != 3) return false;
+	if (sr.at (0) ._idxDevice != 3 || sr.at (1) ._idxDevice != 2
+		|| sr.at (2) ._idxDevice != 1) return false;
+	if (sr.at (0) ._size != 2 || sr.at (0) ._deviceAddress != 0) return false;
+
+	return true;
+}
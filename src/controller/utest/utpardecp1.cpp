@@ -400,5 +400,41 @@ UT_RAIDNPParDecVolCtrl::moreStripeW1PRequest () {
 		|| sr.at (14) ._idxDevice != 2 || sr.at (14) ._type != RQT_WRITE)
 			return false;
 
+	return true;
+}
+
+OGSS_Bool
+UT_RAIDNPParDecVolCtrl::steadyBuffer () {
+	RAIDNPParDecVolCtrl		module ( (Volume () ), (Device () ) );
+	Request					req;
+	vector <Request>		sr;
+	const Request			* data;
+
+	module._numBytesByDev = 16;
+	module._numBytesBySU = 4;
+	module._numDevices = 5;
+	module._numParity = 1;
+
+	// The largest request sets the capacity of the buffer
+	req._size = 64;
+	req._volumeAddress = 0;
+	req._type = RQT_WRITE;
+
+	module.decompose (req, sr);
+	data = sr.data ();
+
+	// Once the capacity is reached, the buffer is never reallocated
+	for (OGSS_Ulong i = 0; i < 1000; ++i) {
+		req._size = 1 + i % 26;
+		req._volumeAddress = (5 * i) % (64 - req._size + 1);
+		req._type = i % 2 ? RQT_READ : RQT_WRITE;
+		req._numChild = req._numPrioChild = 0;
+
+		sr.clear ();
+		module.decompose (req, sr);
+
+		if (sr.data () != data || sr.empty () ) return false;
+	}
+
 	return true;
 }
\ No newline at end of file
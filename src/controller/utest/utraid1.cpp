@@ -22,6 +22,8 @@ UT_RAID1VolCtrl::UT_RAID1VolCtrl (
 				&UT_RAID1VolCtrl::readRequests) );
 			_tests.push_back (make_pair ("Write request",
 				&UT_RAID1VolCtrl::writeRequest) );
+			_tests.push_back (make_pair ("Failed device read request",
+				&UT_RAID1VolCtrl::failedReadRequest) );
 		} else if (! elt.compare ("middleDev") )
 			_tests.push_back (make_pair ("Middle device request",
 				&UT_RAID1VolCtrl::middleDeviceRequest) );
@@ -43,6 +45,9 @@ UT_RAID1VolCtrl::UT_RAID1VolCtrl (
 		else if (! elt.compare ("writeRequest") )
 			_tests.push_back (make_pair ("Write request",
 				&UT_RAID1VolCtrl::writeRequest) );
+		else if (! elt.compare ("failedRead") )
+			_tests.push_back (make_pair ("Failed device read request",
+				&UT_RAID1VolCtrl::failedReadRequest) );
 		else
 			LOG (WARNING) << ModuleNameMap.at (_module) << " unitary test "
 				<< "named '" << elt << "' does not match!";
@@ -226,3 +231,48 @@ UT_RAID1VolCtrl::writeRequest () {
 
 	return true;
 }
+
+OGSS_Bool
+UT_RAID1VolCtrl::failedReadRequest () {
+	RAID1VolCtrl			module ( (Volume () ), (Device () ) );
+	Request					req, event;
+	vector <Request>		sr;
+
+	module._numBytesByDev = 16;
+	module._numDevices = 4;
+
+	event._type = RQT_EVFLT;
+	event._idxDevice = 0;
+	event._date = 5.;
+
+	module.updateScheme (event);
+
+	req._size = 4;
+	req._volumeAddress = 6;
+	req._type = RQT_READ;
+
+	// Before the failure, the device is still read
+	module._mirrorChosen = true;
+	req._date = 1.;
+	module.decompose (req, sr);
+
+	if (sr.size () != 1 || sr.at (0) ._idxDevice != 0) return false;
+
+	// After the failure, the mirror is read instead
+	sr.clear ();
+	module._mirrorChosen = true;
+	req._date = 10.;
+	module.decompose (req, sr);
+
+	if (sr.size () != 1 || sr.at (0) ._idxDevice != 2) return false;
+
+	// A request dated before the failure, decomposed later, still reads it
+	sr.clear ();
+	module._mirrorChosen = true;
+	req._date = 2.;
+	module.decompose (req, sr);
+
+	if (sr.size () != 1 || sr.at (0) ._idxDevice != 0) return false;
+
+	return true;
+}
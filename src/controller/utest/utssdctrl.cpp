@@ -0,0 +1,202 @@
+OGSS_Bool
+UT_SSDCtrl::checkMapping (
+	const OGSS_FTL			& ftl) {
+	vector <uint32_t>		valid (ftl._numBlocks, 0);
+
+	for (OGSS_Ulong lp = 0; lp < ftl._numPages; ++lp) {
+		uint32_t			pp {ftl._l2p.get (lp)};
+
+		if (pp == OGSS_PageTable::_kNil) continue;
+		if (ftl._p2l.get (pp) != lp) return false;
+		++ valid [pp / ftl._pagesPerBlock];
+	}
+
+	return valid == ftl._valid;
+}
+
+OGSS_Bool
+UT_SSDCtrl::runWorkload (
+	const OGSS_GarbageCollectionType	gc,
+	const OGSS_WearLevellingType		wl,
+	const OGSS_Ulong		hotPages,
+	OGSS_FTL				& res) {
+	const OGSS_Ulong		numRequests = 200000;
+	const OGSS_Ulong		footprint = 700;
+	Device					dev;
+	mt19937					gen (0);
+	vector <Request>		internals;
+
+	dev._param.s._pageSize = 1;
+	dev._param.s._pagesPerBlock = 16;
+	dev._param.s._blocksPerDie = 32;
+	dev._param.s._numDies = 2;
+	dev._param.s._numErase = 0;
+	dev._param.s._overProvisioning = .07;
+	dev._param.s._algTrns = TRS_SSDPAGEMAP;
+	dev._param.s._algGC = gc;
+	dev._param.s._algWL = wl;
+
+	SSDCtrl					ctrl (dev);
+	ctrl._wlThreshold = 8;
+
+	for (OGSS_Ulong i = 0; i < numRequests; ++i) {
+		Request				req;
+
+		req._type = RQT_WRITE;
+		req._date = i;
+		req._idxDevice = 0;
+		req._size = 1 + gen () % 4;
+		req._deviceAddress = (i < footprint / 4) ? 4 * i
+			: (gen () % 10 ? gen () % hotPages : gen () % (footprint - 4) );
+
+		internals.clear ();
+		ctrl.translate (req, internals);
+
+		// Erases are aligned on blocks, copies stay in the device
+		for (auto & elt: internals) {
+			if (elt._type == RQT_ERASE && (elt._deviceAddress % 16 || elt._size != 16) )
+				return false;
+			if (elt._deviceAddress + elt._size > 16 * 64 || ! elt._internal)
+				return false;
+		}
+
+		if (ctrl._ftl [0] ._numFree + 1 < ctrl._gcThreshold) return false;
+	}
+
+	res = move (ctrl._ftl [0]);
+
+	return checkMapping (res) && res._flashWrites >= res._hostWrites
+		&& res._numErase > 0;
+}
+
+OGSS_Bool
+UT_SSDCtrl::mapping () {
+	Device					dev;
+	vector <Request>		internals;
+	Request					req;
+
+	dev._param.s._pageSize = 1;
+	dev._param.s._pagesPerBlock = 16;
+	dev._param.s._blocksPerDie = 32;
+	dev._param.s._numDies = 2;
+	dev._param.s._numErase = 0;
+	dev._param.s._overProvisioning = .07;
+	dev._param.s._algTrns = TRS_SSDPAGEMAP;
+	dev._param.s._algGC = GCL_DEFAULT;
+	dev._param.s._algWL = WRL_DEFAULT;
+
+	SSDCtrl					ctrl (dev);
+
+	req._idxDevice = 0;
+
+	// First write, mapped on the first pages of the flash
+	req._type = RQT_WRITE;	req._deviceAddress = 100;	req._size = 40;
+	ctrl.translate (req, internals);
+	if (! internals.empty () || req._split || req._deviceAddress != 0) return false;
+
+	// Overwrite in the middle, mapped after the first write
+	req._deviceAddress = 108;	req._size = 8;
+	ctrl.translate (req, internals);
+	if (! internals.empty () || req._split || req._deviceAddress != 40) return false;
+
+	// Read of the whole range, split in three fragments
+	req._type = RQT_READ;	req._deviceAddress = 100;	req._size = 40;
+	ctrl.translate (req, internals);
+	if (internals.size () != 3 || ! req._split || req._size != 40) return false;
+	if (internals [0] ._deviceAddress != 0 || internals [0] ._size != 8
+		|| internals [1] ._deviceAddress != 40 || internals [1] ._size != 8
+		|| internals [2] ._deviceAddress != 16 || internals [2] ._size != 24)
+		return false;
+
+	return checkMapping (ctrl._ftl [0]) && ctrl._ftl [0] ._valid [0] == 8
+		&& ctrl._ftl [0] ._valid [2] == 16;
+}
+
+OGSS_Bool
+UT_SSDCtrl::fullCapacity () {
+	const OGSS_Ulong		numRequests = 50000;
+	Device					dev;
+	mt19937					gen (0);
+	vector <Request>		internals;
+
+	dev._param.s._pageSize = 1;
+	dev._param.s._pagesPerBlock = 16;
+	dev._param.s._blocksPerDie = 32;
+	dev._param.s._numDies = 2;
+	dev._param.s._numErase = 0;
+	dev._param.s._overProvisioning = 0;
+	dev._param.s._algTrns = TRS_SSDPAGEMAP;
+	dev._param.s._algWL = WRL_STATIC;
+
+	// Without over-provisioning, only the minimal spare blocks are kept and
+	// the whole exported capacity is overwritten
+	for (auto gc: {GCL_GREEDY, GCL_COSTBENEFIT}) {
+		dev._param.s._algGC = gc;
+
+		SSDCtrl				ctrl (dev);
+		OGSS_Ulong			numLogical {16 * (64 - SSDParameters::_kMinSpareBlocks)};
+
+		for (OGSS_Ulong i = 0; i < numRequests; ++i) {
+			Request			req;
+
+			req._type = RQT_WRITE;
+			req._date = i;
+			req._idxDevice = 0;
+			req._size = (i < numLogical / 4) ? 4 : 1 + gen () % 4;
+			req._deviceAddress = (i < numLogical / 4) ? 4 * i
+				: gen () % (numLogical - req._size + 1);
+
+			internals.clear ();
+			ctrl.translate (req, internals);
+		}
+
+		if (ctrl._ftl [0] ._numLogical != numLogical
+			|| ! checkMapping (ctrl._ftl [0]) ) return false;
+	}
+
+	return true;
+}
+
+OGSS_Bool
+UT_SSDCtrl::greedyCollection () {
+	OGSS_FTL				ftl;
+
+	if (! runWorkload (GCL_GREEDY, WRL_DEFAULT, 64, ftl) ) return false;
+
+	LOG (INFO) << "Greedy: write amplification "
+		<< static_cast <OGSS_Real> (ftl._flashWrites) / ftl._hostWrites
+		<< ", " << ftl._numErase << " erased blocks";
+
+	return true;
+}
+
+OGSS_Bool
+UT_SSDCtrl::costBenefitCollection () {
+	OGSS_FTL				ftl;
+
+	if (! runWorkload (GCL_COSTBENEFIT, WRL_DEFAULT, 64, ftl) ) return false;
+
+	LOG (INFO) << "Cost-benefit: write amplification "
+		<< static_cast <OGSS_Real> (ftl._flashWrites) / ftl._hostWrites
+		<< ", " << ftl._numErase << " erased blocks";
+
+	return true;
+}
+
+OGSS_Bool
+UT_SSDCtrl::wearLevelling () {
+	OGSS_FTL				none, leveled;
+
+	if (! runWorkload (GCL_GREEDY, WRL_DEFAULT, 64, none)
+		|| ! runWorkload (GCL_GREEDY, WRL_STATIC, 64, leveled) ) return false;
+
+	auto spread = [] (const OGSS_FTL & ftl) {
+		auto				res {minmax_element (ftl._erase.begin (), ftl._erase.end () )};
+		return * res.second - * res.first;
+	};
+
+	LOG (INFO) << "Erase count spread: " << spread (none) << " without wear "
+		<< "levelling, " << spread (leveled) << " with static wear levelling";
+
+	return 4 * spread (leveled) < spread (none);
+}
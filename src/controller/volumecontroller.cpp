@@ -1,5 +1,33 @@
 #include "controller/volumecontroller.hpp"
 
+#include <algorithm>
+#include <type_traits>
+
+using namespace std;
+
+static_assert (is_trivially_copyable <Request>::value,
+	"The children are copied from their parent in the child buffer");
+
+static OGSS_Bool
+__requestCompare (
+	const Request						& lhs,
+	const Request						& rhs) {
+	if (lhs._type != rhs._type) return lhs._type < rhs._type;
+	if (lhs._idxDevice != rhs._idxDevice) return lhs._idxDevice < rhs._idxDevice;
+	return lhs._deviceAddress < rhs._deviceAddress;
+}
+
+// The minor index holds the creation sequence of the child when sorting, so
+// the ties are broken as the insertion in an ordered set did and the order
+// does not depend on the implementation of std::sort
+static OGSS_Bool
+__childCompare (
+	const Request						& lhs,
+	const Request						& rhs) {
+	return __requestCompare (lhs, rhs)
+		|| (! __requestCompare (rhs, lhs) && lhs._minrIdx < rhs._minrIdx);
+}
+
 void
 VolumeController::updateScheme (
 	const Request						& event) {
@@ -13,3 +41,55 @@ VolumeController::updateScheme (
 		default:;
 	}
 }
+
+void
+VolumeController::_removeAndMerge (
+	Request								& request,
+	vector <Request>					& subrequests,
+	const OGSS_Bool						renumber) {
+	OGSS_Ulong							last {0};
+	OGSS_Ulong							idx {1};
+
+	if (renumber) request._numChild = request._numPrioChild = 0;
+
+	if (subrequests.empty () ) return;
+
+	// The parity controllers copy the minor index of the parent in several
+	// children, it is replaced by the creation sequence (the numbering done
+	// by the declustered controllers is the same one)
+	for (OGSS_Ulong i {0}; i < subrequests.size (); ++i)
+		subrequests [i] ._minrIdx = i + 1;
+
+	sort (subrequests.begin (), subrequests.end (), __childCompare);
+
+	for (OGSS_Ulong i {1}; i < subrequests.size (); ++i) {
+		Request							& flt = subrequests [last];
+		const Request					& elt = subrequests [i];
+
+		if (! __requestCompare (subrequests [i - 1], elt) )
+			continue;
+
+		if (flt._type == elt._type
+		 && flt._idxDevice == elt._idxDevice
+		 && flt._deviceAddress + flt._size == elt._deviceAddress) {
+			flt._size += elt._size;
+			continue;
+		}
+
+		if (renumber) {
+			flt._minrIdx = idx ++;
+			++ request._numChild;
+			if (flt._prio) ++ request._numPrioChild;
+		}
+
+		if (++ last != i) subrequests [last] = elt;
+	}
+
+	if (renumber) {
+		subrequests [last] ._minrIdx = idx;
+		++ request._numChild;
+		if (subrequests [last] ._prio) ++ request._numPrioChild;
+	}
+
+	subrequests.erase (subrequests.begin () + last + 1, subrequests.end () );
+}
@@ -0,0 +1,288 @@
+/*
+ * Copyright UVSQ - CEA/DAM/DIF (2018)
+ * Contributors:  Sebastien GOUGEAUD  -- sebastien.gougeaud@uvsq.fr
+ *                Soraya ZERTAL       --      soraya.zertal@uvsq.fr
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published per the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+//! \file	commandqueue.cpp
+//! \brief	Definition of the device command queue.
+
+/*----------------------------------------------------------------------------*/
+/* HEADERS -------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+#include "computation/comphdd.hpp"
+
+#include "driver/commandqueue.hpp"
+
+#include "parser/xmlparser.hpp"
+
+#if USE_STATIC_GLOG
+#include "glog/logging.h"
+#else
+#include <glog/logging.h>
+#endif
+
+using namespace std;
+
+constexpr OGSS_Ulong CommandQueue::_kAging;
+constexpr OGSS_Ulong CommandQueue::_kNone;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC MEMBER FUNCTIONS ---------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+CommandQueue::CommandQueue (
+	const Device			& device) {
+	_depth = max <OGSS_Ulong> (device._queueDepth, 1);
+	_scheduling = device._scheduling;
+	_hdd = device._type == DTP_HDD;
+
+	// Without a positioning cost, the arrival order is kept
+	if (! _hdd) { _scheduling = SCH_FIFO; return; }
+
+	_geometry = device._param.h;
+	for (OGSS_Ulong w = 0; w < 2; ++w)
+		CompHDD::seekCurve (_geometry, w, _seekA [w], _seekB [w], _seekMin [w]);
+
+	_entries.reserve (_depth);
+}
+
+CommandQueue::~CommandQueue () {  }
+
+OGSS_Bool
+CommandQueue::isReady (
+	const OGSS_Real			date) const {
+	return ! _entries.empty () && _nextDate () < date;
+}
+
+void
+CommandQueue::push (
+	const Request			& req) {
+	Entry					elt;
+
+	elt._track = 0;
+	elt._angle = .0;
+	elt._seq = _numPushed ++;
+	elt._req = req;
+
+	if (_hdd && _scheduling != SCH_FIFO) {
+		OGSS_Ulong			sector = req._deviceAddress / _geometry._sectorSize;
+
+		elt._track = (sector / _geometry._sectorsPerTrack) % _geometry._tracksPerPlatter;
+		elt._angle = static_cast <OGSS_Real> (sector % _geometry._sectorsPerTrack)
+			/ _geometry._sectorsPerTrack;
+	}
+
+	// The entries stay sorted by track, then by arrival
+	_entries.insert (_entries.begin () + _lowerBound (elt._track + 1), elt);
+}
+
+void
+CommandQueue::pop (
+	Request					& req) {
+	OGSS_Real				date {_nextDate ()};
+	OGSS_Ulong				pos {0}, oldest {0};
+
+	for (OGSS_Ulong i = 1; i < _entries.size (); ++i)
+		if (_entries [i] ._seq < _entries [oldest] ._seq) oldest = i;
+
+	// The oldest request arrived first, so it can always be served
+	if (_scheduling == SCH_FIFO
+		|| _numPushed - _entries [oldest] ._seq > _kAging * _depth)
+		pos = oldest;
+	else if (_scheduling == SCH_SSTF)	pos = _selectSSTF (date);
+	else if (_scheduling == SCH_SCAN)	pos = _selectSCAN (date);
+	else								pos = _selectSPTF (date);
+
+	req = _entries [pos] ._req;
+	req._dispatchIdx = _numPopped ++;
+
+	if (_hdd) {
+		OGSS_Ulong			end = req._deviceAddress / _geometry._sectorSize
+			+ req._size / _geometry._sectorSize;
+
+		_idleDate = date + _positioningTime (_entries [pos], date)
+			+ req._size * _geometry._transferRate;
+		_headTrack = (end / _geometry._sectorsPerTrack) % _geometry._tracksPerPlatter;
+	}
+
+	_entries.erase (_entries.begin () + pos);
+}
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE MEMBER FUNCTIONS --------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+OGSS_Real
+CommandQueue::_nextDate () const {
+	OGSS_Real				first {_entries.front () ._req._date};
+
+	for (auto & elt: _entries)
+		first = min (first, elt._req._date);
+
+	// The device is idle when the first request arrives, or busy until
+	// its idle date
+	return max (_idleDate, first);
+}
+
+OGSS_Ulong
+CommandQueue::_selectSSTF (
+	const OGSS_Real			date) const {
+	OGSS_Ulong				pos {_kNone}, best {0};
+
+	// Entries of a track are in arrival order, and the higher track wins
+	// a tie
+	for (OGSS_Ulong i = 0; i < _entries.size (); ++i) {
+		OGSS_Ulong			track {_entries [i] ._track};
+		OGSS_Ulong			dist {(track >= _headTrack) ? track - _headTrack : _headTrack - track};
+
+		if (_entries [i] ._req._date > date) continue;
+		if (pos == _kNone || dist < best
+			|| (dist == best && track > _entries [pos] ._track) )
+			{ pos = i; best = dist; }
+	}
+
+	return pos;
+}
+
+OGSS_Ulong
+CommandQueue::_selectSCAN (
+	const OGSS_Real			date) {
+	OGSS_Ulong				above {_kNone}, below {_kNone};
+
+	// First arrived entry of the nearest track in each direction, the head
+	// track being in both
+	for (OGSS_Ulong i = 0; i < _entries.size (); ++i) {
+		OGSS_Ulong			track {_entries [i] ._track};
+
+		if (_entries [i] ._req._date > date) continue;
+		if (track >= _headTrack && (above == _kNone || track < _entries [above] ._track) )
+			above = i;
+		if (track <= _headTrack && (below == _kNone || track > _entries [below] ._track) )
+			below = i;
+	}
+
+	if (_up && above == _kNone) _up = false;
+	else if (! _up && below == _kNone) _up = true;
+
+	return _up ? above : below;
+}
+
+OGSS_Ulong
+CommandQueue::_selectSPTF (
+	const OGSS_Real			date) const {
+	OGSS_Ulong				pos {_kNone};
+	OGSS_Real				best {.0};
+
+	for (OGSS_Ulong i = 0; i < _entries.size (); ++i) {
+		OGSS_Real			cost;
+
+		if (_entries [i] ._req._date > date) continue;
+
+		cost = _positioningTime (_entries [i], date);
+		if (pos == _kNone || cost < best
+			|| (cost == best && _entries [i] ._seq < _entries [pos] ._seq) )
+			{ best = cost; pos = i; }
+	}
+
+	return pos;
+}
+
+OGSS_Ulong
+CommandQueue::_lowerBound (
+	const OGSS_Ulong		track) const {
+	return lower_bound (_entries.begin (), _entries.end (), track,
+		[] (const Entry & elt, const OGSS_Ulong t) { return elt._track < t; } )
+		- _entries.begin ();
+}
+
+OGSS_Real
+CommandQueue::_positioningTime (
+	const Entry				& elt,
+	const OGSS_Real			date) const {
+	OGSS_Ulong				w {(elt._req._type & RQT_WRITE) ? 1UL : 0UL};
+	OGSS_Real				dist, seek, head, delay;
+
+	dist = (_headTrack >= elt._track) ? _headTrack - elt._track : elt._track - _headTrack;
+	seek = (dist == 0) ? .0
+		: _seekA [w] * sqrt (dist) + _seekB [w] * (dist - 1) + _seekMin [w];
+
+	// Angle under the head at the end of the seek, the platters turning
+	// from the angle 0 at the date 0 as in the rotational HDD model
+	head = (date + seek) / _geometry._rotationSpeed;
+	head -= floor (head);
+
+	delay = elt._angle - head;
+	if (delay < 0) delay += 1;
+
+	return seek + delay * _geometry._rotationSpeed;
+}
+
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+UT_CommandQueue::UT_CommandQueue (
+	const OGSS_String		& configurationFile):
+	UnitaryTest <UT_CommandQueue> (MTP_COMMANDQUEUE) {
+	set <OGSS_String>		testNames;
+
+	XMLParser::getListOfRequestedUnitaryTests (
+		configurationFile, _module, testNames);
+
+	for (auto & elt: testNames) {
+		if (! elt.compare ("all") ) {
+			_tests.push_back (make_pair ("Shortest seek first",
+				&UT_CommandQueue::shortestSeek) );
+			_tests.push_back (make_pair ("Elevator",
+				&UT_CommandQueue::elevator) );
+			_tests.push_back (make_pair ("Shortest positioning first",
+				&UT_CommandQueue::shortestPositioning) );
+			_tests.push_back (make_pair ("Aging",
+				&UT_CommandQueue::aging) );
+			_tests.push_back (make_pair ("Admission by date",
+				&UT_CommandQueue::dateAdmission) );
+		} else if (! elt.compare ("sstf") )
+			_tests.push_back (make_pair ("Shortest seek first",
+				&UT_CommandQueue::shortestSeek) );
+		else if (! elt.compare ("scan") )
+			_tests.push_back (make_pair ("Elevator",
+				&UT_CommandQueue::elevator) );
+		else if (! elt.compare ("sptf") )
+			_tests.push_back (make_pair ("Shortest positioning first",
+				&UT_CommandQueue::shortestPositioning) );
+		else if (! elt.compare ("aging") )
+			_tests.push_back (make_pair ("Aging",
+				&UT_CommandQueue::aging) );
+		else if (! elt.compare ("admission") )
+			_tests.push_back (make_pair ("Admission by date",
+				&UT_CommandQueue::dateAdmission) );
+		else
+			LOG (WARNING) << ModuleNameMap.at (_module) << " unitary test "
+				<< "named '" << elt << "' does not match!";
+	}
+}
+
+UT_CommandQueue::~UT_CommandQueue () {  }
+
+#include "utest/utcommandqueue.cpp"
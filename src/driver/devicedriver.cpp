@@ -80,7 +80,7 @@ DeviceDriver::processExtraction () {
 	case DTP_HDD:
 		_ctrl = make_unique <HDDCtrl> (); break;
 	case DTP_SSD:
-		_ctrl = make_unique <SSDCtrl> (); break;
+		_ctrl = make_unique <SSDCtrl> (_device); break;
 	case DTP_NVRAM:
 		DLOG(INFO) << "TODO: NVRAM controller is selected"; break;
 	default:
@@ -118,10 +118,41 @@ DeviceDriver::processDecomposition () {
 				break;
 			default:
 // If bug, ensure that the state is valid for all devices (need to know numDev)
-				if (_deviceState [req._idxDevice] .isFailed (req._date) )
+				if (! req._cached && _deviceState [req._idxDevice] .isFailed (req._date) )
 					req._failed = true;
+
+				if (! _syncProc && ! req._failed && ! req._cached) {
+					auto	queue {_queues.find (req._idxDevice)};
+
+					if (queue == _queues.end () )
+						queue = _queues.emplace (req._idxDevice, CommandQueue (_device) ) .first;
+
+					// The device takes the queued requests when it goes
+					// idle before the new one arrives, among the ones which
+					// arrived by then; when the queue is full, the request
+					// chosen by the scheduling makes room for the new one.
+					// The requests keep their dispatch rank, so that the
+					// synchronization serves them in the same order
+					if (queue->second.isEnabled () ) {
+						Request		next;
+
+						while (queue->second.isReady (req._date) ) {
+							queue->second.pop (next);
+							dispatch (next);
+						}
+
+						queue->second.push (req);
+						if (! queue->second.isFull () ) continue;
+						queue->second.pop (req);
+					}
+				}
+
+				dispatch (req);
+				continue;
 		}
 
+		// The queued requests are sent before an event or the end
+		flushQueues ();
 		_ci->send (make_pair (MTP_EXECUTION, 0), &req, sizeof (req) );
 	}
 }
@@ -137,3 +168,32 @@ DeviceDriver::processSynchronization () {
 
 	DLOG(INFO) << "[DD] #" << _id.second << " End of sync.";
 }
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+void
+DeviceDriver::dispatch (
+	Request					& req) {
+	// The internal requests of the controller are executed first
+	if (_ctrl && ! req._failed && ! req._cached) {
+		_ctrl->translate (req, _internals);
+		for (auto & elt: _internals)
+			_ci->send (make_pair (MTP_EXECUTION, 0), &elt, sizeof (elt) );
+		_internals.clear ();
+	}
+
+	_ci->send (make_pair (MTP_EXECUTION, 0), &req, sizeof (req) );
+}
+
+void
+DeviceDriver::flushQueues () {
+	Request					req;
+
+	for (auto & elt: _queues)
+		while (! elt.second.isEmpty () ) {
+			elt.second.pop (req);
+			dispatch (req);
+		}
+}
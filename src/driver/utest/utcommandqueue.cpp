@@ -0,0 +1,149 @@
+Device
+UT_CommandQueue::createDevice (
+	const OGSS_SchedulingType	scheduling,
+	const OGSS_Ulong		depth) {
+	Device					dev;
+
+	// 8 sectors by track, one rotation every 8 time units and a seek of
+	// one time unit whatever the distance
+	dev._type = DTP_HDD;
+	dev._queueDepth = depth;
+	dev._scheduling = scheduling;
+	dev._param.h._sectorSize = 1;
+	dev._param.h._sectorsPerTrack = 8;
+	dev._param.h._tracksPerPlatter = 100;
+	dev._param.h._minReadSeek = dev._param.h._minWriteSeek = 1;
+	dev._param.h._avgReadSeek = dev._param.h._avgWriteSeek = 1;
+	dev._param.h._maxReadSeek = dev._param.h._maxWriteSeek = 1;
+	dev._param.h._rotationSpeed = 8;
+	dev._param.h._transferRate = 0;
+
+	return dev;
+}
+
+void
+UT_CommandQueue::pushTrack (
+	CommandQueue			& queue,
+	const OGSS_Ulong		track,
+	const OGSS_Ulong		sector,
+	const OGSS_Real			date) {
+	Request					req (date, 1, 0, RQT_READ);
+
+	req._deviceAddress = 8 * track + sector;
+	queue.push (req);
+}
+
+vector <OGSS_Ulong>
+UT_CommandQueue::popTracks (
+	CommandQueue			& queue) {
+	vector <OGSS_Ulong>		tracks;
+	Request					req;
+
+	while (! queue.isEmpty () ) {
+		queue.pop (req);
+		tracks.push_back (req._deviceAddress / 8);
+	}
+
+	return tracks;
+}
+
+OGSS_Bool
+UT_CommandQueue::shortestSeek () {
+	CommandQueue			sstf (createDevice (SCH_SSTF, 8) );
+	CommandQueue			fifo (createDevice (SCH_FIFO, 8) );
+
+	if (! sstf.isEnabled () || fifo.isEnabled () ) return false;
+
+	for (auto track: {50, 10, 60, 45}) {
+		pushTrack (sstf, track, 0, 0);
+		pushTrack (fifo, track, 0, 0);
+	}
+
+	// Nearest track from the head, which starts on track 0
+	return popTracks (sstf) == vector <OGSS_Ulong> {10, 45, 50, 60}
+		&& popTracks (fifo) == vector <OGSS_Ulong> {50, 10, 60, 45};
+}
+
+OGSS_Bool
+UT_CommandQueue::elevator () {
+	CommandQueue			queue (createDevice (SCH_SCAN, 8) );
+	vector <OGSS_Ulong>		tracks;
+	Request					req;
+
+	for (auto track: {50, 10, 60, 45})
+		pushTrack (queue, track, 0, 0);
+
+	queue.pop (req);	tracks.push_back (req._deviceAddress / 8);
+	queue.pop (req);	tracks.push_back (req._deviceAddress / 8);
+
+	// The head is on track 45 going up, track 20 waits for the way back
+	pushTrack (queue, 20, 0, 0);
+	pushTrack (queue, 70, 0, 0);
+
+	for (auto elt: popTracks (queue) ) tracks.push_back (elt);
+
+	return tracks == vector <OGSS_Ulong> {10, 45, 50, 60, 70, 20} && ! queue._up;
+}
+
+OGSS_Bool
+UT_CommandQueue::shortestPositioning () {
+	CommandQueue			sptf (createDevice (SCH_SPTF, 8) );
+	CommandQueue			sstf (createDevice (SCH_SSTF, 8) );
+
+	// On the head track, sector 6 is 6 time units away; on the next track,
+	// sector 1 is under the head right after the seek
+	for (auto queue: {&sptf, &sstf}) {
+		pushTrack (* queue, 0, 6, 0);
+		pushTrack (* queue, 1, 1, 0);
+	}
+
+	return popTracks (sptf) == vector <OGSS_Ulong> {1, 0}
+		&& popTracks (sstf) == vector <OGSS_Ulong> {0, 1};
+}
+
+OGSS_Bool
+UT_CommandQueue::aging () {
+	CommandQueue			queue (createDevice (SCH_SSTF, 2) );
+	Request					req;
+	OGSS_Ulong				numPops {0};
+
+	// A far request, then a stream of requests on the head track
+	pushTrack (queue, 90, 0, 0);
+
+	for (OGSS_Ulong i = 0; i < 4 * CommandQueue::_kAging * 2; ++i) {
+		pushTrack (queue, 0, i % 4, 0);
+		if (! queue.isFull () ) continue;
+
+		queue.pop (req);
+		++ numPops;
+
+		// The far request is served once it was passed over for the aging
+		// bound (4 queue depths), never before
+		if (req._deviceAddress / 8 == 90)
+			return numPops == CommandQueue::_kAging * 2;
+	}
+
+	return false;
+}
+
+OGSS_Bool
+UT_CommandQueue::dateAdmission () {
+	CommandQueue			queue (createDevice (SCH_SSTF, 8) );
+	Request					req;
+
+	pushTrack (queue, 50, 0, 0);
+	pushTrack (queue, 90, 0, 0);
+	pushTrack (queue, 52, 0, 100);
+
+	// The device is idle when the first requests arrive
+	if (queue.isReady (0) || ! queue.isReady (1) ) return false;
+
+	// Track 50 is served first: a seek of 1 and a rotational delay of 7,
+	// so the device is busy until 8
+	queue.pop (req);
+	if (req._deviceAddress / 8 != 50 || queue.isReady (8) || ! queue.isReady (9) )
+		return false;
+
+	// At 8, the request of track 52 has not arrived yet
+	return popTracks (queue) == vector <OGSS_Ulong> {90, 52};
+}
@@ -0,0 +1,287 @@
+//! \brief	Communication interface which keeps the sent requests.
+class UT_VolumeDriverInterface:
+public CommunicationInterface {
+public:
+	OGSS_Bool request (const OGSS_Interlocutor to) { return true; }
+	void requestBarrier () {  }
+	void requestFullBarrier () {  }
+	void releaseBarrier (const OGSS_Ushort numThreads) {  }
+	void receive (void * & arg) { arg = nullptr; }
+
+	void send (
+		const OGSS_Interlocutor	to,
+		const void				* arg,
+		const size_t			size,
+		const OGSS_Bool			multi = false) {
+		_sent.push_back (make_pair (to.first,
+			* static_cast <const Request *> (arg) ) );
+	}
+
+	vector <pair <OGSS_ModuleType, Request>>
+								_sent;				//!< Sent requests.
+};
+
+OGSS_Bool
+UT_VolumeDriver::checkOrder (
+	VolumeDriver				& driver) {
+	auto						ci = static_cast <UT_VolumeDriverInterface *> (driver._ci.get () );
+	OGSS_Real					date {.0};
+	OGSS_Ulong					numChild {0};
+
+	// Each request is followed by its children, sent in the date order
+	for (auto & elt: ci->_sent) {
+		if (elt.first == MTP_SYNCHRONIZATION) {
+			if (numChild || elt.second._date < date) return false;
+			date = elt.second._date;
+			numChild = elt.second._numChild;
+		} else if (! numChild -- || elt.second._date != date)
+			return false;
+	}
+
+	return ! numChild;
+}
+
+OGSS_Bool
+UT_VolumeDriver::cacheHitMiss () {
+	VolumeCache					cache (64, 16);
+	vector <OGSS_Ulong>			evicted;
+
+	if (! cache.isEnabled () || cache.getLineSize () != 16) return false;
+
+	// Miss, then hit once the lines are inserted
+	if (cache.lookup (0, 32) ) return false;
+	cache.insert (0, 32, false, evicted);
+	if (! cache.lookup (0, 32) || ! cache.lookup (8, 16) ) return false;
+
+	// A range which crosses a missing line is a miss
+	if (cache.lookup (16, 32) ) return false;
+
+	return evicted.empty () && ! VolumeCache ().isEnabled ();
+}
+
+OGSS_Bool
+UT_VolumeDriver::cacheEviction () {
+	VolumeCache					cache (64, 16);
+	vector <OGSS_Ulong>			evicted;
+
+	cache.insert (0, 16, false, evicted);
+	cache.insert (16, 16, true, evicted);
+	cache.insert (32, 32, false, evicted);
+
+	// Line 0 is used again, line 1 becomes the least recently used one
+	if (! cache.lookup (0, 16) || ! evicted.empty () ) return false;
+
+	// The dirty line 1 is evicted first and needs a destage
+	cache.insert (64, 16, false, evicted);
+	if (evicted != vector <OGSS_Ulong> {1}) return false;
+
+	// The clean line 2 is evicted without destage
+	evicted.clear ();
+	cache.insert (80, 16, false, evicted);
+	if (! evicted.empty () ) return false;
+
+	return ! cache.lookup (32, 16) && ! cache.lookup (16, 16)
+		&& cache.lookup (0, 16) && cache.lookup (48, 16);
+}
+
+OGSS_Bool
+UT_VolumeDriver::cacheDestage () {
+	Volume						vol;
+		vol._type = VTP_RAIDNP; vol._suSize = 16;
+		vol._numDevices = 5; vol._numRedundancyDevices = 1;
+		vol._numSubVolumes = 0; vol._declustering = DCL_OFF;
+		vol._rangeDecomposition = false; vol._isSubVolume = false;
+		vol._cachePolicy = CCP_WRITEBACK;
+		vol._bufferSize = 32; vol._coalescingWindow = 0;
+	VolumeDriver				driver (_cfg, 0);
+	auto						ci = make_shared <UT_VolumeDriverInterface> ();
+	OGSS_Ulong					numPrioChild, numChild, numUser;
+
+	// RAID 4+1, one stripe is 64 units
+	driver._vol = vol;
+	driver._dev._physicalCapacity = 1 << 20;
+	driver._firstDevIdx = 0;
+	driver._ctrl = createParityCtrl (driver._vol, driver._dev);
+	driver._cache = VolumeCache (vol._bufferSize, vol._suSize);
+	driver._ci = ci;
+
+	// Two lines of the cache, written back
+	for (OGSS_Ulong i = 0; i < 3; ++i) {
+		Request					req (i, 16, 16 * i, RQT_WRITE);
+
+		req._volumeAddress = 16 * i;
+		req._idxDevice = 0;
+		req._numChild = req._numPrioChild = 0;
+
+		driver._ctrl->decompose (req, driver._subrequests);
+		numPrioChild = req._numPrioChild;
+		numUser = driver._subrequests.size ();
+
+		ci->_sent.clear ();
+		driver.processCache (req);
+
+		for (OGSS_Ulong j = 0; j < driver._subrequests.size (); ++j)
+			if (driver._subrequests [j] ._cached != (j < numUser) ) return false;
+
+		// The first two writes only fill the cache
+		if (i < 2 && driver._subrequests.size () != numUser) return false;
+
+		// The third one evicts the dirty line 0, destaged without priority
+		if (i == 2) {
+			if (driver._subrequests.size () <= numUser) return false;
+			for (OGSS_Ulong j = numUser; j < driver._subrequests.size (); ++j)
+				if (driver._subrequests [j] ._prio
+					|| driver._subrequests [j] ._volumeAddress != 0) return false;
+		}
+
+		if (req._numPrioChild != numPrioChild
+			|| req._numChild != driver._subrequests.size () ) return false;
+
+		numChild = req._numChild;
+		driver.sendDecomposition (req);
+
+		if (! driver._subrequests.empty () || ci->_sent.size () != numChild + 1
+			|| ci->_sent.front () .first != MTP_SYNCHRONIZATION) return false;
+	}
+
+	return true;
+}
+
+OGSS_Bool
+UT_VolumeDriver::fullStripe () {
+	Volume						vol;
+		vol._type = VTP_RAIDNP; vol._suSize = 16;
+		vol._numDevices = 5; vol._numRedundancyDevices = 1;
+		vol._numSubVolumes = 0; vol._declustering = DCL_OFF;
+		vol._rangeDecomposition = false; vol._isSubVolume = false;
+		vol._cachePolicy = CCP_WRITEBACK;
+		vol._bufferSize = 0; vol._coalescingWindow = 10;
+	VolumeDriver				driver (_cfg, 0);
+	auto						ci = make_shared <UT_VolumeDriverInterface> ();
+	OGSS_Ulong					numWrites {0}, numReads {0};
+	OGSS_Real					date {0};
+
+	// RAID 4+1, one stripe is 64 units
+	driver._vol = vol;
+	driver._dev._physicalCapacity = 1 << 20;
+	driver._firstDevIdx = 0;
+	driver._ctrl = createParityCtrl (driver._vol, driver._dev);
+	driver._cache = VolumeCache (vol._bufferSize, vol._suSize);
+	driver._ci = ci;
+
+	// The stripe is written out of order, the last write completes it
+	for (OGSS_Ulong addr: {16, 0, 48, 32}) {
+		Request					req (date ++, 16, addr, RQT_WRITE);
+
+		req._volumeAddress = addr;
+		req._idxDevice = 0;
+
+		driver.flushCoalescedStripes (req._date);
+		if (! driver.isCoalescable (req) ) return false;
+		driver.coalesceWrite (req);
+
+		if (addr != 32 && ! ci->_sent.empty () ) return false;
+	}
+
+	for (auto & elt: ci->_sent) {
+		if (elt.second._date != 3) return false;
+		if (elt.first == MTP_SYNCHRONIZATION) continue;
+		if (elt.second._type == RQT_READ) ++ numReads;
+		else ++ numWrites;
+	}
+
+	// Four data writes and the parity one, without any pre-read
+	return driver._coalescedStripes.empty () && numReads == 0
+		&& numWrites == 5 && checkOrder (driver);
+}
+
+OGSS_Bool
+UT_VolumeDriver::partialFlush () {
+	Volume						vol;
+		vol._type = VTP_RAIDNP; vol._suSize = 16;
+		vol._numDevices = 5; vol._numRedundancyDevices = 1;
+		vol._numSubVolumes = 0; vol._declustering = DCL_OFF;
+		vol._rangeDecomposition = false; vol._isSubVolume = false;
+		vol._cachePolicy = CCP_WRITEBACK;
+		vol._bufferSize = 0; vol._coalescingWindow = 10;
+	VolumeDriver				driver (_cfg, 0);
+	auto						ci = make_shared <UT_VolumeDriverInterface> ();
+	OGSS_Ulong					numRequests {0}, numReads {0};
+
+	// RAID 4+1, one stripe is 64 units
+	driver._vol = vol;
+	driver._dev._physicalCapacity = 1 << 20;
+	driver._firstDevIdx = 0;
+	driver._ctrl = createParityCtrl (driver._vol, driver._dev);
+	driver._cache = VolumeCache (vol._bufferSize, vol._suSize);
+	driver._ci = ci;
+
+	for (OGSS_Ulong addr: {0, 16}) {
+		Request					req (addr / 16, 16, addr, RQT_WRITE);
+
+		req._volumeAddress = addr;
+		req._idxDevice = 0;
+
+		driver.flushCoalescedStripes (req._date);
+		driver.coalesceWrite (req);
+	}
+
+	// An event flushes the incomplete stripe at its date
+	driver.flushCoalescedStripes (5, true);
+
+	for (auto & elt: ci->_sent) {
+		if (elt.second._date != 5) return false;
+		if (elt.first == MTP_SYNCHRONIZATION) ++ numRequests;
+		else if (elt.second._type == RQT_READ) ++ numReads;
+	}
+
+	// Each write has its own read-modify-write
+	return driver._coalescedStripes.empty () && numRequests == 2
+		&& numReads > 0 && checkOrder (driver);
+}
+
+OGSS_Bool
+UT_VolumeDriver::timeoutFlush () {
+	Volume						vol;
+		vol._type = VTP_RAIDNP; vol._suSize = 16;
+		vol._numDevices = 5; vol._numRedundancyDevices = 1;
+		vol._numSubVolumes = 0; vol._declustering = DCL_OFF;
+		vol._rangeDecomposition = false; vol._isSubVolume = false;
+		vol._cachePolicy = CCP_WRITEBACK;
+		vol._bufferSize = 0; vol._coalescingWindow = 10;
+	VolumeDriver				driver (_cfg, 0);
+	auto						ci = make_shared <UT_VolumeDriverInterface> ();
+	vector <OGSS_Real>			dates;
+
+	// RAID 4+1, one stripe is 64 units
+	driver._vol = vol;
+	driver._dev._physicalCapacity = 1 << 20;
+	driver._firstDevIdx = 0;
+	driver._ctrl = createParityCtrl (driver._vol, driver._dev);
+	driver._cache = VolumeCache (vol._bufferSize, vol._suSize);
+	driver._ci = ci;
+
+	// The second stripe is held before the first one
+	for (auto elt: {make_pair (0., 64UL), make_pair (2., 0UL), make_pair (6., 128UL)}) {
+		Request					req (elt.first, 16, elt.second, RQT_WRITE);
+
+		req._volumeAddress = elt.second;
+		req._idxDevice = 0;
+
+		driver.flushCoalescedStripes (req._date);
+		driver.coalesceWrite (req);
+	}
+
+	// The first two windows are over, the third one is not
+	driver.flushCoalescedStripes (13);
+	if (driver._coalescedStripes.size () != 1) return false;
+
+	// End of the stream
+	driver.flushCoalescedStripes (OGSS_REAL_MAX);
+
+	for (auto & elt: ci->_sent)
+		if (elt.first == MTP_SYNCHRONIZATION) dates.push_back (elt.second._date);
+
+	return driver._coalescedStripes.empty ()
+		&& dates == vector <OGSS_Real> {10, 12, 16} && checkOrder (driver);
+}
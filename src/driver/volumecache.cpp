@@ -0,0 +1,163 @@
+/*
+ * Copyright UVSQ - CEA/DAM/DIF (2018)
+ * Contributors:  Sebastien GOUGEAUD  -- sebastien.gougeaud@uvsq.fr
+ *                Soraya ZERTAL       --      soraya.zertal@uvsq.fr
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published per the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+//! \file	volumecache.cpp
+//! \brief	Definition of the volume cache.
+
+/*----------------------------------------------------------------------------*/
+/* HEADERS -------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#include "driver/volumecache.hpp"
+
+using namespace std;
+
+constexpr OGSS_Ulong VolumeCache::_kNil;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC MEMBER FUNCTIONS ---------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+VolumeCache::VolumeCache (
+	const OGSS_Ulong		size,
+	const OGSS_Ulong		lineSize) {
+	OGSS_Ulong				numBuckets {1};
+
+	_lineSize = lineSize ? lineSize : 1;
+	_lines.resize (size / _lineSize);
+
+	// At most two lines by bucket in average
+	_hashShift = 64;
+	while (numBuckets < (_lines.size () + 1) / 2)
+		{ numBuckets <<= 1; -- _hashShift; }
+	if (_hashShift == 64)
+		{ numBuckets = 2; _hashShift = 63; }
+
+	_buckets.assign (numBuckets, _kNil);
+}
+
+VolumeCache::~VolumeCache () {  }
+
+OGSS_Bool
+VolumeCache::lookup (
+	const OGSS_Ulong		address,
+	const OGSS_Ulong		size) {
+	OGSS_Ulong				first {address / _lineSize};
+	OGSS_Ulong				last {(address + max <OGSS_Ulong> (size, 1) - 1) / _lineSize};
+
+	for (OGSS_Ulong tag {first}; tag <= last; ++tag)
+		if (_find (tag) == _kNil) return false;
+
+	for (OGSS_Ulong tag {first}; tag <= last; ++tag) {
+		auto				pos {_find (tag)};
+
+		_unlink (pos);
+		_pushFront (pos);
+	}
+
+	return true;
+}
+
+void
+VolumeCache::insert (
+	const OGSS_Ulong		address,
+	const OGSS_Ulong		size,
+	const OGSS_Bool			dirty,
+	vector <OGSS_Ulong>		& evicted) {
+	OGSS_Ulong				first {address / _lineSize};
+	OGSS_Ulong				last {(address + max <OGSS_Ulong> (size, 1) - 1) / _lineSize};
+
+	for (OGSS_Ulong tag {first}; tag <= last; ++tag) {
+		auto				pos {_find (tag)};
+
+		if (pos != _kNil) {
+			_unlink (pos);
+			_lines [pos] ._dirty |= dirty;
+		} else {
+			if (_numUsed < _lines.size () )
+				pos = _numUsed ++;
+			else {								// Eviction of the LRU line
+				pos = _tail;
+				if (_lines [pos] ._dirty)
+					evicted.push_back (_lines [pos] ._tag);
+				_unlink (pos);
+				_unchain (pos);
+			}
+
+			auto			bkt {_bucket (tag)};
+
+			_lines [pos] ._tag = tag;
+			_lines [pos] ._dirty = dirty;
+			_lines [pos] ._chain = _buckets [bkt];
+			_buckets [bkt] = pos;
+		}
+
+		_pushFront (pos);
+	}
+}
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+OGSS_Ulong
+VolumeCache::_find (
+	const OGSS_Ulong		tag) const {
+	auto					pos {_buckets [_bucket (tag)]};
+
+	while (pos != _kNil && _lines [pos] ._tag != tag)
+		pos = _lines [pos] ._chain;
+
+	return pos;
+}
+
+void
+VolumeCache::_unlink (
+	const OGSS_Ulong		pos) {
+	Line					& l = _lines [pos];
+
+	if (l._prev != _kNil)	_lines [l._prev] ._next = l._next;
+	else					_head = l._next;
+	if (l._next != _kNil)	_lines [l._next] ._prev = l._prev;
+	else					_tail = l._prev;
+}
+
+void
+VolumeCache::_pushFront (
+	const OGSS_Ulong		pos) {
+	_lines [pos] ._prev = _kNil;
+	_lines [pos] ._next = _head;
+
+	if (_head != _kNil)		_lines [_head] ._prev = pos;
+	else					_tail = pos;
+	_head = pos;
+}
+
+void
+VolumeCache::_unchain (
+	const OGSS_Ulong		pos) {
+	auto					* link = & _buckets [_bucket (_lines [pos] ._tag)];
+
+	while (* link != pos)
+		link = & _lines [* link] ._chain;
+
+	* link = _lines [pos] ._chain;
+}
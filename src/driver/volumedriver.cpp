@@ -29,6 +29,7 @@
 #include <algorithm>
 #include <bitset>
 #include <cmath>
+#include <set>
 
 #include "controller/decraidvolctrl.hpp"
 #include "controller/jbodvolctrl.hpp"
@@ -38,7 +39,7 @@
 #include "controller/raidnpnodecvolctrl.hpp"
 #include "controller/raidnppardecvolctrl.hpp"
 
-#include "controller/perfparityctrl.hpp"
+#include "controller/fixedparityctrl.hpp"
 
 #include "driver/volumedriver.hpp"
 
@@ -101,7 +102,7 @@ VolumeDriver::processExtraction () {
 			case DCL_OFF: default:
 				_ctrl = make_unique <RAIDNPNoDecVolCtrl> (_vol, _dev); break;
 		}
-*/		_ctrl = make_unique <PerfectParityCtrl> (_vol, _dev); break;
+*/		_ctrl = createParityCtrl (_vol, _dev); break;
 	case VTP_DECRAID:
 		_ctrl = make_unique <DecRAIDVolCtrl> (_vol, _dev, _subVols);
 		break;
@@ -111,6 +112,16 @@ VolumeDriver::processExtraction () {
 			<< "controller type -- JBOD is selected!";
 		_ctrl = make_unique <JBODVolCtrl> (_vol, _dev);
 	}
+
+	// The child buffer keeps its capacity between two decompositions, so
+	// after a few requests no more allocation is done on this path
+	_subrequests.reserve (4 * max <OGSS_Ushort> (_vol._numDevices, 1) );
+
+	// One cache line by stripe unit, the destage of a line is then a
+	// single child on the data devices
+	if (_vol._bufferSize)
+		_cache = VolumeCache (_vol._bufferSize,
+			_vol._suSize ? _vol._suSize : _defaultLineSize);
 }
 
 void
@@ -118,7 +129,6 @@ VolumeDriver::processDecomposition () {
 	void					* arg;
 	Request					req;
 	OGSS_Bool				unfinished = true;
-	vector <Request>		subrequests;
 
 	while (unfinished) {
 		_ci->receive (arg);
@@ -127,7 +137,15 @@ VolumeDriver::processDecomposition () {
 		if (req._type == RQT_END)
 			{ unfinished = false; continue; }
 
+		// Event requests dated before this one are sent first, by chunks
+		generatePendingRequests (req._date);
+
+		// Held writes which are out of the coalescing window
+		flushCoalescedStripes (req._date);
+
 		if (req._type == RQT_EVFLT || req._type == RQT_EVRPL) {
+			flushCoalescedStripes (req._date, true);
+
 			LOG(INFO) << "[VD] Reception of event (" << req._date << ", " << req._idxDevice << ")";
 
 			_lastEventBlockOTF [req._majrIdx] ._deviceAddress = 0;
@@ -153,51 +171,33 @@ VolumeDriver::processDecomposition () {
 
 			if (! _syncOTF) {
 				Request b {req};
-				b._size = _vol._suSize;
-
-				if (req._type == RQT_EVFLT)
-					for (b._deviceAddress = 0; b._deviceAddress < _dev._physicalCapacity; b._deviceAddress += b._size)
-						_ctrl->generateFailureRequests (b, subrequests);
-				else if (req._type == RQT_EVRPL)
-					for (b._deviceAddress = 0; b._deviceAddress < _dev._physicalCapacity; b._deviceAddress += b._size)
-						_ctrl->generateRenewalRequests (b, subrequests);
+				b._size = (_vol._suSize != 0) ? _vol._suSize : _dev._physicalCapacity;
+				b._deviceAddress = 0;
+
+				_pendingEvents.push_back (b);
 			}
 
 			req._idxDevice += _firstDevIdx;
 
 			_ci->send (make_pair (MTP_DEVICE, _id.second), &req, sizeof (req) );
 
-			for (auto & elt: subrequests) {
-				elt._idxDevice += _firstDevIdx;
-
-				_ci->send (make_pair (MTP_DEVICE, _id.second), &elt, sizeof (req) );
-			}
-
 			DLOG (INFO) << "[VD] Event management done";
 
-			subrequests.clear ();
 			continue;
 		}
 
-		req._idxDevice -= _firstDevIdx;
-		_ctrl->decompose (req, subrequests);
-		req._idxDevice += _firstDevIdx;
-		_ci->send (make_pair (MTP_SYNCHRONIZATION, 0), &req, sizeof (req) );
-
-		for (auto & elt: subrequests) {
-			elt._idxDevice += _firstDevIdx;
-			elt._nativeIdxDevice += _firstDevIdx;
+		if (isCoalescable (req) )
+			{ coalesceWrite (req); continue; }
 
-			if (req._type == RQT_READ)
-				elt._transferTimeB2 = req._size;
-			else
-				elt._transferTimeA2 = req._size;
+		req._idxDevice -= _firstDevIdx;
+		_ctrl->decompose (req, _subrequests);
+		if (_cache.isEnabled () ) processCache (req);
+		sendDecomposition (req);
+	}
 
-			_ci->send (make_pair (MTP_DEVICE, _id.second), &elt, sizeof (req) );
-		}
+	flushCoalescedStripes (OGSS_REAL_MAX);
 
-		subrequests.clear ();
-	}
+	generatePendingRequests (OGSS_REAL_MAX);
 
 	_ci->send (make_pair (MTP_DEVICE, _id.second), &req, sizeof (req) );
 
@@ -209,7 +209,6 @@ VolumeDriver::processSynchronization () {
 	void								* arg;
 	OGSS_Ushort							numUnprocessedEvents {_numEvents};
 	Request								req;
-	vector <Request>					subrequests;
 	OGSS_OTFRequest						otfr;
 
 	if (! _syncOTF) return;
@@ -229,7 +228,7 @@ VolumeDriver::processSynchronization () {
 				LOG(INFO) << "STOP on " << _lastEventBlockOTF [req._majrIdx] ._deviceAddress << " for " << req._majrIdx
 					<< " because of the clock {" << otfr._currentClock << "}";
 				req._type = RQT_EVEND;
-				subrequests.push_back (req);
+				_subrequests.push_back (req);
 				-- numUnprocessedEvents;
 			} else {
 				req._size = max (_lastEventBlockOTF [req._majrIdx] ._size, otfr._requestSize);
@@ -239,18 +238,18 @@ VolumeDriver::processSynchronization () {
 					_lastEventBlockOTF [req._majrIdx] ._deviceAddress = otfr._lastDevAddress;
 				}
 
-				if (! generateEventRequests (req, otfr._nbRequests, subrequests) )
+				if (! generateEventRequests (req, otfr._nbRequests, _subrequests) )
 					-- numUnprocessedEvents;
 			}
 
-			for (auto & elt: subrequests) {
+			for (auto & elt: _subrequests) {
 				if (elt._type == RQT_WRITE)
 					elt._size = _lastEventBlockOTF [req._majrIdx] ._size;
 
 				_ci->send (make_pair (MTP_DEVICE, _id.second), &elt, sizeof (elt) );
 			}
 
-			subrequests.clear ();
+			_subrequests.clear ();
 		}
 	}
 
@@ -318,6 +317,252 @@ VolumeDriver::generateEventRequests (
 	return true;
 }
 
+void
+VolumeDriver::generatePendingRequests (
+	const OGSS_Real						date) {
+	OGSS_Bool							generated {true};
+
+	// The rebuild is paced against the user requests: the blocks of an event
+	// are dated one rebuild period apart from the event, and only the blocks
+	// dated before the next request are generated; the events are served in
+	// turn, one chunk each, until all these blocks are sent
+	while (generated) {
+		generated = false;
+
+		for (auto & b: _pendingEvents) {
+			OGSS_Ulong					i {0};
+
+			for (; i < _eventChunkSize && b._date <= date
+				&& b._deviceAddress < _dev._physicalCapacity; ++i) {
+				if (b._type == RQT_EVFLT)
+					_ctrl->generateFailureRequests (b, _subrequests);
+				else
+					_ctrl->generateRenewalRequests (b, _subrequests);
+
+				b._deviceAddress += b._size;
+				b._date += _rebuildPeriod;
+			}
+
+			if (! i) continue;
+
+			for (auto & elt: _subrequests) {
+				elt._idxDevice += _firstDevIdx;
+
+				_ci->send (make_pair (MTP_DEVICE, _id.second), &elt, sizeof (elt) );
+			}
+
+			_subrequests.clear ();
+			generated = true;
+		}
+	}
+
+	_pendingEvents.erase (remove_if (_pendingEvents.begin (), _pendingEvents.end (),
+		[&] (const Request & b) { return b._deviceAddress >= _dev._physicalCapacity; } ),
+		_pendingEvents.end () );
+}
+
+void
+VolumeDriver::processCache (
+	Request						& request) {
+	OGSS_Bool					served;
+	OGSS_Ulong					lineSize {_cache.getLineSize ()};
+
+	if (request._type == RQT_READ) {
+		served = _cache.lookup (request._volumeAddress, request._size);
+		if (! served)
+			_cache.insert (request._volumeAddress, request._size, false, _evictedLines);
+	} else {
+		served = (_vol._cachePolicy == CCP_WRITEBACK);
+		_cache.insert (request._volumeAddress, request._size, served, _evictedLines);
+	}
+
+	if (served)
+		for (auto & elt: _subrequests)
+			elt._cached = true;
+
+	if (_evictedLines.empty () ) return;
+
+	// Contiguous lines are destaged by a single write
+	sort (_evictedLines.begin (), _evictedLines.end () );
+
+	for (OGSS_Ulong i {0}, j; i < _evictedLines.size (); i = j) {
+		for (j = i + 1; j < _evictedLines.size ()
+			&& _evictedLines [j] == _evictedLines [j - 1] + 1; ++j);
+
+		Request					destage {request};
+
+		destage._type = RQT_WRITE;
+		destage._volumeAddress = _evictedLines [i] * lineSize;
+		destage._size = (j - i) * lineSize;
+		destage._numChild = destage._numPrioChild = 0;
+
+		_ctrl->decompose (destage, _destages);
+
+		// The destage does not take part in the priority chain of the
+		// request, so its pre-reads do not delay the user children
+		for (auto & elt: _destages) {
+			elt._minrIdx += request._numChild;
+			elt._cached = false;
+			elt._prio = false;
+			_subrequests.push_back (elt);
+		}
+
+		request._numChild += destage._numChild;
+
+		_destages.clear ();
+	}
+
+	_evictedLines.clear ();
+}
+
+void
+VolumeDriver::sendDecomposition (
+	Request						& request) {
+	request._idxDevice += _firstDevIdx;
+	_ci->send (make_pair (MTP_SYNCHRONIZATION, 0), &request, sizeof (request) );
+
+	for (auto & elt: _subrequests) {
+		elt._idxDevice += _firstDevIdx;
+		elt._nativeIdxDevice += _firstDevIdx;
+
+		if (request._type == RQT_READ)
+			elt._transferTimeB2 = request._size;
+		else
+			elt._transferTimeA2 = request._size;
+
+		_ci->send (make_pair (MTP_DEVICE, _id.second), &elt, sizeof (elt) );
+	}
+
+	_subrequests.clear ();
+}
+
+OGSS_Bool
+VolumeDriver::isCoalescable (
+	const Request				& request) const {
+	OGSS_Ulong					stripeSize {_vol._suSize * (_vol._numDevices - _vol._numRedundancyDevices)};
+
+	return _vol._coalescingWindow > 0 && _vol._type == VTP_RAIDNP
+		&& ! _cache.isEnabled () && ! _numEvents
+		&& request._type == RQT_WRITE && request._size && stripeSize
+		&& request._size < stripeSize
+		&& request._volumeAddress / stripeSize
+			== (request._volumeAddress + request._size - 1) / stripeSize;
+}
+
+void
+VolumeDriver::coalesceWrite (
+	const Request				& request) {
+	OGSS_Ulong					stripeSize {_vol._suSize * (_vol._numDevices - _vol._numRedundancyDevices)};
+	OGSS_Ulong					stripe {request._volumeAddress / stripeSize};
+	OGSS_Ulong					start {request._volumeAddress % stripeSize};
+	OGSS_CoalescedStripe		& cs = _coalescedStripes [stripe];
+	OGSS_Ulong					last {0};
+
+	if (cs._writes.empty () ) cs._date = request._date;
+	cs._writes.push_back (request);
+
+	// Written ranges are kept sorted and merged
+	cs._ranges.push_back (make_pair (start, start + request._size) );
+	sort (cs._ranges.begin (), cs._ranges.end () );
+	for (OGSS_Ulong i {1}; i < cs._ranges.size (); ++i) {
+		if (cs._ranges [i] .first <= cs._ranges [last] .second)
+			cs._ranges [last] .second = max (cs._ranges [last] .second, cs._ranges [i] .second);
+		else
+			cs._ranges [++ last] = cs._ranges [i];
+	}
+	cs._ranges.resize (last + 1);
+
+	if (cs._ranges.front () .first == 0 && cs._ranges.front () .second == stripeSize) {
+		writeFullStripe (stripe, cs._writes);
+		_coalescedStripes.erase (stripe);
+	}
+}
+
+void
+VolumeDriver::writeFullStripe (
+	const OGSS_Ulong			stripe,
+	vector <Request>			& writes) {
+	OGSS_Ulong					stripeSize {_vol._suSize * (_vol._numDevices - _vol._numRedundancyDevices)};
+	OGSS_DeviceMask				dataDevices;
+	Request						full {writes.back ()};
+	const OGSS_Real				date {full._date};
+
+	full._idxDevice -= _firstDevIdx;
+	full._volumeAddress = stripe * stripeSize;
+	full._size = stripeSize;
+	full._numChild = full._numPrioChild = 0;
+
+	_ctrl->decompose (full, _stripeChildren);
+
+	for (auto & w: writes) {
+		// The held writes leave the window with the write which completes
+		// the stripe
+		w._date = date;
+
+		Request					data {w};
+
+		// A read of the same range gives the data children of the write,
+		// without the pre-reads and the parity writes
+		data._type = RQT_READ;
+		data._idxDevice -= _firstDevIdx;
+		data._numChild = data._numPrioChild = 0;
+		_ctrl->decompose (data, _subrequests);
+
+		for (auto & elt: _subrequests) {
+			elt._type = RQT_WRITE;
+			dataDevices.set (elt._idxDevice);
+		}
+
+		// The parity of the stripe is written with the last write
+		if (&w == &writes.back () )
+			for (auto & elt: _stripeChildren)
+				if (! dataDevices [elt._idxDevice])
+					_subrequests.push_back (elt);
+
+		for (OGSS_Ulong i {0}; i < _subrequests.size (); ++i) {
+			_subrequests [i] ._minrIdx = i + 1;
+			_subrequests [i] ._prio = false;
+		}
+
+		w._idxDevice -= _firstDevIdx;
+		w._numChild = _subrequests.size ();
+		w._numPrioChild = 0;
+		sendDecomposition (w);
+	}
+
+	_stripeChildren.clear ();
+}
+
+void
+VolumeDriver::flushCoalescedStripes (
+	const OGSS_Real				date,
+	const OGSS_Bool				all) {
+	vector <pair <OGSS_Real, OGSS_Ulong>>	flushed;
+
+	for (auto & elt: _coalescedStripes) {
+		OGSS_Real				end {elt.second._date + _vol._coalescingWindow};
+
+		if (all || end < date)
+			flushed.push_back (make_pair (min (end, date), elt.first) );
+	}
+
+	// The stripes leave the window by date, so the requests are still sent
+	// in the date order
+	sort (flushed.begin (), flushed.end () );
+
+	for (auto & elt: flushed) {
+		// Timeout, each write has its own read-modify-write
+		for (auto & w: _coalescedStripes [elt.second] ._writes) {
+			w._date = elt.first;
+			w._idxDevice -= _firstDevIdx;
+			_ctrl->decompose (w, _subrequests);
+			sendDecomposition (w);
+		}
+
+		_coalescedStripes.erase (elt.second);
+	}
+}
+
 void
 VolumeDriver::receiveData () {
 	void						* arg;
@@ -345,3 +590,59 @@ VolumeDriver::receiveData () {
 	ack = true;
 	_ci->send (std::make_pair (MTP_HARDWARE, 0), &ack, sizeof (ack) );
 }
+
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+UT_VolumeDriver::UT_VolumeDriver (
+	const OGSS_String		& configurationFile):
+	UnitaryTest <UT_VolumeDriver> (MTP_VOLUME) {
+	set <OGSS_String>		testNames;
+
+	_cfg = configurationFile;
+
+	XMLParser::getListOfRequestedUnitaryTests (
+		configurationFile, _module, testNames);
+
+	for (auto & elt: testNames) {
+		if (! elt.compare ("all") ) {
+			_tests.push_back (make_pair ("Cache hit and miss",
+				&UT_VolumeDriver::cacheHitMiss) );
+			_tests.push_back (make_pair ("Cache eviction",
+				&UT_VolumeDriver::cacheEviction) );
+			_tests.push_back (make_pair ("Cache destage",
+				&UT_VolumeDriver::cacheDestage) );
+			_tests.push_back (make_pair ("Full stripe",
+				&UT_VolumeDriver::fullStripe) );
+			_tests.push_back (make_pair ("Partial flush",
+				&UT_VolumeDriver::partialFlush) );
+			_tests.push_back (make_pair ("Timeout flush",
+				&UT_VolumeDriver::timeoutFlush) );
+		} else if (! elt.compare ("cacheHitMiss") )
+			_tests.push_back (make_pair ("Cache hit and miss",
+				&UT_VolumeDriver::cacheHitMiss) );
+		else if (! elt.compare ("cacheEviction") )
+			_tests.push_back (make_pair ("Cache eviction",
+				&UT_VolumeDriver::cacheEviction) );
+		else if (! elt.compare ("cacheDestage") )
+			_tests.push_back (make_pair ("Cache destage",
+				&UT_VolumeDriver::cacheDestage) );
+		else if (! elt.compare ("fullStripe") )
+			_tests.push_back (make_pair ("Full stripe",
+				&UT_VolumeDriver::fullStripe) );
+		else if (! elt.compare ("partialFlush") )
+			_tests.push_back (make_pair ("Partial flush",
+				&UT_VolumeDriver::partialFlush) );
+		else if (! elt.compare ("timeoutFlush") )
+			_tests.push_back (make_pair ("Timeout flush",
+				&UT_VolumeDriver::timeoutFlush) );
+		else
+			LOG (WARNING) << ModuleNameMap.at (_module) << " unitary test "
+				<< "named '" << elt << "' does not match!";
+	}
+}
+
+UT_VolumeDriver::~UT_VolumeDriver () {  }
+
+#include "utest/utvolumedriver.cpp"
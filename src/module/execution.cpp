@@ -28,10 +28,7 @@
 
 #include <algorithm>
 
-#include "computation/comphdd.hpp"
 #include "computation/compinterface.hpp"
-#include "computation/compssd.hpp"
-#include "computation/compnvram.hpp"
 
 #include "module/execution.hpp"
 
@@ -56,6 +53,7 @@ Execution::Execution (
 	Module (configurationFile, make_pair (MTP_EXECUTION, 0) ) {
 	OGSS_String				sncModel;
 	OGSS_SynchronizationType	syncType = SNC_TOTAL;
+	OGSS_Ulong				batchSize;
 
 	sncModel = XMLParser::getComputationModel (_cfg, PTP_SYNC);
 
@@ -68,9 +66,21 @@ Execution::Execution (
 	if (find (OTFModels.begin (), OTFModels.end (), syncType) != OTFModels.end () )
 					_syncOTF = true;
 	else			_syncOTF = false;
+
+	batchSize = XMLParser::getExecutionBatchSize (_cfg);
+	if (batchSize) _batchSize = batchSize;
+	_batchWindow = XMLParser::getExecutionBatchWindow (_cfg);
 }
 
-Execution::~Execution () {  }
+Execution::~Execution () {
+	{
+		lock_guard <mutex>	lock (_poolMutex);
+		_poolStop = true;
+	}
+
+	_poolStart.notify_all ();
+	for (auto & elt: _workers) elt.join ();
+}
 
 void
 Execution::processExtraction () {
@@ -83,6 +93,8 @@ Execution::processExtraction () {
 	}
 
 	initComputationModels (_cfg);
+
+	_internalTime.assign (_devices.size (), .0);
 }
 
 void
@@ -97,26 +109,29 @@ Execution::processDecomposition () {
 		_ci->receive (arg);
 		req = * static_cast <Request *> (arg); free (arg);
 
-		switch (req._type) {
-			case RQT_END:
-				-- counter;
-//				DLOG(INFO) << "[EX] Received an end request, wait for " << counter << " more!";
-				continue;
-			case RQT_EVEND:
-//				LOG(INFO) << "[EX] #" << _id.second << " Reception of end event (" << req._date << ", " << req._idxDevice << ")";
-				break;
-			case RQT_EVSTP:
-				break;
-			case RQT_EVFLT: case RQT_EVRPL:
-//				DLOG(INFO) << "[EX] Received an event " << req._majrIdx << "/" << req._minrIdx;
-				break;
-			default:
-				treatRequest (req);
+		if (req._type == RQT_END) {
+			-- counter;
+//			DLOG(INFO) << "[EX] Received an end request, wait for " << counter << " more!";
+			continue;
 		}
 
-		_ci->send (make_pair (MTP_SYNCHRONIZATION, 0), &req, sizeof (Request) );
+		// A batch does not last more than the date window, so the requests
+		// are not held too long when the stream is sparse
+		if (_batchWindow > 0 && ! _batch.empty ()
+			&& req._date >= _batch.front () ._date + _batchWindow)
+			treatBatch ();
+
+		_batch.push_back (req);
+
+		// During the on-the-fly synchronization, the synchronization module
+		// waits for each request before generating the next ones
+		if (_syncProc || _batch.size () >= _batchSize)
+			treatBatch ();
 	}
 
+	// End of the stream, the last requests are computed
+	treatBatch ();
+
 	DLOG (INFO) << "[EX] Send ending to SC";
 
 	if (! _syncProc) {
@@ -139,88 +154,169 @@ Execution::processSynchronization () {
 /*----------------------------------------------------------------------------*/
 
 void
-Execution::treatRequest (
-	Request					& req) {
+Execution::treatBatch () {
+	OGSS_Ulong				numBusy {0};
 
-	LOG_IF (FATAL, req._idxDevice >= _devices.size () ) << "Bad device index on ["
-		<< req._mainIdx << "/" << req._majrIdx << "/" << req._minrIdx << "] -- " << req._idxDevice;
+	for (auto & req: _batch) {
+		if (! isComputed (req) ) continue;
 
-	if (req._failed)
-		req._serviceTime = .0;
-	else {
-		if (_devices [req._idxDevice] ._type == DTP_HDD)
-			_hdd->compute (req);
-		else if(_devices [req._idxDevice]._type == DTP_SSD){
-			_ssd->compute (req);
-		}else{
-			_nvram->compute (req);
+		LOG_IF (FATAL, req._idxDevice >= _devices.size () ) << "Bad device index on ["
+			<< req._mainIdx << "/" << req._majrIdx << "/" << req._minrIdx << "] -- " << req._idxDevice;
+
+		auto & shard = _shards [_shardOf [req._idxDevice] ];
+
+		if (req._failed || req._cached || req._split)
+			req._serviceTime = .0;
+		else
+			shard._batches [_modelOf [req._idxDevice] ] .push_back (&req);
+	}
+
+	for (auto & shard: _shards)
+		if (any_of (begin (shard._batches), end (shard._batches),
+			[] (const vector <Request *> & elt) { return ! elt.empty (); } ) )
+			++ numBusy;
+
+	// Each shard owns its devices, the workers are only woken up when
+	// there is more than one shard to compute
+	if (numBusy > 1) {
+		{
+			lock_guard <mutex>	lock (_poolMutex);
+			_poolPending = _workers.size ();
+			++ _poolRound;
+		}
+
+		_poolStart.notify_all ();
+		computeShard (_shards [0]);
+
+		unique_lock <mutex>	lock (_poolMutex);
+		_poolDone.wait (lock, [&] { return ! _poolPending; } );
+	} else
+		for (auto & shard: _shards) computeShard (shard);
+
+	for (auto & req: _batch) {
+		// The internal requests of a device controller are charged to the
+		// next request of the device
+		if (req._internal) {
+			_internalTime [req._idxDevice] += req._serviceTime;
+			continue;
+		}
+
+		if (isComputed (req) ) {
+			req._serviceTime += _internalTime [req._idxDevice];
+			_internalTime [req._idxDevice] = .0;
+
+			_transferBatch.push_back (&req);
 		}
 	}
 
-	_interface->compute (req);
+	_interface->computeBatch (_transferBatch);
+	_transferBatch.clear ();
+
+	for (auto & req: _batch) {
+		if (req._internal) continue;
+
+		// The volume cache answers, the devices bus is not used
+		if (req._cached && isComputed (req) )
+			req._transferTimeA3 = req._transferTimeB3 = .0;
+
+		_ci->send (make_pair (MTP_SYNCHRONIZATION, 0), &req, sizeof (Request) );
+	}
+
+	_batch.clear ();
 }
 
 void
-Execution::initComputationModels (
-	const OGSS_String		configurationFile) {
-	OGSS_String				modelType;
-	OGSS_HDDComputationType	hddType;
-	OGSS_SSDComputationType	ssdType;
-	OGSS_NVRAMComputationType nvramType;
-	OGSS_InterfaceComputationType	interfaceType;
+Execution::runWorker (
+	const OGSS_Ulong		idx) {
+	OGSS_Ulong				round {0};
+
+	while (true) {
+		{
+			unique_lock <mutex>	lock (_poolMutex);
+			_poolStart.wait (lock, [&] { return _poolStop || _poolRound != round; } );
+			if (_poolStop) return;
+			round = _poolRound;
+		}
 
-	modelType = XMLParser::getComputationModel (configurationFile, PTP_HDD);
+		computeShard (_shards [idx]);
 
-	auto findRes1 = find_if (HDDComputationNameMap.begin (), HDDComputationNameMap.end (),
-		[&] (const pair <OGSS_HDDComputationType, OGSS_String> & elt)
-		{ return ! elt.second.compare (modelType); } );
-	if (findRes1 != HDDComputationNameMap.end () )
-		hddType = findRes1->first;
-	else {
-		DLOG (INFO) << "Default HDD computation model is chosen";
-		hddType = HCP_DEFAULT;
+		lock_guard <mutex>	lock (_poolMutex);
+		if (! -- _poolPending) _poolDone.notify_one ();
 	}
+}
 
-	switch (hddType) {
-		case HCP_TOTAL:
-		case HCP_DEFAULT:
-		_hdd = make_unique <CompHDD> (_devices);
+void
+Execution::computeShard (
+	OGSS_ExecutionShard		& shard) {
+	for (OGSS_Ulong i = 0; i < DTP_TOTAL; ++i) {
+		if (shard._batches [i] .empty () ) continue;
+
+		if (shard._cache.isEnabled () ) shard._cache.filter (shard._batches [i]);
+		shard._models [i] ->computeBatch (shard._batches [i]);
+		if (shard._cache.isEnabled () ) shard._cache.settle (shard._batches [i]);
+		shard._batches [i] .clear ();
 	}
+}
 
-	modelType = XMLParser::getComputationModel (configurationFile, PTP_SSD);
+void
+Execution::initShards (
+	OGSS_Ulong				numShards) {
+	OGSS_Ulong				numDevices {_devices.size ()};
 
-	auto findRes2 = find_if (SSDComputationNameMap.begin (), SSDComputationNameMap.end (),
-		[&] (const pair <OGSS_SSDComputationType, OGSS_String> & elt)
-		{ return ! elt.second.compare (modelType); } );
-	if (findRes2 != SSDComputationNameMap.end () )
-		ssdType = findRes2->first;
-	else {
-		DLOG (INFO) << "Default SSD computation model is chosen";
-		ssdType = SCP_DEFAULT;
-	}
+	numShards = max <OGSS_Ulong> (1, min <OGSS_Ulong> (numShards, numDevices) );
 
-	switch (ssdType) {
-		case SCP_TOTAL:
-		case SCP_DEFAULT:
-		_ssd = make_unique <CompSSD> (_devices);
-	}
+	_shards.resize (numShards);
+	_shardOf.resize (numDevices);
 
-	modelType = XMLParser::getComputationModel (configurationFile, PTP_NVRAM);
+	for (OGSS_Ulong i = 0; i < numShards; ++i) {
+		_shards [i] ._firstDevice = i * numDevices / numShards;
+		_shards [i] ._lastDevice = (i + 1) * numDevices / numShards;
 
-	auto findRes4 = find_if (NVRAMComputationNameMap.begin (), NVRAMComputationNameMap.end (),
-		[&] (const pair <OGSS_NVRAMComputationType, OGSS_String> & elt)
-		{ return ! elt.second.compare (modelType); } );
-	if (findRes4 != NVRAMComputationNameMap.end () )
-		nvramType = findRes4->first;
-	else {
-		DLOG (INFO) << "Default NVRAM computation model is chosen";
-		nvramType = NCP_DEFAULT;
+		for (auto j = _shards [i] ._firstDevice; j < _shards [i] ._lastDevice; ++j)
+			_shardOf [j] = i;
+
+		_shards [i] ._cache = DeviceCache (_devices,
+			_shards [i] ._firstDevice, _shards [i] ._lastDevice);
 	}
 
-	switch (nvramType) {
-		case NCP_TOTAL:
-		case NCP_DEFAULT:
-		_nvram = make_unique <CompNVRAM> (_devices);
+	for (OGSS_Ulong i = 1; i < numShards; ++i)
+		_workers.emplace_back (&Execution::runWorker, this, i);
+
+	DLOG (INFO) << "[EX] " << numShards << " execution shard(s) for "
+		<< numDevices << " devices";
+}
+
+void
+Execution::initComputationModels (
+	const OGSS_String		configurationFile) {
+	const OGSS_ParamType	modelParam [DTP_TOTAL] {PTP_HDD, PTP_SSD, PTP_NVRAM};
+	OGSS_String				modelType;
+	OGSS_InterfaceComputationType	interfaceType;
+
+	initShards (XMLParser::getNumExecutionShards (configurationFile) );
+
+	// The model of each device is chosen once, the devices of an unknown
+	// type use the NVRAM model
+	_modelOf.resize (_devices.size () );
+	for (OGSS_Ulong i = 0; i < _devices.size (); ++i)
+		_modelOf [i] = (_devices [i] ._type < DTP_NVRAM) ? _devices [i] ._type : DTP_NVRAM;
+
+	for (OGSS_Ulong i = 0; i < DTP_TOTAL; ++i) {
+		auto				type {static_cast <OGSS_DeviceType> (i)};
+
+		modelType = XMLParser::getComputationModel (configurationFile, modelParam [i]);
+
+		for (auto & shard: _shards) {
+			shard._models [i] = createComputationModel (type, modelType, _devices,
+				shard._firstDevice, shard._lastDevice);
+			if (shard._models [i]) continue;
+
+			DLOG (INFO) << "Default " << DeviceNameMap.at (type)
+				<< " computation model is chosen";
+			modelType = "default";
+			shard._models [i] = createComputationModel (type, modelType, _devices,
+				shard._firstDevice, shard._lastDevice);
+		}
 	}
 
 	modelType = XMLParser::getComputationModel (configurationFile, PTP_INTERFACE);
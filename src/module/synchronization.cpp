@@ -33,6 +33,7 @@
 
 #include "synchronization/syncdefv2.hpp"
 #include "synchronization/syncdefv4otf.hpp"
+#include "synchronization/syncparallel.hpp"
 #include "synchronization/syncsingledisk.hpp"
 
 #include "parser/xmlparser.hpp"
@@ -57,6 +58,8 @@ Synchronization::Synchronization (
 	_resumeFile = XMLParser::getFilePath (_cfg, FTP_RESUME, false);
 
 	_globalDU = XMLParser::getDataUnit(_cfg, PTP_GLOBAL);
+
+	_online = XMLParser::getOnlineSynchronization (_cfg);
 }
 
 Synchronization::~Synchronization () {
@@ -124,6 +127,7 @@ Synchronization::processDecomposition () {
 			_evtStats.push_back (stat);
 		} else {
 			_sync->addEntry (req);
+			if (_online) _sync->advance ();
 			_nbRequests++;
 			if(req._majrIdx == 0){ //Logical Request
 				_nbLogicalRequests++;
@@ -203,6 +207,22 @@ Synchronization::initSyncModel () {
 		syncType = SNC_DEFV2;
 	}
 
+	// Only the version 2 models and the parallel one process the steps
+	// during the decomposition
+	LOG_IF(FATAL, _online && (syncType == SNC_DEFV4OTF
+		|| syncType == SNC_SINGLEDISK) )
+		<< "The online synchronization is not supported by the " << modelType
+		<< " model, use defv2, defv2heap or parallel";
+
+	// The version 2 models retire the requests during the decomposition,
+	// once processed by the online synchronization: in the batch mode, they
+	// are all received before. The version 4 model does not keep the output
+	// rows, so it releases them during the batch synchronization
+	LOG_IF(FATAL, XMLParser::getRequestRetirement (_cfg) && ! _online
+		&& syncType != SNC_DEFV4OTF)
+		<< "The request retirement needs the online synchronization, or the "
+		<< "defv4otf model";
+
 	switch (syncType) {
 		case SNC_DEFV4OTF:
 			_sync = make_unique <SyncDefV4OTF> (_ci, _hardParam, _tiers, _volumes,
@@ -211,9 +231,23 @@ Synchronization::initSyncModel () {
 		case SNC_SINGLEDISK: 
 			_sync = make_unique <SyncSingleDisk> (_ci, _hardParam, _globalDU);
 			break;
-		case SNC_TOTAL: case SNC_DEFAULT: case SNC_PARALLEL: case SNC_QUEUE:
+		case SNC_PARALLEL:
+			_sync = make_unique <SyncParallel> (_ci, _hardParam, _tiers, _volumes,
+				_devices, _interfaces, _globalDU,
+				XMLParser::getNumSynchronizationShards (_cfg) );
+			break;
+		// The steps are done earliest first instead of in the scan order,
+		// so the results can differ from the ones of defv2
+		case SNC_DEFV2HEAP:
+			_sync = make_unique <SyncDefV2> (_ci, _hardParam, _tiers, _volumes,
+				_devices, _interfaces, _globalDU, true);
+			break;
+		case SNC_TOTAL: case SNC_DEFAULT: case SNC_QUEUE:
 		case SNC_DEFV2:
 			_sync = make_unique <SyncDefV2> (_ci, _hardParam, _tiers, _volumes,
 				_devices, _interfaces, _globalDU);
 	}
+
+	if (XMLParser::getRequestRetirement (_cfg) )
+		_sync->enableRetirement (_outputFile);
 }
@@ -302,6 +302,78 @@ XMLParser::getComputationModel (
 	return _getString (root, ParamNameMap.at (paramType), false);
 }
 
+OGSS_Ulong
+XMLParser::getNumExecutionShards (
+	const OGSS_String		& filename) {
+	XMLDocument				doc;
+	XMLElement				* root {_getRootNode (filename, doc) };
+
+	root = _getNode (root, ParamNameMap.at (PTP_COMPUTATION), true);
+
+	return _getLong (root, ParamNameMap.at (PTP_SHARDS) );
+}
+
+OGSS_Ulong
+XMLParser::getExecutionBatchSize (
+	const OGSS_String		& filename) {
+	XMLDocument				doc;
+	XMLElement				* root {_getRootNode (filename, doc) };
+
+	root = _getNode (root, ParamNameMap.at (PTP_COMPUTATION), true);
+
+	return _getLong (root, ParamNameMap.at (PTP_BATCHSIZE) );
+}
+
+OGSS_Real
+XMLParser::getExecutionBatchWindow (
+	const OGSS_String		& filename) {
+	XMLDocument				doc;
+	XMLElement				* root {_getRootNode (filename, doc) };
+
+	root = _getNode (root, ParamNameMap.at (PTP_COMPUTATION), true);
+
+	return _getReal (root, ParamNameMap.at (PTP_BATCHWINDOW) );
+}
+
+OGSS_Ulong
+XMLParser::getNumSynchronizationShards (
+	const OGSS_String		& filename) {
+	XMLDocument				doc;
+	XMLElement				* root {_getRootNode (filename, doc) };
+
+	root = _getNode (root, ParamNameMap.at (PTP_COMPUTATION), true);
+
+	return _getLong (root, ParamNameMap.at (PTP_SYNCSHARDS) );
+}
+
+OGSS_Bool
+XMLParser::getOnlineSynchronization (
+	const OGSS_String		& filename) {
+	XMLDocument				doc;
+	XMLElement				* root {_getRootNode (filename, doc) };
+	OGSS_String				value;
+
+	root = _getNode (root, ParamNameMap.at (PTP_COMPUTATION), true);
+	value = _getString (root, ParamNameMap.at (PTP_ONLINE) );
+
+	return ! value.compare ("on") || ! value.compare ("yes")
+		|| ! value.compare ("true");
+}
+
+OGSS_Bool
+XMLParser::getRequestRetirement (
+	const OGSS_String		& filename) {
+	XMLDocument				doc;
+	XMLElement				* root {_getRootNode (filename, doc) };
+	OGSS_String				value;
+
+	root = _getNode (root, ParamNameMap.at (PTP_COMPUTATION), true);
+	value = _getString (root, ParamNameMap.at (PTP_RETIRE) );
+
+	return ! value.compare ("on") || ! value.compare ("yes")
+		|| ! value.compare ("true");
+}
+
 OGSS_Ulong
 XMLParser::getCommunicationPort (
 	const OGSS_String		& filename) {
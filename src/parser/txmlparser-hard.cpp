@@ -94,7 +94,11 @@ getSubVolumes (
 
 		v._parent = parent;
 		v._numSubVolumes = 0;
+		v._bufferSize = 0;
+		v._cachePolicy = CCP_WRITEBACK;
+		v._coalescingWindow = .0;
 		v._suSize = 0;
+		v._rangeDecomposition = false;
 		v._isSubVolume = true;
 
 		volType = _getString (item, ParamNameMap.at (PTP_TYPE), true);
@@ -118,6 +122,10 @@ getSubVolumes (
 				v._numRedundancyDevices = _getLong (item,
 					ParamNameMap.at (PTP_NBPAR), true);
 
+				decType = _getString (item, ParamNameMap.at (PTP_RANGES), true);
+				v._rangeDecomposition = ! decType.compare ("on")
+					|| ! decType.compare ("yes") || ! decType.compare ("true");
+
 				decType = _getString (item, ParamNameMap.at (PTP_DECL), true);
 				auto fR2 = find_if (DeclusteringNameMap.begin (), DeclusteringNameMap.end (),
 					[&] (const pair <OGSS_DeclusteringType, OGSS_String> & elt)
@@ -154,6 +162,7 @@ getVolumes (
 	OGSS_String				busName;
 	OGSS_String				volType;
 	OGSS_String				decType;
+	OGSS_String				cchType;
 	OGSS_String				devPath;
 
 	item = root->FirstChildElement (ParamNameMap.at (PTP_VOLUME) .c_str () );
@@ -164,6 +173,7 @@ getVolumes (
 		v._parent = parent;
 		v._numSubVolumes = 0;
 		v._suSize = 0;
+		v._rangeDecomposition = false;
 		v._isSubVolume = false;
 
 		busName = _getString (item, ParamNameMap.at (PTP_BUS), true);
@@ -187,6 +197,22 @@ getVolumes (
 
 		v._numDevices = _getLong (cfg, ParamNameMap.at (PTP_NBDEV), true);
 
+		v._bufferSize = _getLongPrefix (cfg, PTP_BUFSIZE);
+		v._cachePolicy = CCP_WRITEBACK;
+		if (v._bufferSize) {
+			cchType = _getString (cfg, ParamNameMap.at (PTP_CACHE) );
+			auto fR3 = find_if (CachePolicyNameMap.begin (), CachePolicyNameMap.end (),
+				[&] (const pair <OGSS_CachePolicy, OGSS_String> & elt)
+				{ return ! elt.second.compare (cchType); } );
+			if (fR3 != CachePolicyNameMap.end () && fR3->first != CCP_TOTAL)
+				v._cachePolicy = fR3->first;
+			else if (cchType.length () )
+				LOG (WARNING) << "The cache policy '" << cchType << "' is "
+					<< "not available! 'Write-back' policy is chosen instead.";
+		}
+
+		v._coalescingWindow = _getRealPrefix (cfg, PTP_COALESCING);
+
 		if (v._type == VTP_DECRAID) {
 			v._suSize = _getLong (cfg, ParamNameMap.at (PTP_SUSIZE), true);
 			v._numRedundancyDevices = _getLong (cfg,
@@ -225,6 +251,10 @@ getVolumes (
 					v._numRedundancyDevices = _getLong (cfg,
 						ParamNameMap.at (PTP_NBPAR), true);
 
+					decType = _getString (cfg, ParamNameMap.at (PTP_RANGES), true);
+					v._rangeDecomposition = ! decType.compare ("on")
+						|| ! decType.compare ("yes") || ! decType.compare ("true");
+
 					decType = _getString (cfg, ParamNameMap.at (PTP_DECL), true);
 					auto fR2 = find_if (DeclusteringNameMap.begin (), DeclusteringNameMap.end (),
 						[&] (const pair <OGSS_DeclusteringType, OGSS_String> & elt)
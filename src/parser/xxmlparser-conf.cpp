@@ -423,6 +423,150 @@ XMLParser::getComputationModel (
 	return _getString (node, ParamNameMap.at (paramType), false);
 }
 
+OGSS_Ulong
+XMLParser::getNumExecutionShards (
+	const OGSS_String		& filename) {
+	ifstream				filestream (filename.c_str () );
+	XercesDOMParser			parser;
+	DOMNode					* node;
+
+	if (! filestream.good () ) {
+		LOG (FATAL) << "The configuration file '" << filename
+			<< "' does not exist!";
+		return 1;
+	}
+
+	filestream.close ();
+
+	parser.parse (filename.c_str () );
+
+	node = parser.getDocument () ->getDocumentElement ();
+	node = _getNode (node, ParamNameMap.at (PTP_COMPUTATION), true);
+
+	return _getLong (node, ParamNameMap.at (PTP_SHARDS) );
+}
+
+OGSS_Ulong
+XMLParser::getExecutionBatchSize (
+	const OGSS_String		& filename) {
+	ifstream				filestream (filename.c_str () );
+	XercesDOMParser			parser;
+	DOMNode					* node;
+
+	if (! filestream.good () ) {
+		LOG (FATAL) << "The configuration file '" << filename
+			<< "' does not exist!";
+		return 0;
+	}
+
+	filestream.close ();
+
+	parser.parse (filename.c_str () );
+
+	node = parser.getDocument () ->getDocumentElement ();
+	node = _getNode (node, ParamNameMap.at (PTP_COMPUTATION), true);
+
+	return _getLong (node, ParamNameMap.at (PTP_BATCHSIZE) );
+}
+
+OGSS_Real
+XMLParser::getExecutionBatchWindow (
+	const OGSS_String		& filename) {
+	ifstream				filestream (filename.c_str () );
+	XercesDOMParser			parser;
+	DOMNode					* node;
+
+	if (! filestream.good () ) {
+		LOG (FATAL) << "The configuration file '" << filename
+			<< "' does not exist!";
+		return .0;
+	}
+
+	filestream.close ();
+
+	parser.parse (filename.c_str () );
+
+	node = parser.getDocument () ->getDocumentElement ();
+	node = _getNode (node, ParamNameMap.at (PTP_COMPUTATION), true);
+
+	return _getReal (node, ParamNameMap.at (PTP_BATCHWINDOW) );
+}
+
+OGSS_Ulong
+XMLParser::getNumSynchronizationShards (
+	const OGSS_String		& filename) {
+	ifstream				filestream (filename.c_str () );
+	XercesDOMParser			parser;
+	DOMNode					* node;
+
+	if (! filestream.good () ) {
+		LOG (FATAL) << "The configuration file '" << filename
+			<< "' does not exist!";
+		return 0;
+	}
+
+	filestream.close ();
+
+	parser.parse (filename.c_str () );
+
+	node = parser.getDocument () ->getDocumentElement ();
+	node = _getNode (node, ParamNameMap.at (PTP_COMPUTATION), true);
+
+	return _getLong (node, ParamNameMap.at (PTP_SYNCSHARDS) );
+}
+
+OGSS_Bool
+XMLParser::getOnlineSynchronization (
+	const OGSS_String		& filename) {
+	ifstream				filestream (filename.c_str () );
+	XercesDOMParser			parser;
+	DOMNode					* node;
+	OGSS_String				value;
+
+	if (! filestream.good () ) {
+		LOG (FATAL) << "The configuration file '" << filename
+			<< "' does not exist!";
+		return false;
+	}
+
+	filestream.close ();
+
+	parser.parse (filename.c_str () );
+
+	node = parser.getDocument () ->getDocumentElement ();
+	node = _getNode (node, ParamNameMap.at (PTP_COMPUTATION), true);
+	value = _getString (node, ParamNameMap.at (PTP_ONLINE) );
+
+	return ! value.compare ("on") || ! value.compare ("yes")
+		|| ! value.compare ("true");
+}
+
+OGSS_Bool
+XMLParser::getRequestRetirement (
+	const OGSS_String		& filename) {
+	ifstream				filestream (filename.c_str () );
+	XercesDOMParser			parser;
+	DOMNode					* node;
+	OGSS_String				value;
+
+	if (! filestream.good () ) {
+		LOG (FATAL) << "The configuration file '" << filename
+			<< "' does not exist!";
+		return false;
+	}
+
+	filestream.close ();
+
+	parser.parse (filename.c_str () );
+
+	node = parser.getDocument () ->getDocumentElement ();
+	node = _getNode (node, ParamNameMap.at (PTP_COMPUTATION), true);
+	value = _getString (node, ParamNameMap.at (PTP_RETIRE) );
+
+	return ! value.compare ("on") || ! value.compare ("yes")
+		|| ! value.compare ("true");
+}
+
 OGSS_Ulong
 XMLParser::getCommunicationPort (
 	const OGSS_String		& filename) {
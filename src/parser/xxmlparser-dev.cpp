@@ -90,6 +90,15 @@ getNVRAMGeometry (
 	device._param.n._cols = _getLong (node, ParamNameMap.at (PTP_COLS) );
 	device._param.n._rows = _getLong (node, ParamNameMap.at (PTP_ROWS) );
 
+	// Without banks, the chips have a single bank
+	device._param.n._nbBanks = _getNode (node, ParamNameMap.at (PTP_NBBANKS) )
+		? _getLong (node, ParamNameMap.at (PTP_NBBANKS) ) : 1;
+	if (! device._param.n._nbBanks) {
+		LOG (WARNING) << "The NVRAM '" << ParamNameMap.at (PTP_NBBANKS)
+			<< "' parameter is null, a single bank is used";
+		device._param.n._nbBanks = 1;
+	}
+
 	return device._param.n._nbChips 
 		* device._param.n._bytesPerCol
 		* device._param.n._cols
@@ -145,6 +154,8 @@ getNVRAMPerformance (
 
 	device._param.n._read = _getRealMeasure (node, PTP_READ);
 	device._param.n._write = _getRealMeasure (node, PTP_WRITE);
+	device._param.n._activation = _getNode (node, ParamNameMap.at (PTP_ACTIVATION) )
+		? _getRealMeasure (node, PTP_ACTIVATION) : .0;
 }
 
 void
@@ -169,6 +180,43 @@ getSSDReliability (
 	device._param.s._numErase = _getLong (node, ParamNameMap.at (PTP_NBERASE) );
 }
 
+void
+getCommandQueue (
+	DOMNode					* node,
+	Device					& device) {
+	OGSS_String				schType;
+
+	schType = _getString (node, ParamNameMap.at (PTP_SCHEDULING), true);
+	device._queueDepth = max <OGSS_Ulong> (1,
+		_getLong (node, ParamNameMap.at (PTP_QUEUEDEPTH), true) );
+
+	auto findRes = find_if (SchedulingNameMap.begin (), SchedulingNameMap.end (),
+		[&] (const pair <OGSS_SchedulingType, OGSS_String> & elt)
+		{ return ! elt.second.compare (schType); } );
+	if (findRes != SchedulingNameMap.end () )
+		device._scheduling = findRes->first;
+	else
+		device._scheduling = SCH_FIFO;
+}
+
+void
+getDeviceBuffer (
+	DOMNode					* node,
+	Device					& device) {
+	OGSS_String				wcType;
+
+	wcType = _getString (node, ParamNameMap.at (PTP_WRITECACHE), true);
+	device._numSegments = _getLong (node, ParamNameMap.at (PTP_SEGMENTS), true);
+
+	auto findRes = find_if (CachePolicyNameMap.begin (), CachePolicyNameMap.end (),
+		[&] (const pair <OGSS_CachePolicy, OGSS_String> & elt)
+		{ return ! elt.second.compare (wcType); } );
+	if (findRes != CachePolicyNameMap.end () )
+		device._writeCache = findRes->first;
+	else
+		device._writeCache = CCP_WRITETHROUGH;
+}
+
 void
 getHDDController (
 	DOMNode					* root,
@@ -178,6 +226,8 @@ getHDDController (
 	OGSS_String				dfrgType;
 
 	node = _getNode (root, ParamNameMap.at (PTP_CONTROLLER) );
+	getCommandQueue (node, device);
+	getDeviceBuffer (node, device);
 
 	trnsType = _getString (node, ParamNameMap.at (PTP_TRANSLATION), true);
 	dfrgType = _getString (node, ParamNameMap.at (PTP_DEFRAGMENTATION), true);
@@ -213,11 +263,17 @@ getSSDController (
 	OGSS_String				gcType;
 
 	node = _getNode (root, ParamNameMap.at (PTP_CONTROLLER) );
+	getCommandQueue (node, device);
+	getDeviceBuffer (node, device);
 
 	trnsType = _getString (node, ParamNameMap.at (PTP_TRANSLATION), true);
 	wlType = _getString (node, ParamNameMap.at (PTP_WEARLEVELLING), true);
 	gcType = _getString (node, ParamNameMap.at (PTP_GARBAGECOLLECTION), true);
 
+	// Without value, 7% of the blocks are spare (a 2^30 vs 10^9 ratio)
+	device._param.s._overProvisioning = _getNode (node, ParamNameMap.at (PTP_OVERPROV) )
+		? _getReal (node, ParamNameMap.at (PTP_OVERPROV) ) : .07;
+
 	auto findRes1 = find_if (TranslationNameMap.begin (), TranslationNameMap.end (),
 		[&] (const pair <OGSS_TranslationType, OGSS_String> & elt)
 		{ return ! elt.second.compare (trnsType); } );
@@ -296,6 +352,12 @@ getDevice (
 			getSSDPerformance (root, device);
 			getSSDReliability (root, device);
 			getSSDController (root, device);
+
+			// The spare blocks of the page-mapped translation are not exported
+			if (device._param.s._algTrns == TRS_SSDPAGEMAP)
+				device._physicalCapacity -= device._param.s.numSpareBlocks ()
+					* device._param.s._pagesPerBlock
+					* static_cast <OGSS_Ulong> (device._param.s._pageSize);
 		break;
 		case DTP_NVRAM:
 			device._physicalCapacity = getNVRAMGeometry(root, device);
@@ -29,7 +29,7 @@
 
 #include "scheme/sd2sscheme.hpp"
 
-#include <set>
+#include <algorithm>
 
 #include "util/math.hpp"
 
@@ -66,11 +66,21 @@ SD2SScheme::SD2SScheme (
 
 	for (auto i = 0; i < _numSpareDevices; ++i)
 		_belongs.push_back (OGSS_ULONG_MAX);
+
+	LOG_IF (FATAL, _numDevices > OGSS_MAXVOLUMEDEVICES) << "A declustered RAID can not "
+		<< "have more than " << OGSS_MAXVOLUMEDEVICES << " devices";
+
+	_redirection.resize (_numDevices);
+	_eventTimes.resize (_numDevices, make_pair (.0, .0) );
+	_deviceState.resize (_numDevices);
 }
 SD2SScheme::~SD2SScheme () {  }
 
 void
-SD2SScheme::build () { findFirstGoodLambda (); }
+SD2SScheme::build () {
+	findFirstGoodLambda ();
+	buildLayoutTables ();
+}
 
 /*void
 SD2SScheme::realloc (
@@ -128,14 +138,14 @@ SD2SScheme::realloc (
 		if (request._operation == ROP_COPY)
 			request._idxDevice = _redirection [request._idxDevice][stripe];
 		else if (request._operation == ROP_NATIVE || request._operation == ROP_RECOVERY) {
-			while (_deviceState [request._idxDevice] .isFailed (request._date) )
+			while (isFailed (request._idxDevice, request._date) )
 				request._idxDevice = _redirection [request._idxDevice][stripe];
 		}
 	} else if (request._type == RQT_WRITE) {
 		if (request._operation == ROP_UPDATE)
 			request._idxDevice = _redirection [request._idxDevice][stripe];
 		else if (request._operation == ROP_NATIVE) {
-			while (_deviceState [request._idxDevice] .isFailed (request._date) )
+			while (isFailed (request._idxDevice, request._date) )
 				request._idxDevice = _redirection [request._idxDevice][stripe];
 		}
 	}
@@ -144,128 +154,102 @@ SD2SScheme::realloc (
 void
 SD2SScheme::updateFailureScheme (
 	const Request			& event) {
-	OGSS_Ushort				logicalDevice;
+	OGSS_Ushort				device = event._idxDevice;
+	OGSS_Ushort				logical;
 	OGSS_Ushort				idxVector;
 	OGSS_Ushort				firstIdx;
-	OGSS_Ushort				firstIdxVec;
-	OGSS_Ushort				redLogicalDevice;
+	OGSS_Ushort				firstIdxVec {device};
+	OGSS_Bool				found {false};
 
-	DLOG (INFO) << "Number of redirection vectors: " << _redirection.size ();
+	DLOG (INFO) << "Number of redirection vectors: " << _redirectedDevices.size ();
 
-	_eventTimes [event._idxDevice] .first = event._date;
-	_eventTimes [event._idxDevice] .second = OGSS_REAL_MAX;
-	_deviceState [event._idxDevice] ._failureDate = event._date;
+	_eventDevices.set (device);
+	_eventTimes [device] .first = event._date;
+	_eventTimes [device] .second = OGSS_REAL_MAX;
+	_deviceState [device] ._failureDate = event._date;
 
-	if (_eventTimes.size () > _numSpareDevices) {
+	if (_eventDevices.count () > _numSpareDevices) {
 		DLOG (INFO) << "The Declustered RAID cannot be rebuilt!";
-		_redirection [event._idxDevice] = vector <OGSS_Ushort> (_numDataDevices, OGSS_USHORT_MAX);
+		if (_redirection [device] .empty () ) {
+			_redirectedDevices.insert (upper_bound (_redirectedDevices.begin (),
+				_redirectedDevices.end (), device), device);
+			_redirection [device] .resize (_numDataDevices, OGSS_USHORT_MAX);
+		} else
+			for (OGSS_Ulong i = 0; i < _numDataDevices; ++i)
+				setRedirection (device, i, OGSS_USHORT_MAX);
 		return;
 	}
 
-	for (auto i = 0; i < _numDataDevices; ++i) {
+	for (OGSS_Ulong i = 0; i < _numDataDevices; ++i) {
 		// First check if there is native data
-		logicalDevice
-			= (_numDevices * i + event._idxDevice - i * _lambda) % _numDevices;
-		idxVector = event._idxDevice;
-		if (logicalDevice >= _numDataDevices) { // A spare disk
+		logical = logicalDevice (i, device);
+		idxVector = device;
+		if (logical >= _numDataDevices) { // A spare disk
 			// Else check for rebuilt data
-			for (OGSS_Ushort j = 0; j < _numDevices; ++j) {
-				if (_redirection.find (j) != _redirection.end () ) {
-					if (_redirection [j][i] == event._idxDevice) {
-						logicalDevice
-							= (_numDevices * i + j - i * _lambda)
-							% _numDevices;
-						idxVector = j;
-						break;
-					}
-				}
-			}
+			idxVector = findRedirectedDevice (i, device);
+			if (idxVector == _numDevices) continue;
+			logical = logicalDevice (i, idxVector);
 		}
 
-		if (logicalDevice >= _numDataDevices) continue;
+		if (logical >= _numDataDevices) continue;
 
-		if (_redirection.find (event._idxDevice) == _redirection.end () ) {
-			_redirection [event._idxDevice]	= vector <OGSS_Ushort> (
-				_numDataDevices, _numDevices);
+		if (_redirection [device] .empty () ) {
+			_redirectedDevices.insert (upper_bound (_redirectedDevices.begin (),
+				_redirectedDevices.end (), device), device);
+			_redirection [device] .resize (_numDataDevices, _numDevices);
 		}
-		
+
 		firstIdx = _numDevices;
 		for (OGSS_Ushort j = 0; j < _numDevices; ++j) {
-			// If spare area
-			if ( (_numDevices * i + j - i * _lambda) % _numDevices >= _numDataDevices) {
-				redLogicalDevice = 0;
-
-				// If device is faulty and not renewed
-				if (_eventTimes.find (j) != _eventTimes.end ()
-				 && _eventTimes [j] .first <= event._date
-				 && _eventTimes [j] .second > event._date) {
-					redLogicalDevice = _numDevices;
-					continue;
-				}
+			// If not a spare area
+			if (logicalDevice (i, j) < _numDataDevices) continue;
 
-				// If the spare area is not already used
-				for (auto elt: _redirection) {
-					if (elt.second [i] == j) {
-						redLogicalDevice = _numDevices;
-						break;
-					}
-				}
+			found = false;
 
-				// If one condition is not respected
-				if (redLogicalDevice == _numDevices)
-					continue;
+			// If device is faulty and not renewed, or if the spare area is
+			// already used
+			if (isFaulty (j, event._date) || _spareUse [i * _numDevices + j])
+				continue;
 
-				OGSS_Bool test = true;
+			// If the device already hosts the logical device, natively or
+			// through the redirection of a faulty device
+			OGSS_Bool		test {! _hosted [j] .test (logical)};
 
-				for (OGSS_Ushort k = 0;
-				  k < _numDataDevices; ++k) {
-					if ( (_numDevices * k + j - k * _lambda) % _numDevices
-						== logicalDevice)
-					{ test = false; break; }
-				}
+			for (auto k: _redirectedDevices) {
+				if (! test) break;
+				if (! isFaulty (k, event._date) ) continue;
 
-				for (OGSS_Ushort k = 0; k < _numDevices && test; ++k) {
-					if (_redirection.find (k) != _redirection.end ()
-					 && _eventTimes [k] .first <= event._date
-					 && _eventTimes [k] .second > event._date) {
-						for (OGSS_Ushort l = 0; l < _numDataDevices; ++l) {
-							if (_redirection [k][l] == j
-								&& (_numDevices * l + k - l * _lambda)
-								% _numDevices == logicalDevice) {
-								test = false; break;
-							}
-						}
+				for (OGSS_Ulong l = 0; l < _redirection [k] .size (); ++l) {
+					if (_redirection [k][l] == j && logicalDevice (l, k) == logical) {
+						test = false; break;
 					}
 				}
+			}
 
-				if (!test) {
-					if (firstIdx == _numDevices) {
-						firstIdx = j;
-						firstIdxVec = idxVector;
-					}
-
-					redLogicalDevice = _numDevices;
+			if (! test) {
+				if (firstIdx == _numDevices) {
+					firstIdx = j;
+					firstIdxVec = idxVector;
 				}
 
-				// If one condition is not respected
-				if (redLogicalDevice == _numDevices)
-					continue;
+				continue;
+			}
 
-				_redirection [idxVector][i] = j;
+			setRedirection (idxVector, i, j);
+			found = true;
 
-				break;
-			}
+			break;
 		}
 
-		if (redLogicalDevice == _numDevices)
-			_redirection [firstIdxVec][i] = firstIdx;
+		if (! found)
+			setRedirection (firstIdxVec, i, firstIdx);
 	}
 
-	DLOG (INFO) << "Number of redirection vectors: " << _redirection.size ();
-	DLOG (INFO) << "Redirection vector after event on " << event._idxDevice << ":";
+	DLOG (INFO) << "Number of redirection vectors: " << _redirectedDevices.size ();
+	DLOG (INFO) << "Redirection vector after event on " << device << ":";
 
-	for (auto i = 0; i < _redirection [event._idxDevice] .size (); ++i) {
-		DLOG (INFO) << "[" << i << "]" << " -> " << _redirection [event._idxDevice][i];
+	for (auto i = 0; i < _redirection [device] .size (); ++i) {
+		DLOG (INFO) << "[" << i << "]" << " -> " << _redirection [device][i];
 	}
 }
 
@@ -278,6 +262,7 @@ SD2SScheme::generateFailureRequests (
 void
 SD2SScheme::updateRenewalScheme (
 	const Request			& event) {
+	_eventDevices.set (event._idxDevice);
 	_eventTimes [event._idxDevice] .second = event._date;
 	_deviceState [event._idxDevice] ._renewalDate = event._date;
 }
@@ -287,7 +272,8 @@ SD2SScheme::generateRenewalRequests (
 	const Request			& block,
 	vector <Request>		& subrequests) {
 	
-	if (_redirection [block._idxDevice][(block._deviceAddress / _numBytesBySU) % _numDataDevices] == _numDevices)
+	if (_redirection [block._idxDevice] .empty ()
+	 || _redirection [block._idxDevice][(block._deviceAddress / _numBytesBySU) % _numDataDevices] == _numDevices)
 		return;
 
 	Request r {block}, s {block};
@@ -319,19 +305,12 @@ SD2SScheme::getLogicalBlock (
 
 	if (logicalDevice >= _numDataDevices) { // A spare space
 		// Else check for rebuilt data
-		auto				found {false};
-		for (OGSS_Ushort j = 0; j < _numDevices; ++j) {
-			if (_redirection.find (j) != _redirection.end () ) {
-				if (_redirection [j][idx] == block._idxDevice) {
-					logicalDevice
-						= (_numDevices * _numDataDevices + j - idx * _lambda) % _numDevices;
-					found = true;
-					break;
-				}
-			}
-		}
+		auto				j {findRedirectedDevice (idx, block._idxDevice)};
 
-		if (! found) logicalDevice = _numDataDevices;
+		if (j != _numDevices)
+			logicalDevice
+				= (_numDevices * _numDataDevices + j - idx * _lambda) % _numDevices;
+		else logicalDevice = _numDataDevices;
 	}
 
 	if (logicalDevice >= _numDataDevices) {
@@ -361,11 +340,19 @@ SD2SScheme::requestMultiplier (
 void
 SD2SScheme::findFirstGoodLambda () {
 	OGSS_Bool				found {false};
+	vector <OGSS_Short>		ranks (_half_up (_numDevices), -1);
+
+	// The four passes can look at the same offset several times, so the
+	// rank of an offset is only computed once
+	auto					rank = [&] (int i) -> OGSS_Ushort {
+		if (ranks [i] < 0) ranks [i] = computeMatrixRank (i);
+		return ranks [i];
+	};
 
 	for (int i = 1; i < _half_up (_numDevices); ++i) {
 		if (OGSS_Math::GCD (i, _numDevices) != 1)
 			continue;
-		if (computeMatrixRank (i) == 2) {
+		if (rank (i) == 2) {
 			_lambda = i;
 			found = true;
 			break;
@@ -376,7 +363,7 @@ SD2SScheme::findFirstGoodLambda () {
 		for (int i = 1; i < _half_up (_numDevices); ++i) {
 			if (OGSS_Math::GCD (i, _numDevices) == 1)
 				continue;
-			if (computeMatrixRank (i) == 2) {
+			if (rank (i) == 2) {
 				_lambda = i;
 				found = true;
 				break;
@@ -388,7 +375,7 @@ SD2SScheme::findFirstGoodLambda () {
 		for (int i = 1; i < _half_up (_numDevices); ++i) {
 			if (OGSS_Math::GCD (i, _numDevices) != 1)
 				continue;
-			if (computeMatrixRank (i) == 1) {
+			if (rank (i) == 1) {
 				_lambda = i;
 				found = true;
 				break;
@@ -400,7 +387,7 @@ SD2SScheme::findFirstGoodLambda () {
 		for (int i = 1; i < _half_up (_numDevices); ++i) {
 			if (OGSS_Math::GCD (i, _numDevices) == 1)
 				continue;
-			if (computeMatrixRank (i) == 1) {
+			if (rank (i) == 1) {
 				_lambda = i;
 				found = true;
 				break;
@@ -415,56 +402,43 @@ OGSS_Ushort
 SD2SScheme::computeMatrixRank (
 	OGSS_Ulong				lambda) {
 	OGSS_Ushort				physicalDisk;
-	OGSS_Ushort				logical_Volume;
+	OGSS_Ulong				numSubVolumes {0};
 	OGSS_Bool				optimizable;
-	vector <pair <OGSS_Ushort, OGSS_Ushort> >
-							degreeMatrix (_numDevices * _numDevices,
-								make_pair (0, 0) );
+	OGSS_Ulong				common;
+	OGSS_Ulong				degree;
+	OGSS_Ulong				difference;
 	vector <int>			deviceLoad (_numDevices, 0);
-	vector <set <OGSS_Ushort> >	originSets (_numDevices);
 
-	for (auto i = originSets.begin (); i != originSets.end (); ++i)
-		i->clear ();
+	for (auto i = 0; i < _numDataDevices; ++i)
+		numSubVolumes = max (numSubVolumes, _belongs [i] + 1);
+
+	// For each physical disk and subvolume, the rows where the disk hosts a
+	// device of the subvolume; two disks share as many stripes as the
+	// common bits of their masks
+	vector <OGSS_DeviceMask>	rows (_numDevices * numSubVolumes);
 
 	for (auto i = 0; i < _numDataDevices; ++i) {
 		for (auto j = 0; j < _numDataDevices; ++j) {
 			physicalDisk = (i + j * lambda) % _numDevices;
 			deviceLoad [physicalDisk] ++;
-
-			if (i < _numDataDevices) {
-				originSets [physicalDisk] .insert (
-					j + _belongs [i] * _numDataDevices);
-
-				logical_Volume = _belongs [i];
-
-				for (auto k = 0; k < _numDataDevices; ++k) {
-					if (physicalDisk != (k + j * lambda) %_numDevices
-						&& _belongs [k] == logical_Volume) {
-						degreeMatrix [physicalDisk * _numDevices
-							+ ( (k + j * lambda) % _numDevices) ] .first ++;
-					}
-				}
-			}
-		}
-	}
-
-	for (auto i = 0; i < _numDevices; ++i) {
-		for (auto j = i + 1; j < _numDevices; ++j) {
-			degreeMatrix [i * _numDevices + j] .first = min (deviceLoad [i],
-				deviceLoad [j])	- degreeMatrix [i * _numDevices + j] .first;
-			degreeMatrix [i * _numDevices + j] .second
-				= abs (deviceLoad [i] - deviceLoad [j]);
-			degreeMatrix [j * _numDevices + i]
-				= degreeMatrix [i * _numDevices + j];
+			rows [physicalDisk * numSubVolumes + _belongs [i]] .set (j);
 		}
 	}
 
 	optimizable = true;
 	for (auto i = 0; i < _numDevices; ++i) {
 		for (auto j = i + 1; j < _numDevices; ++j) {
-			if (degreeMatrix [i * _numDevices + j] .first == 0)
+			common = 0;
+			for (OGSS_Ulong k = 0; k < numSubVolumes; ++k)
+				common += (rows [i * numSubVolumes + k]
+					& rows [j * numSubVolumes + k]) .count ();
+
+			degree = min (deviceLoad [i], deviceLoad [j]) - common;
+			difference = abs (deviceLoad [i] - deviceLoad [j]);
+
+			if (degree == 0)
 			{
-				if (degreeMatrix [i * _numDevices + j] .second == 0)
+				if (difference == 0)
 				{
 					DLOG(INFO) << "Rank for computed lambda (" << lambda << ") is 0";
 					return 0;
@@ -483,3 +457,42 @@ SD2SScheme::computeMatrixRank (
 	DLOG(INFO) << "Rank for computed lambda (" << lambda << ") is 2";
 	return 2;
 }
+
+void
+SD2SScheme::buildLayoutTables () {
+	_hosted.assign (_numDevices, OGSS_DeviceMask () );
+	_spareUse.assign (_numDataDevices * _numDevices, 0);
+
+	for (OGSS_Ulong i = 0; i < _numDataDevices; ++i) {
+		for (OGSS_Ulong j = 0; j < _numDevices; ++j) {
+			auto			logical {logicalDevice (i, j)};
+			if (logical < _numDataDevices) _hosted [j] .set (logical);
+		}
+	}
+}
+
+void
+SD2SScheme::setRedirection (
+	const OGSS_Ushort		device,
+	const OGSS_Ulong		row,
+	const OGSS_Ushort		target) {
+	auto					& entry {_redirection [device][row]};
+
+	if (entry < _numDevices) -- _spareUse [row * _numDevices + entry];
+	if (target < _numDevices) ++ _spareUse [row * _numDevices + target];
+
+	entry = target;
+}
+
+OGSS_Ushort
+SD2SScheme::findRedirectedDevice (
+	const OGSS_Ulong		row,
+	const OGSS_Ushort		target) {
+	if (target >= _numDevices || ! _spareUse [row * _numDevices + target])
+		return _numDevices;
+
+	for (auto elt: _redirectedDevices)
+		if (_redirection [elt][row] == target) return elt;
+
+	return _numDevices;
+}
@@ -27,6 +27,9 @@
 /* HEADERS -------------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+#include <algorithm>
+#include <cmath>
+
 #include "structure/hardware.hpp"
 
 #if USE_STATIC_GLOG
@@ -35,6 +38,10 @@
 #include <glog/logging.h>
 #endif
 
+using namespace std;
+
+constexpr OGSS_Ulong		SSDParameters::_kMinSpareBlocks;
+
 /*----------------------------------------------------------------------------*/
 /* FUNCTIONS -----------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
@@ -54,6 +61,7 @@ Volume::applyDataUnit (
 			<< "requested memory data unit ("
 			<< _suSize << " >=? " << du._memory << ")";
 	_suSize /= du._memory;
+	_coalescingWindow /= du._time;
 }
 
 void
@@ -83,12 +91,21 @@ SSDParameters::applyDataUnit (
 	_erase /= du._time;
 }
 
+OGSS_Ulong
+SSDParameters::numSpareBlocks () const {
+	OGSS_Ulong				numBlocks {_blocksPerDie * _numDies};
+
+	return min (numBlocks, max (_kMinSpareBlocks,
+		static_cast <OGSS_Ulong> (ceil (numBlocks * _overProvisioning) ) ) );
+}
+
 void
 NVRAMParameters::applyDataUnit (
 	const OGSS_DataUnit		du) {
 	_bytesPerCol /= du._memory;
 	_read /= du._time;
 	_write /= du._time;
+	_activation /= du._time;
 }
 
 void
@@ -114,3 +131,32 @@ Interface::applyDataUnit (
 	_bandwidth /= du._memory;
 	_bandwidth /= du._time;
 }
+
+vector <OGSS_DevicePath>
+createDevicePaths (
+	const HardwareParameters	& params,
+	const vector <Tier>		& tiers,
+	const vector <Volume>	& vols,
+	const vector <Device>	& devs,
+	const vector <Interface>	& intfs) {
+	vector <OGSS_DevicePath>	paths (devs.size () );
+	auto					cost = [&] (const OGSS_Ulong idx) -> OGSS_Real
+		{ return idx < intfs.size () ? 1. / intfs [idx] ._bandwidth : .0; };
+
+	for (OGSS_Ulong i = 0; i < devs.size (); ++i) {
+		auto				& p = paths [i];
+
+		p._volume = devs [i] ._parent;
+		p._tier = vols [p._volume] ._parent;
+
+		p._hostInterface = params._hostInterface;
+		p._tierInterface = tiers [p._tier] ._interface;
+		p._volumeInterface = vols [p._volume] ._interface;
+
+		p._hostCost = cost (p._hostInterface);
+		p._tierCost = cost (p._tierInterface);
+		p._volumeCost = cost (p._volumeInterface);
+	}
+
+	return paths;
+}
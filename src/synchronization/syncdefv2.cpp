@@ -26,14 +26,20 @@
 /* HEADERS -------------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <numeric>
+#include <set>
 #include <cmath>
 
 #include "synchronization/syncdefv2.hpp"
 
+#include "parser/xmlparser.hpp"
+
 #if USE_STATIC_GLOG
 #include "glog/logging.h"
 #else
@@ -42,6 +48,10 @@
 
 using namespace std;
 
+constexpr OGSS_Ulong SyncDefV2::_kUnd;
+constexpr OGSS_Ulong SyncDefV2::_kGone;
+constexpr OGSS_Ulong SyncDefV2::_kDrop;
+
 /*----------------------------------------------------------------------------*/
 /* LOCAL FUNCTIONS -----------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
@@ -61,133 +71,162 @@ SyncDefV2::SyncDefV2 (
 	vector <Volume>			& vols,
 	vector <Device>			& devs,
 	vector <Interface>		& intfs,
-	OGSS_DataUnit			globalDU):
+	OGSS_DataUnit			globalDU,
+	const OGSS_Bool			heapOrder):
 	SynchronizationModel (ci),
 	_hardParam (params), _tiers (tiers), _volumes (vols),
-	_devices (devs), _interfaces (intfs), _globalDU (globalDU) {
+	_devices (devs), _interfaces (intfs), _heapOrder (heapOrder),
+	_globalDU (globalDU) {
 		_mainRequestsDone = 0;
 		_nbRequests = 0;
+		_paths = createDevicePaths (_hardParam, _tiers, _volumes, _devices, _interfaces);
+		_busClocks.assign (_hardParam._numInterfaces, .0);
+		_devClocks.assign (_hardParam._numDevices, .0);
+		_dispatch.resize (_hardParam._numDevices);
+		_laidDate = _horizon = - numeric_limits <double> ::max ();
 	}
 SyncDefV2::~SyncDefV2 () {  }
 
 void
 SyncDefV2::addEntry (
 	Request  				&req) {
-	index_t					idx
-		= make_tuple (req._mainIdx, req._majrIdx, req._minrIdx);
-	_data [idx][ARRIVL] = req._date;
-	_failedReqs [idx] = req._failed;
+	OGSS_Ulong				row {_index.size () };
+
+	// The system requests are not attached to a logical request
+	if (req._mainIdx != OGSS_ULONG_MAX) {
+		// The rows of a laid out logical request can not get a new child
+		LOG_IF(FATAL, req._mainIdx < _nextMain)
+			<< "Request [" << req._mainIdx << "/" << req._majrIdx << "/"
+			<< req._minrIdx << "] was received after its logical request was "
+			<< "laid out";
+
+		// A late logical request is kept and waits as the other ones, but
+		// the steps up to the horizon are already processed
+		LOG_IF(WARNING, ! req._majrIdx && req._date < _horizon)
+			<< "Logical request " << req._mainIdx << " was received after "
+			<< "the date " << _horizon << " was synchronized, its waiting "
+			<< "times can differ from the batch mode";
+
+		if (req._mainIdx - _nextMain >= _pending.size () )
+			_pending.resize (req._mainIdx - _nextMain + 1,
+				{numeric_limits <double> ::max (), 0, 0} );
+
+		auto				& pending = _pending [req._mainIdx - _nextMain];
+
+		// The children can arrive before their parent, so each level has
+		// its own count
+		if (! req._majrIdx) {
+			pending._date = req._date;
+			pending._majrs += req._numChild;
+		} else if (! req._minrIdx) {
+			-- pending._majrs;
+			pending._minrs += req._numChild;
+		} else
+			-- pending._minrs;
+	}
+
+	_index.push_back (make_tuple (req._mainIdx, req._majrIdx, req._minrIdx) );
+	for (auto & e: _data) e.push_back (.0);
+	for (auto & e: _rslt) e.push_back (- numeric_limits <double> ::max () );
+	for (auto & e: _cntr) e.push_back (0);
+	_failedReqs.push_back (req._failed);
+	_cachedReqs.push_back (req._cached);
+	_dispatchIdx.push_back (req._dispatchIdx);
+	_heapPos.push_back (-1);
+
+	_data [ARRIVL][row] = req._date;
 
 	if (req._minrIdx != 0) {
-		_data [idx][TO_TIR] = req._transferTimeA1;
-		_data [idx][TO_VOL] = req._transferTimeA2;
-		_data [idx][TO_DEV] = req._transferTimeA3;
-		_data [idx][SERVCE] = req._serviceTime;
-		_data [idx][FM_DEV] = req._transferTimeB3;
-		_data [idx][FM_VOL] = req._transferTimeB2;
-		_data [idx][FM_TIR] = req._transferTimeB1;
+		_data [TO_TIR][row] = req._transferTimeA1;
+		_data [TO_VOL][row] = req._transferTimeA2;
+		_data [TO_DEV][row] = req._transferTimeA3;
+		_data [SERVCE][row] = req._serviceTime;
+		_data [FM_DEV][row] = req._transferTimeB3;
+		_data [FM_VOL][row] = req._transferTimeB2;
+		_data [FM_TIR][row] = req._transferTimeB1;
 	}
 
 	if (req._type & RQT_WRITE)
-		_cntr [idx][RQTYPE] = 1;
+		_cntr [RQTYPE][row] = 1;
 	else
-		_cntr [idx][RQTYPE] = 0;
+		_cntr [RQTYPE][row] = 0;
 
-	_cntr [idx][RQSIZE] = req._size;
+	_cntr [RQSIZE][row] = req._size;
 
 	if (req._majrIdx == 0){
 		_nbRequests ++;
-		_cntr [idx][IDSTEP] = ARRIVL;
+		_cntr [IDSTEP][row] = ARRIVL;
+		_rslt [ARRIVL][row] = req._date;
 	}
 	else {
-		_cntr [idx][IDSTEP] = UND;
-		_data [idx][ARRIVL] = numeric_limits <double> ::max ();
+		_cntr [IDSTEP][row] = UND;
+		_data [ARRIVL][row] = numeric_limits <double> ::max ();
 	}
-	_cntr [idx][NBCHLD] = req._numChild;
-	_cntr [idx][NBPRIO] = req._numPrioChild;
+	_cntr [NBCHLD][row] = req._numChild;
+	_cntr [NBPRIO][row] = req._numPrioChild;
 
+	// The I/O path is given to the parents once they all arrived
 	if (req._minrIdx != 0 || req._numChild == 0) {
-		_cntr [idx][IDDEVC] = req._idxDevice;
-		_cntr [idx][IDVOLM] = _devices [_cntr [idx][IDDEVC]] ._parent;
-		_cntr [idx][IDTIER] = _volumes [_cntr [idx][IDVOLM]] ._parent;
-
-		_cntr [idx][IDBUSD] = _volumes [_cntr [idx][IDVOLM]] ._interface;
-		_cntr [idx][IDBUSV] = _tiers   [_cntr [idx][IDTIER]] ._interface;
-		_cntr [idx][IDBUST] = _hardParam._hostInterface;
-
-		_cntr [make_tuple (req._mainIdx, req._majrIdx, 0)][IDBUST] = _cntr [idx][IDBUST];
-		_cntr [make_tuple (req._mainIdx, req._majrIdx, 0)][IDBUSV] = _cntr [idx][IDBUSV];
-		_cntr [make_tuple (req._mainIdx, req._majrIdx, 0)][IDBUSD] = _cntr [idx][IDBUSD];
+		const OGSS_DevicePath	& path = _paths [req._idxDevice];
 
-		_cntr [make_tuple (req._mainIdx, 0, 0)][IDBUST] = _cntr [idx][IDBUST];
-		_cntr [make_tuple (req._mainIdx, 0, 0)][IDBUSV] = _cntr [idx][IDBUSV];
-		_cntr [make_tuple (req._mainIdx, 0, 0)][IDBUSD] = _cntr [idx][IDBUSD];
+		_cntr [IDDEVC][row] = req._idxDevice;
+		_cntr [IDVOLM][row] = path._volume;
+		_cntr [IDTIER][row] = path._tier;
 
-		_data [make_tuple (req._mainIdx, req._majrIdx, 0)][TO_VOL] = _data [idx][TO_VOL];
-		_data [make_tuple (req._mainIdx, req._majrIdx, 0)][FM_VOL] = _data [idx][FM_VOL];
+		_cntr [IDBUSD][row] = path._volumeInterface;
+		_cntr [IDBUSV][row] = path._tierInterface;
+		_cntr [IDBUST][row] = path._hostInterface;
 
-		_data [make_tuple (req._mainIdx, 0, 0)][TO_TIR] = _data [idx][TO_TIR];
-		_data [make_tuple (req._mainIdx, 0, 0)][FM_TIR] = _data [idx][FM_TIR];
+		_leaves.push_back (row);
 	}
-
-	_rslt [idx][ARRIVL] = 0;
-
-	_idpt [idx][IDNEXT]
-		= make_tuple (OGSS_ULONG_MAX, OGSS_ULONG_MAX, OGSS_ULONG_MAX);
-	_idpt [idx][IDPREV] = _idpt [idx][IDNEXT];
-
-	for (auto &e: _rslt [idx])
-		e = - numeric_limits <double> ::max ();
-
-	if (req._majrIdx == 0)
-		_rslt [idx][ARRIVL] = _data [idx][ARRIVL];
 }
 
 RequestStat
 SyncDefV2::prepareStat (
-	const index_t			idx) {
+	const OGSS_Ulong		row) {
 	RequestStat				stat;
+	const index_t			& idx = _index [row];
 
 	stat._mainIdx = get<0> (idx);
 	stat._majrIdx = get<1> (idx);
 	stat._minrIdx = get<2> (idx);
 
-	if (_cntr [idx][RQTYPE])
+	if (_cntr [RQTYPE][row])
 		stat._type = RQT_WRITE;
 	else
 		stat._type = RQT_READ;
 
-	stat._size = _cntr [idx][RQSIZE];
+	stat._size = _cntr [RQSIZE][row];
 
 	stat._serviceTime = .0;
 
-	stat._idxTier = _cntr [idx][IDTIER];
-	stat._idxVolume = _cntr [idx][IDVOLM];
-	stat._idxDevice = _cntr [idx][IDDEVC];
+	stat._idxTier = _cntr [IDTIER][row];
+	stat._idxVolume = _cntr [IDVOLM][row];
+	stat._idxDevice = _cntr [IDDEVC][row];
 
-	stat._arrivalDate = _data [idx][ARRIVL];
+	stat._arrivalDate = _data [ARRIVL][row];
 
-	stat._failed = _failedReqs [idx];
+	stat._failed = _failedReqs [row];
 
 	if (! get<1> (idx) ) {
-		stat._idxBus = _cntr [idx][IDBUST];
-		stat._transferTime = _data [idx][FM_TIR] + _data [idx][TO_TIR];
-		stat._waitingTime = _rslt [idx][FM_TIR] - _rslt [idx][ARRIVL]
+		stat._idxBus = _cntr [IDBUST][row];
+		stat._transferTime = _data [FM_TIR][row] + _data [TO_TIR][row];
+		stat._waitingTime = _rslt [FM_TIR][row] - _rslt [ARRIVL][row]
 			- stat._transferTime;
 		stat._serviceTime = 0;
 	}
 	else if (! get<2> (idx) ) {
-		stat._idxBus = _cntr [idx][IDBUSV];
-		stat._transferTime = _data [idx][FM_VOL] + _data [idx][TO_VOL];
-		stat._waitingTime = _rslt [idx][FM_VOL] - _rslt [idx][TO_TIR]
+		stat._idxBus = _cntr [IDBUSV][row];
+		stat._transferTime = _data [FM_VOL][row] + _data [TO_VOL][row];
+		stat._waitingTime = _rslt [FM_VOL][row] - _rslt [TO_TIR][row]
 			- stat._transferTime;
 		stat._serviceTime = 0;
 	}
 	else {
-		stat._idxBus = _cntr [idx][IDBUSD];
-		stat._serviceTime = _data [idx][SERVCE];
-		stat._transferTime = _data [idx][FM_DEV] + _data [idx][TO_DEV];
-		stat._waitingTime = _rslt [idx][FM_DEV] - _rslt [idx][TO_VOL]
+		stat._idxBus = _cntr [IDBUSD][row];
+		stat._serviceTime = _data [SERVCE][row];
+		stat._transferTime = _data [FM_DEV][row] + _data [TO_DEV][row];
+		stat._waitingTime = _rslt [FM_DEV][row] - _rslt [TO_VOL][row]
 			- stat._serviceTime - stat._transferTime;
 	}
 	
@@ -196,272 +235,641 @@ SyncDefV2::prepareStat (
 
 void
 SyncDefV2::process () {
-	vector <double>			busClocks (_hardParam._numInterfaces, .0);
-	vector <double>			devClocks (_hardParam._numDevices, .0);
-	OGSS_Ulong				nbComputations = _data.size () * (TABTOT - 1);
-	OGSS_Ulong				savedNumber;
-	index_t					starter = _data.begin () ->first;
-	double					minSearch;
-	index_t					minCursor;
-	OGSS_Ulong				lastMainIdx = get<0> (_data.rbegin () ->first);
-	index_t					idxUnd = make_tuple (OGSS_ULONG_MAX, OGSS_ULONG_MAX,
-		OGSS_ULONG_MAX);
-	index_t					restart = idxUnd;
-	index_t					checkpoint = idxUnd;
-
-	DLOG(INFO) << "[SC] Nb computations requested: " << nbComputations;
-
-	_resume = Resume(_nbRequests, _globalDU, _tiers.size(), _volumes.size(), _devices.size());
-
-	while (nbComputations) {
-		minSearch = numeric_limits <double> ::max ();
-		minCursor = idxUnd;
-
-		table_t::iterator e;
-
-		if (restart != idxUnd) {
-			e = _rslt.find (restart);
-			if (checkpoint != idxUnd)
-				minSearch = _rslt [checkpoint][_cntr [checkpoint][IDSTEP]];
-				minCursor = checkpoint;
-		}
-		else
-			e = _rslt.find (starter);
+	_layout (OGSS_ULONG_MAX);
 
-		while (e != _rslt.end () ) {
-			if (e->second [ARRIVL] > minSearch) break;
+	DLOG(INFO) << "[SC] Nb computations requested: " << _nbComputations;
 
-			if (_cntr [e->first][IDSTEP] == FM_TIR
-				|| _cntr [e->first][IDSTEP] == UND) {
-				++e;
-				continue;
-			}
+	_run (numeric_limits <double> ::max () );
 
-			if (e->second [_cntr [e->first][IDSTEP]] < minSearch) {
-				if (_idpt [e->first][IDNEXT] != idxUnd) {
-					e = _rslt.find (_idpt [e->first][IDNEXT]);
-					continue;
-				}
+	LOG_IF(FATAL, _nbComputations)
+		<< "Issue with the SyncDefV2 model (too much computations requested"
+		<< ": " << _nbComputations << ")";
+}
 
-				if (minCursor != idxUnd) {
-					_idpt [minCursor][IDNEXT] = e->first;
-					_idpt [e->first][IDPREV] = minCursor;
-				}
+void
+SyncDefV2::advance () {
+	OGSS_Ulong				nextMain {_nextMain};
+
+	while (! _pending.empty () && _pending.front () ._date
+		!= numeric_limits <double> ::max ()
+		&& ! _pending.front () ._majrs && ! _pending.front () ._minrs) {
+		_laidDate = max (_laidDate, _pending.front () ._date);
+		_pending.pop_front ();
+		++ _nextMain;
+	}
 
-				minSearch = e->second [_cntr [e->first][IDSTEP]];
-				minCursor = e->first;
-			}
+	if (_nextMain != nextMain)
+		_layout (_nextMain - 1);
+
+	// The logical requests are laid out in index order, which is their date
+	// order, so the next ones do not arrive before the last laid out one. The
+	// horizon never goes back, even if a late logical request came
+	_horizon = max (_horizon, _laidDate);
+
+	_run (_horizon);
+}
+
+void
+SyncDefV2::enableRetirement (
+	const OGSS_String		outputFile) {
+	_retire = true;
+
+	if (! outputFile.compare ("") ) return;
+
+	// The data section follows the results one, so it waits in a temporary
+	// file until the end
+	_outputDataFile = outputFile + ".data";
+	_output.open (outputFile);
+	_outputData.open (_outputDataFile);
+
+	_printHeader (_output);
+}
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+void
+SyncDefV2::_layout (
+	const OGSS_Ulong		lastMainIdx) {
+	OGSS_Ulong				first {_laid};
+	OGSS_Ulong				numRows {_index.size () - first};
+	vector <OGSS_Ulong>		order (numRows);
+	vector <OGSS_Ulong>		rank (numRows);
+
+	if (! first && ! _numRetired)
+		_resume = Resume(_nbRequests, _globalDU, _tiers.size(), _volumes.size(), _devices.size());
+
+	iota (order.begin (), order.end (), first);
+	sort (order.begin (), order.end (),
+		[&] (OGSS_Ulong a, OGSS_Ulong b) { return _index [a] < _index [b]; } );
+
+	for (OGSS_Ulong i = 0; i < numRows; ++i)
+		rank [order [i] - first] = first + i;
+
+	// Each column is moved in turn, to only hold one more column at a time
+	auto permute = [&] (auto & column) {
+		typename remove_reference <decltype (column)> ::type tmp (numRows);
+		for (OGSS_Ulong i = 0; i < numRows; ++i)
+			tmp [i] = column [order [i] ];
+		copy (tmp.begin (), tmp.end (), column.begin () + first);
+	};
+
+	permute (_index);
+	for (auto & e: _data) permute (e);
+	for (auto & e: _rslt) permute (e);
+	for (auto & e: _cntr) permute (e);
+	permute (_failedReqs);
+	permute (_cachedReqs);
+	permute (_dispatchIdx);
+
+	// The rows of the next logical requests stay after the laid out ones
+	OGSS_Ulong				last {static_cast <OGSS_Ulong> (upper_bound (
+		_index.begin () + first, _index.end (), lastMainIdx,
+		[] (OGSS_Ulong a, const index_t & b) { return a < get<0> (b); } )
+		- _index.begin () ) };
+
+	_parent.resize (last);
+	_end.resize (last);
+	for (auto & e: _idpt) e.resize (last, _kUnd);
+	_prevDate.resize (last);
+
+	OGSS_Ulong				main {first}, majr {first};
+
+	for (OGSS_Ulong row = first; row < last; ++row) {
+		const index_t		& idx = _index [row];
+
+		LOG_IF(FATAL, row > first && idx == _index [row - 1])
+			<< "Request " << IDPRINT(idx) << " was received twice";
+
+		if (get<1> (idx) == 0) main = majr = _parent [row] = row;
+		else if (get<2> (idx) == 0) { _parent [row] = main; majr = row; }
+		else _parent [row] = majr;
+
+		LOG_IF(FATAL, get<0> (_index [_parent [row] ]) != get<0> (idx)
+			|| (get<2> (idx) && get<1> (_index [_parent [row] ]) != get<1> (idx) ) )
+			<< "Request " << IDPRINT(idx) << " was received without its parent";
+
+		_end [row] = row + 1;
+	}
+
+	for (OGSS_Ulong row = last; row -- > first; )
+		_end [_parent [row] ] = max (_end [_parent [row] ], _end [row]);
+
+	vector <OGSS_Ulong>		waiting;
+
+	for (auto leaf: _leaves) {
+		OGSS_Ulong			row {rank [leaf - first]};
+
+		if (row >= last) { waiting.push_back (row); continue; }
+
+		OGSS_Ulong			majr {get<2> (_index [row]) ? _parent [row] : row};
+		OGSS_Ulong			main {_parent [majr]};
+
+		_cntr [IDBUSD][majr] = _cntr [IDBUSD][main] = _cntr [IDBUSD][row];
+		_cntr [IDBUSV][majr] = _cntr [IDBUSV][main] = _cntr [IDBUSV][row];
+		_cntr [IDBUST][majr] = _cntr [IDBUST][main] = _cntr [IDBUST][row];
+
+		_data [TO_VOL][majr] = _data [TO_VOL][row];
+		_data [FM_VOL][majr] = _data [FM_VOL][row];
+
+		_data [TO_TIR][main] = _data [TO_TIR][row];
+		_data [FM_TIR][main] = _data [FM_TIR][row];
+
+		if (_failedReqs [row] && main != row) _failedReqs [main] = true;
+	}
+
+	_leaves.swap (waiting);
+
+	// The logical requests are the first active ones. The requests which
+	// wait for the prior ones of their parent are not awaited on their device
+	for (OGSS_Ulong row = first; row < last; ++row) {
+		if (get<2> (_index [row]) )
+			_dispatch.add (_cntr [IDDEVC][row], _dispatchIdx [row], row,
+				_cntr [NBPRIO][row] || ! _cntr [NBPRIO][_parent [row] ]);
+		_schedule (row);
+	}
+
+	_nbComputations += (last - first) * (TABTOT - 1);
+	_laid = last;
+
+	// A request parked behind one which was not received can be next now,
+	// and the scan starts over to reach it
+	for (OGSS_Ulong device = 0; device < _devClocks.size (); ++device) {
+		OGSS_Ulong			row {_dispatch.release (device)};
+
+		if (row == OGSS_ULONG_MAX) continue;
+
+		_release (row, _nbComputations, _devClocks);
+		_restart = _kUnd;
+	}
+}
+
+void
+SyncDefV2::_run (
+	const double			horizon) {
+	OGSS_Ulong				row;
 
+	while (_nbComputations && (row = _findNext (horizon) ) != _kUnd) {
+		_step (row, _nbComputations);
+		if (! _heapOrder) _updateShortcuts (row);
+
+		if (_retire && row == _retired) _retireRows ();
+	}
+}
+
+OGSS_Ulong
+SyncDefV2::_findNext (
+	const double			horizon) {
+	double					minSearch {numeric_limits <double> ::max () };
+	OGSS_Ulong				minCursor {_kUnd};
+	OGSS_Ulong				e {_starter};
+
+	if (_heapOrder)
+		return _steps.empty () || _steps.front () ._date > horizon
+			? _kUnd : _steps.front () ._row;
+
+	_links.clear ();
+
+	if (_restart != _kUnd) {
+		e = _restart;
+		if (_checkpoint == _kGone)
+			minSearch = _checkpointDate;
+		else if (_checkpoint != _kUnd)
+			minSearch = _rslt [_cntr [IDSTEP][_checkpoint] ][_checkpoint];
+		minCursor = _checkpoint;
+	}
+
+	// Only the logical requests have an arrival date in the results, and
+	// they are in date order
+	while (e < _laid) {
+		auto				step {_cntr [IDSTEP][e]};
+
+		if (_rslt [ARRIVL][e] > minSearch) break;
+
+		if (step == FM_TIR || step == UND) {
 			++e;
+			continue;
 		}
 
-		LOG_IF(FATAL, minSearch == OGSS_REAL_MAX)
-			<< "Issue with the SyncDefV2 model (too much computations requested"
-			<< ": " << nbComputations << ")";
+		if (_rslt [step][e] < minSearch) {
+			if (_idpt [IDNEXT][e] != _kUnd) {
+				e = _idpt [IDNEXT][e];
+				continue;
+			}
+
+			if (minCursor != _kUnd)
+				_links.push_back (make_pair (minCursor, e) );
+
+			minSearch = _rslt [step][e];
+			minCursor = e;
+		}
+
+		++e;
+	}
 
-		auto & tmp = _rslt [minCursor];
-		auto & idx = _cntr [minCursor];
+	// The requests which are not laid out yet arrive after the horizon, so
+	// they do not change a step before it
+	if (minCursor == _kUnd || minSearch > horizon) return _kUnd;
+
+	LOG_IF(FATAL, minCursor == _kGone)
+		<< "Issue with the SyncDefV2 model (a removed request is not done)";
+	LOG_IF(FATAL, _cntr [IDSTEP][minCursor] == FM_TIR
+		|| _cntr [IDSTEP][minCursor] == UND)
+		<< "Issue with the SyncDefV2 model (request " << IDPRINT(_index [minCursor])
+		<< " is not active)";
+
+	// A removed checkpoint only leaves its date to the next request
+	for (auto & elt: _links) {
+		if (elt.first == _kGone)
+			_prevDate [elt.second] = _checkpointDate;
+		else
+			_idpt [IDNEXT][elt.first] = elt.second;
+		_idpt [IDPREV][elt.second] = elt.first;
+	}
 
-		++ idx [IDSTEP];
+	return minCursor;
+}
 
-		tmp [idx [IDSTEP]]
-			= max (busClocks [idx [IDCLK (idx [IDSTEP])]],
-			tmp [idx [IDSTEP] - 1]) + _data [minCursor][idx [IDSTEP]];
+void
+SyncDefV2::_updateShortcuts (
+	const OGSS_Ulong		row) {
+	auto					elt2 {_idpt [IDPREV][row]};
+	auto					step {_cntr [IDSTEP][row]};
 
-		busClocks [idx [IDCLK (idx [IDSTEP])]] = tmp [idx [IDSTEP]];
+	if (elt2 == _kUnd) {
+		_restart = _kUnd;
+		return;
+	}
 
-		switch (idx [IDSTEP]) {
-			case TO_TIR: _processToTier (minCursor, tmp, idx, nbComputations); break;
-			case TO_VOL: _processToVolume (minCursor, tmp, idx, nbComputations); break;
-			case TO_DEV: _processToDevice (minCursor, tmp, idx, nbComputations, devClocks); break;
-			case FM_DEV: _processFromDevice (minCursor, tmp, idx, nbComputations); break;
-			case FM_VOL: _processFromVolume (minCursor, tmp, idx, nbComputations); break;
-			case FM_TIR: _processFromTier (minCursor, tmp, idx, nbComputations, starter, lastMainIdx); break;
+	// The rows before a removed one are done, so the scan restarts from
+	// the starter
+	if (elt2 == _kGone) {
+		if (step == FM_TIR || step == UND)
+			_restart = _kUnd;
+		else if (_prevDate [row] <= _rslt [step][row]) {
+			_idpt [IDPREV][row] = _kUnd;
+			_restart = row;
+			_checkpoint = _kGone;
+			_checkpointDate = _prevDate [row];
+		} else {
+			_restart = row;
+			_checkpoint = _kUnd;
 		}
+		return;
+	}
 
-		if (_idpt [minCursor][IDPREV] != idxUnd) {
-			auto elt2 = _idpt [minCursor][IDPREV];
-			if (_cntr [minCursor][IDSTEP] == FM_TIR || _cntr [minCursor][IDSTEP] == UND) {
-				_idpt [elt2][IDNEXT] = idxUnd;
-				restart = elt2;
-				checkpoint = idxUnd;
-			} else if (_rslt [elt2][_cntr [elt2][IDSTEP]] 
-				<= _rslt [minCursor][_cntr[minCursor][IDSTEP]]) {
-				_idpt [elt2][IDNEXT] = idxUnd;
-				_idpt [minCursor][IDPREV] = idxUnd;
-				restart = minCursor;
-				checkpoint = elt2;
-			} else {
-				restart = minCursor;
-				checkpoint = idxUnd;
-			}
-		} else
-			restart = idxUnd;
+	if (step == FM_TIR || step == UND) {
+		_idpt [IDNEXT][elt2] = _kUnd;
+		_restart = elt2;
+		_checkpoint = _kUnd;
+	} else if (_rslt [_cntr [IDSTEP][elt2] ][elt2] <= _rslt [step][row]) {
+		_idpt [IDNEXT][elt2] = _kUnd;
+		_idpt [IDPREV][row] = _kUnd;
+		_restart = row;
+		_checkpoint = elt2;
+	} else {
+		_restart = row;
+		_checkpoint = _kUnd;
+	}
+}
 
-		-- nbComputations;
+void
+SyncDefV2::_schedule (
+	vector <step_t>			& steps,
+	const OGSS_Ulong		row) {
+	auto					step {_cntr [IDSTEP][row]};
+	auto					& pos {_heapPos [row]};
+	OGSS_Bool				active {step != FM_TIR && step != UND};
+
+	if (pos < 0) {
+		if (! active) return;
+
+		steps.push_back ({_rslt [step][row], row});
+		pos = steps.size () - 1;
+	} else if (active)
+		steps [pos] ._date = _rslt [step][row];
+	else {
+		_unschedule (steps, row);
+		return;
 	}
+
+	_sift (steps, pos);
 }
 
-/*----------------------------------------------------------------------------*/
-/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
-/*----------------------------------------------------------------------------*/
+void
+SyncDefV2::_unschedule (
+	vector <step_t>			& steps,
+	const OGSS_Ulong		row) {
+	auto					& pos {_heapPos [row]};
+	OGSS_Ulong				last = pos;
+
+	if (pos < 0) return;
+
+	pos = -1;
+	if (last == steps.size () - 1) { steps.pop_back (); return; }
+
+	_place (steps, last, steps.back () );
+	steps.pop_back ();
+	_sift (steps, last);
+}
+
+void
+SyncDefV2::_sift (
+	vector <step_t>			& steps,
+	OGSS_Ulong				pos) {
+	step_t					step {steps [pos]};
+
+	while (pos && _before (step, steps [(pos - 1) / 2]) ) {
+		_place (steps, pos, steps [(pos - 1) / 2]);
+		pos = (pos - 1) / 2;
+	}
+
+	for (OGSS_Ulong child = 2 * pos + 1; child < steps.size (); child = 2 * pos + 1) {
+		if (child + 1 < steps.size () && _before (steps [child + 1], steps [child]) )
+			++ child;
+		if (! _before (steps [child], step) ) break;
+
+		_place (steps, pos, steps [child]);
+		pos = child;
+	}
+
+	_place (steps, pos, step);
+}
+
+void
+SyncDefV2::_step (
+	const OGSS_Ulong		row,
+	OGSS_Ulong				& nbComputations) {
+	auto					& step = _cntr [IDSTEP][row];
+
+	++ step;
+
+	_rslt [step][row]
+		= max (_busClocks [_cntr [IDCLK (step)][row]],
+		_rslt [step - 1][row]) + _data [step][row];
+
+	_busClocks [_cntr [IDCLK (step)][row]] = _rslt [step][row];
+
+	switch (step) {
+		case TO_TIR: _processToTier (row, nbComputations); break;
+		case TO_VOL: _processToVolume (row, nbComputations); break;
+		case TO_DEV: _processToDevice (row, nbComputations, _devClocks); break;
+		case FM_DEV: _processFromDevice (row, nbComputations); break;
+		case FM_VOL: _processFromVolume (row, nbComputations); break;
+		case FM_TIR: _processFromTier (row); break;
+	}
+
+	_schedule (row);
+
+	-- nbComputations;
+}
+
+void
+SyncDefV2::_retireRows () {
+	// The rows are written in order, so a logical request which is done
+	// waits for the previous ones
+	while (_retired < _laid && _cntr [IDSTEP][_retired] == FM_TIR) {
+		OGSS_Ulong			end {_end [_retired]};
+
+		if (_output.is_open () )
+			for (OGSS_Ulong row = _retired; row < end; ++row) {
+				_printResults (_output, row);
+				_printData (_outputData, row);
+			}
+
+		_retired = end;
+	}
+
+	if (_retired < _kDrop || 2 * _retired < _index.size () ) return;
+
+	OGSS_Ulong				num {min (_retired, _starter)};
+	auto					date = [&] (OGSS_Ulong row)
+		{ return _rslt [_cntr [IDSTEP][row] ][row]; };
+
+	// The removed rows are done, so the date of their step does not change
+	// anymore: the shortcuts and the checkpoint keep it. A scan from a
+	// removed row only goes through done rows up to the starter
+	for (OGSS_Ulong row = num; row < _laid; ++row)
+		if (_idpt [IDPREV][row] < num) {
+			_prevDate [row] = date (_idpt [IDPREV][row]);
+			_idpt [IDPREV][row] = _kGone;
+		}
+
+	if (_checkpoint < num) {
+		_checkpointDate = date (_checkpoint);
+		_checkpoint = _kGone;
+	}
+
+	if (_restart < num) _restart = _starter;
+
+	// The capacity is kept for the next rows
+	auto drop = [&] (auto & column)
+		{ column.erase (column.begin (), column.begin () + num); };
+	auto shift = [&] (OGSS_Ulong & row)
+		{ if (row != _kUnd && row != _kGone) row -= num; };
+
+	drop (_index);
+	for (auto & e: _data) drop (e);
+	for (auto & e: _rslt) drop (e);
+	for (auto & e: _cntr) drop (e);
+	for (auto & e: _idpt) drop (e);
+	drop (_prevDate);
+	drop (_failedReqs);
+	drop (_cachedReqs);
+	drop (_dispatchIdx);
+	drop (_heapPos);
+	drop (_parent);
+	drop (_end);
+
+	for (auto & e: _parent) e -= num;
+	for (auto & e: _end) e -= num;
+	for (auto & e: _leaves) e -= num;
+	for (auto & e: _steps) e._row -= num;
+	_dispatch.shift (num);
+	for (auto & e: _idpt)
+		for (auto & row: e) shift (row);
+
+	_starter -= num;
+	shift (_restart);
+	shift (_checkpoint);
+
+	_laid -= num;
+	_numRetired += num;
+	_retired -= num;
+}
 
 void
 SyncDefV2::_processToTier (
-	index_t					& minCursor,
-	value_t					& tmp,
-	valct_t					& idx,
+	const OGSS_Ulong		row,
 	OGSS_Ulong				& nbComputations) {
 	auto savedNumber = nbComputations;
 
-	for (auto elt = ++_rslt.find (minCursor); elt != _rslt.end (); ++elt) {
-		if (get<0> (elt->first) != get<0> (minCursor) ) break;
-		if (get<2> (elt->first) != 0) continue;
-		elt->second [TO_TIR] = tmp [TO_TIR];
-		_cntr [elt->first][IDSTEP] = TO_TIR;
-		_data [elt->first][ARRIVL] = tmp [TO_TIR];
+	// The next intermediate request follows the last child of the previous one
+	for (auto elt = row + 1; elt < _end [row]; elt = _end [elt]) {
+		_rslt [TO_TIR][elt] = _rslt [TO_TIR][row];
+		_cntr [IDSTEP][elt] = TO_TIR;
+		_data [ARRIVL][elt] = _rslt [TO_TIR][row];
+		_schedule (elt);
 		-- nbComputations;
 		
 	}
 	if (savedNumber != nbComputations)
-		idx [IDSTEP] = UND;
+		_cntr [IDSTEP][row] = UND;
 }
 
 void
 SyncDefV2::_processToVolume (
-	index_t					& minCursor,
-	value_t					& tmp,
-	valct_t					& idx,
+	const OGSS_Ulong		row,
 	OGSS_Ulong				& nbComputations) {
 	auto savedNumber = nbComputations;
-	for (auto elt = ++_rslt.find (minCursor); elt != _rslt.end (); ++elt) {
-		if (get<0> (elt->first) != get<0> (minCursor)
-			|| get<1> (elt->first) != get<1> (minCursor) ) break;
-		elt->second [TO_VOL] = tmp [TO_VOL];
+	for (auto elt = row + 1; elt < _end [row]; ++elt) {
+		_rslt [TO_VOL][elt] = _rslt [TO_VOL][row];
 		nbComputations -= 2;
-		if (_cntr [elt->first][NBPRIO] || ! idx [NBPRIO]){
-			_cntr [elt->first][IDSTEP] = TO_VOL;
-			_data [elt->first][ARRIVL] = tmp [TO_VOL];
+		if (_cntr [NBPRIO][elt] || ! _cntr [NBPRIO][row]){
+			_cntr [IDSTEP][elt] = TO_VOL;
+			_data [ARRIVL][elt] = _rslt [TO_VOL][row];
 		}
+		_schedule (elt);
 	}
 	if (savedNumber != nbComputations)
-		idx [IDSTEP] = UND;
+		_cntr [IDSTEP][row] = UND;
 }
 
 void
 SyncDefV2::_processToDevice (
-	index_t					& minCursor,
-	value_t					& tmp,
-	valct_t					& idx,
+	const OGSS_Ulong		row,
 	OGSS_Ulong				& nbComputations,
 	vector <double>			& devClocks) {
-	++ idx [IDSTEP];
+	++ _cntr [IDSTEP][row];
 
-	if (_failedReqs [minCursor]) {
-		auto elt = _rslt.find (make_tuple (get <0> (minCursor), 0, 0) );
-		if (elt->first != minCursor) {
-			_failedReqs [elt->first] = true;
-		}
-	} else {
-		tmp [SERVCE]
-			= max (devClocks [idx [IDDEVC]], tmp [TO_DEV])
-			+ _data [minCursor][SERVCE];
-		devClocks [idx [IDDEVC]] = tmp [SERVCE];
+	// The failed requests are not served, their logical request is marked
+	// on the layout
+	if (_failedReqs [row]) {
+		-- nbComputations;
+		return;
+	}
+
+	OGSS_Ulong				device {_cntr [IDDEVC][row]};
+
+	// The service step is counted once the request is released
+	if (! _dispatch.isNext (device, _dispatchIdx [row]) ) {
+		_dispatch.park (device, _dispatchIdx [row]);
+		_cntr [IDSTEP][row] = UND;
+		return;
 	}
 
+	_serve (row, devClocks);
 	-- nbComputations;
+
+	_release (_dispatch.serve (device, _dispatchIdx [row]), nbComputations,
+		devClocks);
+}
+
+void
+SyncDefV2::_release (
+	OGSS_Ulong				row,
+	OGSS_Ulong				& nbComputations,
+	vector <double>			& devClocks) {
+	for (; row != OGSS_ULONG_MAX;
+		row = _dispatch.serve (_cntr [IDDEVC][row], _dispatchIdx [row]) ) {
+		_cntr [IDSTEP][row] = SERVCE;
+		_serve (row, devClocks);
+		_schedule (row);
+		-- nbComputations;
+	}
+}
+
+void
+SyncDefV2::_serve (
+	const OGSS_Ulong		row,
+	vector <double>			& devClocks) {
+	if (_cachedReqs [row]) {
+		_rslt [SERVCE][row] = _rslt [TO_DEV][row];
+	} else {
+		_rslt [SERVCE][row]
+			= max (devClocks [_cntr [IDDEVC][row]], _rslt [TO_DEV][row])
+			+ _data [SERVCE][row];
+		devClocks [_cntr [IDDEVC][row]] = _rslt [SERVCE][row];
+	}
 }
 
 void
 SyncDefV2::_processFromDevice (
-	index_t					& minCursor,
-	value_t					& tmp,
-	valct_t					& idx,
+	const OGSS_Ulong		row,
 	OGSS_Ulong				& nbComputations) {
-	auto elt = _rslt.find (make_tuple (get<0> (minCursor), get<1> (minCursor), 0) );
+	if (! get<2> (_index [row]) ) return;
 
-	if (elt->first != minCursor) {
-		elt->second [FM_DEV] = max (elt->second [FM_DEV], tmp [FM_DEV]);
-		idx [IDSTEP] = FM_TIR;
-		nbComputations -= 2;
+	auto majr = _parent [row];
 
-		if (! -- _cntr [elt->first][NBCHLD]) {
-			_cntr [elt->first][IDSTEP] = FM_DEV;
-			nbComputations -= 3;
-		}
-
-		if (idx [NBPRIO]) {
-			-- _cntr [elt->first][NBPRIO];
-			for (auto flt = ++_rslt.find (elt->first); flt != _rslt.end (); ++flt) {
-				if (get<0> (flt->first) != get<0> (minCursor) ) break;
-				if (get<1> (flt->first) != get<1> (minCursor) ) continue;
+	_rslt [FM_DEV][majr] = max (_rslt [FM_DEV][majr], _rslt [FM_DEV][row]);
+	_cntr [IDSTEP][row] = FM_TIR;
+	nbComputations -= 2;
 
-				if (!_cntr [flt->first][NBPRIO]) {
-					if (!_cntr [elt->first][NBPRIO]){
-						_cntr [flt->first][IDSTEP] = TO_VOL;
-						_data [flt->first][ARRIVL] = tmp[FM_DEV];
-					}
+	if (! -- _cntr [NBCHLD][majr]) {
+		_cntr [IDSTEP][majr] = FM_DEV;
+		_schedule (majr);
+		nbComputations -= 3;
+	}
 
-					_rslt [flt->first][TO_VOL]
-						= max (_rslt [flt->first][TO_VOL], tmp [FM_DEV]);
+	if (_cntr [NBPRIO][row]) {
+		-- _cntr [NBPRIO][majr];
+		for (auto flt = majr + 1; flt < _end [majr]; ++flt) {
+			if (!_cntr [NBPRIO][flt]) {
+				if (!_cntr [NBPRIO][majr]){
+					_cntr [IDSTEP][flt] = TO_VOL;
+					_data [ARRIVL][flt] = _rslt [FM_DEV][row];
 				}
+
+				_rslt [TO_VOL][flt]
+					= max (_rslt [TO_VOL][flt], _rslt [FM_DEV][row]);
+				_schedule (flt);
 			}
 		}
+	}
 
-		_cntr [elt->first][IDTIER] = _cntr [minCursor][IDTIER];
-		_cntr [elt->first][IDVOLM] = _cntr [minCursor][IDVOLM];
-		_cntr [elt->first][IDDEVC] = _cntr [minCursor][IDDEVC];
+	_cntr [IDTIER][majr] = _cntr [IDTIER][row];
+	_cntr [IDVOLM][majr] = _cntr [IDVOLM][row];
+	_cntr [IDDEVC][majr] = _cntr [IDDEVC][row];
 
-		sendStat (prepareStat (minCursor) );
-		_resume.updateStats(prepareStat(minCursor));
-	}
+	_emitStat (row);
 }
 
 void
 SyncDefV2::_processFromVolume (
-	index_t					& minCursor,
-	value_t					& tmp,
-	valct_t					& idx,
+	const OGSS_Ulong		row,
 	OGSS_Ulong				& nbComputations) {
-	auto elt = _rslt.find (make_tuple (get<0> (minCursor), 0, 0) );
+	auto main = _parent [_parent [row] ];
 
-	if (elt->first != minCursor) {
-		elt->second [FM_VOL] = max (elt->second [FM_VOL], tmp [FM_VOL]);
-		idx [IDSTEP] = FM_TIR;
+	if (main != row) {
+		_rslt [FM_VOL][main] = max (_rslt [FM_VOL][main], _rslt [FM_VOL][row]);
+		_cntr [IDSTEP][row] = FM_TIR;
 		-- nbComputations;
 
-		if (! --_cntr [elt->first][NBCHLD]) {
-			_cntr [elt->first][IDSTEP] = FM_VOL;
+		if (! --_cntr [NBCHLD][main]) {
+			_cntr [IDSTEP][main] = FM_VOL;
+			_schedule (main);
 			nbComputations -= 5;
 		}
 
-		_cntr [elt->first][IDTIER] = _cntr [minCursor][IDTIER];
-		_cntr [elt->first][IDVOLM] = _cntr [minCursor][IDVOLM];
-		_cntr [elt->first][IDDEVC] = _cntr [minCursor][IDDEVC];
+		_cntr [IDTIER][main] = _cntr [IDTIER][row];
+		_cntr [IDVOLM][main] = _cntr [IDVOLM][row];
+		_cntr [IDDEVC][main] = _cntr [IDDEVC][row];
 
-		sendStat (prepareStat (minCursor) );
-		_resume.updateStats(prepareStat(minCursor));
+		_emitStat (row);
 	}
 }
 
 void
 SyncDefV2::_processFromTier (
-	index_t					& minCursor,
-	value_t					& tmp,
-	valct_t					& idx,
-	OGSS_Ulong				& nbComputations,
-	index_t					& starter,
-	OGSS_Ulong				& lastMainIdx) {
+	const OGSS_Ulong		row) {
 	OGSS_Ulong				printStep {max (_nbRequests/100, (OGSS_Ulong) 1) };
-	if (get<1> (minCursor) == 0 && get<2> (minCursor) == 0
-		&& get<0> (minCursor) == get<0> (starter) ) {
-		int y = get<0> (minCursor);
-		do {
-			if (++y > lastMainIdx) break;
-		} while (_cntr [make_tuple (y, 0, 0)][IDSTEP] == FM_TIR);
 
-		starter = make_tuple (y, 0, 0);
-	}
+	// The starter goes to the next logical request which is not done
+	if (row == _starter)
+		do {
+			_starter = _end [_starter];
+		} while (_starter < _laid && _cntr [IDSTEP][_starter] == FM_TIR);
 
 	if(_mainRequestsDone == 0){
 		cout << "\r\t" << 0 << "% Requests Done [0/" << _nbRequests << "]" << flush;
@@ -479,22 +887,21 @@ SyncDefV2::_processFromTier (
 		}
 	}
 
-	sendStat (prepareStat (minCursor) );
-	_resume.updateStats(prepareStat(minCursor));
+	_emitStat (row);
 }
 
 void
-SyncDefV2::createOutputFile (
-	const OGSS_String		outputFile) {
-	if (! outputFile.compare ("") ){
-		cout << "\r\t\tOutput file not requested by the configuration" << endl;
-		return;
-	} 
+SyncDefV2::_emitStat (
+	const OGSS_Ulong		row) {
+	RequestStat				stat {prepareStat (row) };
 
-	ofstream				output (outputFile);
-	OGSS_Ulong				printStep {max (_rslt.size() / 100, (OGSS_Ulong) 1) };
-	OGSS_Ulong				printStep2 {max (_data.size() / 100, (OGSS_Ulong) 1) };
+	sendStat (stat);
+	_resume.updateStats (stat);
+}
 
+void
+SyncDefV2::_printHeader (
+	ostream					& output) {
 	output << left << setfill (' ') << setw (6) << "#M.a.m" << " | "
 		 << left << setfill (' ') << setw (8) << "Arrival" << " | "
 		 << left << setfill (' ') << setw (17) << "ToTier" << " | "
@@ -504,78 +911,125 @@ SyncDefV2::createOutputFile (
 		 << left << setfill (' ') << setw (17) << "FromDevice" << " | "
 		 << left << setfill (' ') << setw (17) << "FromVolume" << " | "
 		 << left << setfill (' ') << setw (17) << "FromTier"
-		 << endl;
+		 << '\n';
+}
 
-	OGSS_Ulong nbResults = 0;
-	for (auto & e: _rslt) {
-		output << right << setfill (' ') << setw (2) << get<0> (e.first) << "." << get<1> (e.first) << "."
-			 << get<2> (e.first) << " | ";
+void
+SyncDefV2::_printResults (
+	ostream					& output,
+	const OGSS_Ulong		row) {
+	const index_t			& idx = _index [row];
 
-		if (e.second [ARRIVL] < 0 || _data [e.first][ARRIVL] < 0)
-			output << left << setfill (' ') << setw (8) << "-";
+	output << right << setfill (' ') << setw (2) << get<0> (idx) << "." << get<1> (idx) << "."
+		 << get<2> (idx) << " | ";
+
+	if (_rslt [ARRIVL][row] < 0 || _data [ARRIVL][row] < 0)
+		output << left << setfill (' ') << setw (8) << "-";
+	else
+		output << left << setfill (' ') << setw (8) << _rslt [ARRIVL][row];
+	for (auto j = 1; j < TABTOT; ++j) {
+		if (_rslt [j][row] < 0 || _data [j][row] < 0)
+			output << " | " << setfill (' ') << setw (17) << "-";
 		else
-			output << left << setfill (' ') << setw (8) << e.second [ARRIVL];
-		for (auto j = 1; j < TABTOT; ++j) {
-			if (e.second [j] < 0 || _data [e.first][j] < 0)
-				output << " | " << setfill (' ') << setw (17) << "-";
-			else
-				output << " | " << setfill (' ') << setw (17) << e.second [j] - _data [e.first][j];
-		}
+			output << " | " << setfill (' ') << setw (17) << _rslt [j][row] - _data [j][row];
+	}
+
+	output << '\n' << setfill (' ') << setw (6) << " " << " | " << setfill (' ') << setw (8) << " ";
+
+	for (auto j = 1; j < TABTOT; ++j) {
+		if (_rslt [j][row] < 0 || _data [j][row] < 0)
+			output << " > " << setfill (' ') << setw (17) << "-";
+		else
+			output << " > " << setfill (' ') << setw (17) << _rslt [j][row];
+	}
+
+	output << '\n';
+}
+
+void
+SyncDefV2::_printData (
+	ostream					& output,
+	const OGSS_Ulong		row) {
+	const index_t			& idx = _index [row];
+
+	output << right << setfill (' ') << setw (2) << get<0> (idx) << "." << get<1> (idx) << "."
+		 << get<2> (idx) << " | ";
+
+	if (_data [ARRIVL][row] < 0 || _data [ARRIVL][row] == numeric_limits<double> ::max () )
+		output << left << setfill (' ') << setw (8) << "-";
+	else
+		output << left << setfill (' ') << setw (8) << _data [ARRIVL][row];
+	for (auto j = 1; j < TABTOT; ++j) {
+		if (_data [j][row] < 0)
+			output << " | " << setfill (' ') << setw (17);
+		else
+			output << " | " << setfill (' ') << setw (17) << _data [j][row];
+	}
 
-		output << endl << setfill (' ') << setw (6) << " " << " | " << setfill (' ') << setw (8) << " ";
+	output << '\n';
+}
 
-		for (auto j = 1; j < TABTOT; ++j) {
-			if (e.second [j] < 0 || _data [e.first][j] < 0)
-				output << " > " << setfill (' ') << setw (17) << "-";
-			else
-				output << " > " << setfill (' ') << setw (17) << e.second [j];
+void
+SyncDefV2::createOutputFile (
+	const OGSS_String		outputFile) {
+	if (! outputFile.compare ("") ){
+		cout << "\r\t\tOutput file not requested by the configuration" << endl;
+		return;
+	} 
+
+	// The retired rows are already written
+	if (_retire) {
+		for (OGSS_Ulong row = _retired; row < _index.size (); ++row) {
+			_printResults (_output, row);
+			_printData (_outputData, row);
 		}
 
-		output << endl;
+		_outputData.close ();
+
+		ifstream			data (_outputDataFile);
+
+		_output << endl << "----------------------" << endl << endl;
+		_printHeader (_output);
+
+		if (data.peek () != ifstream::traits_type::eof () )
+			_output << data.rdbuf ();
+
+		data.close ();
+		remove (_outputDataFile.c_str () );
+		_output.close ();
+		return;
+	}
+
+	ofstream				output (outputFile);
+	OGSS_Ulong				printStep {max (_index.size() / 100, (OGSS_Ulong) 1) };
+	OGSS_Ulong				printStep2 {max (_index.size() / 100, (OGSS_Ulong) 1) };
+
+	_printHeader (output);
+
+	OGSS_Ulong nbResults = 0;
+	for (OGSS_Ulong row = 0; row < _index.size (); ++row) {
+		_printResults (output, row);
 
 		nbResults++;
 
 		if(!( nbResults % printStep)){
 			if(printStep == 1){
-				cout << "\r\t\t" << floor(((OGSS_Real)nbResults/_rslt.size()) + 0.5) * 100 << "%  results written" << flush;
+				cout << "\r\t\t" << floor(((OGSS_Real)nbResults/_index.size()) + 0.5) * 100 << "%  results written" << flush;
 			}else
 			cout << "\r\t\t" << floor(((OGSS_Real)nbResults/printStep) + 0.5) << "%  results written" << flush;
 		}
-		if(nbResults == _rslt.size()){
+		if(nbResults == _index.size()){
 			cout << endl;
 		}
 	}
 
 	output << endl << "----------------------" << endl << endl;
 
-	output << left << setfill (' ') << setw (6) << "#M.a.m" << " | "
-		 << left << setfill (' ') << setw (8) << "Arrival" << " | "
-		 << left << setfill (' ') << setw (17) << "ToTier" << " | "
-		 << left << setfill (' ') << setw (17) << "ToVolume" << " | "
-		 << left << setfill (' ') << setw (17) << "ToDevice" << " | "
-		 << left << setfill (' ') << setw (17) << "Service" << " | "
-		 << left << setfill (' ') << setw (17) << "FromDevice" << " | "
-		 << left << setfill (' ') << setw (17) << "FromVolume" << " | "
-		 << left << setfill (' ') << setw (17) << "FromTier"
-		 << endl;
+	_printHeader (output);
 
 	OGSS_Ulong nbData = 0;
-	for (auto & e: _data) {
-		output << right << setfill (' ') << setw (2) << get<0> (e.first) << "." << get<1> (e.first) << "."
-			 << get<2> (e.first) << " | ";
-
-		if (e.second [ARRIVL] < 0 || e.second [ARRIVL] == numeric_limits<double> ::max () )
-			output << left << setfill (' ') << setw (8) << "-";
-		else
-			output << left << setfill (' ') << setw (8) << e.second [ARRIVL];
-		for (auto j = 1; j < TABTOT; ++j) {
-			if (e.second [j] < 0)
-				output << " | " << setfill (' ') << setw (17);
-			else
-				output << " | " << setfill (' ') << setw (17) << e.second [j];
-		}
-
-		output << endl;
+	for (OGSS_Ulong row = 0; row < _index.size (); ++row) {
+		_printData (output, row);
 
 		nbData++;
 
@@ -583,12 +1037,12 @@ SyncDefV2::createOutputFile (
 			cout << "\r\t\t" << floor(((OGSS_Real)nbData/printStep2) + 0.5) << "%  data written" << flush;
 
 			if(printStep2 == 1){
-				cout << "\r\t\t" << floor(((OGSS_Real)nbData/_rslt.size()) + 0.5) * 100 << "%  data written" << flush;
+				cout << "\r\t\t" << floor(((OGSS_Real)nbData/_index.size()) + 0.5) * 100 << "%  data written" << flush;
 			}else
 			cout << "\r\t\t" << floor(((OGSS_Real)nbData/printStep2) + 0.5) << "%  data written" << flush;
 		}
 
-		if(nbData == _data.size()){
+		if(nbData == _index.size()){
 				cout << endl;
 		}
 	}
@@ -600,3 +1054,78 @@ SyncDefV2::createResumeFile (
 	
 	_resume.save(resumeFile);
 }
+
+/*----------------------------------------------------------------------------*/
+/* UNITARY TEST --------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+UT_SyncDefV2::UT_SyncDefV2 (
+	const OGSS_String		& configurationFile):
+	UnitaryTest <UT_SyncDefV2> (MTP_SYNCDEFV2) {
+	set <OGSS_String>		testNames;
+
+	XMLParser::getListOfRequestedUnitaryTests (
+		configurationFile, _module, testNames);
+
+	for (auto & elt: testNames) {
+		if (! elt.compare ("all") ) {
+			_tests.push_back (make_pair ("1 request",
+				&UT_SyncDefV2::oneRequest) );
+			_tests.push_back (make_pair ("2 requests",
+				&UT_SyncDefV2::twoRequests) );
+			_tests.push_back (make_pair ("2 requests -- small lambda",
+				&UT_SyncDefV2::twoRequests_smallLambda) );
+			_tests.push_back (make_pair ("2 requests -- huge lambda",
+				&UT_SyncDefV2::twoRequests_hugeLambda) );
+			_tests.push_back (make_pair ("2 requests -- 2 volumes",
+				&UT_SyncDefV2::twoRequests_twoVolumes) );
+			_tests.push_back (make_pair ("3 requests -- in RAIDNP",
+				&UT_SyncDefV2::threeRequests_RAIDNP) );
+			_tests.push_back (make_pair ("Scan order",
+				&UT_SyncDefV2::scanOrder) );
+			_tests.push_back (make_pair ("Heap order",
+				&UT_SyncDefV2::heapOrder) );
+			_tests.push_back (make_pair ("Dispatch order",
+				&UT_SyncDefV2::dispatchOrder) );
+			_tests.push_back (make_pair ("Online -- 2 volumes",
+				&UT_SyncDefV2::onlineVolumes) );
+			_tests.push_back (make_pair ("Online -- coalescing",
+				&UT_SyncDefV2::onlineCoalescing) );
+			_tests.push_back (make_pair ("Online -- retirement",
+				&UT_SyncDefV2::onlineRetirement) );
+		} else if (! elt.compare ("requests") ) {
+			_tests.push_back (make_pair ("1 request",
+				&UT_SyncDefV2::oneRequest) );
+			_tests.push_back (make_pair ("2 requests",
+				&UT_SyncDefV2::twoRequests) );
+			_tests.push_back (make_pair ("2 requests -- small lambda",
+				&UT_SyncDefV2::twoRequests_smallLambda) );
+			_tests.push_back (make_pair ("2 requests -- huge lambda",
+				&UT_SyncDefV2::twoRequests_hugeLambda) );
+			_tests.push_back (make_pair ("2 requests -- 2 volumes",
+				&UT_SyncDefV2::twoRequests_twoVolumes) );
+			_tests.push_back (make_pair ("3 requests -- in RAIDNP",
+				&UT_SyncDefV2::threeRequests_RAIDNP) );
+		} else if (! elt.compare ("order") ) {
+			_tests.push_back (make_pair ("Scan order",
+				&UT_SyncDefV2::scanOrder) );
+			_tests.push_back (make_pair ("Heap order",
+				&UT_SyncDefV2::heapOrder) );
+			_tests.push_back (make_pair ("Dispatch order",
+				&UT_SyncDefV2::dispatchOrder) );
+		} else if (! elt.compare ("online") ) {
+			_tests.push_back (make_pair ("Online -- 2 volumes",
+				&UT_SyncDefV2::onlineVolumes) );
+			_tests.push_back (make_pair ("Online -- coalescing",
+				&UT_SyncDefV2::onlineCoalescing) );
+			_tests.push_back (make_pair ("Online -- retirement",
+				&UT_SyncDefV2::onlineRetirement) );
+		} else
+			LOG (WARNING) << ModuleNameMap.at (_module) << " unitary test "
+				<< "named '" << elt << "' does not match!";
+	}
+}
+
+UT_SyncDefV2::~UT_SyncDefV2 () {  }
+
+#include "utest/utsyncdefv2.cpp"
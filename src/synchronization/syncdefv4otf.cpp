@@ -26,11 +26,13 @@
 /* HEADERS -------------------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
+#include <algorithm>
 #include <bitset>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <numeric>
 #include <queue>
 
 #include "synchronization/syncdefv4otf.hpp"
@@ -52,110 +54,116 @@ static OGSS_Ushort						_VOLM_ {1};
 static OGSS_Ushort						_DVIN_ {2};
 static OGSS_Ushort						_DVOT_ {3};
 
-typedef pair <OGSS_RequestIdx, OGSS_Real> __Stamp;
-typedef OGSS_Bool (* __StampCmpFunc) (__Stamp, __Stamp);
+typedef pair <OGSS_Ulong, OGSS_Real> __Stamp;
 
+// Number of children of a heap node: the children of a node share a cache line
+static const OGSS_Ulong					_ARITY_ {4};
+
+// The stamps are ordered by date, then by row. The ones inserted in order are
+// appended to a FIFO, the other ones are kept in a d-ary heap
 struct SyncDefV4OTF::OrderedWaitQueue {
 	queue <__Stamp>						_primary;
-	set <__Stamp, __StampCmpFunc>		_secondary {SyncDefV4OTF::__stampCompare};
-
-	OGSS_Real							_minValue {OGSS_REAL_MAX};
-															// min between primary & secondary
-	OGSS_Real							_lastValue {.0};	// last value of primary
+	vector <__Stamp>					_secondary;
 
 	OGSS_Real probe ();
-	OGSS_RequestIdx fetch ();
+	OGSS_Ulong fetch ();
 	void insert (
 		const __Stamp					s);
 	OGSS_Ulong size ();
+	void shift (
+		const OGSS_Ulong				n);
 
 private:
-	void _reinject ();
+	OGSS_Bool _fromPrimary ();
 };
 
 OGSS_Real
-SyncDefV4OTF::OrderedWaitQueue::probe ()
-	{ return _minValue; }
+SyncDefV4OTF::OrderedWaitQueue::probe () {
+	if (_fromPrimary () ) return _primary.front () .second;
+	if (_secondary.size () ) return _secondary.front () .second;
+	return OGSS_REAL_MAX;
+}
 
-OGSS_RequestIdx
+OGSS_Ulong
 SyncDefV4OTF::OrderedWaitQueue::fetch () {
-	OGSS_RequestIdx						r;
-	if (_primary.size () && _primary.front () .second <= _minValue) {
-		r = _primary.front () .first;
+	if (_fromPrimary () ) {
+		const OGSS_Ulong				r {_primary.front () .first};
 		_primary.pop ();
-	} else if (_secondary.size () ) {
-		r = _secondary.begin () ->first;
-		_secondary.erase (_secondary.begin () );
-	} else return OGSS_REQUESTIDX_UND;
+		return r;
+	}
+
+	if (! _secondary.size () ) return OGSS_ULONG_MAX;
+
+	const OGSS_Ulong					r {_secondary.front () .first};
+	const __Stamp						last {_secondary.back () };
+	const OGSS_Ulong					n {_secondary.size () - 1};
+	OGSS_Ulong							pos {0};
+
+	_secondary.pop_back ();
+
+	if (! n) return r;
+
+	// The last stamp goes down from the root, the smallest children go up
+	for (auto child = 1UL; child < n; child = _ARITY_ * pos + 1) {
+		auto							best {child};
+
+		for (auto i = child + 1; i < min (child + _ARITY_, n); ++i)
+			if (SyncDefV4OTF::__stampCompare (_secondary [i], _secondary [best]) )
+				best = i;
 
-	if (_primary.size () &&
-		( (! _secondary.size () )
-			|| (_secondary.size () && _primary.front () .second <= _secondary.begin () ->second) ) )
-		_minValue = _primary.front () .second;
-	else if (_secondary.size () )
-		_minValue = _secondary.begin () ->second;
-	else
-		_minValue = OGSS_REAL_MAX;
+		if (! SyncDefV4OTF::__stampCompare (_secondary [best], last) ) break;
 
-	if (! _primary.size () ) {
-		_lastValue = .0;
+		_secondary [pos] = _secondary [best];
+		pos = best;
 	}
 
+	_secondary [pos] = last;
+
 	return r;
 }
 
 void
 SyncDefV4OTF::OrderedWaitQueue::insert (
 	const __Stamp						s) {
-	if (s.second < _minValue) {
-		_minValue = s.second;
+	if (! _primary.size () || ! SyncDefV4OTF::__stampCompare (s, _primary.back () ) ) {
+		_primary.push (s);
+		return;
 	}
 
-	if (_secondary.size () >= 2500) {
-		_reinject ();
-	}
+	auto								pos {_secondary.size ()};
 
-	if (_lastValue <= s.second) {
-		_lastValue = s.second;
-		_primary.push (s);
-	} else {
-		_secondary.insert (s);
-	}
+	_secondary.push_back (s);
+
+	for (; pos && SyncDefV4OTF::__stampCompare (s, _secondary [(pos - 1) / _ARITY_]);
+		pos = (pos - 1) / _ARITY_)
+		_secondary [pos] = _secondary [(pos - 1) / _ARITY_];
+
+	_secondary [pos] = s;
 }
 
 OGSS_Ulong
 SyncDefV4OTF::OrderedWaitQueue::size ()
 	{ return _primary.size () + _secondary.size (); }
 
+// The rows keep their order, so do the stamps
 void
-SyncDefV4OTF::OrderedWaitQueue::_reinject () {
+SyncDefV4OTF::OrderedWaitQueue::shift (
+	const OGSS_Ulong					n) {
 	queue <__Stamp>						tmp {};
-	auto								i {0};
-	auto								setIter {_secondary.begin () };
 
-	auto								a {_primary.size () + _secondary.size () };
+	for (; _primary.size (); _primary.pop () )
+		tmp.push (make_pair (_primary.front () .first - n, _primary.front () .second) );
+	for (auto & elt: _secondary) elt.first -= n;
 
-	tmp.swap (_primary);
-
-	while (tmp.size () || setIter != _secondary.end () ) {
-		if (setIter == _secondary.end ()
-		 || (tmp.size () && tmp.front () .second <= setIter->second) ) {
-			_primary.push (tmp.front () );
-			DLOG_IF(INFO, tmp.front () .first == OGSS_REQUESTIDX_UND) << "Err[3] -- insert UND from primary";
-			tmp.pop ();
-		} else {
-			_primary.push (* setIter);
-			DLOG_IF(INFO, setIter->first == OGSS_REQUESTIDX_UND) << "Err[4] -- insert UND from primary";
-			++ setIter;
-		}
-	}
-
-	_secondary.clear ();
-
-	DLOG_IF(INFO, a != _primary.size () ) << "Err[1] -- size difference " << a << " /= " << _primary.size ();
-	DLOG_IF(INFO, _secondary.size () ) << "Err[2] -- secondary is not empty" << _secondary.size ();
+	_primary.swap (tmp);
 }
 
+OGSS_Bool
+SyncDefV4OTF::OrderedWaitQueue::_fromPrimary () {
+	return _primary.size ()
+		&& (! _secondary.size ()
+			|| SyncDefV4OTF::__stampCompare (_primary.front (), _secondary.front () ) ); }
+
 OGSS_Bool
 SyncDefV4OTF::__stampCompare (
 	__Stamp								lhs,
@@ -191,11 +199,9 @@ SyncDefV4OTF::SyncDefV4OTF (
 	_hardParam (params), _tiers (tiers), _volumes (vols),
 	_devices (devs), _globalDU (globalDU) {
 
-	for (auto i = 0; i < _hardParam._numInterfaces; ++i)
-		_busClocks [i] = .0;
-
-	for (auto i = 0; i < _hardParam._numDevices; ++i)
-		_devClocks [i] = .0;
+	_busClocks.assign (_hardParam._numInterfaces, .0);
+	_devClocks.assign (_hardParam._numDevices, .0);
+	_dispatch.resize (_hardParam._numDevices);
 
 	_minOTFRequestSize = max ((OGSS_Ulong) 1, _minOTFRequestSize / _globalDU._memory);
 
@@ -236,73 +242,73 @@ SyncDefV4OTF::addEntry (
 			_evByDev [req._idxDevice] .second = req._index;
 			_deviceState [req._idxDevice] ._renewalDate = req._date;
 		}
-	} else	_userRequests [req._index] = req;
 
-	_data [req._index][ARRIVL] =		req._date;
+		return;
+	}
+
+	OGSS_Ulong						row {_requests.size () };
+
+	_requests.push_back (req);
+	for (auto & e: _data) e.push_back (.0);
+	for (auto & e: _userRslt) e.push_back (.0);
+	for (auto & e: _cntr) e.push_back (0);
+	_requestClock.push_back (.0);
+
+	_data [ARRIVL][row] =			req._date;
 
 	if (! req._majrIdx) {							// Logical request
 		if (! req._system) {
 
-			_cntr [req._index][IDSTEP] = 	ARRIVL;
-			_cntr [req._index][IDBUS] =	_hardParam._hostInterface;
-			_cntr [req._index][START] =	true;
-			_cntr [req._index][REMOVE] =	false;
+			_cntr [IDSTEP][row] = 	ARRIVL;
+			_cntr [IDBUS][row] =	_hardParam._hostInterface;
+			_cntr [START][row] =	true;
+			_cntr [REMOVE][row] =	false;
 
-			_userRslt [req._index][ARRIVL] =	req._date;
-			_userRslt [req._index][IN] =	.0;
-			_userRslt [req._index][OUT] =	.0;
+			_userRslt [ARRIVL][row] =	req._date;
+			_userRslt [IN][row] =	.0;
+			_userRslt [OUT][row] =	.0;
 
-			_requestClock [req._index._main] = make_pair (req._date, req._date);
+			_requestClock [row] = req._date;
 
-			_busWaitQueue [_TIER_] .insert (make_pair (req._index, req._date) );
+			_mains.push_back (row);				// Queued once the rows are sorted
 
 			++ _nbMainRequests;
 		}
 	} else if (! req._minrIdx) {					// Intermediate request
 
-			_cntr [req._index][IDSTEP] = 	UND;
-			_cntr [req._index][IDBUS] =	_tiers [_volumes [req._idxVolume] ._parent] ._interface;
-			_cntr [req._index][START] =	false;
-			_cntr [req._index][REMOVE] =	false;
+			_cntr [IDSTEP][row] = 	UND;
+			_cntr [IDBUS][row] =	_tiers [_volumes [req._idxVolume] ._parent] ._interface;
+			_cntr [START][row] =	false;
+			_cntr [REMOVE][row] =	false;
 
-			_userRslt [req._index][ARRIVL] =	.0;
-			_userRslt [req._index][IN] =	.0;
-			_userRslt [req._index][OUT] =	.0;
+			_userRslt [ARRIVL][row] =	.0;
+			_userRslt [IN][row] =	.0;
+			_userRslt [OUT][row] =	.0;
 	} else {										// Physical request
-		_data [req._index][IN]	=		req._transferTimeA3;
-		_data [req._index][OUT] =		req._transferTimeB3;
-
-		OGSS_RequestIdx					main {req._index._main, 0, 0};
-		OGSS_RequestIdx					majr {req._index._main, req._index._major, 0};
-
-		_data [main][IN] =				req._transferTimeA1;
-		_data [main][OUT] =				req._transferTimeB1;
-		_data [majr][IN] =				req._transferTimeA2;
-		_data [majr][OUT] =				req._transferTimeB2;
+		_data [IN][row]	=			req._transferTimeA3;
+		_data [OUT][row] =			req._transferTimeB3;
 
-		_userRequests [main] ._idxDevice = req._idxDevice;
-		_userRequests [majr] ._idxDevice = req._idxDevice;
+		_leaves.push_back (row);				// Parent data are set once sorted
 
-		_cntr [req._index][IDSTEP] = 	UND;
-		_cntr [req._index][IDBUS] =	_volumes [req._idxVolume] ._interface;
-		_cntr [req._index][START] =	false;
-		_cntr [req._index][REMOVE] =	false;
+		_cntr [IDSTEP][row] = 	UND;
+		_cntr [IDBUS][row] =	_volumes [req._idxVolume] ._interface;
+		_cntr [START][row] =	false;
+		_cntr [REMOVE][row] =	false;
 
-		_userRslt [req._index][ARRIVL] =	.0;
-		_userRslt [req._index][IN] =	.0;
-		_userRslt [req._index][OUT] =	.0;
+		_userRslt [ARRIVL][row] =	.0;
+		_userRslt [IN][row] =	.0;
+		_userRslt [OUT][row] =	.0;
 	}
 
-	_cntr [req._index][SYSTEM] =		req._system;
-
-//	_failedReqs [req._index] = req._failed;
+	_cntr [SYSTEM][row] =			req._system;
 }
 
 RequestStat
 SyncDefV4OTF::prepareStat (
-	const OGSS_RequestIdx			idx) {
+	const OGSS_Ulong				row) {
 	RequestStat						stat;
-	Request & r = _userRequests.at (idx);
+	Request & r = _requests [row];
+	const OGSS_RequestIdx			& idx = r._index;
 
 	stat._mainIdx = r._mainIdx;
 	stat._majrIdx = r._majrIdx;
@@ -323,19 +329,19 @@ SyncDefV4OTF::prepareStat (
 	stat._failed = r._failed;
 
 	if (idx.isLogical () ) {
-		stat._idxBus = _cntr [idx][IDBUS];
+		stat._idxBus = _cntr [IDBUS][row];
 		stat._transferTime = r._transferTimeA1 + r._transferTimeA2;
 		stat._waitingTime = r._waitingTime;
 		stat._serviceTime = r._responseTime - stat._transferTime - stat._waitingTime;
 	}
 	else if (idx.isIntermediate () ) {
-		stat._idxBus = _cntr [idx][IDBUS];
+		stat._idxBus = _cntr [IDBUS][row];
 		stat._transferTime = r._transferTimeA2 + r._transferTimeB2;
 		stat._waitingTime = r._waitingTime;
 		stat._serviceTime = 0;
 	}
 	else {
-		stat._idxBus = _cntr [idx][IDBUS];
+		stat._idxBus = _cntr [IDBUS][row];
 		stat._serviceTime = r._serviceTime;
 		stat._transferTime = r._transferTimeA3 + r._transferTimeB3;
 		stat._waitingTime = r._waitingTime;
@@ -346,24 +352,31 @@ SyncDefV4OTF::prepareStat (
 
 void
 SyncDefV4OTF::process () {
+	_layout ();
+
 	_resume = Resume (_nbMainRequests, _globalDU, _tiers.size(), _volumes.size(), _devices.size() );
 	_resume.setFirstDateEvent (_firstEventDate);
 
 	LOG(INFO) << "Number of requests to process: " << _nbMainRequests << endl;
 
 	while (_nbMainRequestsDone != _nbMainRequests) {
-		auto e {_getNextRequest () };
+		auto row {_getNextRequest () };
 
-		LOG_IF(FATAL, e == OGSS_REQUESTIDX_UND) << "No more request to process, but the whole request set is not processed yet";
+		LOG_IF(FATAL, row == OGSS_ULONG_MAX) << "No more request to process, but the whole request set is not processed yet";
 
-		if (e.isLogical () && _cntr [e][IDSTEP] == ARRIVL)			_processToTier (e);
-		else if (e.isLogical ())									_processFromTier (e);
-		else if (e.isIntermediate () && _cntr [e][IDSTEP] == ARRIVL)_processToVolume (e);
-		else if (e.isIntermediate ())								_processFromVolume (e);
+		const OGSS_RequestIdx		& e = _requests [row] ._index;
+		const OGSS_Bool				arrival {_cntr [IDSTEP][row] == ARRIVL};
+
+		if (e.isLogical () && arrival)								_processToTier (row);
+		else if (e.isLogical ())									_processFromTier (row);
+		else if (e.isIntermediate () && arrival)					_processToVolume (row);
+		else if (e.isIntermediate ())								_processFromVolume (row);
 		else {
-			if (e.isPhysical () && _cntr [e][IDSTEP] == ARRIVL)		_processUserToDevice (e);
-			else													_processUserFromDevice (e);
+			if (e.isPhysical () && arrival)							_processUserToDevice (row);
+			else													_processUserFromDevice (row);
 		}
+
+		if (_retire && row == _retired) _retireRows ();
 	}
 
 	cout << "-\tNumber of events to resolve: " << _events.size () << endl;
@@ -392,6 +405,11 @@ SyncDefV4OTF::process () {
 	LOG(INFO) << "[SC] Process done!";
 }
 
+void
+SyncDefV4OTF::enableRetirement (
+	const OGSS_String		outputFile)
+	{ _retire = true; }
+
 void
 SyncDefV4OTF::createOutputFile (
 	const OGSS_String		outputFile) {  }
@@ -407,10 +425,126 @@ SyncDefV4OTF::createResumeFile (
 /* PRIVATE FUNCTIONS ---------------------------------------------------------*/
 /*----------------------------------------------------------------------------*/
 
-OGSS_RequestIdx
+void
+SyncDefV4OTF::_layout () {
+	OGSS_Ulong						numRows {_requests.size () };
+	vector <OGSS_Ulong>				order (numRows);
+	vector <OGSS_Ulong>				rank (numRows);
+
+	iota (order.begin (), order.end (), 0);
+	sort (order.begin (), order.end (),
+		[&] (OGSS_Ulong a, OGSS_Ulong b)
+			{ return _requests [a] ._index < _requests [b] ._index; } );
+
+	for (OGSS_Ulong i = 0; i < numRows; ++i)
+		rank [order [i] ] = i;
+
+	// Each column is moved in turn, to only hold one more column at a time
+	auto permute = [&] (auto & column) {
+		typename remove_reference <decltype (column)> ::type tmp (numRows);
+		for (OGSS_Ulong i = 0; i < numRows; ++i)
+			tmp [i] = std::move (column [order [i] ]);
+		column.swap (tmp);
+	};
+
+	permute (_requests);
+	for (auto & e: _data) permute (e);
+	for (auto & e: _userRslt) permute (e);
+	for (auto & e: _cntr) permute (e);
+	permute (_requestClock);
+
+	_parent.resize (numRows);
+	_end.resize (numRows);
+
+	OGSS_Ulong						main {0}, majr {0};
+
+	for (OGSS_Ulong row = 0; row < numRows; ++row) {
+		const OGSS_RequestIdx		& idx = _requests [row] ._index;
+
+		LOG_IF(FATAL, row && idx == _requests [row - 1] ._index)
+			<< "Request " << idx << " was received twice";
+
+		if (! idx._major) main = majr = _parent [row] = row;
+		else if (! idx._minor) { _parent [row] = main; majr = row; }
+		else _parent [row] = majr;
+
+		const OGSS_RequestIdx		& pdx = _requests [_parent [row] ] ._index;
+
+		LOG_IF(FATAL, pdx._main != idx._main
+			|| (idx._minor && pdx._major != idx._major) )
+			<< "Request " << idx << " was received without its parent";
+
+		_end [row] = row + 1;
+	}
+
+	for (OGSS_Ulong row = numRows; row --; )
+		_end [_parent [row] ] = max (_end [_parent [row] ], _end [row]);
+
+	// A parent received after one of its children keeps its own device
+	for (auto leaf: _leaves) {
+		OGSS_Ulong					row {rank [leaf]};
+		OGSS_Ulong					majr {_parent [row]};
+		OGSS_Ulong					main {_parent [majr]};
+		const Request				& r = _requests [row];
+
+		_data [IN][main] =			r._transferTimeA1;
+		_data [OUT][main] =			r._transferTimeB1;
+		_data [IN][majr] =			r._transferTimeA2;
+		_data [OUT][majr] =			r._transferTimeB2;
+
+		if (order [main] < leaf) _requests [main] ._idxDevice = r._idxDevice;
+		if (order [majr] < leaf) _requests [majr] ._idxDevice = r._idxDevice;
+
+		// The requests which wait for the prior ones of their parent are not
+		// awaited on their device
+		_dispatch.add (r._idxDevice, r._dispatchIdx, row,
+			r._prio || ! _requests [majr] ._numPrioChild);
+	}
+
+	for (auto elt: _mains)
+		_busWaitQueue [_TIER_] .insert (
+			make_pair (rank [elt], _requests [rank [elt] ] ._date) );
+
+	vector <OGSS_Ulong> () .swap (_leaves);
+	vector <OGSS_Ulong> () .swap (_mains);
+}
+
+void
+SyncDefV4OTF::_retireRows () {
+	// The system requests are not processed with the user ones
+	while (_retired < _requests.size ()
+		&& (_cntr [SYSTEM][_retired] || _cntr [IDSTEP][_retired] == OUT) )
+		_retired = _end [_retired];
+
+	if (_retired < 1024 || 2 * _retired < _requests.size () ) return;
+
+	// No row is added during the synchronization, so the memory is released
+	auto drop = [&] (auto & column) {
+		typename remove_reference <decltype (column)> ::type tmp (
+			column.begin () + _retired, column.end () );
+		column.swap (tmp);
+	};
+
+	drop (_requests);
+	for (auto & e: _data) drop (e);
+	for (auto & e: _userRslt) drop (e);
+	for (auto & e: _cntr) drop (e);
+	drop (_requestClock);
+	drop (_parent);
+	drop (_end);
+
+	for (auto & e: _parent) e -= _retired;
+	for (auto & e: _end) e -= _retired;
+	for (auto & e: _busWaitQueue) e.shift (_retired);
+	_dispatch.shift (_retired);
+
+	_retired = 0;
+}
+
+OGSS_Ulong
 SyncDefV4OTF::_getNextRequest () {
 	auto								minValue {OGSS_REAL_MAX};
-	auto								minIndex {OGSS_REQUESTIDX_UND};
+	auto								minIndex {OGSS_ULONG_MAX};
 	OrderedWaitQueue					* tmp;
 
 	for (auto & elt: _busWaitQueue) {
@@ -421,20 +555,26 @@ SyncDefV4OTF::_getNextRequest () {
 	}
 
 	if (minValue == OGSS_REAL_MAX)
-		return OGSS_REQUESTIDX_UND;
+		return OGSS_ULONG_MAX;
 
 	minIndex = tmp->fetch ();
 
+	if (minIndex == OGSS_ULONG_MAX)
+		return OGSS_ULONG_MAX;
+
 	/*** Event management when the disk will be in idle step ***/
-	if (minIndex._minor && _cntr [minIndex][IDSTEP] == ARRIVL) {
-		if (_userRslt [minIndex][_cntr [minIndex][IDSTEP]] > _busClocks [_cntr [minIndex][IDBUS]]
-			&& ! _evByVolIdx [_userRequests [minIndex] ._idxVolume] .empty ()) {
+	if (_requests [minIndex] ._index._minor && _cntr [IDSTEP][minIndex] == ARRIVL) {
+		const OGSS_Ulong				idxVolume {_requests [minIndex] ._idxVolume};
+		const OGSS_Real					clock {_userRslt [_cntr [IDSTEP][minIndex]][minIndex]};
 
-			for (auto elt: _evByVolIdx [_userRequests [minIndex] ._idxVolume]) {
-				if (_events [elt] ._date >= _userRslt [minIndex][_cntr [minIndex][IDSTEP]]) continue;
+		if (clock > _busClocks [_cntr [IDBUS][minIndex]]
+			&& ! _evByVolIdx [idxVolume] .empty ()) {
+
+			for (auto elt: _evByVolIdx [idxVolume]) {
+				if (_events [elt] ._date >= clock) continue;
 				if (! _eventRequests [elt] .first) continue;
 
-				_processEvent (elt, _userRslt [minIndex][_cntr [minIndex][IDSTEP]]);
+				_processEvent (elt, clock);
 			}
 		}
 	}
@@ -445,140 +585,153 @@ SyncDefV4OTF::_getNextRequest () {
 
 void
 SyncDefV4OTF::_updateRequestClock (
-	const OGSS_Ulong				mainIdx,
+	const OGSS_Ulong				main,
 	const OGSS_Real					clock) {
-	OGSS_RequestIdx				main {mainIdx, 0, 0};
-
-	for (auto elt = _userRslt.find (main); elt != _userRslt.end (); ++elt) {
-		if (elt->first._main != mainIdx) break;
-		if (! _cntr [elt->first][START]) continue;
-		_requestClock [mainIdx] .second = min (_requestClock [mainIdx] .second, elt->second [ARRIVL]);
+	for (auto elt = main; elt < _end [main]; ++elt) {
+		if (! _cntr [START][elt]) continue;
+		_requestClock [main] = min (_requestClock [main], _userRslt [ARRIVL][elt]);
 	}
 }
 
 void
 SyncDefV4OTF::_processToTier (
-	const OGSS_RequestIdx			idx) {
-	Request & r = _userRequests.at (idx);
+	const OGSS_Ulong				row) {
+	Request & r = _requests [row];
 
-	_userRslt [idx][IN] = max (_busClocks [_cntr [idx][IDBUS]], _userRslt [idx][ARRIVL]) + _data [idx][IN];
+	_userRslt [IN][row] = max (_busClocks [_cntr [IDBUS][row]], _userRslt [ARRIVL][row]) + _data [IN][row];
 	r._waitingTime += max (.0,
-		_busClocks [_cntr [idx][IDBUS]] - _userRslt [idx][ARRIVL]);
-	_busClocks [_cntr [idx][IDBUS]] = _userRslt [idx][IN];
-
-	for (auto elt = ++ _userRslt.find (idx); elt != _userRslt.end (); ++elt) {
-		if (elt->first._main != idx._main) break;
-		if (elt->first._minor) continue;
-		elt->second [ARRIVL] = _userRslt [idx][IN];
-		_cntr [elt->first][IDSTEP] = ARRIVL;
-		_cntr [elt->first][START] = true;
-		_busWaitQueue [_VOLM_] .insert (make_pair (elt->first, elt->second [ARRIVL] ) );
+		_busClocks [_cntr [IDBUS][row]] - _userRslt [ARRIVL][row]);
+	_busClocks [_cntr [IDBUS][row]] = _userRslt [IN][row];
+
+	// The intermediate requests are reached by jumping over their children
+	for (auto elt = row + 1; elt < _end [row]; elt = _end [elt]) {
+		_userRslt [ARRIVL][elt] = _userRslt [IN][row];
+		_cntr [IDSTEP][elt] = ARRIVL;
+		_cntr [START][elt] = true;
+		_busWaitQueue [_VOLM_] .insert (make_pair (elt, _userRslt [ARRIVL][elt] ) );
 	}
 
-	_updateRequestClock (idx._main, _userRslt [idx][IN]);
+	_updateRequestClock (row, _userRslt [IN][row]);
 
-	_cntr [idx][IDSTEP] = IN;
-	_cntr [idx][START] = false;
+	_cntr [IDSTEP][row] = IN;
+	_cntr [START][row] = false;
 }
 
 void
 SyncDefV4OTF::_processToVolume (
-	const OGSS_RequestIdx			idx) {
-	Request & r = _userRequests.at (idx);
+	const OGSS_Ulong				row) {
+	Request & r = _requests [row];
 
-	_userRslt [idx][IN] = max (_busClocks [_cntr [idx][IDBUS]], _userRslt [idx][ARRIVL]) + _data [idx][IN];
+	_userRslt [IN][row] = max (_busClocks [_cntr [IDBUS][row]], _userRslt [ARRIVL][row]) + _data [IN][row];
 	r._waitingTime += max (.0,
-		_busClocks [_cntr [idx][IDBUS]] - _userRslt [idx][ARRIVL]);
-	_busClocks [_cntr [idx][IDBUS]] = _userRslt [idx][IN];
+		_busClocks [_cntr [IDBUS][row]] - _userRslt [ARRIVL][row]);
+	_busClocks [_cntr [IDBUS][row]] = _userRslt [IN][row];
 
-	_selectUserRequestOperation (idx, _userRslt [idx][IN]);
+	_selectUserRequestOperation (row, _userRslt [IN][row]);
 
-	for (auto elt = ++ _userRslt.find (idx); elt != _userRslt.end (); ++elt) {
-		if (elt->first._main != idx._main || elt->first._major != idx._major) break;
-		if (_cntr [elt->first][REMOVE]) continue;
-		Request & c = _userRequests.at (elt->first);
+	for (auto elt = row + 1; elt < _end [row]; ++elt) {
+		if (_cntr [REMOVE][elt]) continue;
+		Request & c = _requests [elt];
 		if (c._prio || ! r._numPrioChild) {
-			elt->second [ARRIVL] = _userRslt [idx][IN];
-			_cntr [elt->first][IDSTEP] = ARRIVL;
-			_cntr [elt->first][START] = true;
-			_busWaitQueue [_DVIN_] .insert (make_pair (elt->first, elt->second [ARRIVL] ) );
+			_userRslt [ARRIVL][elt] = _userRslt [IN][row];
+			_cntr [IDSTEP][elt] = ARRIVL;
+			_cntr [START][elt] = true;
+			_busWaitQueue [_DVIN_] .insert (make_pair (elt, _userRslt [ARRIVL][elt] ) );
 		}
 	}
 
-	_updateRequestClock (idx._main, _userRslt [idx][IN]);
+	_updateRequestClock (_parent [row], _userRslt [IN][row]);
 
-	_cntr [idx][IDSTEP] = IN;
-	_cntr [idx][START] = false;
+	_cntr [IDSTEP][row] = IN;
+	_cntr [START][row] = false;
 }
 
 void
 SyncDefV4OTF::_processUserToDevice (
-	const OGSS_RequestIdx			idx) {
-	Request & r = _userRequests.at (idx);
+	const OGSS_Ulong				row) {
+	Request & r = _requests [row];
+
+	_userRslt [IN][row] = max (_busClocks [_cntr [IDBUS][row]], _userRslt [ARRIVL][row]) + _data [IN][row];
+	r._waitingTime += max (.0, _busClocks [_cntr [IDBUS][row]] - _userRslt [ARRIVL][row]);
+	_busClocks [_cntr [IDBUS][row]] = _userRslt [IN][row];
 
-	_userRslt [idx][IN] = max (_busClocks [_cntr [idx][IDBUS]], _userRslt [idx][ARRIVL]) + _data [idx][IN];
-	r._waitingTime += max (.0, _busClocks [_cntr [idx][IDBUS]] - _userRslt [idx][ARRIVL]);
-	_busClocks [_cntr [idx][IDBUS]] = _userRslt [idx][IN];
+	_requestClock [_parent [_parent [row]]] = _userRslt [IN][row];
+	_cntr [IDSTEP][row] = IN;
 
-	_requestClock [idx._main] .second = _userRslt [idx][IN];
+	if (! _dispatch.isNext (r._idxDevice, r._dispatchIdx) ) {
+		_dispatch.park (r._idxDevice, r._dispatchIdx);
+		return;
+	}
 
-	_userRslt [idx][IN] = max (_devClocks [r._idxDevice], _userRslt [idx][IN]) + r._serviceTime;
-	r._waitingTime += max (.0, _devClocks [r._idxDevice] - _busClocks [_cntr [idx][IDBUS]]);
-	_devClocks [r._idxDevice] = _userRslt [idx][IN];
+	_serveUserRequest (row);
+
+	for (auto elt = _dispatch.serve (r._idxDevice, r._dispatchIdx); elt != OGSS_ULONG_MAX;
+		elt = _dispatch.serve (r._idxDevice, _requests [elt] ._dispatchIdx) )
+		_serveUserRequest (elt);
+}
 
-	_busWaitQueue [_DVOT_] .insert (make_pair (idx, _userRslt [idx][IN] ) );
+void
+SyncDefV4OTF::_serveUserRequest (
+	const OGSS_Ulong				row) {
+	Request & r = _requests [row];
+	OGSS_Real						busClock {_userRslt [IN][row]};
+
+	if (! r._cached) {
+		_userRslt [IN][row] = max (_devClocks [r._idxDevice], busClock) + r._serviceTime;
+		r._waitingTime += max (.0, _devClocks [r._idxDevice] - busClock);
+		_devClocks [r._idxDevice] = _userRslt [IN][row];
+	}
 
-	_cntr [idx][IDSTEP] = IN;
+	_busWaitQueue [_DVOT_] .insert (make_pair (row, _userRslt [IN][row] ) );
 }
 
 void
 SyncDefV4OTF::_processUserFromDevice (
-	const OGSS_RequestIdx			idx) {
-	Request & r = _userRequests.at (idx);
+	const OGSS_Ulong				row) {
+	Request & r = _requests [row];
 
 
-	_userRslt [idx][OUT] = max (_busClocks [_cntr [idx][IDBUS]], _userRslt [idx][IN]) + _data [idx][OUT];
+	_userRslt [OUT][row] = max (_busClocks [_cntr [IDBUS][row]], _userRslt [IN][row]) + _data [OUT][row];
 	r._waitingTime += max (.0,
-		_busClocks [_cntr [idx][IDBUS]] - _userRslt [idx][IN]);
-	_busClocks [_cntr [idx][IDBUS]] = _userRslt [idx][OUT];
+		_busClocks [_cntr [IDBUS][row]] - _userRslt [IN][row]);
+	_busClocks [_cntr [IDBUS][row]] = _userRslt [OUT][row];
 
-	OGSS_RequestIdx				parent {idx._main, idx._major, 0};
-	Request							& p = _userRequests.at (parent);
+	OGSS_Ulong						parent {_parent [row]};
+	Request							& p = _requests [parent];
 
 	-- p._numChild;
 
 	if (r._prio) {
 		-- p._numPrioChild;
 
-		for (auto elt = ++ _userRslt.find (parent); elt != _userRslt.end (); ++elt) {
-			if (elt->first._main != idx._main || elt->first._major != idx._major) break;
-			Request & c = _userRequests.at (elt->first);
+		for (auto elt = parent + 1; elt < _end [parent]; ++elt) {
+			Request & c = _requests [elt];
 			if (c._operation != r._operation) continue;
 			if (! c._prio) {
-				elt->second [ARRIVL] = _userRslt [idx][OUT];
-				_cntr [elt->first][IDSTEP] = ARRIVL;
+				_userRslt [ARRIVL][elt] = _userRslt [OUT][row];
+				_cntr [IDSTEP][elt] = ARRIVL;
 				if (! p._numPrioChild) {
-					_cntr [elt->first][START] = true;
-					_busWaitQueue [_DVIN_] .insert (make_pair (elt->first, elt->second [ARRIVL] ) );
+					_cntr [START][elt] = true;
+					_busWaitQueue [_DVIN_] .insert (make_pair (elt, _userRslt [ARRIVL][elt] ) );
 				}
 			}
 		}
 	} else {
-		_userRslt [parent][IN] = _userRslt [idx][OUT];
+		_userRslt [IN][parent] = _userRslt [OUT][row];
 
 		if (! p._numChild) {
-			_cntr [parent][START] = true;
-			_busWaitQueue [_VOLM_] .insert (make_pair (parent, _userRslt [parent][IN] ) );
+			_cntr [START][parent] = true;
+			_busWaitQueue [_VOLM_] .insert (make_pair (parent, _userRslt [IN][parent] ) );
 		}
 	}
 
-	_cntr [idx][IDSTEP] = OUT;
-	_cntr [idx][START] = false;
+	_cntr [IDSTEP][row] = OUT;
+	_cntr [START][row] = false;
 
-	_requestClock [idx._main] .second = _userRslt [idx][OUT];
+	_requestClock [_parent [parent]] = _userRslt [OUT][row];
 
-	sendStat (prepareStat (idx) );
-	_resume.updateStats (prepareStat (idx) );
+	sendStat (prepareStat (row) );
+	_resume.updateStats (prepareStat (row) );
 
 	_manageBlocks (r);
 }
@@ -609,61 +762,54 @@ SyncDefV4OTF::_processSystem (
 
 void
 SyncDefV4OTF::_processFromVolume (
-	const OGSS_RequestIdx			idx) {
-	Request & r = _userRequests.at (idx);
+	const OGSS_Ulong				row) {
+	Request & r = _requests [row];
 
-	_userRslt [idx][OUT] = max (_busClocks [_cntr [idx][IDBUS]], _userRslt [idx][IN]) + _data [idx][OUT];
+	_userRslt [OUT][row] = max (_busClocks [_cntr [IDBUS][row]], _userRslt [IN][row]) + _data [OUT][row];
 	r._waitingTime += max (.0,
-		_busClocks [_cntr [idx][IDBUS]] - _userRslt [idx][IN]);
-	_busClocks [_cntr [idx][IDBUS]] = _userRslt [idx][OUT];
+		_busClocks [_cntr [IDBUS][row]] - _userRslt [IN][row]);
+	_busClocks [_cntr [IDBUS][row]] = _userRslt [OUT][row];
 
-	OGSS_RequestIdx				parent {idx._main, 0, 0};
-	Request							& p = _userRequests.at (parent);
+	OGSS_Ulong						parent {_parent [row]};
+	Request							& p = _requests [parent];
 
 	-- p._numChild;
 
-	_userRslt [parent][IN] = _userRslt [idx][OUT];
+	_userRslt [IN][parent] = _userRslt [OUT][row];
 	if (! p._numChild) {
-		_cntr [parent][START] = true;
-		_busWaitQueue [_TIER_] .insert (make_pair (parent, _userRslt [parent][IN] ) );
+		_cntr [START][parent] = true;
+		_busWaitQueue [_TIER_] .insert (make_pair (parent, _userRslt [IN][parent] ) );
 	}
 
-	_cntr [idx][IDSTEP] = OUT;
-	_cntr [idx][START] = false;
+	_cntr [IDSTEP][row] = OUT;
+	_cntr [START][row] = false;
 
-	sendStat (prepareStat (idx) );
-	_resume.updateStats (prepareStat (idx) );
+	sendStat (prepareStat (row) );
+	_resume.updateStats (prepareStat (row) );
 }
 
 void
 SyncDefV4OTF::_processFromTier (
-	const OGSS_RequestIdx			idx) {
+	const OGSS_Ulong				row) {
 	OGSS_Ulong				printStep {max (_nbMainRequests/100, (OGSS_Ulong) 1) };
-	Request & r = _userRequests.at (idx);
+	Request & r = _requests [row];
 
-	_userRslt [idx][OUT] = max (_busClocks [_cntr [idx][IDBUS]], _userRslt [idx][IN]) + _data [idx][OUT];
+	_userRslt [OUT][row] = max (_busClocks [_cntr [IDBUS][row]], _userRslt [IN][row]) + _data [OUT][row];
 	r._waitingTime += max (.0,
-		_busClocks [_cntr [idx][IDBUS]] - _userRslt [idx][IN]);
-	_busClocks [_cntr [idx][IDBUS]] = _userRslt [idx][OUT];
+		_busClocks [_cntr [IDBUS][row]] - _userRslt [IN][row]);
+	_busClocks [_cntr [IDBUS][row]] = _userRslt [OUT][row];
 
-	_cntr [idx][IDSTEP] = OUT;
-	_cntr [idx][START] = false;
+	_cntr [IDSTEP][row] = OUT;
+	_cntr [START][row] = false;
 
-	if (idx._main == _starter) {
-		int y = _starter;
-		do { if (++y > _nbMainRequests) break;
-		} while (_cntr [OGSS_RequestIdx (y, 0, 0)][IDSTEP] == OUT);
-		_starter = y;
-	}
-
-	r._responseTime = _userRslt [idx][OUT] - r._date;
+	r._responseTime = _userRslt [OUT][row] - r._date;
 
 	if(_nbMainRequestsDone == 0){
 		cout << "\r-\t" << 0 << "% Requests Done [0/" << _nbMainRequests << "]" << flush;
 	}
 
 	++ _nbMainRequestsDone;
-//	DLOG(INFO) << "Request " << idx << " done";
+//	DLOG(INFO) << "Request " << r._index << " done";
 
 	if(!(_nbMainRequestsDone % printStep)){
 		if(printStep == 1){
@@ -675,10 +821,10 @@ SyncDefV4OTF::_processFromTier (
 		}
 	}
 
-	_requestClock [idx._main] .second = OGSS_REAL_MAX;
+	_requestClock [row] = OGSS_REAL_MAX;
 
-	sendStat (prepareStat (idx) );
-	_resume.updateStats (prepareStat (idx) );
+	sendStat (prepareStat (row) );
+	_resume.updateStats (prepareStat (row) );
 }
 
 OGSS_Bool
@@ -868,15 +1014,16 @@ SyncDefV4OTF::_selectSysRequestOperation (
 
 void
 SyncDefV4OTF::_selectUserRequestOperation (
-	const OGSS_RequestIdx				idx,
+	const OGSS_Ulong					row,
 	const OGSS_Real						clock) {
-	auto								jdx {idx};
-	auto								& parent {_userRequests.at (idx)};
+	auto								& parent {_requests [row]};
 
 	if (! parent._multiple) return;
 
-	for (jdx._minor = parent._numChild; jdx._minor > 0; --jdx._minor) {
-		auto							& elt {_userRequests.at (jdx)};
+	for (auto jdx = row + 1; jdx < _end [row]; ++jdx) {
+		auto							& elt {_requests [jdx]};
+		if (elt._index._minor > parent._numChild) continue;
+
 		auto							stp {elt._nativeDeviceAddress / _volumes [elt._idxVolume] ._suSize};
 		auto							idx {elt._nativeIdxDevice};
 
@@ -884,32 +1031,32 @@ SyncDefV4OTF::_selectUserRequestOperation (
 			if (elt._operation == ROP_NATIVE) {
 				if ((_deviceState [idx] .isFailed (clock) && ! _sparedBlocks [idx][stp])
 				 || (_deviceState [idx] .isRenewed (clock) && ! _rebuiltBlocks [idx][stp]))
-					_cntr [jdx][REMOVE] = true;
+					_cntr [REMOVE][jdx] = true;
 			} else if (elt._operation == ROP_RECOVERY) {
 				if ((! _deviceState [idx] .isFailed (clock) && ! _deviceState [idx] .isRenewed (clock))
 				 || _sparedBlocks [idx][stp] || _rebuiltBlocks [idx][stp])
-					_cntr [jdx][REMOVE] = true;
+					_cntr [REMOVE][jdx] = true;
 			} else if (elt._operation == ROP_COPY) {
 				if (! _deviceState [idx] .isRenewed (clock)
 				 || ! _sparedBlocks [idx][stp] || _rebuiltBlocks [idx][stp])
-					_cntr [jdx][REMOVE] = true;
+					_cntr [REMOVE][jdx] = true;
 			} else if (elt._operation == ROP_UPDATE) {
 				if (! _deviceState [idx] .isFailed (clock) || _sparedBlocks [idx][stp])
-					_cntr [jdx][REMOVE] = true;
+					_cntr [REMOVE][jdx] = true;
 			} else if (elt._operation == ROP_RENEW) {
 				if (! _deviceState [idx] .isRenewed (clock) || _rebuiltBlocks [idx][stp])
-					_cntr [jdx][REMOVE] = true;
+					_cntr [REMOVE][jdx] = true;
 			}
 		} else {
 			if (elt._operation == ROP_NATIVE) {
 				if (_deviceState [idx] .isFailed (clock) || _deviceState [idx] .isRenewed (clock) )
-					_cntr [jdx][REMOVE] = true;
+					_cntr [REMOVE][jdx] = true;
 			} else if (elt._operation == ROP_UPDATE) {
 				if (_deviceState [idx] .isRenewed (clock) || ! _deviceState [idx] .isFailed (clock) )
-					_cntr [jdx][REMOVE] = true;
+					_cntr [REMOVE][jdx] = true;
 			} else if (elt._operation == ROP_RENEW) {
 				if (! _deviceState [idx] .isRenewed (clock) )
-					_cntr [jdx][REMOVE] = true;
+					_cntr [REMOVE][jdx] = true;
 			}
 		}
 	}
@@ -0,0 +1,477 @@
+/*
+ * Copyright UVSQ - CEA/DAM/DIF (2017-2018)
+ * Contributors:  Sebastien GOUGEAUD  -- sebastien.gougeaud@uvsq.fr
+ *                Soraya ZERTAL       --      soraya.zertal@uvsq.fr
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+//! \file	syncparallel.cpp
+//! \brief	Definition of the parallel model.
+
+/*----------------------------------------------------------------------------*/
+/* HEADERS -------------------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+#include "synchronization/syncparallel.hpp"
+
+#if USE_STATIC_GLOG
+#include "glog/logging.h"
+#else
+#include <glog/logging.h>
+#endif
+
+using namespace std;
+
+/*----------------------------------------------------------------------------*/
+/* LOCAL FUNCTIONS -----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+//! \brief	Number of heap steps explored to compute the earliest date a
+//!			shard can send a request, before the remaining ones are bounded
+//!			by their own date.
+#define MAX_VISITS		1024
+
+thread_local SyncParallel::shard_t * SyncParallel::_shard {nullptr};
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTIONS ----------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+SyncParallel::SyncParallel (
+	std::shared_ptr <CommunicationInterface>	ci,
+	HardwareParameters		& params,
+	vector <Tier>			& tiers,
+	vector <Volume>			& vols,
+	vector <Device>			& devs,
+	vector <Interface>		& intfs,
+	OGSS_DataUnit			globalDU,
+	OGSS_Ulong				numShards):
+	SyncDefV2 (ci, params, tiers, vols, devs, intfs, globalDU, true),
+	_numShards (numShards) {
+	LOG_IF(FATAL, ! _numShards) << "The parallel synchronization model needs "
+		<< "the number of synchronization shards";
+}
+
+SyncParallel::~SyncParallel () {  }
+
+void
+SyncParallel::process () {
+	_layout (OGSS_ULONG_MAX);
+
+	DLOG(INFO) << "[SC] Nb computations requested: " << _nbComputations;
+
+	if (_partition () )
+		_runShards ();
+	else
+		_run (numeric_limits <double> ::max () );
+
+	LOG_IF(FATAL, _nbComputations)
+		<< "Issue with the SyncParallel model (too much computations requested"
+		<< ": " << _nbComputations << ")";
+}
+
+void
+SyncParallel::advance () {  }
+
+void
+SyncParallel::enableRetirement (
+	const OGSS_String		outputFile) {
+	LOG (WARNING) << "The requests are not retired by the parallel "
+		<< "synchronization model";
+}
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTIONS ---------------------------------------------------------*/
+/*----------------------------------------------------------------------------*/
+
+OGSS_Bool
+SyncParallel::_partition () {
+	OGSS_Ulong				numDevices {_devClocks.size () };
+	OGSS_Ulong				first {numDevices + _busClocks.size () };
+	vector <OGSS_Ulong>		group (first + 1);
+	vector <OGSS_Ulong>		load (first + 1, 0);
+	vector <OGSS_Ulong>		shardOfGroup (first + 1, 0);
+	vector <OGSS_Ulong>		order;
+
+	// The devices are the first nodes, then the interfaces, then the first
+	// shard
+	iota (group.begin (), group.end (), 0);
+
+	auto find = [&] (OGSS_Ulong elt) {
+		while (group [elt] != elt) elt = group [elt] = group [group [elt] ];
+		return elt;
+	};
+	auto merge = [&] (OGSS_Ulong a, OGSS_Ulong b)
+		{ group [find (a)] = find (b); };
+
+	for (auto & path: _paths) {
+		merge (numDevices + path._hostInterface, first);
+		merge (numDevices + path._tierInterface, first);
+	}
+
+	_lookDown = _lookUp = numeric_limits <double> ::infinity ();
+
+	for (OGSS_Ulong row = 0; row < _index.size (); ++row) {
+		const index_t		& idx = _index [row];
+
+		// The requests which go from a tier interface to a volume interface
+		if (! get<2> (idx) && (get<1> (idx) || ! _cntr [NBCHLD][row]) )
+			_lookDown = min (_lookDown, _data [TO_VOL][row]);
+
+		if (_cntr [NBCHLD][row]) continue;
+
+		OGSS_Ulong			device = _cntr [IDDEVC][row];
+
+		_lookUp = min (_lookUp, _data [FM_DEV][row]);
+		++ load [device];
+
+		merge (device, numDevices + _cntr [IDBUSD][row]);
+		if (get<2> (idx) )
+			merge (device, _cntr [IDDEVC][_parent [row] + 1]);
+	}
+
+	for (OGSS_Ulong device = 0; device < numDevices; ++device)
+		if (find (device) != device) load [find (device)] += load [device];
+
+	for (OGSS_Ulong elt = 0; elt < first; ++elt)
+		if (find (elt) == elt && load [elt] && find (elt) != find (first) )
+			order.push_back (elt);
+
+	OGSS_Ulong				numShards {min <OGSS_Ulong> (_numShards, order.size () + 1)};
+
+	DLOG(INFO) << "[SC] " << numShards << " synchronization shard(s) for "
+		<< order.size () << " device group(s)";
+
+	if (numShards < 2) return false;
+
+	// Each group goes to the least loaded shard, the largest first
+	vector <OGSS_Ulong>		shardLoad (numShards, 0);
+
+	stable_sort (order.begin (), order.end (),
+		[&] (OGSS_Ulong a, OGSS_Ulong b) { return load [a] > load [b]; } );
+
+	for (auto elt: order) {
+		OGSS_Ulong			shard = min_element (shardLoad.begin () + 1,
+			shardLoad.end () ) - shardLoad.begin ();
+
+		shardOfGroup [elt] = shard;
+		shardLoad [shard] += load [elt];
+	}
+
+	_shardOf.resize (numDevices);
+	for (OGSS_Ulong device = 0; device < numDevices; ++device)
+		_shardOf [device] = shardOfGroup [find (device)];
+
+	_shards.resize (numShards);
+
+	return true;
+}
+
+void
+SyncParallel::_runShards () {
+	vector <thread>			threads;
+
+	const stamp_t			origin {{- numeric_limits <double> ::max (), 0}, 0};
+
+	_stamps.assign (_index.size (), origin);
+
+	// Each shard counts down from the whole number of computations, and
+	// only its own steps are removed from it
+	for (auto & shard: _shards) {
+		shard._stamp = origin;
+		shard._nbComputations = _nbComputations;
+	}
+
+	// The logical requests start on the first shard
+	_shards [0] ._steps.swap (_steps);
+	for (auto & shard: _shards)
+		shard._output = _earliestOutput (shard);
+
+	for (OGSS_Ulong idx = 1; idx < _shards.size (); ++idx)
+		threads.emplace_back (&SyncParallel::_work, this, idx);
+
+	while (_exchange () ) {
+		{
+			lock_guard <mutex>	lock (_roundLock);
+			_running = _shards.size () - 1;
+			++ _round;
+		}
+		_roundStart.notify_all ();
+
+		_runRound (_shards [0]);
+
+		unique_lock <mutex>		lock (_roundLock);
+		_roundEnd.wait (lock, [&] { return ! _running; } );
+	}
+
+	{
+		lock_guard <mutex>		lock (_roundLock);
+		_done = true;
+		++ _round;
+	}
+	_roundStart.notify_all ();
+
+	for (auto & elt: threads) elt.join ();
+
+	_shard = nullptr;
+
+	const OGSS_Ulong		total {_nbComputations};
+
+	for (auto & shard: _shards)
+		_nbComputations -= total - shard._nbComputations;
+}
+
+void
+SyncParallel::_work (
+	const OGSS_Ulong		idx) {
+	OGSS_Ulong				round {0};
+
+	while (true) {
+		{
+			unique_lock <mutex>	lock (_roundLock);
+			_roundStart.wait (lock, [&] { return _round != round; } );
+			++ round;
+
+			if (_done) return;
+		}
+
+		_runRound (_shards [idx]);
+
+		{
+			lock_guard <mutex>	lock (_roundLock);
+			if (-- _running) continue;
+		}
+		_roundEnd.notify_one ();
+	}
+}
+
+void
+SyncParallel::_runRound (
+	shard_t					& shard) {
+	_shard = &shard;
+
+	for (auto & msg: shard._inbox) {
+		_stamps [msg._row] = {msg._stamp._step, msg._stamp._hops + 1};
+		_schedule (shard._steps, msg._row);
+	}
+	shard._inbox.clear ();
+
+	// A step before the horizon can not be preceded by a request of the
+	// other shards. A step is done after the latest one which led to it, so
+	// its stat is sent after theirs.
+	while (! shard._steps.empty ()
+		&& (shard._forced || shard._steps.front () ._date < shard._horizon) ) {
+		const step_t		step {shard._steps.front () };
+
+		if (_precedes (shard._stamp, {step, 0}) ) shard._stamp = {step, 0};
+		if (_precedes (shard._stamp, _stamps [step._row]) )
+			shard._stamp = _stamps [step._row];
+
+		shard._forced = false;
+		_step (step._row, shard._nbComputations);
+	}
+
+	shard._forced = false;
+	shard._output = _earliestOutput (shard);
+}
+
+OGSS_Bool
+SyncParallel::_exchange () {
+	const double			inf {numeric_limits <double> ::infinity () };
+	step_t					next {inf, OGSS_ULONG_MAX};
+	shard_t					* forced {nullptr};
+	double					up {inf};
+
+	for (auto & shard: _shards) {
+		for (auto & msg: shard._outbox)
+			_shards [msg._shard] ._inbox.push_back (msg);
+		shard._outbox.clear ();
+	}
+
+	for (OGSS_Ulong idx = 0; idx < _shards.size (); ++idx) {
+		auto				& shard = _shards [idx];
+		step_t				top {shard._steps.empty ()
+			? step_t {inf, OGSS_ULONG_MAX} : shard._steps.front () };
+
+		for (auto & msg: shard._inbox) {
+			step_t			step {_rslt [_cntr [IDSTEP][msg._row] ][msg._row],
+				msg._row};
+
+			if (_before (step, top) ) top = step;
+			shard._output = min (shard._output, _outputDate (msg._row, ! idx) );
+		}
+
+		shard._next = top._date;
+		if (_before (top, next) ) { next = top; forced = &shard; }
+		if (idx) up = min (up, shard._output);
+	}
+
+	// The stats before the next step of each shard can not be preceded
+	// anymore
+	const double			down {_shards [0] ._output};
+	stamp_t					limit {{inf, OGSS_ULONG_MAX}, 0};
+
+	for (OGSS_Ulong idx = 0; idx < _shards.size (); ++idx) {
+		auto				& shard = _shards [idx];
+		stamp_t				stamp {{min (shard._next, idx ? down : min (up, down) ), 0}, 0};
+
+		if (_precedes (stamp, shard._stamp) ) stamp = shard._stamp;
+		if (_precedes (stamp, limit) ) limit = stamp;
+	}
+
+	_flushStats (limit);
+
+	if (! forced) return false;
+
+	// The first shard waits for the requests going up from the devices,
+	// including the ones it sends down during the round, and the other ones
+	// for the requests going down from the tiers. The earliest step is always
+	// done, so a round is never empty.
+	for (auto & shard: _shards) shard._horizon = down;
+	_shards [0] ._horizon = min (up, down + _lookUp);
+	forced->_forced = true;
+
+	return true;
+}
+
+void
+SyncParallel::_flushStats (
+	const stamp_t			& limit) {
+	while (true) {
+		shard_t				* first {nullptr};
+
+		for (auto & shard: _shards)
+			if (! shard._stats.empty () && _precedes (shard._stats.front () ._stamp,
+				first ? first->_stats.front () ._stamp : limit) )
+				first = &shard;
+
+		if (! first) return;
+
+		sendStat (first->_stats.front () ._stat);
+		_resume.updateStats (first->_stats.front () ._stat);
+		first->_stats.pop_front ();
+	}
+}
+
+double
+SyncParallel::_earliestOutput (
+	shard_t					& shard) {
+	const OGSS_Bool			down {&shard == &_shards [0] };
+	const double			look {down ? _lookDown : _lookUp};
+	const auto				& steps = shard._steps;
+	auto					& visit = shard._visit;
+	double					date {numeric_limits <double> ::infinity () };
+	OGSS_Ulong				budget {MAX_VISITS};
+
+	if (! steps.empty () ) visit.push_back (0);
+
+	// The steps after a heap step are not earlier, so its subtree is skipped
+	// once it can not lead to an earlier date
+	while (! visit.empty () ) {
+		OGSS_Ulong			pos {visit.back () };
+
+		visit.pop_back ();
+
+		if (steps [pos] ._date + look >= date) continue;
+		if (! budget) { date = steps [pos] ._date + look; continue; }
+		-- budget;
+
+		date = min (date, _outputDate (steps [pos] ._row, down) );
+
+		for (OGSS_Ulong child = 2 * pos + 1;
+			child < min <OGSS_Ulong> (2 * pos + 3, steps.size () ); ++child)
+			visit.push_back (child);
+	}
+
+	// A parked request is released by a service on its device, so it is
+	// served after its transfer to the device
+	for (OGSS_Ulong device = 0; ! down && device < _shardOf.size (); ++device) {
+		if (&_shards [_shardOf [device] ] != &shard
+			|| ! _dispatch._numParked [device]) continue;
+
+		for (auto & elt: _dispatch._queued [device]) {
+			OGSS_Ulong		row {elt.second._row};
+
+			if (elt.second._parked)
+				date = min (date, _rslt [TO_DEV][row] + _data [SERVCE][row]
+					+ _data [FM_DEV][row]);
+		}
+	}
+
+	return date;
+}
+
+double
+SyncParallel::_outputDate (
+	const OGSS_Ulong		row,
+	const OGSS_Bool			down) {
+	auto					step {_cntr [IDSTEP][row]};
+
+	// The sums are done in the order of the steps, so that the bound is not
+	// rounded above the date of the step
+	if (down && step == ARRIVL)
+		return _rslt [ARRIVL][row] + _data [TO_TIR][row] + _lookDown;
+	if (down && step == TO_TIR)
+		return _rslt [TO_TIR][row] + _data [TO_VOL][row];
+	if (! down && step == TO_VOL)
+		return _rslt [TO_VOL][row] + _data [TO_DEV][row]
+			+ (_failedReqs [row] || _cachedReqs [row] ? .0 : _data [SERVCE][row])
+			+ _data [FM_DEV][row];
+	if (! down && step == SERVCE)
+		return max (_rslt [TO_DEV][row], _rslt [SERVCE][row])
+			+ _data [FM_DEV][row];
+
+	return numeric_limits <double> ::infinity ();
+}
+
+void
+SyncParallel::_schedule (
+	const OGSS_Ulong		row) {
+	if (! _shard) { _schedule (_steps, row); return; }
+
+	auto					step {_cntr [IDSTEP][row]};
+	shard_t					* target {_shard};
+
+	// The devices and the volume interfaces are used from the step after the
+	// transfer to the volume, up to the service
+	if (step == TO_VOL || step == SERVCE)
+		target = &_shards [_shardOf [_cntr [IDDEVC][row] ] ];
+	else if (step != FM_TIR && step != UND)
+		target = &_shards [0];
+
+	if (target == _shard) {
+		_schedule (_shard->_steps, row);
+		return;
+	}
+
+	_unschedule (_shard->_steps, row);
+	_shard->_outbox.push_back ({row,
+		static_cast <OGSS_Ulong> (target - &_shards [0]), _shard->_stamp} );
+}
+
+void
+SyncParallel::_emitStat (
+	const OGSS_Ulong		row) {
+	if (! _shard) { SyncDefV2::_emitStat (row); return; }
+
+	_shard->_stats.push_back ({_shard->_stamp, prepareStat (row)} );
+}
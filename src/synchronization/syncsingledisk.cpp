@@ -121,6 +121,23 @@ SyncSingleDisk::process () {
 
 	sort (_reqs.begin (), _reqs.end (), requestSort);
 
+	// The disk serves the requests of its command queue in their dispatch
+	// order, in the places they take in the arrival order
+	vector <OGSS_Ulong>		slots;
+	vector <Request>		queued;
+
+	for (OGSS_Ulong i = 0; i < _reqs.size (); ++i)
+		if (_reqs [i] ._dispatchIdx != OGSS_ULONG_MAX) {
+			slots.push_back (i);
+			queued.push_back (_reqs [i]);
+		}
+
+	sort (queued.begin (), queued.end (), [] (const Request & a, const Request & b)
+		{ return a._dispatchIdx < b._dispatchIdx; } );
+
+	for (OGSS_Ulong i = 0; i < slots.size (); ++i)
+		_reqs [slots [i] ] = queued [i];
+
 	for (auto & e: _reqs) {
 		busClock = .0;
 		e._transferTimeA1 = e._transferTimeA2
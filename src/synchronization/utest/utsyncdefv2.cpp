@@ -1,35 +1,120 @@
 #include <cmath>
 
-UT_SyncDefV2::UT_SyncDefV2 (
-	const OGSS_String		& configurationFile):
-	UnitaryTest <UT_SyncDefV2> (MTP_SYNCDEFV2) {
-	_tests.push_back (make_pair ("1 request",
-		&UT_SyncDefV2::oneRequest) );
-	_tests.push_back (make_pair ("2 requests",
-		&UT_SyncDefV2::twoRequests) );
-	_tests.push_back (make_pair ("2 requests -- small lambda",
-		&UT_SyncDefV2::twoRequests_smallLambda) );
-	_tests.push_back (make_pair ("2 requests -- huge lambda",
-		&UT_SyncDefV2::twoRequests_hugeLambda) );
-	_tests.push_back (make_pair ("2 requests -- 2 volumes",
-		&UT_SyncDefV2::twoRequests_twoVolumes) );
-	_tests.push_back (make_pair ("3 requests -- in RAIDNP",
-		&UT_SyncDefV2::threeRequests_RAIDNP) );
-/*	_tests.push_back (make_pair ("4 requests -- user/system",
-		&UT_SyncDefV2::multiRequests_system) );
-	_tests.push_back (make_pair ("2 requests before failure recovery",
-		&UT_SyncDefV2::failure2ReqBRecovery) );
-	_tests.push_back (make_pair ("2 requests after failure recovery",
-		&UT_SyncDefV2::failure2ReqARecovery) );
-	_tests.push_back (make_pair ("2 requests after renewal before failure recovery",
-		&UT_SyncDefV2::renewal2ReqBRecovery) );
-	_tests.push_back (make_pair ("2 requests after renewal after failure recovery",
-		&UT_SyncDefV2::renewal2ReqARecovery) );
-	_tests.push_back (make_pair ("2 requests after renewal after renewal copy",
-		&UT_SyncDefV2::renewal2ReqACopy) );
-*/}
-
-UT_SyncDefV2::~UT_SyncDefV2 () {  }
+//! \brief	Communication interface which keeps the indexes and the waiting
+//!			times of the sent stats.
+class UT_SyncDefV2Interface:
+public CommunicationInterface {
+public:
+	OGSS_Bool request (const OGSS_Interlocutor to) { return true; }
+	void requestBarrier () {  }
+	void requestFullBarrier () {  }
+	void releaseBarrier (const OGSS_Ushort numThreads) {  }
+	void receive (void * & arg) { arg = nullptr; }
+
+	void send (
+		const OGSS_Interlocutor	to,
+		const void				* arg,
+		const size_t			size,
+		const OGSS_Bool			multi = false) {
+		auto					stat = static_cast <const RequestStat *> (arg);
+
+		_sent.push_back (make_tuple (stat->_mainIdx, stat->_majrIdx,
+			stat->_minrIdx) );
+		_waits.push_back (stat->_waitingTime);
+	}
+
+	vector <tuple <OGSS_Ulong, OGSS_Ulong, OGSS_Ulong>>
+								_sent;				//!< Indexes of the sent stats.
+	vector <OGSS_Real>			_waits;				//!< Waiting times of the sent stats.
+};
+
+OGSS_Ulong
+UT_SyncDefV2::findRow (
+	SyncDefV2				& sync,
+	const OGSS_Ulong		mainIdx,
+	const OGSS_Ulong		majrIdx,
+	const OGSS_Ulong		minrIdx) {
+	return find (sync._index.begin (), sync._index.end (),
+		make_tuple (mainIdx, majrIdx, minrIdx) ) - sync._index.begin ();
+}
+
+Request
+UT_SyncDefV2::createRequest (
+	const OGSS_Real			date,
+	const OGSS_Ulong		mainIdx,
+	const OGSS_Ulong		majrIdx,
+	const OGSS_Ulong		minrIdx,
+	const OGSS_Ulong		numChild,
+	const OGSS_Ulong		device) {
+	Request					req {date, 8, 0, RQT_WRITE};
+
+	req._mainIdx = mainIdx;		req._majrIdx = majrIdx;		req._minrIdx = minrIdx;
+	req._numChild = numChild;	req._numPrioChild = 0;
+	req._idxDevice = device;	req._idxVolume = device / 2;
+
+	// The times change from one request to the other, so that they compete
+	// for the interfaces and the devices
+	req._transferTimeA1 = req._transferTimeB1 = .1 * (1 + mainIdx % 3);
+	req._transferTimeA2 = req._transferTimeB2 = .2 * (1 + majrIdx);
+	req._transferTimeA3 = req._transferTimeB3 = .3 * minrIdx;
+	req._serviceTime = 1. + (7 * mainIdx + 3 * minrIdx) % 5;
+
+	return req;
+}
+
+OGSS_Bool
+UT_SyncDefV2::compareOnline (
+	const vector <Request>	& requests,
+	const OGSS_Bool			retire,
+	const OGSS_Bool			heapOrder) {
+	HardwareParameters		hp;
+		hp._numInterfaces = 4; hp._numTiers = 1; hp._numVolumes = 2;
+		hp._numDevices = 4; hp._hostInterface = 0;
+	vector <Tier>			vT;
+		vT.push_back (Tier () ); vT.back () ._interface = 1;
+	vector <Volume>			vV;
+		vV.push_back (Volume () ); vV.back () ._interface = 2; vV.back () ._parent = 0;
+		vV.push_back (Volume () ); vV.back () ._interface = 3; vV.back () ._parent = 0;
+	vector <Device>			vD (hp._numDevices);
+		for (OGSS_Ulong i = 0; i < vD.size (); ++i) vD [i] ._parent = i / 2;
+	vector <Interface>		vI (hp._numInterfaces);
+
+	auto					batchCI = make_shared <UT_SyncDefV2Interface> ();
+	auto					onlineCI = make_shared <UT_SyncDefV2Interface> ();
+	SyncDefV2				batch (batchCI, hp, vT, vV, vD, vI, OGSS_DataUnit (),
+		heapOrder);
+	SyncDefV2				online (onlineCI, hp, vT, vV, vD, vI, OGSS_DataUnit (),
+		heapOrder);
+	OGSS_Ulong				numSent, numRows {0};
+
+	if (retire) online.enableRetirement ("");
+
+	for (auto & elt: requests) {
+		Request				b {elt}, o {elt};
+
+		batch.addEntry (b);
+		online.addEntry (o);
+		online.advance ();
+		numRows = max (numRows, online._index.size () );
+	}
+
+	numSent = onlineCI->_sent.size ();
+
+	batch.process ();
+	online.process ();
+
+	// Some requests are done during the reception, and the results are the
+	// same as in the batch mode
+	if (! numSent || numSent == onlineCI->_sent.size ()
+		|| onlineCI->_sent != batchCI->_sent || onlineCI->_waits != batchCI->_waits)
+		return false;
+
+	// Only the requests in flight and the last written ones are kept
+	if (retire)
+		return online._numRetired && numRows <= 2 * SyncDefV2::_kDrop;
+
+	return online._rslt == batch._rslt;
+}
 
 OGSS_Bool
 UT_SyncDefV2::oneRequest () {
@@ -43,7 +128,10 @@ UT_SyncDefV2::oneRequest () {
 	vector <Device>			vD;
 		vD.push_back (Device () ); vD.front () ._parent = 0;
 
-	SyncDefV2				sync (nullptr, hp, vT, vV, vD);
+	vector <Interface>		vI (hp._numInterfaces);
+
+	SyncDefV2				sync (make_shared <UT_SyncDefV2Interface> (),
+		hp, vT, vV, vD, vI, OGSS_DataUnit () );
 	Request					r {5.};
 
 	r._serviceTime = 10.; r._idxVolume = 0; r._idxDevice = 0;
@@ -60,11 +148,11 @@ UT_SyncDefV2::oneRequest () {
 
 	sync.process ();
 
-	if (fabs (sync._rslt [make_tuple (1, 0, 0)][SyncDefV2::FM_TIR]
-		    - sync._rslt [make_tuple (1, 0, 0)][SyncDefV2::ARRIVL]
-		    -(sync._data [make_tuple (1, 0, 0)][SyncDefV2::FM_TIR]
-		    + sync._data [make_tuple (1, 0, 0)][SyncDefV2::TO_TIR])
-		- 17.2)	< numeric_limits <float> ::epsilon () )
+	if (fabs (sync._rslt [SyncDefV2::FM_TIR][findRow (sync, 1, 0, 0)]
+		    - sync._rslt [SyncDefV2::ARRIVL][findRow (sync, 1, 0, 0)]
+		    -(sync._data [SyncDefV2::FM_TIR][findRow (sync, 1, 0, 0)]
+		    + sync._data [SyncDefV2::TO_TIR][findRow (sync, 1, 0, 0)])
+		- 17.)	< numeric_limits <float> ::epsilon () )
 		return true;
 
 	return false;
@@ -82,7 +170,10 @@ UT_SyncDefV2::twoRequests () {
 	vector <Device>			vD;
 		vD.push_back (Device () ); vD.front () ._parent = 0;
 
-	SyncDefV2				sync (nullptr, hp, vT, vV, vD);
+	vector <Interface>		vI (hp._numInterfaces);
+
+	SyncDefV2				sync (make_shared <UT_SyncDefV2Interface> (),
+		hp, vT, vV, vD, vI, OGSS_DataUnit () );
 	Request					r {5.};
 
 	r._serviceTime = 10.; r._idxVolume = 0; r._idxDevice = 0;
@@ -104,16 +195,16 @@ UT_SyncDefV2::twoRequests () {
 
 	sync.process ();
 
-	if (fabs (sync._rslt [make_tuple (1, 0, 0)][SyncDefV2::FM_TIR]
-		    - sync._rslt [make_tuple (1, 0, 0)][SyncDefV2::ARRIVL]
-		    -(sync._data [make_tuple (1, 0, 0)][SyncDefV2::FM_TIR]
-		    + sync._data [make_tuple (1, 0, 0)][SyncDefV2::TO_TIR])
-		- 17.2)	< numeric_limits <float> ::epsilon ()
-	 && fabs (sync._rslt [make_tuple (2, 0, 0)][SyncDefV2::FM_TIR]
-		    - sync._rslt [make_tuple (2, 0, 0)][SyncDefV2::ARRIVL]
-		    -(sync._data [make_tuple (2, 0, 0)][SyncDefV2::FM_TIR]
-		    + sync._data [make_tuple (2, 0, 0)][SyncDefV2::TO_TIR])
-		- 17.2)	< numeric_limits <float> ::epsilon ())
+	if (fabs (sync._rslt [SyncDefV2::FM_TIR][findRow (sync, 1, 0, 0)]
+		    - sync._rslt [SyncDefV2::ARRIVL][findRow (sync, 1, 0, 0)]
+		    -(sync._data [SyncDefV2::FM_TIR][findRow (sync, 1, 0, 0)]
+		    + sync._data [SyncDefV2::TO_TIR][findRow (sync, 1, 0, 0)])
+		- 17.)	< numeric_limits <float> ::epsilon ()
+	 && fabs (sync._rslt [SyncDefV2::FM_TIR][findRow (sync, 2, 0, 0)]
+		    - sync._rslt [SyncDefV2::ARRIVL][findRow (sync, 2, 0, 0)]
+		    -(sync._data [SyncDefV2::FM_TIR][findRow (sync, 2, 0, 0)]
+		    + sync._data [SyncDefV2::TO_TIR][findRow (sync, 2, 0, 0)])
+		- 17.)	< numeric_limits <float> ::epsilon ())
 		return true;
 
 	return false;
@@ -131,7 +222,10 @@ UT_SyncDefV2::twoRequests_smallLambda () {
 	vector <Device>			vD;
 		vD.push_back (Device () ); vD.front () ._parent = 0;
 
-	SyncDefV2				sync (nullptr, hp, vT, vV, vD);
+	vector <Interface>		vI (hp._numInterfaces);
+
+	SyncDefV2				sync (make_shared <UT_SyncDefV2Interface> (),
+		hp, vT, vV, vD, vI, OGSS_DataUnit () );
 	Request					r {5.};
 
 	r._serviceTime = 10.; r._idxVolume = 0; r._idxDevice = 0;
@@ -153,16 +247,16 @@ UT_SyncDefV2::twoRequests_smallLambda () {
 
 	sync.process ();
 
-	if (fabs (sync._rslt [make_tuple (1, 0, 0)][SyncDefV2::FM_TIR]
-		    - sync._rslt [make_tuple (1, 0, 0)][SyncDefV2::ARRIVL]
-		    -(sync._data [make_tuple (1, 0, 0)][SyncDefV2::FM_TIR]
-		    + sync._data [make_tuple (1, 0, 0)][SyncDefV2::TO_TIR])
-		- 17.2)	< numeric_limits <float> ::epsilon ()
-	 && fabs (sync._rslt [make_tuple (2, 0, 0)][SyncDefV2::FM_TIR]
-		    - sync._rslt [make_tuple (2, 0, 0)][SyncDefV2::ARRIVL]
-		    -(sync._data [make_tuple (2, 0, 0)][SyncDefV2::FM_TIR]
-		    + sync._data [make_tuple (2, 0, 0)][SyncDefV2::TO_TIR])
-		- 22.2)	< numeric_limits <float> ::epsilon ())
+	if (fabs (sync._rslt [SyncDefV2::FM_TIR][findRow (sync, 1, 0, 0)]
+		    - sync._rslt [SyncDefV2::ARRIVL][findRow (sync, 1, 0, 0)]
+		    -(sync._data [SyncDefV2::FM_TIR][findRow (sync, 1, 0, 0)]
+		    + sync._data [SyncDefV2::TO_TIR][findRow (sync, 1, 0, 0)])
+		- 17.)	< numeric_limits <float> ::epsilon ()
+	 && fabs (sync._rslt [SyncDefV2::FM_TIR][findRow (sync, 2, 0, 0)]
+		    - sync._rslt [SyncDefV2::ARRIVL][findRow (sync, 2, 0, 0)]
+		    -(sync._data [SyncDefV2::FM_TIR][findRow (sync, 2, 0, 0)]
+		    + sync._data [SyncDefV2::TO_TIR][findRow (sync, 2, 0, 0)])
+		- 22.)	< numeric_limits <float> ::epsilon ())
 		return true;
 
 	return false;
@@ -180,7 +274,10 @@ UT_SyncDefV2::twoRequests_hugeLambda () {
 	vector <Device>			vD;
 		vD.push_back (Device () ); vD.front () ._parent = 0;
 
-	SyncDefV2				sync (nullptr, hp, vT, vV, vD);
+	vector <Interface>		vI (hp._numInterfaces);
+
+	SyncDefV2				sync (make_shared <UT_SyncDefV2Interface> (),
+		hp, vT, vV, vD, vI, OGSS_DataUnit () );
 	Request					r {5.};
 
 	r._serviceTime = 10.; r._idxVolume = 0; r._idxDevice = 0;
@@ -202,16 +299,16 @@ UT_SyncDefV2::twoRequests_hugeLambda () {
 
 	sync.process ();
 
-	if (fabs (sync._rslt [make_tuple (1, 0, 0)][SyncDefV2::FM_TIR]
-		    - sync._rslt [make_tuple (1, 0, 0)][SyncDefV2::ARRIVL]
-		    -(sync._data [make_tuple (1, 0, 0)][SyncDefV2::FM_TIR]
-		    + sync._data [make_tuple (1, 0, 0)][SyncDefV2::TO_TIR])
-		- 17.2)	< numeric_limits <float> ::epsilon ()
-	 && fabs (sync._rslt [make_tuple (2, 0, 0)][SyncDefV2::FM_TIR]
-		    - sync._rslt [make_tuple (2, 0, 0)][SyncDefV2::ARRIVL]
-		    -(sync._data [make_tuple (2, 0, 0)][SyncDefV2::FM_TIR]
-		    + sync._data [make_tuple (2, 0, 0)][SyncDefV2::TO_TIR])
-		- 27.15) < numeric_limits <float> ::epsilon ())
+	if (fabs (sync._rslt [SyncDefV2::FM_TIR][findRow (sync, 1, 0, 0)]
+		    - sync._rslt [SyncDefV2::ARRIVL][findRow (sync, 1, 0, 0)]
+		    -(sync._data [SyncDefV2::FM_TIR][findRow (sync, 1, 0, 0)]
+		    + sync._data [SyncDefV2::TO_TIR][findRow (sync, 1, 0, 0)])
+		- 17.)	< numeric_limits <float> ::epsilon ()
+	 && fabs (sync._rslt [SyncDefV2::FM_TIR][findRow (sync, 2, 0, 0)]
+		    - sync._rslt [SyncDefV2::ARRIVL][findRow (sync, 2, 0, 0)]
+		    -(sync._data [SyncDefV2::FM_TIR][findRow (sync, 2, 0, 0)]
+		    + sync._data [SyncDefV2::TO_TIR][findRow (sync, 2, 0, 0)])
+		- 26.95) < numeric_limits <float> ::epsilon ())
 		return true;
 
 	return false;
@@ -231,7 +328,10 @@ UT_SyncDefV2::twoRequests_twoVolumes () {
 		vD.push_back (Device () ); vD.back () ._parent = 0;
 		vD.push_back (Device () ); vD.back () ._parent = 1;
 
-	SyncDefV2				sync (nullptr, hp, vT, vV, vD);
+	vector <Interface>		vI (hp._numInterfaces);
+
+	SyncDefV2				sync (make_shared <UT_SyncDefV2Interface> (),
+		hp, vT, vV, vD, vI, OGSS_DataUnit () );
 	Request					r {5.};
 
 	r._serviceTime = 10.; r._idxVolume = 0; r._idxDevice = 0;
@@ -254,16 +354,16 @@ UT_SyncDefV2::twoRequests_twoVolumes () {
 
 	sync.process ();
 
-	if (fabs (sync._rslt [make_tuple (1, 0, 0)][SyncDefV2::FM_TIR]
-		    - sync._rslt [make_tuple (1, 0, 0)][SyncDefV2::ARRIVL]
-		    -(sync._data [make_tuple (1, 0, 0)][SyncDefV2::FM_TIR]
-		    + sync._data [make_tuple (1, 0, 0)][SyncDefV2::TO_TIR])
-		- 17.4)	< numeric_limits <float> ::epsilon ()
-	 && fabs (sync._rslt [make_tuple (2, 0, 0)][SyncDefV2::FM_TIR]
-		    - sync._rslt [make_tuple (2, 0, 0)][SyncDefV2::ARRIVL]
-		    -(sync._data [make_tuple (2, 0, 0)][SyncDefV2::FM_TIR]
-		    + sync._data [make_tuple (2, 0, 0)][SyncDefV2::TO_TIR])
-		- 17.85) < numeric_limits <float> ::epsilon ())
+	if (fabs (sync._rslt [SyncDefV2::FM_TIR][findRow (sync, 1, 0, 0)]
+		    - sync._rslt [SyncDefV2::ARRIVL][findRow (sync, 1, 0, 0)]
+		    -(sync._data [SyncDefV2::FM_TIR][findRow (sync, 1, 0, 0)]
+		    + sync._data [SyncDefV2::TO_TIR][findRow (sync, 1, 0, 0)])
+		- 17.)	< numeric_limits <float> ::epsilon ()
+	 && fabs (sync._rslt [SyncDefV2::FM_TIR][findRow (sync, 2, 0, 0)]
+		    - sync._rslt [SyncDefV2::ARRIVL][findRow (sync, 2, 0, 0)]
+		    -(sync._data [SyncDefV2::FM_TIR][findRow (sync, 2, 0, 0)]
+		    + sync._data [SyncDefV2::TO_TIR][findRow (sync, 2, 0, 0)])
+		- 17.45) < numeric_limits <float> ::epsilon ())
 		return true;
 
 	return false;
@@ -283,7 +383,10 @@ UT_SyncDefV2::threeRequests_RAIDNP () {
 		vD.push_back (Device () ); vD.back () ._parent = 0;
 		vD.push_back (Device () ); vD.back () ._parent = 0;
 
-	SyncDefV2				sync (nullptr, hp, vT, vV, vD);
+	vector <Interface>		vI (hp._numInterfaces);
+
+	SyncDefV2				sync (make_shared <UT_SyncDefV2Interface> (),
+		hp, vT, vV, vD, vI, OGSS_DataUnit () );
 	Request					r {5.};
 
 	r._serviceTime = 10.; r._idxVolume = 0; r._idxDevice = 0;
@@ -304,15 +407,278 @@ UT_SyncDefV2::threeRequests_RAIDNP () {
 
 	sync.process ();
 
-	if (fabs (sync._rslt [make_tuple (1, 0, 0)][SyncDefV2::FM_TIR]
-		    - sync._rslt [make_tuple (1, 0, 0)][SyncDefV2::ARRIVL]
-		    -(sync._data [make_tuple (1, 0, 0)][SyncDefV2::FM_TIR]
-		    + sync._data [make_tuple (1, 0, 0)][SyncDefV2::TO_TIR])
-		- 43.2)	< numeric_limits <float> ::epsilon ())
+	if (fabs (sync._rslt [SyncDefV2::FM_TIR][findRow (sync, 1, 0, 0)]
+		    - sync._rslt [SyncDefV2::ARRIVL][findRow (sync, 1, 0, 0)]
+		    -(sync._data [SyncDefV2::FM_TIR][findRow (sync, 1, 0, 0)]
+		    + sync._data [SyncDefV2::TO_TIR][findRow (sync, 1, 0, 0)])
+		- 43.)	< numeric_limits <float> ::epsilon ())
 		return true;
 
 	return false;
 }
+OGSS_Bool
+UT_SyncDefV2::scanOrder () {
+	HardwareParameters		hp;
+		hp._numInterfaces = 3; hp._numTiers = 1; hp._numVolumes = 1;
+		hp._numDevices = 2; hp._hostInterface = 0;
+	vector <Tier>			vT;
+		vT.push_back (Tier () ); vT.back () ._interface = 1;
+	vector <Volume>			vV;
+		vV.push_back (Volume () ); vV.back () ._interface = 2; vV.back () ._parent = 0;
+	vector <Device>			vD;
+		vD.push_back (Device () ); vD.back () ._parent = 0;
+		vD.push_back (Device () ); vD.back () ._parent = 0;
+	vector <Interface>		vI (hp._numInterfaces);
+
+	auto					ci = make_shared <UT_SyncDefV2Interface> ();
+	SyncDefV2				sync (ci, hp, vT, vV, vD, vI, OGSS_DataUnit () );
+	Request					r {0., 8, 0, RQT_WRITE}, s {1., 8, 0, RQT_READ};
+
+	r._idxDevice = s._idxDevice = 0;
+	r._numChild = 2;		r._numPrioChild = 0;
+	s._numChild = 1;		s._numPrioChild = 0;
+
+	r._mainIdx = 0;				sync.addEntry (r);
+	Request r1 {r}, r2 {r};
+	r1._majrIdx = 1;			r1._numChild = 1;		r1._numPrioChild = 0;
+	sync.addEntry (r1);
+	Request r11 {r1};			r11._minrIdx = 1;		r11._numChild = 0;
+	r11._transferTimeA1 = .1;	r11._transferTimeA2 = 0;	r11._transferTimeA3 = 0;
+	r11._serviceTime = 3.;
+	r11._transferTimeB3 = 1.;	r11._transferTimeB2 = .6;	r11._transferTimeB1 = .3;
+	sync.addEntry (r11);
+	r2._majrIdx = 2;			r2._numChild = 1;		r2._numPrioChild = 1;
+	sync.addEntry (r2);
+	Request r21 {r2};			r21._minrIdx = 1;		r21._numChild = 0;
+	r21._idxDevice = 1;
+	r21._transferTimeA1 = .1;	r21._transferTimeA2 = 0;	r21._transferTimeA3 = 1.5;
+	r21._serviceTime = 6.;
+	r21._transferTimeB3 = 1.5;	r21._transferTimeB2 = .6;	r21._transferTimeB1 = .2;
+	sync.addEntry (r21);
+
+	s._mainIdx = 1;				sync.addEntry (s);
+	Request s1 {s};				s1._majrIdx = 1;		s1._numPrioChild = 1;
+	sync.addEntry (s1);
+	Request s11 {s1};			s11._minrIdx = 1;		s11._numChild = 0;
+	s11._idxDevice = 1;
+	s11._transferTimeA1 = .2;	s11._transferTimeA2 = .3;	s11._transferTimeA3 = .5;
+	s11._serviceTime = 9.;
+	s11._transferTimeB3 = 1.5;	s11._transferTimeB2 = .3;	s11._transferTimeB1 = .1;
+	sync.addEntry (s11);
+
+	sync.process ();
+
+	// The first logical request is back on the host interface at 9.9,
+	// before the physical request of the second one is done at 18.1, but
+	// the scan restarts from the shortcut left by the last step and reaches
+	// the second one first
+	return ci->_sent == vector <tuple <OGSS_Ulong, OGSS_Ulong, OGSS_Ulong>> {
+		make_tuple (0, 1, 1), make_tuple (0, 1, 0), make_tuple (0, 2, 1),
+		make_tuple (0, 2, 0), make_tuple (1, 1, 1), make_tuple (0, 0, 0),
+		make_tuple (1, 1, 0), make_tuple (1, 0, 0)};
+}
+
+OGSS_Bool
+UT_SyncDefV2::heapOrder () {
+	HardwareParameters		hp;
+		hp._numInterfaces = 3; hp._numTiers = 1; hp._numVolumes = 1;
+		hp._numDevices = 2; hp._hostInterface = 0;
+	vector <Tier>			vT;
+		vT.push_back (Tier () ); vT.back () ._interface = 1;
+	vector <Volume>			vV;
+		vV.push_back (Volume () ); vV.back () ._interface = 2; vV.back () ._parent = 0;
+	vector <Device>			vD;
+		vD.push_back (Device () ); vD.back () ._parent = 0;
+		vD.push_back (Device () ); vD.back () ._parent = 0;
+	vector <Interface>		vI (hp._numInterfaces);
+
+	auto					ci = make_shared <UT_SyncDefV2Interface> ();
+	SyncDefV2				sync (ci, hp, vT, vV, vD, vI, OGSS_DataUnit (), true);
+	Request					r {0., 8, 0, RQT_WRITE}, s {1., 8, 0, RQT_READ};
+
+	r._idxDevice = s._idxDevice = 0;
+	r._numChild = 2;		r._numPrioChild = 0;
+	s._numChild = 1;		s._numPrioChild = 0;
+
+	r._mainIdx = 0;				sync.addEntry (r);
+	Request r1 {r}, r2 {r};
+	r1._majrIdx = 1;			r1._numChild = 1;		r1._numPrioChild = 0;
+	sync.addEntry (r1);
+	Request r11 {r1};			r11._minrIdx = 1;		r11._numChild = 0;
+	r11._transferTimeA1 = .1;	r11._transferTimeA2 = 0;	r11._transferTimeA3 = 0;
+	r11._serviceTime = 3.;
+	r11._transferTimeB3 = 1.;	r11._transferTimeB2 = .6;	r11._transferTimeB1 = .3;
+	sync.addEntry (r11);
+	r2._majrIdx = 2;			r2._numChild = 1;		r2._numPrioChild = 1;
+	sync.addEntry (r2);
+	Request r21 {r2};			r21._minrIdx = 1;		r21._numChild = 0;
+	r21._idxDevice = 1;
+	r21._transferTimeA1 = .1;	r21._transferTimeA2 = 0;	r21._transferTimeA3 = 1.5;
+	r21._serviceTime = 6.;
+	r21._transferTimeB3 = 1.5;	r21._transferTimeB2 = .6;	r21._transferTimeB1 = .2;
+	sync.addEntry (r21);
+
+	s._mainIdx = 1;				sync.addEntry (s);
+	Request s1 {s};				s1._majrIdx = 1;		s1._numPrioChild = 1;
+	sync.addEntry (s1);
+	Request s11 {s1};			s11._minrIdx = 1;		s11._numChild = 0;
+	s11._idxDevice = 1;
+	s11._transferTimeA1 = .2;	s11._transferTimeA2 = .3;	s11._transferTimeA3 = .5;
+	s11._serviceTime = 9.;
+	s11._transferTimeB3 = 1.5;	s11._transferTimeB2 = .3;	s11._transferTimeB1 = .1;
+	sync.addEntry (s11);
+
+	sync.process ();
+
+	// The first logical request is back on the host interface at 9.9, so
+	// it is done before the physical request of the second one, unlike in
+	// the scan order
+	if (ci->_sent != vector <tuple <OGSS_Ulong, OGSS_Ulong, OGSS_Ulong>> {
+		make_tuple (0, 1, 1), make_tuple (0, 1, 0), make_tuple (0, 2, 1),
+		make_tuple (0, 2, 0), make_tuple (0, 0, 0), make_tuple (1, 1, 1),
+		make_tuple (1, 1, 0), make_tuple (1, 0, 0)}) return false;
+
+	// The online mode and the retirement keep the heap order
+	vector <Request>		requests;
+
+	for (OGSS_Ulong i = 0; i < 4000; ++i) {
+		OGSS_Ulong			dev {2 * (i % 2)};
+
+		requests.push_back (createRequest (3. * i, i, 0, 0, 1, dev) );
+		requests.push_back (createRequest (3. * i, i, 1, 0, 2, dev) );
+		requests.push_back (createRequest (3. * i, i, 1, 1, 0, dev) );
+		requests.push_back (createRequest (3. * i, i, 1, 2, 0, dev + 1) );
+	}
+
+	return compareOnline (requests, true, true);
+}
+
+OGSS_Bool
+UT_SyncDefV2::dispatchOrder () {
+	const OGSS_Ulong		numMains {8};
+	vector <Request>		requests;
+	HardwareParameters		hp;
+		hp._numInterfaces = 4; hp._numTiers = 1; hp._numVolumes = 2;
+		hp._numDevices = 4; hp._hostInterface = 0;
+	vector <Tier>			vT;
+		vT.push_back (Tier () ); vT.back () ._interface = 1;
+	vector <Volume>			vV;
+		vV.push_back (Volume () ); vV.back () ._interface = 2; vV.back () ._parent = 0;
+		vV.push_back (Volume () ); vV.back () ._interface = 3; vV.back () ._parent = 0;
+	vector <Device>			vD (hp._numDevices);
+		for (OGSS_Ulong i = 0; i < vD.size (); ++i) vD [i] ._parent = i / 2;
+	vector <Interface>		vI (hp._numInterfaces);
+
+	// The command queue of the device 0 swaps the requests of each pair of
+	// logical requests, so the first one waits for the second one, which is
+	// not received yet in the online mode
+	for (OGSS_Ulong i = 0; i < numMains; ++i) {
+		requests.push_back (createRequest (2. * i, i, 0, 0, 1, 0) );
+		requests.push_back (createRequest (2. * i, i, 1, 0, 2, 0) );
+		requests.push_back (createRequest (2. * i, i, 1, 1, 0, 0) );
+		requests.back () ._dispatchIdx = i ^ 1;
+		requests.push_back (createRequest (2. * i, i, 1, 2, 0, 1) );
+	}
+
+	if (! compareOnline (requests, false, false) ) return false;
+
+	SyncDefV2				sync (make_shared <UT_SyncDefV2Interface> (),
+		hp, vT, vV, vD, vI, OGSS_DataUnit () );
+
+	for (auto elt: requests) sync.addEntry (elt);
+	sync.process ();
+
+	// Each service starts once the previous one in the dispatch order is done
+	for (OGSS_Ulong i = 0; i + 1 < numMains; ++i) {
+		OGSS_Ulong			prev {findRow (sync, i ^ 1, 1, 1)};
+		OGSS_Ulong			next {findRow (sync, (i + 1) ^ 1, 1, 1)};
+
+		if (sync._rslt [SyncDefV2::SERVCE][next] - sync._data [SyncDefV2::SERVCE][next]
+			- sync._rslt [SyncDefV2::SERVCE][prev] < - numeric_limits <float> ::epsilon () )
+			return false;
+	}
+
+	return true;
+}
+
+OGSS_Bool
+UT_SyncDefV2::onlineVolumes () {
+	const OGSS_Ulong		numMains {8}, delay {2};
+	vector <vector <Request>>	slots (numMains + delay);
+	vector <Request>		requests;
+
+	// The even logical requests are on both volumes, the odd ones on one of
+	// them. The volume 0 sends the children right after their logical
+	// request, and the volume 1 two logical requests later, the physical
+	// requests first
+	for (OGSS_Ulong i = 0; i < numMains; ++i) {
+		OGSS_Ulong			numMajrs {i % 2 ? 1UL : 2UL};
+		OGSS_Ulong			majr {0};
+
+		slots [i] .push_back (createRequest (2. * i, i, 0, 0, numMajrs, 0) );
+
+		for (OGSS_Ulong vol = 0; vol < 2; ++vol) {
+			if (i % 2 && vol != (i / 2) % 2) continue;
+
+			auto			& slot = slots [i + vol * delay];
+			Request			major {createRequest (2. * i, i, ++ majr, 0, 2, 2 * vol)};
+
+			if (! vol) slot.push_back (major);
+			slot.push_back (createRequest (2. * i, i, majr, 2, 0, 2 * vol + 1) );
+			slot.push_back (createRequest (2. * i, i, majr, 1, 0, 2 * vol) );
+			if (vol) slot.push_back (major);
+		}
+	}
+
+	for (auto & slot: slots)
+		requests.insert (requests.end (), slot.begin (), slot.end () );
+
+	return compareOnline (requests, false, false);
+}
+
+OGSS_Bool
+UT_SyncDefV2::onlineCoalescing () {
+	const OGSS_Ulong		numMains {8}, numHeld {4};
+	vector <Request>		requests, held;
+
+	// The writes of the first logical requests are held by the volume until
+	// the stripe is full, then sent with the date of the last one, after
+	// the next logical requests are received
+	for (OGSS_Ulong i = 0; i < numMains; ++i) {
+		auto				& dest = (i < numHeld) ? held : requests;
+		OGSS_Real			date {i < numHeld ? numHeld - 1. : 2. * i};
+
+		requests.push_back (createRequest (2. * i, i, 0, 0, 1, 0) );
+		dest.push_back (createRequest (date, i, 1, 0, 2, 0) );
+		dest.push_back (createRequest (date, i, 1, 1, 0, 0) );
+		dest.push_back (createRequest (date, i, 1, 2, 0, 1) );
+
+		if (i == numHeld + 1)
+			requests.insert (requests.end (), held.begin (), held.end () );
+	}
+
+	return compareOnline (requests, false, false);
+}
+
+OGSS_Bool
+UT_SyncDefV2::onlineRetirement () {
+	const OGSS_Ulong		numMains {4000};
+	vector <Request>		requests;
+
+	// The logical requests alternate between the volumes, and each one has
+	// two physical requests: 16 000 rows in all
+	for (OGSS_Ulong i = 0; i < numMains; ++i) {
+		OGSS_Ulong			dev {2 * (i % 2)};
+
+		requests.push_back (createRequest (3. * i, i, 0, 0, 1, dev) );
+		requests.push_back (createRequest (3. * i, i, 1, 0, 2, dev) );
+		requests.push_back (createRequest (3. * i, i, 1, 1, 0, dev) );
+		requests.push_back (createRequest (3. * i, i, 1, 2, 0, dev + 1) );
+	}
+
+	return compareOnline (requests, true, false);
+}
+
 /*
 OGSS_Bool
 UT_SyncDefV2::multiRequests_system () {